@@ -22,6 +22,7 @@
 #include <zephyr/tracing/tracing_macros.h>
 #include <zephyr/sys/mem_stats.h>
 #include <zephyr/sys/iterable_sections.h>
+#include <zephyr/sys/heap_cache.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -2911,6 +2912,13 @@ struct k_mutex {
 
 	SYS_PORT_TRACING_TRACKING_FIELD(k_mutex)
 
+#ifdef CONFIG_OBJ_CORE_STATS_MUTEX
+	/** Contention statistics */
+	struct k_lock_stats stats;
+	/** Time (in cycles) when the current owner took the mutex */
+	uint32_t held_since;
+#endif
+
 #ifdef CONFIG_OBJ_CORE_MUTEX
 	struct k_obj_core obj_core;
 #endif
@@ -3096,23 +3104,40 @@ __syscall int k_condvar_wait(struct k_condvar *condvar, struct k_mutex *mutex,
 
 struct k_sem {
 	_wait_q_t wait_q;
+#ifdef CONFIG_SEM_FAST_PATH
+	atomic_t count;
+#else
 	unsigned int count;
+#endif
 	unsigned int limit;
 
 	Z_DECL_POLL_EVENT
 
 	SYS_PORT_TRACING_TRACKING_FIELD(k_sem)
 
+#ifdef CONFIG_OBJ_CORE_STATS_SEM
+	struct k_lock_stats stats;
+#endif
+
 #ifdef CONFIG_OBJ_CORE_SEM
 	struct k_obj_core  obj_core;
 #endif
 };
 
+#ifdef CONFIG_SEM_FAST_PATH
+/* The top bit of the atomic count is reserved, so limits above what the
+ * rest of it can hold are clamped.
+ */
+#define Z_SEM_COUNT_MAX ((unsigned int)INT_MAX)
+#else
+#define Z_SEM_COUNT_MAX UINT_MAX
+#endif
+
 #define Z_SEM_INITIALIZER(obj, initial_count, count_limit) \
 	{ \
 	.wait_q = Z_WAIT_Q_INIT(&obj.wait_q), \
-	.count = initial_count, \
-	.limit = count_limit, \
+	.count = MIN(initial_count, Z_SEM_COUNT_MAX), \
+	.limit = MIN(count_limit, Z_SEM_COUNT_MAX), \
 	Z_POLL_EVENT_OBJ_INIT(obj) \
 	}
 
@@ -3133,6 +3158,8 @@ struct k_sem {
  * an explicit maximum limit, and instead is just used for
  * counting purposes.
  *
+ * When @kconfig{CONFIG_SEM_FAST_PATH} is enabled the count saturates at
+ * INT_MAX, as its top bit is reserved.
  */
 #define K_SEM_MAX_LIMIT UINT_MAX
 
@@ -3213,7 +3240,11 @@ __syscall unsigned int k_sem_count_get(struct k_sem *sem);
  */
 static inline unsigned int z_impl_k_sem_count_get(struct k_sem *sem)
 {
+#ifdef CONFIG_SEM_FAST_PATH
+	return (unsigned int)(atomic_get(&sem->count) & Z_SEM_COUNT_MAX);
+#else
 	return sem->count;
+#endif
 }
 
 /**
@@ -3455,6 +3486,46 @@ void k_work_queue_start(struct k_work_q *queue,
 			k_thread_stack_t *stack, size_t stack_size,
 			int prio, const struct k_work_queue_config *cfg);
 
+/** @brief Start a work queue served by a pool of threads.
+ *
+ * This works like k_work_queue_start(), except that @p num_threads threads
+ * take work items from the queue.  Items may then be processed concurrently,
+ * but a given work item is never processed by more than one thread at a
+ * time.  Flushing, cancelling and draining behave as they do for a queue
+ * with a single thread.
+ *
+ * The queue's own thread, as returned by k_work_queue_thread_get(), is the
+ * first thread of the pool and uses the first stack of @p stacks.
+ *
+ * @note Requires CONFIG_WORKQUEUE_POOL.
+ *
+ * @param queue pointer to the queue structure. It must be initialized
+ *        in zeroed/bss memory or with @ref k_work_queue_init before
+ *        use.
+ *
+ * @param threads array of @p num_threads - 1 thread objects for the
+ *        additional threads.  May be NULL if @p num_threads is 1.
+ *
+ * @param stacks array of @p num_threads stacks, as defined by
+ *        K_THREAD_STACK_ARRAY_DEFINE().
+ *
+ * @param stack_size size of each stack, which must be the same constant
+ *        passed to K_THREAD_STACK_ARRAY_DEFINE().
+ *
+ * @param num_threads number of threads serving the queue.
+ *
+ * @param prio initial priority of all the threads
+ *
+ * @param cfg optional additional configuration parameters.  Pass @c
+ * NULL if not required, to use the defaults documented in
+ * k_work_queue_config.
+ */
+void k_work_queue_pool_start(struct k_work_q *queue,
+			     struct k_thread *threads,
+			     k_thread_stack_t *stacks, size_t stack_size,
+			     size_t num_threads, int prio,
+			     const struct k_work_queue_config *cfg);
+
 /** @brief Access the thread that animates a work queue.
  *
  * This is necessary to grant a work queue thread access to things the work
@@ -4024,6 +4095,17 @@ struct k_work_q {
 
 	/* Flags describing queue state. */
 	uint32_t flags;
+
+#if defined(CONFIG_WORKQUEUE_POOL) || defined(__DOXYGEN__)
+	/* Threads animating the work in addition to thread. */
+	struct k_thread *threads;
+
+	/* Total number of threads animating the work. */
+	uint16_t num_threads;
+
+	/* Number of threads currently processing a work item. */
+	uint16_t busy;
+#endif
 };
 
 /* Provide the implementation for inline functions declared above */
@@ -4589,6 +4671,63 @@ __syscall int k_msgq_put(struct k_msgq *msgq, const void *data, k_timeout_t time
  */
 __syscall int k_msgq_get(struct k_msgq *msgq, void *data, k_timeout_t timeout);
 
+/**
+ * @brief Send several messages to a message queue.
+ *
+ * This routine sends up to @a num_msgs consecutive messages from @a data to
+ * message queue @a msgq, holding the queue lock only once. Messages are
+ * handed directly to threads waiting to receive, then copied into the ring
+ * buffer until it is full, and the caller is rescheduled at most once.
+ *
+ * If no message can be sent immediately the caller waits for up to
+ * @a timeout for room for the first message only, in which case at most one
+ * message is sent.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param msgq Address of the message queue.
+ * @param data Pointer to an array of @a num_msgs messages.
+ * @param num_msgs Number of messages to send.
+ * @param timeout Non-negative waiting period to add the first message,
+ *                or one of the special values K_NO_WAIT and
+ *                K_FOREVER.
+ *
+ * @retval >=0 Number of messages sent.
+ * @retval -ENOMSG Returned without waiting or queue purged.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+__syscall int k_msgq_put_many(struct k_msgq *msgq, const void *data,
+			      uint32_t num_msgs, k_timeout_t timeout);
+
+/**
+ * @brief Receive several messages from a message queue.
+ *
+ * This routine receives up to @a num_msgs messages from message queue
+ * @a msgq into @a data in a "first in, first out" manner, holding the queue
+ * lock only once. Threads waiting to send are then admitted into the freed
+ * slots, and the caller is rescheduled at most once.
+ *
+ * If the queue is empty the caller waits for up to @a timeout for a single
+ * message, in which case at most one message is received.
+ *
+ * @note @a timeout must be set to K_NO_WAIT if called from ISR.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param msgq Address of the message queue.
+ * @param data Address of an area large enough to hold @a num_msgs messages.
+ * @param num_msgs Maximum number of messages to receive.
+ * @param timeout Waiting period to receive the first message,
+ *                or one of the special values K_NO_WAIT and
+ *                K_FOREVER.
+ *
+ * @retval >=0 Number of messages received.
+ * @retval -ENOMSG Returned without waiting.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+__syscall int k_msgq_get_many(struct k_msgq *msgq, void *data,
+			      uint32_t num_msgs, k_timeout_t timeout);
+
 /**
  * @brief Peek/read a message from a message queue.
  *
@@ -4850,6 +4989,8 @@ struct k_pipe {
 	size_t         bytes_used;      /**< # bytes used in buffer */
 	size_t         read_index;      /**< Where in buffer to read from */
 	size_t         write_index;     /**< Where in buffer to write */
+	size_t         put_claimed;     /**< # bytes claimed for writing */
+	size_t         get_claimed;     /**< # bytes claimed for reading */
 	struct k_spinlock lock;		/**< Synchronization lock */
 
 	struct {
@@ -4880,6 +5021,8 @@ struct k_pipe {
 	.bytes_used = 0,                                            \
 	.read_index = 0,                                            \
 	.write_index = 0,                                           \
+	.put_claimed = 0,                                           \
+	.get_claimed = 0,                                           \
 	.lock = {},                                                 \
 	.wait_q = {                                                 \
 		.readers = Z_WAIT_Q_INIT(&obj.wait_q.readers),       \
@@ -5045,6 +5188,93 @@ __syscall void k_pipe_flush(struct k_pipe *pipe);
  */
 __syscall void k_pipe_buffer_flush(struct k_pipe *pipe);
 
+/**
+ * @brief Claim space in a pipe's buffer for writing in place.
+ *
+ * This routine gives direct access to up to @a size contiguous free bytes
+ * of @a pipe's ring buffer, so that a producer can build its data there
+ * instead of copying it in with k_pipe_put(). The data only becomes
+ * readable once k_pipe_put_commit() is called.
+ *
+ * Only one write claim may be outstanding on a pipe at a time. While it
+ * is, k_pipe_put() callers can only hand data directly to waiting readers
+ * and otherwise wait for the claim to be committed.
+ *
+ * @note This routine is not available to user mode threads, which cannot
+ *       access the pipe's buffer.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param pipe Address of the pipe.
+ * @param data Address of the pointer to the claimed area.
+ * @param size Requested number of bytes.
+ *
+ * @return Number of bytes claimed, which may be less than @a size if the
+ *         free space wraps around the end of the buffer. Zero if the pipe is
+ *         full, has no buffer, or a write claim is already outstanding.
+ */
+size_t k_pipe_put_claim(struct k_pipe *pipe, uint8_t **data, size_t size);
+
+/**
+ * @brief Commit data written in place into a pipe's buffer.
+ *
+ * This routine makes the first @a size bytes of the area obtained with
+ * k_pipe_put_claim() readable and releases the claim. Waiting readers are
+ * served from the buffer before returning.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param pipe Address of the pipe.
+ * @param size Number of valid bytes written, possibly zero.
+ *
+ * @retval 0 Data committed.
+ * @retval -EINVAL @a size exceeds the claimed size.
+ */
+int k_pipe_put_commit(struct k_pipe *pipe, size_t size);
+
+/**
+ * @brief Claim data in a pipe's buffer for reading in place.
+ *
+ * This routine gives direct access to up to @a size contiguous bytes of
+ * data held in @a pipe's ring buffer, so that a consumer can process it
+ * without copying it out with k_pipe_get(). Data held by waiting writers
+ * is not visible until it has been moved into the buffer.
+ *
+ * Only one read claim may be outstanding on a pipe at a time. While it is,
+ * k_pipe_get() callers wait for the claim to be committed.
+ *
+ * @note This routine is not available to user mode threads, which cannot
+ *       access the pipe's buffer.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param pipe Address of the pipe.
+ * @param data Address of the pointer to the claimed data.
+ * @param size Requested number of bytes.
+ *
+ * @return Number of bytes claimed, which may be less than @a size if the
+ *         data wraps around the end of the buffer. Zero if the buffer is
+ *         empty, missing, or a read claim is already outstanding.
+ */
+size_t k_pipe_get_claim(struct k_pipe *pipe, uint8_t **data, size_t size);
+
+/**
+ * @brief Release data read in place from a pipe's buffer.
+ *
+ * This routine frees the first @a size bytes of the area obtained with
+ * k_pipe_get_claim() and releases the claim. Unconsumed bytes stay in the
+ * pipe. Waiting writers are moved into the freed space before returning.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param pipe Address of the pipe.
+ * @param size Number of bytes consumed, possibly zero.
+ *
+ * @retval 0 Data released.
+ * @retval -EINVAL @a size exceeds the claimed size.
+ */
+int k_pipe_get_commit(struct k_pipe *pipe, size_t size);
+
 /** @} */
 
 /**
@@ -5060,6 +5290,15 @@ struct k_mem_slab_info {
 #endif
 };
 
+#ifdef CONFIG_MEM_SLAB_CACHE
+/* Free blocks of a memory slab kept by one CPU */
+struct z_mem_slab_cache_cpu {
+	struct k_spinlock lock;
+	char *free_list;
+	uint32_t count;
+};
+#endif
+
 struct k_mem_slab {
 	_wait_q_t wait_q;
 	struct k_spinlock lock;
@@ -5072,6 +5311,12 @@ struct k_mem_slab {
 #ifdef CONFIG_OBJ_CORE_MEM_SLAB
 	struct k_obj_core  obj_core;
 #endif
+
+#ifdef CONFIG_MEM_SLAB_CACHE
+	struct z_mem_slab_cache_cpu cache[CONFIG_MP_MAX_NUM_CPUS];
+	/* Set while threads wait for a block, frees bypass the caches */
+	atomic_t cache_hold;
+#endif
 };
 
 #define Z_MEM_SLAB_INITIALIZER(_slab, _slab_buffer, _slab_block_size, \
@@ -5208,6 +5453,11 @@ int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem,
  */
 void k_mem_slab_free(struct k_mem_slab *slab, void *mem);
 
+#ifdef CONFIG_MEM_SLAB_CACHE
+/* Number of free blocks held in the per-CPU caches of a memory slab */
+uint32_t z_mem_slab_num_cached(struct k_mem_slab *slab);
+#endif
+
 /**
  * @brief Get the number of used blocks in a memory slab.
  *
@@ -5220,7 +5470,11 @@ void k_mem_slab_free(struct k_mem_slab *slab, void *mem);
  */
 static inline uint32_t k_mem_slab_num_used_get(struct k_mem_slab *slab)
 {
+#ifdef CONFIG_MEM_SLAB_CACHE
+	return slab->info.num_used - z_mem_slab_num_cached(slab);
+#else
 	return slab->info.num_used;
+#endif
 }
 
 /**
@@ -5255,7 +5509,7 @@ static inline uint32_t k_mem_slab_max_used_get(struct k_mem_slab *slab)
  */
 static inline uint32_t k_mem_slab_num_free_get(struct k_mem_slab *slab)
 {
-	return slab->info.num_blocks - slab->info.num_used;
+	return slab->info.num_blocks - k_mem_slab_num_used_get(slab);
 }
 
 /**
@@ -5287,6 +5541,208 @@ int k_mem_slab_runtime_stats_reset_max(struct k_mem_slab *slab);
 
 /** @} */
 
+#if defined(CONFIG_MEM_CACHE) || defined(__DOXYGEN__)
+
+/**
+ * @cond INTERNAL_HIDDEN
+ */
+
+struct k_mem_cache_info {
+	uint32_t num_grown;
+	uint32_t max_grown;
+	uint32_t grow_failures;
+};
+
+/* Each object is preceded by the word the slab links free blocks
+ * with, so that free objects keep their constructed state
+ */
+#define Z_MEM_CACHE_ALIGN(obj_align) MAX(obj_align, sizeof(void *))
+
+/**
+ * INTERNAL_HIDDEN @endcond
+ */
+
+/**
+ * @defgroup mem_cache_apis Object Cache APIs
+ * @ingroup kernel_apis
+ * @{
+ */
+
+/**
+ * @brief Object constructor or destructor of a k_mem_cache
+ *
+ * @param obj Object to construct or destroy
+ */
+typedef void (*k_mem_cache_ctor_t)(void *obj);
+
+/**
+ * @brief Object cache
+ *
+ * A cache of fixed-size objects built on memory slabs, see
+ * k_mem_cache_init().
+ */
+struct k_mem_cache {
+	/** Slab of the objects given at initialization */
+	struct k_mem_slab slab;
+	_wait_q_t wait_q;
+	struct k_spinlock lock;
+	atomic_t waiters;
+	size_t obj_size;
+	size_t obj_align;
+	k_mem_cache_ctor_t ctor;
+	k_mem_cache_ctor_t dtor;
+	/* Slabs grown from the heap */
+	struct k_heap *heap;
+	uint32_t grow_objs;
+	uint32_t grow_max;
+	sys_slist_t grown;
+	struct k_mem_cache_info info;
+
+#ifdef CONFIG_OBJ_CORE_MEM_CACHE
+	struct k_obj_core obj_core;
+#endif
+};
+
+/**
+ * @brief Size of the slab block holding one object of a k_mem_cache
+ *
+ * @param obj_size Size of the objects
+ * @param obj_align Alignment of the objects, a power of two
+ */
+#define K_MEM_CACHE_BLOCK_SIZE(obj_size, obj_align) \
+	(Z_MEM_CACHE_ALIGN(obj_align) + \
+	 ROUND_UP(obj_size, Z_MEM_CACHE_ALIGN(obj_align)))
+
+/**
+ * @brief Statically define and initialize an object cache.
+ *
+ * The cache initially holds @a num objects, constructed at boot.
+ * It can be declared in another module with
+ * `extern struct k_mem_cache <name>;`.
+ *
+ * @param name Name of the object cache.
+ * @param size Size of each object in bytes.
+ * @param num Number of objects of the initial slab.
+ * @param align Alignment of the objects in bytes, a power of two.
+ * @param ctor_fn Constructor of the objects, or NULL.
+ * @param dtor_fn Destructor of the objects, or NULL.
+ */
+#define K_MEM_CACHE_DEFINE(name, size, num, align, ctor_fn, dtor_fn) \
+	static char __noinit __aligned(Z_MEM_CACHE_ALIGN(align)) \
+		_k_mem_cache_buf_##name[(num) * K_MEM_CACHE_BLOCK_SIZE(size, align)]; \
+	STRUCT_SECTION_ITERABLE(k_mem_cache, name) = { \
+		.slab = Z_MEM_SLAB_INITIALIZER(name.slab, _k_mem_cache_buf_##name, \
+					       K_MEM_CACHE_BLOCK_SIZE(size, align), \
+					       num), \
+		.wait_q = Z_WAIT_Q_INIT(&name.wait_q), \
+		.obj_size = size, \
+		.obj_align = Z_MEM_CACHE_ALIGN(align), \
+		.ctor = ctor_fn, \
+		.dtor = dtor_fn, \
+	}
+
+/**
+ * @brief Initialize an object cache.
+ *
+ * Objects are allocated from a memory slab of @a num_objs blocks of
+ * K_MEM_CACHE_BLOCK_SIZE() bytes in @a buffer.  With
+ * CONFIG_MEM_SLAB_CACHE, the slab keeps per-CPU magazines of free
+ * objects, so allocations and frees on different CPUs don't contend.
+ *
+ * The constructor runs once for each object when its slab is created,
+ * here or when the cache grows, and the destructor when its slab is
+ * released by k_mem_cache_shrink().  Objects must be freed in their
+ * constructed state, which the cache preserves, so that costly
+ * initialization is not repeated on every allocation.
+ *
+ * @param cache Address of the object cache.
+ * @param buffer Memory of the initial slab, aligned to @a obj_align,
+ *               or NULL if @a num_objs is 0.
+ * @param obj_size Size of each object in bytes.
+ * @param obj_align Alignment of the objects in bytes, a power of two.
+ * @param num_objs Number of objects of the initial slab.
+ * @param ctor Constructor of the objects, or NULL.
+ * @param dtor Destructor of the objects, or NULL.
+ *
+ * @retval 0 on success
+ * @retval -EINVAL invalid data supplied
+ */
+int k_mem_cache_init(struct k_mem_cache *cache, void *buffer,
+		     size_t obj_size, size_t obj_align, uint32_t num_objs,
+		     k_mem_cache_ctor_t ctor, k_mem_cache_ctor_t dtor);
+
+/**
+ * @brief Let an object cache grow from a heap.
+ *
+ * When all objects are in use, the cache allocates an additional slab
+ * of @a grow_objs objects from @a heap, up to @a grow_max slabs.  Slabs
+ * whose objects are all free are given back by k_mem_cache_shrink().
+ *
+ * @param cache Address of the object cache.
+ * @param heap Heap to grow from.
+ * @param grow_objs Number of objects of each additional slab.
+ * @param grow_max Maximum number of additional slabs.
+ *
+ * @retval 0 on success
+ * @retval -EINVAL invalid data supplied
+ */
+int k_mem_cache_heap_set(struct k_mem_cache *cache, struct k_heap *heap,
+			 uint32_t grow_objs, uint32_t grow_max);
+
+/**
+ * @brief Allocate an object from an object cache.
+ *
+ * The object is in its constructed state.  If none is free and the
+ * cache can't grow, the thread waits for one up to @a timeout.
+ *
+ * @param cache Address of the object cache.
+ * @param timeout Waiting period to wait for an object, or one of the
+ *                special values K_NO_WAIT and K_FOREVER.
+ *
+ * @return Address of the object, or NULL if none was available.
+ */
+void *k_mem_cache_alloc(struct k_mem_cache *cache, k_timeout_t timeout);
+
+/**
+ * @brief Free an object to an object cache.
+ *
+ * @param cache Address of the object cache.
+ * @param obj Object returned by k_mem_cache_alloc(), in its
+ *            constructed state.
+ */
+void k_mem_cache_free(struct k_mem_cache *cache, void *obj);
+
+/**
+ * @brief Release the unused slabs an object cache grew.
+ *
+ * Destroys the objects of every additional slab whose objects are all
+ * free and returns its memory to the heap.
+ *
+ * @param cache Address of the object cache.
+ *
+ * @return Number of slabs released.
+ */
+uint32_t k_mem_cache_shrink(struct k_mem_cache *cache);
+
+/**
+ * @brief Get the memory stats of an object cache
+ *
+ * The maximum is only tracked with CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
+ * and is the sum of the maximums of the slabs currently in the cache.
+ *
+ * @param cache Address of the object cache.
+ * @param stats Pointer to memory into which to copy memory usage statistics
+ *
+ * @retval 0 Success
+ * @retval -EINVAL Any parameter points to NULL
+ */
+int k_mem_cache_runtime_stats_get(struct k_mem_cache *cache,
+				  struct sys_memory_stats *stats);
+
+/** @} */
+
+#endif /* CONFIG_MEM_CACHE */
+
 /**
  * @addtogroup heap_apis
  * @{
@@ -5298,6 +5754,9 @@ struct k_heap {
 	struct sys_heap heap;
 	_wait_q_t wait_q;
 	struct k_spinlock lock;
+#ifdef CONFIG_SYS_HEAP_CACHE
+	struct sys_heap_cache cache;
+#endif
 };
 
 /**
@@ -5377,7 +5836,11 @@ void k_heap_free(struct k_heap *h, void *mem) __attribute_nonnull(1);
 /* Hand-calculated minimum heap sizes needed to return a successful
  * 1-byte allocation.  See details in lib/os/heap.[ch]
  */
+#ifdef CONFIG_SYS_HEAP_TLSF
+#define Z_HEAP_MIN_SIZE (sizeof(void *) > 4 ? 64 : 52)
+#else
 #define Z_HEAP_MIN_SIZE (sizeof(void *) > 4 ? 56 : 44)
+#endif
 
 /**
  * @brief Define a static k_heap in the specified linker section
@@ -6059,6 +6522,43 @@ int k_thread_runtime_stats_get(k_tid_t thread,
  */
 int k_thread_runtime_stats_all_get(k_thread_runtime_stats_t *stats);
 
+#if defined(CONFIG_SCHED_LATENCY_STATS) || defined(__DOXYGEN__)
+/**
+ * @brief Get the wake-to-run latencies of a priority level
+ *
+ * This routine retrieves the histogram of the wake-to-run latencies of all
+ * the threads that were switched in at priority @a prio. The latencies of a
+ * thread or a CPU are part of its runtime statistics.
+ *
+ * @param prio Thread priority.
+ * @param stats Pointer to struct to copy statistics into.
+ * @return -EINVAL if @a prio is not a valid priority or @a stats is NULL,
+ *         otherwise 0
+ */
+int k_sched_latency_prio_get(int prio, struct k_sched_latency_stats *stats);
+
+/**
+ * @brief Get the wake-to-run latencies of a CPU
+ *
+ * This routine retrieves the histogram of the wake-to-run latencies of all
+ * the threads that were switched in on CPU @a cpu.
+ *
+ * @param cpu CPU index.
+ * @param stats Pointer to struct to copy statistics into.
+ * @return -EINVAL if @a cpu is not a valid CPU or @a stats is NULL,
+ *         otherwise 0
+ */
+int k_sched_latency_cpu_get(unsigned int cpu, struct k_sched_latency_stats *stats);
+
+/**
+ * @brief Reset the wake-to-run latencies of all priority levels and CPUs
+ *
+ * The latencies of each thread are reset along with its other statistics
+ * through k_obj_core_stats_reset().
+ */
+void k_sched_latency_reset(void);
+#endif
+
 /**
  * @brief Enable gathering of runtime statistics for specified thread
  *
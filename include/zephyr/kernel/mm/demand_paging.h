@@ -48,6 +48,11 @@ struct k_mem_paging_stats_t {
 		/** Number of page faults while in ISR */
 		unsigned long			in_isr;
 #endif
+
+#if defined(CONFIG_DEMAND_PAGING_READ_AHEAD) || defined(__DOXYGEN__)
+		/** Number of pages read ahead of sequential page faults */
+		unsigned long			read_ahead;
+#endif
 	} pagefaults;
 
 	struct {
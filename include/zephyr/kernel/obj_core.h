@@ -45,6 +45,8 @@
 #define K_OBJ_TYPE_MBOX_ID       K_OBJ_TYPE_ID_GEN("MBOX")
 /** Memory slab object type */
 #define K_OBJ_TYPE_MEM_SLAB_ID   K_OBJ_TYPE_ID_GEN("SLAB")
+/** Object cache object type */
+#define K_OBJ_TYPE_MEM_CACHE_ID  K_OBJ_TYPE_ID_GEN("MCCH")
 /** Message queue object type */
 #define K_OBJ_TYPE_MSGQ_ID       K_OBJ_TYPE_ID_GEN("MSGQ")
 /** Mutex object type */
@@ -53,6 +55,8 @@
 #define K_OBJ_TYPE_PIPE_ID       K_OBJ_TYPE_ID_GEN("PIPE")
 /** Semaphore object type */
 #define K_OBJ_TYPE_SEM_ID        K_OBJ_TYPE_ID_GEN("SEM4")
+/** Spinlock object type */
+#define K_OBJ_TYPE_SPINLOCK_ID   K_OBJ_TYPE_ID_GEN("SPIN")
 /** Stack object type */
 #define K_OBJ_TYPE_STACK_ID      K_OBJ_TYPE_ID_GEN("STCK")
 /** Thread object type */
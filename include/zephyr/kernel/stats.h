@@ -30,4 +30,63 @@ struct k_cycle_stats {
 	bool      track_usage;  /**< true if gathering usage stats */
 };
 
+#if defined(CONFIG_SCHED_LATENCY_STATS) || defined(__DOXYGEN__)
+/**
+ * Structure used to track the wake-to-run latency of threads, that is the
+ * time between a thread being made ready and it being switched in. Bucket N
+ * of the histogram counts latencies of [2^N, 2^(N+1)) cycles, except for the
+ * first one which also counts shorter latencies and the last one which also
+ * counts all longer ones.
+ */
+
+struct k_sched_latency_stats {
+	uint64_t  total;        /**< total latency in cycles */
+	uint32_t  count;        /**< \# of wake-ups */
+	uint32_t  max;          /**< longest latency in cycles */
+	/** log2 histogram of the latencies */
+	uint32_t  buckets[CONFIG_SCHED_LATENCY_STATS_BUCKETS];
+};
+#endif
+
+/**
+ * Structure used to track lock contention statistics of spinlocks,
+ * mutexes and semaphores. All times are in cycles as measured by
+ * k_cycle_get_32(), so a single wait or hold longer than the 32-bit
+ * cycle counter period is not reported correctly.
+ */
+
+struct k_lock_stats {
+	uint64_t  acquisitions; /**< \# of times the lock was taken */
+	uint64_t  contentions;  /**< \# of attempts that found it unavailable */
+	uint64_t  total_wait;   /**< total cycles spent waiting for it */
+	uint32_t  max_wait;     /**< longest wait in cycles */
+	uint32_t  max_hold;     /**< longest hold in cycles (not for semaphores) */
+};
+
+/**
+ * @cond INTERNAL_HIDDEN
+ */
+
+static inline void z_lock_stats_contended(struct k_lock_stats *stats,
+					  uint32_t wait)
+{
+	stats->contentions++;
+	stats->total_wait += wait;
+	if (wait > stats->max_wait) {
+		stats->max_wait = wait;
+	}
+}
+
+static inline void z_lock_stats_released(struct k_lock_stats *stats,
+					 uint32_t hold)
+{
+	if (hold > stats->max_hold) {
+		stats->max_hold = hold;
+	}
+}
+
+/**
+ * INTERNAL_HIDDEN @endcond
+ */
+
 #endif
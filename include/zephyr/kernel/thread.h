@@ -114,6 +114,11 @@ struct _thread_base {
 	/* CPU index on which thread was last run */
 	uint8_t cpu;
 
+#ifdef CONFIG_SCHED_PERCPU
+	/* CPU index of the run queue holding this thread */
+	uint8_t runq_cpu;
+#endif
+
 	/* Recursive count of irq_lock() calls */
 	uint8_t global_lock_count;
 
@@ -145,6 +150,11 @@ struct _thread_base {
 #ifdef CONFIG_SCHED_THREAD_USAGE
 	struct k_cycle_stats  usage;   /* Track thread usage statistics */
 #endif
+
+#ifdef CONFIG_SCHED_LATENCY_STATS
+	uint32_t ready_since;  /* When made ready, 0 if not waiting to run */
+	struct k_sched_latency_stats latency;
+#endif
 };
 
 typedef struct _thread_base _thread_base_t;
@@ -228,6 +238,15 @@ typedef struct k_thread_runtime_stats {
 	uint64_t idle_cycles;
 #endif
 
+#ifdef CONFIG_SCHED_LATENCY_STATS
+	/*
+	 * Wake-to-run latencies of the thread. In the context of CPU
+	 * statistics, those of all the threads that the CPU switched in.
+	 */
+
+	struct k_sched_latency_stats latency;
+#endif
+
 #if defined(__cplusplus) && !defined(CONFIG_SCHED_THREAD_USAGE) &&                                 \
 	!defined(CONFIG_SCHED_THREAD_USAGE_ANALYSIS) && !defined(CONFIG_SCHED_THREAD_USAGE_ALL)
 	/* If none of the above Kconfig values are defined, this struct will have a size 0 in C
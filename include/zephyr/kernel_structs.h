@@ -114,7 +114,7 @@ struct _cpu {
 	/* one assigned idle thread per CPU */
 	struct k_thread *idle_thread;
 
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#if defined(CONFIG_SCHED_CPU_MASK_PIN_ONLY) || defined(CONFIG_SCHED_PERCPU)
 	struct _ready_q ready_q;
 #endif
 
@@ -149,6 +149,11 @@ struct _cpu {
 #endif
 #endif
 
+#ifdef CONFIG_SCHED_LATENCY_STATS
+	/* Wake-to-run latencies of the threads switched in on this CPU */
+	struct k_sched_latency_stats latency;
+#endif
+
 #ifdef CONFIG_OBJ_CORE_SYSTEM
 	struct k_obj_core  obj_core;
 #endif
@@ -170,7 +175,7 @@ struct z_kernel {
 	 * ready queue: can be big, keep after small fields, since some
 	 * assembly (e.g. ARC) are limited in the encoding of the offset
 	 */
-#ifndef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#if !defined(CONFIG_SCHED_CPU_MASK_PIN_ONLY) && !defined(CONFIG_SCHED_PERCPU)
 	struct _ready_q ready_q;
 #endif
 
@@ -255,14 +260,30 @@ struct _timeout;
 typedef void (*_timeout_func_t)(struct _timeout *t);
 
 struct _timeout {
+#ifdef CONFIG_TIMEOUT_QUEUE_SCALABLE
+	struct rbnode node;
+#else
 	sys_dnode_t node;
+#endif
 	_timeout_func_t fn;
 #ifdef CONFIG_TIMEOUT_64BIT
-	/* Can't use k_ticks_t for header dependency reasons */
+	/* Can't use k_ticks_t for header dependency reasons.  With
+	 * CONFIG_TIMEOUT_QUEUE_SCALABLE this holds the absolute expiry
+	 * tick (zero when inactive) rather than a delta from the
+	 * previous timeout in the queue.
+	 */
 	int64_t dticks;
 #else
 	int32_t dticks;
 #endif
+#ifdef CONFIG_TIMEOUT_QUEUE_SCALABLE
+	/* Tie breaker keeping same-tick timeouts in FIFO order */
+	uint32_t order_key;
+#endif
+#ifdef CONFIG_TIMEOUT_QUEUE_PERCPU
+	/* Index of the per-CPU queue holding this timeout */
+	uint8_t cpu;
+#endif
 };
 
 typedef void (*k_thread_timeslice_fn_t)(struct k_thread *thread, void *data);
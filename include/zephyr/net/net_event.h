@@ -210,6 +210,7 @@ enum net_event_l4_cmd {
 	NET_EVENT_L4_CMD_DNS_SERVER_ADD,
 	NET_EVENT_L4_CMD_DNS_SERVER_DEL,
 	NET_EVENT_L4_CMD_HOSTNAME_CHANGED,
+	NET_EVENT_L4_CMD_MEM_PRESSURE,
 };
 
 #define NET_EVENT_L4_CONNECTED				\
@@ -227,6 +228,9 @@ enum net_event_l4_cmd {
 #define NET_EVENT_HOSTNAME_CHANGED			\
 	(_NET_EVENT_L4_BASE | NET_EVENT_L4_CMD_HOSTNAME_CHANGED)
 
+#define NET_EVENT_MEM_PRESSURE				\
+	(_NET_EVENT_L4_BASE | NET_EVENT_L4_CMD_MEM_PRESSURE)
+
 /** @endcond */
 
 /**
@@ -295,6 +299,20 @@ struct net_event_l4_hostname {
 	char hostname[NET_HOSTNAME_SIZE];
 };
 
+/**
+ * @brief Network Management event information structure
+ * Used to pass information on NET_EVENT_MEM_PRESSURE event when
+ * CONFIG_NET_MGMT_EVENT_INFO is enabled.
+ */
+struct net_event_mem_pressure {
+	/** Name of the memory pressure source */
+	const char *name;
+	/** New pressure level, see enum mem_pressure_level */
+	uint8_t level;
+	/** Usage of the source in percent */
+	uint8_t usage;
+};
+
 #ifdef __cplusplus
 }
 #endif
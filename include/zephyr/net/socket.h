@@ -1192,6 +1192,44 @@ struct ifreq {
 #define TCP_KEEPINTVL 3
 /** Number of keepalives before dropping connection */
 #define TCP_KEEPCNT 4
+/** Information about the connection, struct tcp_info (read-only) */
+#define TCP_INFO 5
+/** Congestion control algorithm, by name, e.g. "reno" or "cubic" */
+#define TCP_CONGESTION 6
+
+/** Maximum length of a congestion control algorithm name */
+#define TCP_CA_NAME_MAX 16
+
+/** Timestamps option in use, see struct tcp_info */
+#define TCPI_OPT_TIMESTAMPS 1
+/** Selective acknowledgment option in use, see struct tcp_info */
+#define TCPI_OPT_SACK 2
+/** Window scale option in use, see struct tcp_info */
+#define TCPI_OPT_WSCALE 4
+
+/**
+ * @brief Information about a TCP connection, read with the TCP_INFO
+ *        socket option.
+ *
+ * The fields are a subset of the Linux structure of the same name, with
+ * times in microseconds. A shorter structure than this one can be read,
+ * in which case the fields that do not fit are left out.
+ */
+struct tcp_info {
+	uint8_t tcpi_retransmits;      /**< Retransmissions of the oldest unacknowledged data */
+	uint8_t tcpi_options;          /**< Options in use, TCPI_OPT_* */
+	uint8_t tcpi_snd_wscale;       /**< Window scale shift of the peer */
+	uint8_t tcpi_rcv_wscale;       /**< Window scale shift advertised */
+	uint32_t tcpi_rto;             /**< Retransmission timeout */
+	uint32_t tcpi_snd_mss;         /**< Maximum segment size sent */
+	uint32_t tcpi_rtt;             /**< Smoothed round-trip time, 0 until measured */
+	uint32_t tcpi_rttvar;          /**< Round-trip time variation */
+	uint32_t tcpi_snd_ssthresh;    /**< Slow start threshold in bytes */
+	uint32_t tcpi_snd_cwnd;        /**< Congestion window in bytes */
+	uint32_t tcpi_snd_wnd;         /**< Receive window of the peer in bytes */
+	uint32_t tcpi_rcv_wnd;         /**< Receive window advertised in bytes */
+	uint32_t tcpi_bytes_in_flight; /**< Bytes sent and not acknowledged */
+};
 
 /** @} */
 
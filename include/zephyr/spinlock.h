@@ -19,6 +19,10 @@
 #include <zephyr/sys/atomic.h>
 #include <zephyr/sys/__assert.h>
 #include <zephyr/sys/time_units.h>
+#ifdef CONFIG_OBJ_CORE_STATS_SPINLOCK
+#include <zephyr/kernel/obj_core.h>
+#include <zephyr/kernel/stats.h>
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -78,8 +82,16 @@ struct k_spinlock {
 #endif /* CONFIG_SPIN_LOCK_TIME_LIMIT */
 #endif /* CONFIG_SPIN_VALIDATE */
 
+#ifdef CONFIG_OBJ_CORE_STATS_SPINLOCK
+	/* Contention statistics, only updated with the lock held */
+	struct k_lock_stats stats;
+	/* Stores the time (in cycles) when the lock was last taken */
+	uint32_t held_since;
+	struct k_obj_core obj_core;
+#endif /* CONFIG_OBJ_CORE_STATS_SPINLOCK */
+
 #if defined(CONFIG_CPP) && !defined(CONFIG_SMP) && \
-	!defined(CONFIG_SPIN_VALIDATE)
+	!defined(CONFIG_SPIN_VALIDATE) && !defined(CONFIG_OBJ_CORE_STATS_SPINLOCK)
 	/* If CONFIG_SMP and CONFIG_SPIN_VALIDATE are both not defined
 	 * the k_spinlock struct will have no members. The result
 	 * is that in C sizeof(k_spinlock) is 0 and in C++ it is 1.
@@ -116,6 +128,33 @@ bool z_spin_lock_mem_coherent(struct k_spinlock *l);
 
 #endif /* CONFIG_SPIN_VALIDATE */
 
+#ifdef CONFIG_OBJ_CORE_STATS_SPINLOCK
+/**
+ * @brief Integrate a spinlock into the object core framework
+ *
+ * Every spinlock gathers contention statistics when
+ * CONFIG_OBJ_CORE_STATS_SPINLOCK is enabled.  This routine links @p l
+ * to the spinlock object type so that they can be found with
+ * k_obj_type_walk_locked() and read with k_obj_core_stats_query(),
+ * which returns a struct k_lock_stats.  It must not be called before
+ * the kernel objects have been initialized at PRE_KERNEL_1.
+ *
+ * @param l A pointer to the spinlock
+ * @retval 0 on success
+ * @retval -errno on failure
+ */
+int k_spin_stats_register(struct k_spinlock *l);
+
+/**
+ * @brief Remove a spinlock from the object core framework
+ *
+ * @param l A pointer to a spinlock registered with k_spin_stats_register()
+ * @retval 0 on success
+ * @retval -errno on failure
+ */
+int k_spin_stats_deregister(struct k_spinlock *l);
+#endif /* CONFIG_OBJ_CORE_STATS_SPINLOCK */
+
 /**
  * @brief Spinlock key type
  *
@@ -151,6 +190,40 @@ static ALWAYS_INLINE void z_spinlock_validate_post(struct k_spinlock *l)
 #endif /* CONFIG_SPIN_VALIDATE */
 }
 
+static ALWAYS_INLINE uint32_t z_spinlock_stats_pre(void)
+{
+#ifdef CONFIG_OBJ_CORE_STATS_SPINLOCK
+	return sys_clock_cycle_get_32();
+#else
+	return 0;
+#endif
+}
+
+static ALWAYS_INLINE void z_spinlock_stats_post(struct k_spinlock *l,
+						uint32_t start, bool contended)
+{
+	ARG_UNUSED(l);
+	ARG_UNUSED(start);
+	ARG_UNUSED(contended);
+#ifdef CONFIG_OBJ_CORE_STATS_SPINLOCK
+	uint32_t now = contended ? sys_clock_cycle_get_32() : start;
+
+	l->stats.acquisitions++;
+	if (contended) {
+		z_lock_stats_contended(&l->stats, now - start);
+	}
+	l->held_since = now;
+#endif
+}
+
+static ALWAYS_INLINE void z_spinlock_stats_release(struct k_spinlock *l)
+{
+	ARG_UNUSED(l);
+#ifdef CONFIG_OBJ_CORE_STATS_SPINLOCK
+	z_lock_stats_released(&l->stats, sys_clock_cycle_get_32() - l->held_since);
+#endif
+}
+
 /**
  * @brief Lock a spinlock
  *
@@ -183,6 +256,8 @@ static ALWAYS_INLINE k_spinlock_key_t k_spin_lock(struct k_spinlock *l)
 {
 	ARG_UNUSED(l);
 	k_spinlock_key_t k;
+	uint32_t start;
+	bool contended = false;
 
 	/* Note that we need to use the underlying arch-specific lock
 	 * implementation.  The "irq_lock()" API in SMP context is
@@ -191,6 +266,7 @@ static ALWAYS_INLINE k_spinlock_key_t k_spin_lock(struct k_spinlock *l)
 	k.key = arch_irq_lock();
 
 	z_spinlock_validate_pre(l);
+	start = z_spinlock_stats_pre();
 #ifdef CONFIG_SMP
 #ifdef CONFIG_TICKET_SPINLOCKS
 	/*
@@ -200,15 +276,18 @@ static ALWAYS_INLINE k_spinlock_key_t k_spin_lock(struct k_spinlock *l)
 	atomic_val_t ticket = atomic_inc(&l->tail);
 	/* Spin until our ticket is served */
 	while (atomic_get(&l->owner) != ticket) {
+		contended = true;
 		arch_spin_relax();
 	}
 #else
 	while (!atomic_cas(&l->locked, 0, 1)) {
+		contended = true;
 		arch_spin_relax();
 	}
 #endif /* CONFIG_TICKET_SPINLOCKS */
 #endif /* CONFIG_SMP */
 	z_spinlock_validate_post(l);
+	z_spinlock_stats_post(l, start, contended);
 
 	return k;
 }
@@ -264,6 +343,7 @@ static ALWAYS_INLINE int k_spin_trylock(struct k_spinlock *l, k_spinlock_key_t *
 #endif /* CONFIG_TICKET_SPINLOCKS */
 #endif /* CONFIG_SMP */
 	z_spinlock_validate_post(l);
+	z_spinlock_stats_post(l, z_spinlock_stats_pre(), false);
 
 	k->key = key;
 
@@ -312,6 +392,7 @@ static ALWAYS_INLINE void k_spin_unlock(struct k_spinlock *l,
 		 l, delta, CONFIG_SPIN_LOCK_TIME_LIMIT);
 #endif /* CONFIG_SPIN_LOCK_TIME_LIMIT */
 #endif /* CONFIG_SPIN_VALIDATE */
+	z_spinlock_stats_release(l);
 
 #ifdef CONFIG_SMP
 #ifdef CONFIG_TICKET_SPINLOCKS
@@ -362,6 +443,7 @@ static ALWAYS_INLINE void k_spin_release(struct k_spinlock *l)
 #ifdef CONFIG_SPIN_VALIDATE
 	__ASSERT(z_spin_unlock_valid(l), "Not my spinlock %p", l);
 #endif
+	z_spinlock_stats_release(l);
 #ifdef CONFIG_SMP
 #ifdef CONFIG_TICKET_SPINLOCKS
 	atomic_inc(&l->owner);
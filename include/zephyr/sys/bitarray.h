@@ -168,6 +168,34 @@ int sys_bitarray_test_and_clear_bit(sys_bitarray_t *bitarray, size_t bit, int *p
 int sys_bitarray_alloc(sys_bitarray_t *bitarray, size_t num_bits,
 		       size_t *offset);
 
+/**
+ * Allocate several regions of bits in a bit array
+ *
+ * This finds @p num_regions previously unallocated regions of
+ * @p num_bits contiguous bits each, in a single pass over the bit
+ * array. If they all exist, their bits are marked as allocated and the
+ * offsets to their starts are returned in @p offsets, in increasing
+ * order. Otherwise nothing is allocated.
+ *
+ * With @p num_bits of 1, this allocates @p num_regions bits anywhere
+ * in the bit array.
+ *
+ * @param[in]  bitarray    Bitarray struct
+ * @param[in]  num_bits    Number of bits in each region
+ * @param[in]  num_regions Number of regions to allocate
+ * @param[out] offsets     Offsets to the start of the allocated regions
+ *                         if successful. It must have at least
+ *                         @p num_regions elements.
+ *
+ * @retval 0       Allocation successful
+ * @retval -EINVAL Invalid argument (e.g. allocating more bits than
+ *                 the bitarray has, trying to allocate 0 bits, etc.)
+ * @retval -ENOSPC Not enough unallocated regions to accommodate
+ *                 the allocation
+ */
+int sys_bitarray_alloc_regions(sys_bitarray_t *bitarray, size_t num_bits,
+			       size_t num_regions, size_t *offsets);
+
 /**
  * Free bits in a bit array
  *
@@ -277,6 +305,57 @@ int sys_bitarray_test_and_set_region(sys_bitarray_t *bitarray, size_t num_bits,
 int sys_bitarray_clear_region(sys_bitarray_t *bitarray, size_t num_bits,
 			      size_t offset);
 
+/**
+ * Find the first set bit in a bit array
+ *
+ * This finds the first set bit at or after @p offset, scanning the
+ * bit array a word at a time.
+ *
+ * @param[in]  bitarray Bitarray struct
+ * @param[in]  offset   Bit position to start searching from
+ * @param[out] bit      Position of the set bit if successful
+ *
+ * @retval 0       Set bit found
+ * @retval -ENOENT No set bit at or after @p offset
+ * @retval -EINVAL Invalid argument (e.g. @p offset exceeds the number
+ *                 of bits in bit array, etc.)
+ */
+int sys_bitarray_find_first_set(sys_bitarray_t *bitarray, size_t offset,
+				size_t *bit);
+
+/**
+ * Find the first cleared bit in a bit array
+ *
+ * This finds the first cleared bit at or after @p offset, scanning the
+ * bit array a word at a time.
+ *
+ * @param[in]  bitarray Bitarray struct
+ * @param[in]  offset   Bit position to start searching from
+ * @param[out] bit      Position of the cleared bit if successful
+ *
+ * @retval 0       Cleared bit found
+ * @retval -ENOENT No cleared bit at or after @p offset
+ * @retval -EINVAL Invalid argument (e.g. @p offset exceeds the number
+ *                 of bits in bit array, etc.)
+ */
+int sys_bitarray_find_first_clear(sys_bitarray_t *bitarray, size_t offset,
+				  size_t *bit);
+
+/**
+ * Count the set bits in a region of a bit array
+ *
+ * @param[in]  bitarray Bitarray struct
+ * @param[in]  num_bits Number of bits in the region
+ * @param[in]  offset   Starting bit position of the region
+ * @param[out] count    Number of set bits in the region if successful
+ *
+ * @retval 0       Operation successful
+ * @retval -EINVAL Invalid argument (e.g. out-of-bounds access, trying
+ *                 to count 0 bits, etc.)
+ */
+int sys_bitarray_popcount_region(sys_bitarray_t *bitarray, size_t num_bits,
+				 size_t offset, size_t *count);
+
 /**
  * @}
  */
@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_SYS_HEAP_CACHE_H_
+#define ZEPHYR_INCLUDE_SYS_HEAP_CACHE_H_
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <zephyr/types.h>
+#include <zephyr/spinlock.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/sys_heap.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(CONFIG_SYS_HEAP_CACHE) || defined(__DOXYGEN__)
+
+/* Free blocks of small sizes kept by one CPU, one singly linked
+ * list per chunk size.  Only accessed with the lock held.
+ */
+struct z_heap_cache_cpu {
+	struct k_spinlock lock;
+	void *bins[CONFIG_SYS_HEAP_CACHE_CLASSES];
+	uint8_t counts[CONFIG_SYS_HEAP_CACHE_CLASSES];
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+	uint32_t hits;
+	uint32_t misses;
+	uint32_t frees;
+	uint32_t overflows;
+#endif
+};
+
+/**
+ * @brief Per-CPU cache of small blocks in front of a sys_heap
+ *
+ * See sys_heap_cache_alloc().
+ */
+struct sys_heap_cache {
+	struct z_heap_cache_cpu cpus[CONFIG_MP_MAX_NUM_CPUS];
+	atomic_t hold;
+};
+
+/** @brief sys_heap cache statistics */
+struct sys_heap_cache_stats {
+	/** Allocations served from the cache */
+	uint32_t hits;
+	/** Allocations of a cached size that had to use the heap */
+	uint32_t misses;
+	/** Frees kept in the cache */
+	uint32_t frees;
+	/** Frees of a cached size that went back to the heap */
+	uint32_t overflows;
+	/** Bytes currently held by the cache */
+	size_t cached_bytes;
+};
+
+/** @brief Initialize a sys_heap cache
+ *
+ * @param cache Cache to initialize
+ */
+void sys_heap_cache_init(struct sys_heap_cache *cache);
+
+/** @brief Allocate memory from a sys_heap cache
+ *
+ * Small blocks freed with sys_heap_cache_free() are kept in per-CPU
+ * lists, one for each chunk size up to
+ * CONFIG_SYS_HEAP_CACHE_CLASSES chunk units.  This returns such a
+ * block if one of the right size is available on the current CPU
+ * and meets the requested alignment.
+ * Unlike the sys_heap functions, this is internally synchronized and
+ * only needs a lock private to the current CPU, so the caller must not
+ * hold the lock protecting the heap itself.
+ *
+ * @param heap Heap the cache is in front of
+ * @param cache Cache from which to allocate
+ * @param align Alignment in bytes, with an optional rewind as for
+ *              sys_heap_aligned_alloc()
+ * @param bytes Number of bytes requested
+ * @param site Allocation site reported to the heap profiler, or NULL
+ *             for the caller of this function
+ * @return Pointer to memory the caller can now use, or NULL if the
+ *         request must be passed to the heap.
+ */
+void *sys_heap_cache_alloc(struct sys_heap *heap, struct sys_heap_cache *cache,
+			   size_t align, size_t bytes, void *site);
+
+/** @brief Free memory into a sys_heap cache
+ *
+ * Keeps a small block in the cache of the current CPU instead of
+ * returning it to the heap, unless the cache for its size is full or
+ * held with sys_heap_cache_hold().  As sys_heap_cache_alloc(), this
+ * must be invoked without the heap lock held.
+ *
+ * @param heap Heap the memory was allocated from
+ * @param cache Cache to keep the memory in
+ * @param mem A pointer previously returned from the heap or the cache
+ * @return true if the block was kept, false if the caller must free
+ *         it to the heap.
+ */
+bool sys_heap_cache_free(struct sys_heap *heap, struct sys_heap_cache *cache,
+			 void *mem);
+
+/** @brief Return all cached blocks to the heap
+ *
+ * Empties the caches of all CPUs into the heap with sys_heap_free().
+ * As for other sys_heap functions the caller must hold the lock
+ * protecting the heap.
+ *
+ * @param heap Heap the cache is in front of
+ * @param cache Cache to empty
+ * @return Number of blocks returned to the heap
+ */
+size_t sys_heap_cache_flush(struct sys_heap *heap, struct sys_heap_cache *cache);
+
+/** @brief Stop or resume keeping freed blocks in a cache
+ *
+ * While held, sys_heap_cache_free() passes all blocks back to the
+ * caller.  This is used while an allocator waits for memory to be
+ * freed to the heap.
+ *
+ * @param cache Cache to hold or resume
+ * @param hold true to hold the cache, false to resume it
+ */
+static inline void sys_heap_cache_hold(struct sys_heap_cache *cache, bool hold)
+{
+	(void)atomic_set(&cache->hold, hold ? 1 : 0);
+}
+
+#if defined(CONFIG_SYS_HEAP_RUNTIME_STATS) || defined(__DOXYGEN__)
+/**
+ * @brief Get the statistics of a sys_heap cache
+ *
+ * Blocks held by the cache are accounted as allocated in the heap's
+ * own statistics, see sys_heap_runtime_stats_get().
+ *
+ * @param heap Pointer to the sys_heap the cache is in front of
+ * @param cache Pointer to the cache
+ * @param stats Pointer to struct to copy statistics into
+ * @return -EINVAL if null pointers, otherwise 0
+ */
+int sys_heap_cache_stats_get(struct sys_heap *heap,
+			     struct sys_heap_cache *cache,
+			     struct sys_heap_cache_stats *stats);
+#endif /* CONFIG_SYS_HEAP_RUNTIME_STATS */
+
+#endif /* CONFIG_SYS_HEAP_CACHE */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_SYS_HEAP_CACHE_H_ */
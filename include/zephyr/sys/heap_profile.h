@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_SYS_HEAP_PROFILE_H_
+#define ZEPHYR_INCLUDE_SYS_HEAP_PROFILE_H_
+
+#include <stddef.h>
+#include <zephyr/types.h>
+#include <zephyr/spinlock.h>
+#include <zephyr/sys/slist.h>
+#include <zephyr/sys/sys_heap.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(CONFIG_SYS_HEAP_PROFILE) || defined(__DOXYGEN__)
+
+/** @brief Allocation statistics of one call site */
+struct sys_heap_profile_site {
+	/** Address the allocation was requested from */
+	void *site;
+	/** Successful allocations */
+	uint32_t allocs;
+	/** Frees of blocks allocated from this site */
+	uint32_t frees;
+	/** Blocks currently allocated */
+	uint32_t live_blocks;
+	/** Bytes currently allocated, as requested */
+	size_t live_bytes;
+	/** Highest value of @a live_bytes */
+	size_t max_live_bytes;
+	/** Requested sizes: bin N counts sizes from 2^N to 2^(N+1) - 1
+	 * bytes, the last bin also counts all larger sizes
+	 */
+	uint32_t sizes[CONFIG_SYS_HEAP_PROFILE_SIZE_BINS];
+	/** Sum of the lifetimes of freed blocks, in ticks */
+	uint64_t lifetime_ticks;
+	/** Longest lifetime of a freed block, in ticks */
+	uint32_t max_lifetime_ticks;
+	/** Age of the oldest live block, in ticks.  Only computed by
+	 * sys_heap_profile_foreach_site().
+	 */
+	uint32_t oldest_live_ticks;
+};
+
+/* A live block, in an open-addressed table keyed by its address */
+struct z_heap_profile_block {
+	void *mem;
+	size_t bytes;
+	uint32_t tick;
+	uint16_t site;
+};
+
+/**
+ * @brief Allocation site profile of a sys_heap
+ *
+ * See sys_heap_profile_attach().
+ */
+struct sys_heap_profile {
+	struct k_spinlock lock;
+	struct sys_heap *heap;
+	sys_snode_t node;
+	/* Allocations not accounted because a table was full */
+	uint32_t untracked;
+	struct sys_heap_profile_site sites[CONFIG_SYS_HEAP_PROFILE_SITES];
+	struct z_heap_profile_block blocks[CONFIG_SYS_HEAP_PROFILE_BLOCKS];
+};
+
+/** @brief Start profiling the allocations of a sys_heap
+ *
+ * From now on, every allocation from @a heap is accounted to the
+ * address it was requested from: the caller of sys_heap_alloc() and
+ * related functions, or of k_heap_alloc(), k_malloc() and related
+ * functions for heaps used through those.  Each site records its
+ * number of allocations and frees, its live blocks and bytes, a
+ * histogram of requested sizes and the lifetime of its blocks.
+ * Sites with ever growing live blocks are leak candidates.
+ *
+ * Up to CONFIG_SYS_HEAP_PROFILE_SITES sites and
+ * CONFIG_SYS_HEAP_PROFILE_BLOCKS live blocks are tracked; others are
+ * only counted as untracked.  Blocks allocated before the profile
+ * was attached are ignored.
+ *
+ * Like the sys_heap functions, this must be called with the heap
+ * lock held, if any.
+ *
+ * @param heap Heap to profile
+ * @param profile Profile to record into, initialized by this call
+ */
+void sys_heap_profile_attach(struct sys_heap *heap,
+			     struct sys_heap_profile *profile);
+
+/** @brief Stop profiling the allocations of a sys_heap
+ *
+ * Like the sys_heap functions, this must be called with the heap
+ * lock held, if any.
+ *
+ * @param heap Heap to stop profiling
+ */
+void sys_heap_profile_detach(struct sys_heap *heap);
+
+/** @brief Clear a sys_heap profile
+ *
+ * Forgets all sites and live blocks.  Blocks that are live at this
+ * point are no longer accounted when freed.
+ *
+ * @param profile Profile to clear
+ */
+void sys_heap_profile_reset(struct sys_heap_profile *profile);
+
+/**
+ * @typedef sys_heap_profile_site_cb_t
+ * @brief Callback type for sys_heap_profile_foreach_site()
+ *
+ * @param site Snapshot of the site statistics
+ * @param user_data User data passed to sys_heap_profile_foreach_site()
+ */
+typedef void (*sys_heap_profile_site_cb_t)(const struct sys_heap_profile_site *site,
+					   void *user_data);
+
+/** @brief Iterate over the sites of a sys_heap profile
+ *
+ * The callback is given a snapshot of each site, and runs without any
+ * lock held so it may print or allocate.
+ *
+ * @param profile Profile to iterate over
+ * @param cb Callback called for each site
+ * @param user_data User data passed to the callback
+ * @return Number of allocations not accounted to any site
+ */
+uint32_t sys_heap_profile_foreach_site(struct sys_heap_profile *profile,
+				       sys_heap_profile_site_cb_t cb,
+				       void *user_data);
+
+/**
+ * @typedef sys_heap_profile_cb_t
+ * @brief Callback type for sys_heap_profile_foreach()
+ *
+ * @param heap Profiled heap
+ * @param profile Profile of @a heap
+ * @param user_data User data passed to sys_heap_profile_foreach()
+ */
+typedef void (*sys_heap_profile_cb_t)(struct sys_heap *heap,
+				      struct sys_heap_profile *profile,
+				      void *user_data);
+
+/** @brief Iterate over all attached sys_heap profiles
+ *
+ * @param cb Callback called for each profile
+ * @param user_data User data passed to the callback
+ */
+void sys_heap_profile_foreach(sys_heap_profile_cb_t cb, void *user_data);
+
+/* Hooks of the sys_heap implementation */
+void z_heap_profile_alloc(struct sys_heap_profile *profile, void *mem,
+			  size_t bytes, void *site);
+void z_heap_profile_free(struct sys_heap_profile *profile, void *mem);
+
+#endif /* CONFIG_SYS_HEAP_PROFILE */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_SYS_HEAP_PROFILE_H_ */
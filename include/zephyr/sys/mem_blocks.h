@@ -240,6 +240,30 @@ int sys_mem_blocks_alloc(sys_mem_blocks_t *mem_block, size_t count,
 int sys_mem_blocks_alloc_contiguous(sys_mem_blocks_t *mem_block, size_t count,
 				   void **out_block);
 
+/**
+ * @brief Allocate several contiguous sets of memory blocks
+ *
+ * Allocate @p num_runs sets of @p count contiguous memory blocks each,
+ * in a single pass over the block bitmap, and place the pointers to
+ * the start of each set into the output array. Either all sets are
+ * allocated or none is. Each set is freed with
+ * sys_mem_blocks_free_contiguous().
+ *
+ * @param[in]  mem_block  Pointer to memory block object.
+ * @param[in]  count      Number of blocks in each set.
+ * @param[in]  num_runs   Number of sets to allocate.
+ * @param[out] out_blocks Output array to be populated by pointers to
+ *                        the start of each set. It must have at least
+ *                        @p num_runs elements.
+ *
+ * @retval 0       Successful
+ * @retval -EINVAL Invalid argument supplied.
+ * @retval -ENOMEM Not enough contiguous blocks for allocation.
+ */
+int sys_mem_blocks_alloc_contiguous_batch(sys_mem_blocks_t *mem_block,
+					  size_t count, size_t num_runs,
+					  void **out_blocks);
+
 /**
  * @brief Force allocation of a specified blocks in a memory block object
  *
@@ -0,0 +1,229 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_SYS_MEM_PRESSURE_H_
+#define ZEPHYR_INCLUDE_SYS_MEM_PRESSURE_H_
+
+#include <stdint.h>
+#include <zephyr/sys/slist.h>
+#include <zephyr/sys/util.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup mem_pressure_apis Memory Pressure APIs
+ * @ingroup memory_management
+ * @{
+ */
+
+/** @brief Memory pressure level of a source */
+enum mem_pressure_level {
+	/** Usage below the low threshold */
+	MEM_PRESSURE_NONE = 0,
+	/** Usage at or above the low threshold */
+	MEM_PRESSURE_LOW,
+	/** Usage at or above the critical threshold */
+	MEM_PRESSURE_CRITICAL,
+};
+
+/** @brief Type of the memory pool watched by a source */
+enum mem_pressure_type {
+	/** A struct k_heap */
+	MEM_PRESSURE_K_HEAP = 0,
+	/** A struct sys_heap */
+	MEM_PRESSURE_SYS_HEAP,
+	/** A struct k_mem_slab */
+	MEM_PRESSURE_K_MEM_SLAB,
+	/** A struct net_buf_pool, with CONFIG_NET_BUF_POOL_USAGE */
+	MEM_PRESSURE_NET_BUF_POOL,
+};
+
+/**
+ * @brief Memory pool watched for pressure
+ *
+ * Sources are initialized with MEM_PRESSURE_SOURCE_DEFINE() and
+ * registered with mem_pressure_source_register().
+ */
+struct mem_pressure_source {
+	sys_snode_t node;
+	/** Name shown by the shell and in events */
+	const char *name;
+	/** Watched pool */
+	void *obj;
+	/** Type of @a obj, see enum mem_pressure_type */
+	uint8_t type;
+	/** Usage in percent at which the level becomes LOW */
+	uint8_t low;
+	/** Usage in percent at which the level becomes CRITICAL */
+	uint8_t critical;
+	/** Current level, see enum mem_pressure_level */
+	uint8_t level;
+	/** Usage in percent when last checked */
+	uint8_t usage;
+	/** Number of times the level rose */
+	uint32_t events;
+};
+
+/**
+ * @typedef mem_pressure_reclaim_t
+ * @brief Reclaim callback of memory pressure notifications
+ *
+ * Called from the system work queue when the pressure level of a
+ * source changes, so that the callback may release memory it does not
+ * strictly need (caches, pending packets, ...) when the level rises.
+ * It must not register or unregister sources or callbacks.
+ *
+ * @param src Source whose level changed
+ * @param level New pressure level
+ * @param user_data User data given at registration
+ */
+typedef void (*mem_pressure_reclaim_t)(const struct mem_pressure_source *src,
+				       enum mem_pressure_level level,
+				       void *user_data);
+
+/**
+ * @brief Memory pressure reclaim callback
+ *
+ * Callbacks are initialized with MEM_PRESSURE_CALLBACK_DEFINE() and
+ * registered with mem_pressure_callback_register().
+ */
+struct mem_pressure_callback {
+	sys_snode_t node;
+	mem_pressure_reclaim_t reclaim;
+	/** Bit mask of the source types to be notified about */
+	uint32_t types;
+	void *user_data;
+};
+
+/**
+ * @brief Define a memory pressure source
+ *
+ * @param _name Name of the source variable, also shown in the shell
+ * @param _type Type of the pool, see enum mem_pressure_type
+ * @param _obj Pointer to the pool
+ * @param _low Usage in percent at which the level becomes LOW
+ * @param _critical Usage in percent at which the level becomes CRITICAL
+ */
+#define MEM_PRESSURE_SOURCE_DEFINE(_name, _type, _obj, _low, _critical) \
+	struct mem_pressure_source _name = {                            \
+		.name = STRINGIFY(_name),                               \
+		.obj = (_obj),                                          \
+		.type = (_type),                                        \
+		.low = (_low),                                          \
+		.critical = (_critical),                                \
+	}
+
+/**
+ * @brief Define a memory pressure reclaim callback
+ *
+ * @param _name Name of the callback variable
+ * @param _types Bit mask of the source types to be notified about,
+ *               e.g. BIT(MEM_PRESSURE_K_HEAP)
+ * @param _reclaim Function of type mem_pressure_reclaim_t
+ * @param _user_data User data passed to the function
+ */
+#define MEM_PRESSURE_CALLBACK_DEFINE(_name, _types, _reclaim, _user_data) \
+	struct mem_pressure_callback _name = {                            \
+		.reclaim = (_reclaim),                                    \
+		.types = (_types),                                        \
+		.user_data = (_user_data),                                \
+	}
+
+/** Source types mask matching all sources */
+#define MEM_PRESSURE_ALL_TYPES UINT32_MAX
+
+/**
+ * @brief Start watching a memory pool
+ *
+ * The source is checked every CONFIG_MEM_PRESSURE_POLL_INTERVAL
+ * milliseconds and whenever an allocation from a k_heap, k_mem_slab or
+ * net_buf pool finds it exhausted.  sys_heap sources are read without
+ * their lock, so their usage may be slightly off.
+ *
+ * @param src Source to register
+ *
+ * @retval 0 on success
+ * @retval -EINVAL invalid thresholds
+ * @retval -ENOTSUP the source type is not supported in this build
+ */
+int mem_pressure_source_register(struct mem_pressure_source *src);
+
+/**
+ * @brief Stop watching a memory pool
+ *
+ * @param src Source to unregister
+ */
+void mem_pressure_source_unregister(struct mem_pressure_source *src);
+
+/**
+ * @brief Register a reclaim callback
+ *
+ * @param cb Callback to register
+ */
+void mem_pressure_callback_register(struct mem_pressure_callback *cb);
+
+/**
+ * @brief Unregister a reclaim callback
+ *
+ * @param cb Callback to unregister
+ */
+void mem_pressure_callback_unregister(struct mem_pressure_callback *cb);
+
+/**
+ * @brief Check all sources now
+ *
+ * Updates the usage and level of every source and runs the callbacks
+ * of those whose level changed, from the calling thread.
+ */
+void mem_pressure_check(void);
+
+/**
+ * @typedef mem_pressure_source_cb_t
+ * @brief Callback type for mem_pressure_source_foreach()
+ *
+ * @param src Source
+ * @param user_data User data passed to mem_pressure_source_foreach()
+ */
+typedef void (*mem_pressure_source_cb_t)(const struct mem_pressure_source *src,
+					 void *user_data);
+
+/**
+ * @brief Iterate over the registered sources
+ *
+ * @param cb Callback called for each source
+ * @param user_data User data passed to the callback
+ */
+void mem_pressure_source_foreach(mem_pressure_source_cb_t cb, void *user_data);
+
+/**
+ * @brief Get the name of a pressure level
+ *
+ * @param level Pressure level
+ *
+ * @return Name of the level
+ */
+const char *mem_pressure_level_str(enum mem_pressure_level level);
+
+/**
+ * @cond INTERNAL_HIDDEN
+ */
+
+/* Called by allocators that ran out of memory, from any context */
+void z_mem_pressure_exhausted(void);
+
+/**
+ * INTERNAL_HIDDEN @endcond
+ */
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_SYS_MEM_PRESSURE_H_ */
@@ -53,12 +53,30 @@ extern "C" {
  * put the two values somewhere else, though it would make
  * SYS_HEAP_DEFINE a little hairy to write.
  */
+struct sys_heap_profile;
+
 struct sys_heap {
 	struct z_heap *heap;
 	void *init_mem;
 	size_t init_bytes;
+#ifdef CONFIG_SYS_HEAP_PROFILE
+	struct sys_heap_profile *profile;
+	/* Allocation site given by a wrapper such as k_heap, see
+	 * Z_HEAP_SITE()
+	 */
+	void *site;
+#endif
 };
 
+/* Address of the caller of the current function, for wrappers of the
+ * heap to pass the site of an allocation to the heap profiler
+ */
+#ifdef CONFIG_SYS_HEAP_PROFILE
+#define Z_HEAP_SITE() __builtin_return_address(0)
+#else
+#define Z_HEAP_SITE() NULL
+#endif
+
 struct z_heap_stress_result {
 	uint32_t total_allocs;
 	uint32_t successful_allocs;
@@ -89,6 +107,34 @@ int sys_heap_runtime_stats_get(struct sys_heap *heap,
  */
 int sys_heap_runtime_stats_reset_max(struct sys_heap *heap);
 
+/** @brief Fragmentation of the free memory of a sys_heap */
+struct sys_heap_fragmentation {
+	/** Total free bytes */
+	size_t free_bytes;
+	/** Free bytes in the largest free block */
+	size_t largest_free_bytes;
+	/** Number of free blocks */
+	uint32_t free_blocks;
+	/** Fragmentation index in percent: 0 when all free memory is in
+	 * one block, approaching 100 as it is split in small blocks
+	 */
+	uint32_t index;
+};
+
+/**
+ * @brief Get the fragmentation of a sys_heap
+ *
+ * This walks all free blocks, so it runs in time linear to their
+ * number and, like the other sys_heap functions, must be called with
+ * the heap lock held, if any.
+ *
+ * @param heap Pointer to specified sys_heap
+ * @param frag Pointer to struct to copy the fragmentation into
+ * @return -EINVAL if null pointers, otherwise 0
+ */
+int sys_heap_fragmentation_get(struct sys_heap *heap,
+			       struct sys_heap_fragmentation *frag);
+
 #endif
 
 /** @brief Initialize sys_heap
@@ -247,6 +293,48 @@ void sys_heap_stress(void *(*alloc_fn)(void *arg, size_t bytes),
 		     int target_percent,
 		     struct z_heap_stress_result *result);
 
+struct k_thread;
+struct z_thread_stack_element;
+
+/** @brief Multithreaded sys_heap stress test rig
+ *
+ * Runs the sys_heap_stress() rig concurrently in @a num_threads
+ * threads on the same heap, each with its own random sequence and
+ * share of the scratch memory, and aiming at its share of the target
+ * fill.  The callbacks must therefore be safe to invoke from several
+ * threads at once.  This returns once all threads are done, with the
+ * sum of their results.
+ *
+ * @param alloc_fn Callback to perform an allocation.
+ * @param free_fn Callback to perform a free.
+ * @param arg Context handle to pass back to the callbacks
+ * @param total_bytes Size of the byte array the heap was initialized in
+ * @param op_count How many iterations each thread should run
+ * @param scratch_mem A pointer to scratch memory shared out between
+ *                    the threads
+ * @param scratch_bytes Size of the memory pointed to by @a scratch_mem
+ * @param target_percent Percentage fill value (1-100) to which the
+ *                       random allocation choices will seek
+ * @param threads Array of @a num_threads thread objects
+ * @param stacks Array of @a num_threads stacks, as defined by
+ *               K_THREAD_STACK_ARRAY_DEFINE()
+ * @param stack_size Size of each stack, the same constant passed to
+ *                   K_THREAD_STACK_ARRAY_DEFINE()
+ * @param num_threads Number of threads
+ * @param prio Priority of the threads
+ * @param result Struct into which to store test results.
+ */
+void sys_heap_stress_threads(void *(*alloc_fn)(void *arg, size_t bytes),
+			     void (*free_fn)(void *arg, void *p),
+			     void *arg, size_t total_bytes,
+			     uint32_t op_count,
+			     void *scratch_mem, size_t scratch_bytes,
+			     int target_percent,
+			     struct k_thread *threads,
+			     struct z_thread_stack_element *stacks,
+			     size_t stack_size, int num_threads, int prio,
+			     struct z_heap_stress_result *result);
+
 /** @brief Print heap internal structure information to the console
  *
  * Print information on the heap structure such as its size, chunk buckets,
@@ -110,6 +110,23 @@ static inline void *z_thread_malloc(size_t size)
 	return z_thread_aligned_alloc(0, size);
 }
 
+/**
+ * @brief Allocate aligned memory from a k_heap on behalf of a caller
+ *
+ * Behaves like k_heap_aligned_alloc(), except that with
+ * CONFIG_SYS_HEAP_PROFILE the allocation is accounted to @a site
+ * rather than to the caller of this function.
+ *
+ * @param h Heap from which to allocate
+ * @param align Alignment in bytes, must be a power of two
+ * @param bytes Number of bytes requested
+ * @param timeout How long to wait, or K_NO_WAIT
+ * @param site Address the allocation was requested from
+ * @return A pointer to valid heap memory, or NULL
+ */
+void *z_k_heap_aligned_alloc(struct k_heap *h, size_t align, size_t bytes,
+			     k_timeout_t timeout, void *site);
+
 /* set and clear essential thread flag */
 
 extern void z_thread_essential_set(void);
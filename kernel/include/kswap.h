@@ -66,17 +66,33 @@ static inline void z_sched_switch_spin(struct k_thread *thread)
 #endif
 }
 
+static ALWAYS_INLINE void z_swap_release(bool runq_locked)
+{
+#ifdef CONFIG_SCHED_PERCPU
+	if (runq_locked) {
+		z_sched_runq_release();
+		return;
+	}
+#else
+	ARG_UNUSED(runq_locked);
+#endif
+	k_spin_release(&sched_spinlock);
+}
+
 /* New style context switching.  arch_switch() is a lower level
  * primitive that doesn't know about the scheduler or return value.
  * Needed for SMP, where the scheduler requires spinlocking that we
  * don't want to have to do in per-architecture assembly.
  *
- * Note that is_spinlock is a compile-time construct which will be
- * optimized out when this function is expanded.
+ * With runq_locked, the caller holds the run queue lock of the current
+ * CPU instead of the scheduler spinlock, see z_swap_runq().
+ *
+ * Note that is_spinlock and runq_locked are compile-time constructs
+ * which will be optimized out when this function is expanded.
  */
 static ALWAYS_INLINE unsigned int do_swap(unsigned int key,
 					  struct k_spinlock *lock,
-					  bool is_spinlock)
+					  bool is_spinlock, bool runq_locked)
 {
 	ARG_UNUSED(lock);
 	struct k_thread *new_thread, *old_thread;
@@ -115,7 +131,7 @@ static ALWAYS_INLINE unsigned int do_swap(unsigned int key,
 	if (is_spinlock && lock != NULL && lock != &sched_spinlock) {
 		k_spin_release(lock);
 	}
-	if (!is_spinlock || lock != &sched_spinlock) {
+	if (!runq_locked && (!is_spinlock || lock != &sched_spinlock)) {
 		(void) k_spin_lock(&sched_spinlock);
 	}
 
@@ -141,7 +157,9 @@ static ALWAYS_INLINE unsigned int do_swap(unsigned int key,
 #endif
 
 #ifdef CONFIG_SPIN_VALIDATE
-		z_spin_lock_set_owner(&sched_spinlock);
+		if (!runq_locked) {
+			z_spin_lock_set_owner(&sched_spinlock);
+		}
 #endif
 
 		arch_cohere_stacks(old_thread, NULL, new_thread);
@@ -163,10 +181,10 @@ static ALWAYS_INLINE unsigned int do_swap(unsigned int key,
 			new_thread->switch_handle = NULL;
 			barrier_dmem_fence_full(); /* write barrier */
 		}
-		k_spin_release(&sched_spinlock);
+		z_swap_release(runq_locked);
 		arch_switch(newsh, &old_thread->switch_handle);
 	} else {
-		k_spin_release(&sched_spinlock);
+		z_swap_release(runq_locked);
 	}
 
 	if (is_spinlock) {
@@ -180,18 +198,29 @@ static ALWAYS_INLINE unsigned int do_swap(unsigned int key,
 
 static inline int z_swap_irqlock(unsigned int key)
 {
-	return do_swap(key, NULL, false);
+	return do_swap(key, NULL, false, false);
 }
 
 static inline int z_swap(struct k_spinlock *lock, k_spinlock_key_t key)
 {
-	return do_swap(key.key, lock, true);
+	return do_swap(key.key, lock, true, false);
 }
 
 static inline void z_swap_unlocked(void)
 {
-	(void) do_swap(arch_irq_lock(), NULL, true);
+	(void) do_swap(arch_irq_lock(), NULL, true, false);
+}
+
+#ifdef CONFIG_SCHED_PERCPU
+/* Switch away from _current holding only the run queue lock of the
+ * current CPU, taken with interrupts already masked by key: see
+ * k_yield()
+ */
+static inline int z_swap_runq(unsigned int key)
+{
+	return do_swap(key, NULL, true, true);
 }
+#endif
 
 #else /* !CONFIG_USE_SWITCH */
 
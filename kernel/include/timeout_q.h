@@ -24,7 +24,14 @@ extern "C" {
 
 static inline void z_init_timeout(struct _timeout *to)
 {
+#ifdef CONFIG_TIMEOUT_QUEUE_SCALABLE
+	to->dticks = 0;
+#ifdef CONFIG_TIMEOUT_QUEUE_PERCPU
+	to->cpu = 0;
+#endif
+#else
 	sys_dnode_init(&to->node);
+#endif
 }
 
 void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
@@ -34,7 +41,14 @@ int z_abort_timeout(struct _timeout *to);
 
 static inline bool z_is_inactive_timeout(const struct _timeout *to)
 {
+#ifdef CONFIG_TIMEOUT_QUEUE_SCALABLE
+	/* Queued timeouts always expire at a tick strictly after
+	 * curr_tick, so a zero absolute expiry marks an idle record
+	 */
+	return to->dticks == 0;
+#else
 	return !sys_dnode_is_linked(&to->node);
+#endif
 }
 
 static inline void z_init_thread_timeout(struct _thread_base *thread_base)
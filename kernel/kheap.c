@@ -8,14 +8,19 @@
 #include <zephyr/init.h>
 #include <zephyr/linker/linker-defs.h>
 #include <zephyr/sys/iterable_sections.h>
+#include <zephyr/sys/mem_pressure.h>
 /* private kernel APIs */
 #include <ksched.h>
 #include <wait_q.h>
+#include <kernel_internal.h>
 
 void k_heap_init(struct k_heap *h, void *mem, size_t bytes)
 {
 	z_waitq_init(&h->wait_q);
 	sys_heap_init(&h->heap, mem, bytes);
+#ifdef CONFIG_SYS_HEAP_CACHE
+	sys_heap_cache_init(&h->cache);
+#endif
 
 	SYS_PORT_TRACING_OBJ_INIT(k_heap, h);
 }
@@ -62,12 +67,22 @@ SYS_INIT_NAMED(statics_init_pre, statics_init, PRE_KERNEL_1, CONFIG_KERNEL_INIT_
 SYS_INIT_NAMED(statics_init_post, statics_init, POST_KERNEL, 0);
 #endif /* CONFIG_DEMAND_PAGING && !CONFIG_LINKER_GENERIC_SECTIONS_PRESENT_AT_BOOT */
 
-void *k_heap_aligned_alloc(struct k_heap *h, size_t align, size_t bytes,
-			k_timeout_t timeout)
+void *z_k_heap_aligned_alloc(struct k_heap *h, size_t align, size_t bytes,
+			     k_timeout_t timeout, void *site)
 {
 	k_timepoint_t end = sys_timepoint_calc(timeout);
 	void *ret = NULL;
 
+#ifdef CONFIG_SYS_HEAP_CACHE
+	/* Small blocks recently freed on this CPU don't need the heap lock */
+	ret = sys_heap_cache_alloc(&h->heap, &h->cache, align, bytes, site);
+	if (ret != NULL) {
+		SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_heap, aligned_alloc, h, timeout);
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_heap, aligned_alloc, h, timeout, ret);
+		return ret;
+	}
+#endif
+
 	k_spinlock_key_t key = k_spin_lock(&h->lock);
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_heap, aligned_alloc, h, timeout);
@@ -76,9 +91,34 @@ void *k_heap_aligned_alloc(struct k_heap *h, size_t align, size_t bytes,
 
 	bool blocked_alloc = false;
 
+#ifdef CONFIG_SYS_HEAP_PROFILE
+	h->heap.site = site;
+#endif
+
 	while (ret == NULL) {
 		ret = sys_heap_aligned_alloc(&h->heap, align, bytes);
 
+#ifdef CONFIG_SYS_HEAP_CACHE
+		if (ret == NULL) {
+			/* The caches may hold enough memory.  If we are going
+			 * to wait, hold them first so that blocks freed from
+			 * now on go to the heap and wake us up.
+			 */
+			if (!K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+				sys_heap_cache_hold(&h->cache, true);
+			}
+			if (sys_heap_cache_flush(&h->heap, &h->cache) != 0U) {
+				ret = sys_heap_aligned_alloc(&h->heap, align, bytes);
+			}
+		}
+#endif
+
+#ifdef CONFIG_MEM_PRESSURE
+		if ((ret == NULL) && !blocked_alloc) {
+			z_mem_pressure_exhausted();
+		}
+#endif
+
 		if (!IS_ENABLED(CONFIG_MULTITHREADING) ||
 		    (ret != NULL) || K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
 			break;
@@ -97,19 +137,33 @@ void *k_heap_aligned_alloc(struct k_heap *h, size_t align, size_t bytes,
 		timeout = sys_timepoint_timeout(end);
 		(void) z_pend_curr(&h->lock, key, &h->wait_q, timeout);
 		key = k_spin_lock(&h->lock);
+#ifdef CONFIG_SYS_HEAP_PROFILE
+		h->heap.site = site;
+#endif
 	}
 
+#ifdef CONFIG_SYS_HEAP_PROFILE
+	h->heap.site = NULL;
+#endif
+
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_heap, aligned_alloc, h, timeout, ret);
 
 	k_spin_unlock(&h->lock, key);
 	return ret;
 }
 
+void *k_heap_aligned_alloc(struct k_heap *h, size_t align, size_t bytes,
+			k_timeout_t timeout)
+{
+	return z_k_heap_aligned_alloc(h, align, bytes, timeout, Z_HEAP_SITE());
+}
+
 void *k_heap_alloc(struct k_heap *h, size_t bytes, k_timeout_t timeout)
 {
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_heap, alloc, h, timeout);
 
-	void *ret = k_heap_aligned_alloc(h, sizeof(void *), bytes, timeout);
+	void *ret = z_k_heap_aligned_alloc(h, sizeof(void *), bytes, timeout,
+					   Z_HEAP_SITE());
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_heap, alloc, h, timeout, ret);
 
@@ -118,9 +172,20 @@ void *k_heap_alloc(struct k_heap *h, size_t bytes, k_timeout_t timeout)
 
 void k_heap_free(struct k_heap *h, void *mem)
 {
+#ifdef CONFIG_SYS_HEAP_CACHE
+	if (sys_heap_cache_free(&h->heap, &h->cache, mem)) {
+		SYS_PORT_TRACING_OBJ_FUNC(k_heap, free, h);
+		return;
+	}
+#endif
+
 	k_spinlock_key_t key = k_spin_lock(&h->lock);
 
 	sys_heap_free(&h->heap, mem);
+#ifdef CONFIG_SYS_HEAP_CACHE
+	/* Any waiter is woken below and holds the cache again if needed */
+	sys_heap_cache_hold(&h->cache, false);
+#endif
 
 	SYS_PORT_TRACING_OBJ_FUNC(k_heap, free, h);
 	if (IS_ENABLED(CONFIG_MULTITHREADING) && z_unpend_all(&h->wait_q) != 0) {
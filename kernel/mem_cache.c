@@ -0,0 +1,418 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+#include <zephyr/sys/check.h>
+#include <zephyr/sys/iterable_sections.h>
+#include <string.h>
+/* private kernel APIs */
+#include <ksched.h>
+#include <wait_q.h>
+
+/* An object cache allocates from its initial slab without any lock of
+ * its own, so that with CONFIG_MEM_SLAB_CACHE the common case only
+ * takes a per-CPU lock.  The slabs grown from the heap are only
+ * accessed with the cache lock held, which also serializes them with
+ * their release.
+ */
+
+/* A slab grown from the heap, followed by its blocks */
+struct z_mem_cache_slab {
+	sys_snode_t node;
+	struct k_mem_slab slab;
+};
+
+#ifdef CONFIG_OBJ_CORE_MEM_CACHE
+static struct k_obj_type obj_type_mem_cache;
+
+#ifdef CONFIG_OBJ_CORE_STATS_MEM_CACHE
+static int k_mem_cache_stats_raw(struct k_obj_core *obj_core, void *stats)
+{
+	__ASSERT((obj_core != NULL) && (stats != NULL), "NULL parameter");
+
+	struct k_mem_cache *cache;
+	k_spinlock_key_t   key;
+
+	cache = CONTAINER_OF(obj_core, struct k_mem_cache, obj_core);
+	key = k_spin_lock(&cache->lock);
+	memcpy(stats, &cache->info, sizeof(cache->info));
+	k_spin_unlock(&cache->lock, key);
+
+	return 0;
+}
+
+static int k_mem_cache_stats_query(struct k_obj_core *obj_core, void *stats)
+{
+	__ASSERT((obj_core != NULL) && (stats != NULL), "NULL parameter");
+
+	struct k_mem_cache *cache;
+
+	cache = CONTAINER_OF(obj_core, struct k_mem_cache, obj_core);
+
+	return k_mem_cache_runtime_stats_get(cache, stats);
+}
+
+static int k_mem_cache_stats_reset(struct k_obj_core *obj_core)
+{
+	__ASSERT(obj_core != NULL, "NULL parameter");
+
+	struct k_mem_cache *cache;
+	k_spinlock_key_t   key;
+
+	cache = CONTAINER_OF(obj_core, struct k_mem_cache, obj_core);
+	key = k_spin_lock(&cache->lock);
+	cache->info.max_grown = cache->info.num_grown;
+	cache->info.grow_failures = 0U;
+	k_spin_unlock(&cache->lock, key);
+
+	return 0;
+}
+
+static struct k_obj_core_stats_desc mem_cache_stats_desc = {
+	.raw_size = sizeof(struct k_mem_cache_info),
+	.query_size = sizeof(struct sys_memory_stats),
+	.raw   = k_mem_cache_stats_raw,
+	.query = k_mem_cache_stats_query,
+	.reset = k_mem_cache_stats_reset,
+	.disable = NULL,
+	.enable = NULL,
+};
+#endif
+#endif
+
+static inline size_t block_size(struct k_mem_cache *cache)
+{
+	return K_MEM_CACHE_BLOCK_SIZE(cache->obj_size, cache->obj_align);
+}
+
+static inline void *block_to_obj(struct k_mem_cache *cache, void *block)
+{
+	return (char *)block + cache->obj_align;
+}
+
+static inline void *obj_to_block(struct k_mem_cache *cache, void *obj)
+{
+	return (char *)obj - cache->obj_align;
+}
+
+static bool slab_owns(struct k_mem_slab *slab, void *block)
+{
+	char *p = block;
+
+	return (p >= slab->buffer) &&
+	       (p < slab->buffer + slab->info.num_blocks * slab->info.block_size);
+}
+
+static void slab_objs_call(struct k_mem_cache *cache, struct k_mem_slab *slab,
+			   k_mem_cache_ctor_t fn)
+{
+	if (fn == NULL) {
+		return;
+	}
+
+	for (uint32_t i = 0U; i < slab->info.num_blocks; i++) {
+		fn(block_to_obj(cache, slab->buffer + i * slab->info.block_size));
+	}
+}
+
+/* Set up the initial slab of a cache, whose fields are already set */
+static int cache_setup(struct k_mem_cache *cache)
+{
+	int rc;
+
+	rc = k_mem_slab_init(&cache->slab, cache->slab.buffer,
+			     block_size(cache), cache->slab.info.num_blocks);
+	if (rc < 0) {
+		return rc;
+	}
+
+	slab_objs_call(cache, &cache->slab, cache->ctor);
+
+#ifdef CONFIG_OBJ_CORE_MEM_CACHE
+	k_obj_core_init_and_link(K_OBJ_CORE(cache), &obj_type_mem_cache);
+#ifdef CONFIG_OBJ_CORE_STATS_MEM_CACHE
+	k_obj_core_stats_register(K_OBJ_CORE(cache), &cache->info,
+				  sizeof(struct k_mem_cache_info));
+#endif
+#endif
+
+	return 0;
+}
+
+static int init_mem_cache_obj_core_list(void)
+{
+	int rc = 0;
+
+#ifdef CONFIG_OBJ_CORE_MEM_CACHE
+	z_obj_type_init(&obj_type_mem_cache, K_OBJ_TYPE_MEM_CACHE_ID,
+			offsetof(struct k_mem_cache, obj_core));
+#ifdef CONFIG_OBJ_CORE_STATS_MEM_CACHE
+	k_obj_type_stats_init(&obj_type_mem_cache, &mem_cache_stats_desc);
+#endif
+#endif
+
+	/* Initialize statically defined caches */
+
+	STRUCT_SECTION_FOREACH(k_mem_cache, cache) {
+		rc = cache_setup(cache);
+		if (rc < 0) {
+			break;
+		}
+	}
+
+	return rc;
+}
+
+/* After the memory slabs, whose object type the initial slabs link to */
+SYS_INIT(init_mem_cache_obj_core_list, PRE_KERNEL_2,
+	 CONFIG_KERNEL_INIT_PRIORITY_OBJECTS);
+
+int k_mem_cache_init(struct k_mem_cache *cache, void *buffer,
+		     size_t obj_size, size_t obj_align, uint32_t num_objs,
+		     k_mem_cache_ctor_t ctor, k_mem_cache_ctor_t dtor)
+{
+	CHECKIF((obj_size == 0U) || ((obj_align & (obj_align - 1U)) != 0U)) {
+		return -EINVAL;
+	}
+
+	cache->obj_size = obj_size;
+	cache->obj_align = Z_MEM_CACHE_ALIGN(obj_align);
+	cache->ctor = ctor;
+	cache->dtor = dtor;
+	cache->heap = NULL;
+	cache->grow_objs = 0U;
+	cache->grow_max = 0U;
+	cache->info = (struct k_mem_cache_info) {0};
+	cache->lock = (struct k_spinlock) {};
+	atomic_clear(&cache->waiters);
+	sys_slist_init(&cache->grown);
+	z_waitq_init(&cache->wait_q);
+
+	cache->slab.buffer = buffer;
+	cache->slab.info.num_blocks = num_objs;
+
+	return cache_setup(cache);
+}
+
+int k_mem_cache_heap_set(struct k_mem_cache *cache, struct k_heap *heap,
+			 uint32_t grow_objs, uint32_t grow_max)
+{
+	CHECKIF((heap == NULL) || (grow_objs == 0U)) {
+		return -EINVAL;
+	}
+
+	k_spinlock_key_t key = k_spin_lock(&cache->lock);
+
+	cache->heap = heap;
+	cache->grow_objs = grow_objs;
+	cache->grow_max = grow_max;
+
+	k_spin_unlock(&cache->lock, key);
+
+	return 0;
+}
+
+/* Add a slab from the heap and take a block from it.  Called with the
+ * cache lock held, which is released while the objects are constructed.
+ */
+static void *cache_grow(struct k_mem_cache *cache, k_spinlock_key_t *key)
+{
+	struct z_mem_cache_slab *gs;
+	size_t hdr = ROUND_UP(sizeof(*gs), cache->obj_align);
+	void *block;
+
+	if ((cache->heap == NULL) || (cache->info.num_grown >= cache->grow_max)) {
+		return NULL;
+	}
+
+	/* Reserve the slab while the lock is released */
+	cache->info.num_grown++;
+	k_spin_unlock(&cache->lock, *key);
+
+	gs = k_heap_aligned_alloc(cache->heap, cache->obj_align,
+				  hdr + cache->grow_objs * block_size(cache),
+				  K_NO_WAIT);
+	if (gs != NULL) {
+		(void)k_mem_slab_init(&gs->slab, (char *)gs + hdr,
+				      block_size(cache), cache->grow_objs);
+		slab_objs_call(cache, &gs->slab, cache->ctor);
+	}
+
+	*key = k_spin_lock(&cache->lock);
+
+	if (gs == NULL) {
+		cache->info.num_grown--;
+		cache->info.grow_failures++;
+		return NULL;
+	}
+
+	cache->info.max_grown = MAX(cache->info.max_grown, cache->info.num_grown);
+	sys_slist_prepend(&cache->grown, &gs->node);
+	(void)k_mem_slab_alloc(&gs->slab, &block, K_NO_WAIT);
+
+	return block;
+}
+
+/* Called with the cache lock held */
+static void *cache_alloc(struct k_mem_cache *cache, k_spinlock_key_t *key)
+{
+	struct z_mem_cache_slab *gs;
+	void *block;
+
+	if (k_mem_slab_alloc(&cache->slab, &block, K_NO_WAIT) == 0) {
+		return block;
+	}
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&cache->grown, gs, node) {
+		if (k_mem_slab_alloc(&gs->slab, &block, K_NO_WAIT) == 0) {
+			return block;
+		}
+	}
+
+	return cache_grow(cache, key);
+}
+
+void *k_mem_cache_alloc(struct k_mem_cache *cache, k_timeout_t timeout)
+{
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+	bool wait = IS_ENABLED(CONFIG_MULTITHREADING) &&
+		    !K_TIMEOUT_EQ(timeout, K_NO_WAIT);
+	k_spinlock_key_t key;
+	void *block;
+
+	/* Objects of the initial slab don't need the cache lock */
+	if (k_mem_slab_alloc(&cache->slab, &block, K_NO_WAIT) == 0) {
+		return block_to_obj(cache, block);
+	}
+
+	__ASSERT(!arch_is_in_isr() || !wait, "");
+
+	key = k_spin_lock(&cache->lock);
+
+	/* Frees to the initial slab check for waiters after freeing, so
+	 * the attempts below see any object freed without waking us
+	 */
+	if (wait) {
+		atomic_inc(&cache->waiters);
+	}
+
+	for (;;) {
+		block = cache_alloc(cache, &key);
+		if ((block != NULL) || !wait) {
+			break;
+		}
+
+		timeout = sys_timepoint_timeout(end);
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			break;
+		}
+
+		(void)z_pend_curr(&cache->lock, key, &cache->wait_q, timeout);
+		key = k_spin_lock(&cache->lock);
+	}
+
+	if (wait) {
+		atomic_dec(&cache->waiters);
+	}
+
+	k_spin_unlock(&cache->lock, key);
+
+	return (block != NULL) ? block_to_obj(cache, block) : NULL;
+}
+
+void k_mem_cache_free(struct k_mem_cache *cache, void *obj)
+{
+	void *block = obj_to_block(cache, obj);
+	k_spinlock_key_t key;
+
+	if (slab_owns(&cache->slab, block)) {
+		k_mem_slab_free(&cache->slab, block);
+		if (atomic_get(&cache->waiters) == 0) {
+			return;
+		}
+		key = k_spin_lock(&cache->lock);
+	} else {
+		struct z_mem_cache_slab *gs;
+		bool found = false;
+
+		key = k_spin_lock(&cache->lock);
+		SYS_SLIST_FOR_EACH_CONTAINER(&cache->grown, gs, node) {
+			if (slab_owns(&gs->slab, block)) {
+				k_mem_slab_free(&gs->slab, block);
+				found = true;
+				break;
+			}
+		}
+
+		__ASSERT(found, "object %p not from cache %p", obj, cache);
+		ARG_UNUSED(found);
+	}
+
+	if (IS_ENABLED(CONFIG_MULTITHREADING) && (z_unpend_all(&cache->wait_q) != 0)) {
+		z_reschedule(&cache->lock, key);
+	} else {
+		k_spin_unlock(&cache->lock, key);
+	}
+}
+
+uint32_t k_mem_cache_shrink(struct k_mem_cache *cache)
+{
+	struct z_mem_cache_slab *gs, *next;
+	sys_slist_t released;
+	uint32_t count = 0U;
+
+	sys_slist_init(&released);
+
+	k_spinlock_key_t key = k_spin_lock(&cache->lock);
+
+	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&cache->grown, gs, next, node) {
+		if (k_mem_slab_num_used_get(&gs->slab) == 0U) {
+			(void)sys_slist_find_and_remove(&cache->grown, &gs->node);
+			sys_slist_append(&released, &gs->node);
+			cache->info.num_grown--;
+		}
+	}
+
+	k_spin_unlock(&cache->lock, key);
+
+	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&released, gs, next, node) {
+		slab_objs_call(cache, &gs->slab, cache->dtor);
+#ifdef CONFIG_OBJ_CORE_MEM_SLAB
+		k_obj_core_unlink(K_OBJ_CORE(&gs->slab));
+#endif
+		k_heap_free(cache->heap, gs);
+		count++;
+	}
+
+	return count;
+}
+
+int k_mem_cache_runtime_stats_get(struct k_mem_cache *cache,
+				  struct sys_memory_stats *stats)
+{
+	struct z_mem_cache_slab *gs;
+	struct sys_memory_stats slab_stats;
+
+	if ((cache == NULL) || (stats == NULL)) {
+		return -EINVAL;
+	}
+
+	k_spinlock_key_t key = k_spin_lock(&cache->lock);
+
+	(void)k_mem_slab_runtime_stats_get(&cache->slab, stats);
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&cache->grown, gs, node) {
+		(void)k_mem_slab_runtime_stats_get(&gs->slab, &slab_stats);
+		stats->free_bytes += slab_stats.free_bytes;
+		stats->allocated_bytes += slab_stats.allocated_bytes;
+		stats->max_allocated_bytes += slab_stats.max_allocated_bytes;
+	}
+
+	k_spin_unlock(&cache->lock, key);
+
+	return 0;
+}
@@ -13,11 +13,19 @@
 #include <zephyr/init.h>
 #include <zephyr/sys/check.h>
 #include <zephyr/sys/iterable_sections.h>
+#include <zephyr/sys/mem_pressure.h>
 #include <string.h>
 /* private kernel APIs */
 #include <ksched.h>
 #include <wait_q.h>
 
+/* Blocks in use, excluding those held by the per-CPU caches */
+#ifdef CONFIG_MEM_SLAB_CACHE
+#define NUM_USED(slab) ((slab)->info.num_used - z_mem_slab_num_cached(slab))
+#else
+#define NUM_USED(slab) ((slab)->info.num_used)
+#endif
+
 #ifdef CONFIG_OBJ_CORE_MEM_SLAB
 static struct k_obj_type obj_type_mem_slab;
 
@@ -48,9 +56,9 @@ static int k_mem_slab_stats_query(struct k_obj_core *obj_core, void *stats)
 
 	slab = CONTAINER_OF(obj_core, struct k_mem_slab, obj_core);
 	key = k_spin_lock(&slab->lock);
-	ptr->free_bytes = (slab->info.num_blocks - slab->info.num_used) *
+	ptr->free_bytes = (slab->info.num_blocks - NUM_USED(slab)) *
 			  slab->info.block_size;
-	ptr->allocated_bytes = slab->info.num_used * slab->info.block_size;
+	ptr->allocated_bytes = NUM_USED(slab) * slab->info.block_size;
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 	ptr->max_allocated_bytes = slab->info.max_used * slab->info.block_size;
 #else
@@ -72,7 +80,7 @@ static int k_mem_slab_stats_reset(struct k_obj_core *obj_core)
 	key = k_spin_lock(&slab->lock);
 
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
-	slab->info.max_used = slab->info.num_used;
+	slab->info.max_used = NUM_USED(slab);
 #endif
 
 	k_spin_unlock(&slab->lock, key);
@@ -92,6 +100,175 @@ static struct k_obj_core_stats_desc mem_slab_stats_desc = {
 #endif
 #endif
 
+#ifdef CONFIG_MEM_SLAB_CACHE
+/* Each CPU keeps up to CONFIG_MEM_SLAB_CACHE_DEPTH free blocks of a slab
+ * in a private list, so that allocations and frees on one CPU don't
+ * contend for the slab lock.  Cached blocks are counted in num_used, as
+ * they are not on the slab's free list.  Lock ordering is slab lock,
+ * then CPU locks in CPU order.
+ */
+
+/* Lock the cache of the current CPU.  Interrupts are locked first so
+ * that the thread can't migrate between picking the CPU and taking its
+ * lock.
+ */
+static struct z_mem_slab_cache_cpu *cache_cpu_lock(struct k_mem_slab *slab,
+						   unsigned int *irq_key,
+						   k_spinlock_key_t *key)
+{
+	struct z_mem_slab_cache_cpu *cc;
+
+	*irq_key = arch_irq_lock();
+	cc = &slab->cache[_current_cpu->id];
+	*key = k_spin_lock(&cc->lock);
+
+	return cc;
+}
+
+static void cache_cpu_unlock(struct z_mem_slab_cache_cpu *cc,
+			     unsigned int irq_key, k_spinlock_key_t key)
+{
+	k_spin_unlock(&cc->lock, key);
+	arch_irq_unlock(irq_key);
+}
+
+static char *cache_alloc(struct k_mem_slab *slab)
+{
+	struct z_mem_slab_cache_cpu *cc;
+	unsigned int irq_key;
+	k_spinlock_key_t key;
+	char *mem;
+
+	cc = cache_cpu_lock(slab, &irq_key, &key);
+
+	mem = cc->free_list;
+	if (mem != NULL) {
+		cc->free_list = *(char **)mem;
+		cc->count--;
+	}
+
+	cache_cpu_unlock(cc, irq_key, key);
+
+	return mem;
+}
+
+static bool cache_free(struct k_mem_slab *slab, char *mem)
+{
+	struct z_mem_slab_cache_cpu *cc;
+	unsigned int irq_key;
+	k_spinlock_key_t key;
+	bool kept = false;
+
+	cc = cache_cpu_lock(slab, &irq_key, &key);
+
+	/* Checked with the CPU lock held: a hold set before a drain is then
+	 * seen here unless the drain finds the block in the cache.
+	 */
+	if ((atomic_get(&slab->cache_hold) == 0) &&
+	    (cc->count < CONFIG_MEM_SLAB_CACHE_DEPTH)) {
+		*(char **)mem = cc->free_list;
+		cc->free_list = mem;
+		cc->count++;
+		kept = true;
+	}
+
+	cache_cpu_unlock(cc, irq_key, key);
+
+	return kept;
+}
+
+/* Move a batch of blocks from the slab's free list to the cache of the
+ * current CPU, so that its next allocations don't take the slab lock.
+ * Called with the slab lock held.
+ */
+static void cache_refill(struct k_mem_slab *slab)
+{
+	struct z_mem_slab_cache_cpu *cc = &slab->cache[_current_cpu->id];
+	k_spinlock_key_t key = k_spin_lock(&cc->lock);
+	uint32_t n = 0U;
+
+	while ((slab->free_list != NULL) &&
+	       (n < (CONFIG_MEM_SLAB_CACHE_DEPTH + 1) / 2) &&
+	       (cc->count < CONFIG_MEM_SLAB_CACHE_DEPTH)) {
+		char *mem = slab->free_list;
+
+		slab->free_list = *(char **)mem;
+		*(char **)mem = cc->free_list;
+		cc->free_list = mem;
+		cc->count++;
+		n++;
+	}
+
+	k_spin_unlock(&cc->lock, key);
+
+	slab->info.num_used += n;
+}
+
+/* Return the blocks of all CPU caches to the slab's free list.  Called
+ * with the slab lock held.
+ */
+static void cache_drain(struct k_mem_slab *slab)
+{
+	for (unsigned int cpu = 0; cpu < arch_num_cpus(); cpu++) {
+		struct z_mem_slab_cache_cpu *cc = &slab->cache[cpu];
+		k_spinlock_key_t key = k_spin_lock(&cc->lock);
+		char *mem = cc->free_list;
+
+		slab->info.num_used -= cc->count;
+		cc->free_list = NULL;
+		cc->count = 0U;
+		k_spin_unlock(&cc->lock, key);
+
+		while (mem != NULL) {
+			char *next = *(char **)mem;
+
+			*(char **)mem = slab->free_list;
+			slab->free_list = mem;
+			mem = next;
+		}
+	}
+}
+
+/* The CPU locks are held together, taken in CPU order, so that the sum
+ * is a snapshot: with the slab lock also held, num_used minus the sum is
+ * then the exact number of blocks in use, even while blocks go in and
+ * out of the caches on other CPUs.
+ */
+uint32_t z_mem_slab_num_cached(struct k_mem_slab *slab)
+{
+	k_spinlock_key_t keys[CONFIG_MP_MAX_NUM_CPUS];
+	unsigned int num_cpus = arch_num_cpus();
+	uint32_t count = 0U;
+
+	for (unsigned int cpu = 0; cpu < num_cpus; cpu++) {
+		keys[cpu] = k_spin_lock(&slab->cache[cpu].lock);
+		count += slab->cache[cpu].count;
+	}
+
+	for (unsigned int cpu = num_cpus; cpu > 0; cpu--) {
+		k_spin_unlock(&slab->cache[cpu - 1].lock, keys[cpu - 1]);
+	}
+
+	return count;
+}
+
+#ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
+/* Unlocked estimate of NUM_USED(), only good enough to tell whether the
+ * locks are worth taking to update max_used.
+ */
+static uint32_t cache_num_used_hint(struct k_mem_slab *slab)
+{
+	uint32_t count = 0U;
+
+	for (unsigned int cpu = 0; cpu < arch_num_cpus(); cpu++) {
+		count += slab->cache[cpu].count;
+	}
+
+	return slab->info.num_used - count;
+}
+#endif
+#endif /* CONFIG_MEM_SLAB_CACHE */
+
 /**
  * @brief Initialize kernel memory slab subsystem.
  *
@@ -179,6 +356,10 @@ int k_mem_slab_init(struct k_mem_slab *slab, void *buffer,
 	slab->buffer = buffer;
 	slab->info.num_used = 0U;
 	slab->lock = (struct k_spinlock) {};
+#ifdef CONFIG_MEM_SLAB_CACHE
+	(void)memset(slab->cache, 0, sizeof(slab->cache));
+	atomic_clear(&slab->cache_hold);
+#endif
 
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 	slab->info.max_used = 0U;
@@ -207,19 +388,56 @@ out:
 
 int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 {
+#ifdef CONFIG_MEM_SLAB_CACHE
+	/* Blocks recently freed on this CPU don't need the slab lock */
+	*mem = cache_alloc(slab);
+	if (*mem != NULL) {
+#ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
+		/* Only take the locks when a new maximum is likely */
+		if (cache_num_used_hint(slab) > slab->info.max_used) {
+			k_spinlock_key_t key = k_spin_lock(&slab->lock);
+
+			slab->info.max_used = MAX(NUM_USED(slab),
+						  slab->info.max_used);
+			k_spin_unlock(&slab->lock, key);
+		}
+#endif
+		SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, alloc, slab, timeout);
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, alloc, slab, timeout, 0);
+		return 0;
+	}
+#endif
+
 	k_spinlock_key_t key = k_spin_lock(&slab->lock);
 	int result;
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, alloc, slab, timeout);
 
+#ifdef CONFIG_MEM_SLAB_CACHE
+	if (slab->free_list == NULL) {
+		/* Other CPUs may hold free blocks.  If we are going to wait,
+		 * hold the caches first so that blocks freed from now on are
+		 * handed to us.
+		 */
+		if (!K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			atomic_set(&slab->cache_hold, 1);
+		}
+		cache_drain(slab);
+	}
+#endif
+
 	if (slab->free_list != NULL) {
 		/* take a free block */
 		*mem = slab->free_list;
 		slab->free_list = *(char **)(slab->free_list);
 		slab->info.num_used++;
 
+#ifdef CONFIG_MEM_SLAB_CACHE
+		cache_refill(slab);
+#endif
+
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
-		slab->info.max_used = MAX(slab->info.num_used,
+		slab->info.max_used = MAX(NUM_USED(slab),
 					  slab->info.max_used);
 #endif
 
@@ -229,8 +447,14 @@ int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 		/* don't wait for a free block to become available */
 		*mem = NULL;
 		result = -ENOMEM;
+#ifdef CONFIG_MEM_PRESSURE
+		z_mem_pressure_exhausted();
+#endif
 	} else {
 		SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_mem_slab, alloc, slab, timeout);
+#ifdef CONFIG_MEM_PRESSURE
+		z_mem_pressure_exhausted();
+#endif
 
 		/* wait for a free block or timeout */
 		result = z_pend_curr(&slab->lock, key, &slab->wait_q, timeout);
@@ -252,15 +476,30 @@ int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 
 void k_mem_slab_free(struct k_mem_slab *slab, void *mem)
 {
-	k_spinlock_key_t key = k_spin_lock(&slab->lock);
-
 	__ASSERT(((char *)mem >= slab->buffer) &&
 		 ((((char *)mem - slab->buffer) % slab->info.block_size) == 0) &&
 		 ((char *)mem <= (slab->buffer + (slab->info.block_size *
 						  (slab->info.num_blocks - 1)))),
 		 "Invalid memory pointer provided");
 
+#ifdef CONFIG_MEM_SLAB_CACHE
+	if (cache_free(slab, mem)) {
+		SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, free, slab);
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, free, slab);
+		return;
+	}
+#endif
+
+	k_spinlock_key_t key = k_spin_lock(&slab->lock);
+
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, free, slab);
+
+#ifdef CONFIG_MEM_SLAB_CACHE
+	/* Any waiter left holds the caches again before pending */
+	if (z_waitq_head(&slab->wait_q) == NULL) {
+		atomic_clear(&slab->cache_hold);
+	}
+#endif
 	if (slab->free_list == NULL && IS_ENABLED(CONFIG_MULTITHREADING)) {
 		struct k_thread *pending_thread = z_unpend_first_thread(&slab->wait_q);
 
@@ -290,8 +529,8 @@ int k_mem_slab_runtime_stats_get(struct k_mem_slab *slab, struct sys_memory_stat
 
 	k_spinlock_key_t key = k_spin_lock(&slab->lock);
 
-	stats->allocated_bytes = slab->info.num_used * slab->info.block_size;
-	stats->free_bytes = (slab->info.num_blocks - slab->info.num_used) *
+	stats->allocated_bytes = NUM_USED(slab) * slab->info.block_size;
+	stats->free_bytes = (slab->info.num_blocks - NUM_USED(slab)) *
 			    slab->info.block_size;
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 	stats->max_allocated_bytes = slab->info.max_used *
@@ -314,7 +553,7 @@ int k_mem_slab_runtime_stats_reset_max(struct k_mem_slab *slab)
 
 	k_spinlock_key_t key = k_spin_lock(&slab->lock);
 
-	slab->info.max_used = slab->info.num_used;
+	slab->info.max_used = NUM_USED(slab);
 
 	k_spin_unlock(&slab->lock, key);
 
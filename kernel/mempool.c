@@ -8,8 +8,12 @@
 #include <string.h>
 #include <zephyr/sys/math_extras.h>
 #include <zephyr/sys/util.h>
+#include <zephyr/sys/heap_profile.h>
+#include <zephyr/init.h>
+#include <kernel_internal.h>
 
-static void *z_heap_aligned_alloc(struct k_heap *heap, size_t align, size_t size)
+static void *z_heap_aligned_alloc(struct k_heap *heap, size_t align, size_t size,
+				  void *site)
 {
 	void *mem;
 	struct k_heap **heap_ref;
@@ -26,7 +30,7 @@ static void *z_heap_aligned_alloc(struct k_heap *heap, size_t align, size_t size
 	}
 	__align = align | sizeof(heap_ref);
 
-	mem = k_heap_aligned_alloc(heap, __align, size, K_NO_WAIT);
+	mem = z_k_heap_aligned_alloc(heap, __align, size, K_NO_WAIT, site);
 	if (mem == NULL) {
 		return NULL;
 	}
@@ -61,7 +65,11 @@ void k_free(void *ptr)
 K_HEAP_DEFINE(_system_heap, K_HEAP_MEM_POOL_SIZE);
 #define _SYSTEM_HEAP (&_system_heap)
 
-void *k_aligned_alloc(size_t align, size_t size)
+/* The public allocators are implemented on top of each other through
+ * these, so that the site of an allocation is the caller of the
+ * public function while the tracing events stay the same
+ */
+static void *system_heap_aligned_alloc(size_t align, size_t size, void *site)
 {
 	__ASSERT(align / sizeof(void *) >= 1
 		&& (align % sizeof(void *)) == 0,
@@ -72,24 +80,34 @@ void *k_aligned_alloc(size_t align, size_t size)
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_heap_sys, k_aligned_alloc, _SYSTEM_HEAP);
 
-	void *ret = z_heap_aligned_alloc(_SYSTEM_HEAP, align, size);
+	void *ret = z_heap_aligned_alloc(_SYSTEM_HEAP, align, size, site);
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_heap_sys, k_aligned_alloc, _SYSTEM_HEAP, ret);
 
 	return ret;
 }
 
-void *k_malloc(size_t size)
+static void *system_heap_malloc(size_t size, void *site)
 {
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_heap_sys, k_malloc, _SYSTEM_HEAP);
 
-	void *ret = k_aligned_alloc(sizeof(void *), size);
+	void *ret = system_heap_aligned_alloc(sizeof(void *), size, site);
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_heap_sys, k_malloc, _SYSTEM_HEAP, ret);
 
 	return ret;
 }
 
+void *k_aligned_alloc(size_t align, size_t size)
+{
+	return system_heap_aligned_alloc(align, size, Z_HEAP_SITE());
+}
+
+void *k_malloc(size_t size)
+{
+	return system_heap_malloc(size, Z_HEAP_SITE());
+}
+
 void *k_calloc(size_t nmemb, size_t size)
 {
 	void *ret;
@@ -103,7 +121,7 @@ void *k_calloc(size_t nmemb, size_t size)
 		return NULL;
 	}
 
-	ret = k_malloc(bounds);
+	ret = system_heap_malloc(bounds, Z_HEAP_SITE());
 	if (ret != NULL) {
 		(void)memset(ret, 0, bounds);
 	}
@@ -117,6 +135,20 @@ void k_thread_system_pool_assign(struct k_thread *thread)
 {
 	thread->resource_pool = _SYSTEM_HEAP;
 }
+
+#ifdef CONFIG_SYS_HEAP_PROFILE_SYSTEM_HEAP
+static struct sys_heap_profile system_heap_profile;
+
+static int system_heap_profile_init(void)
+{
+	sys_heap_profile_attach(&_SYSTEM_HEAP->heap, &system_heap_profile);
+
+	return 0;
+}
+
+/* After the k_heap statics are initialized */
+SYS_INIT(system_heap_profile_init, PRE_KERNEL_2, 0);
+#endif
 #else
 #define _SYSTEM_HEAP	NULL
 #endif
@@ -133,7 +165,7 @@ void *z_thread_aligned_alloc(size_t align, size_t size)
 	}
 
 	if (heap != NULL) {
-		ret = z_heap_aligned_alloc(heap, align, size);
+		ret = z_heap_aligned_alloc(heap, align, size, Z_HEAP_SITE());
 	} else {
 		ret = NULL;
 	}
@@ -1348,6 +1348,24 @@ static inline void paging_stats_eviction_inc(struct k_thread *faulting_thread,
 #endif /* CONFIG_DEMAND_PAGING_STATS */
 }
 
+#ifdef CONFIG_DEMAND_PAGING_READ_AHEAD
+static inline void paging_stats_read_ahead_inc(struct k_thread *faulting_thread,
+					       size_t count)
+{
+#ifdef CONFIG_DEMAND_PAGING_STATS
+	paging_stats.pagefaults.read_ahead += count;
+#ifdef CONFIG_DEMAND_PAGING_THREAD_STATS
+	faulting_thread->paging_stats.pagefaults.read_ahead += count;
+#else
+	ARG_UNUSED(faulting_thread);
+#endif /* CONFIG_DEMAND_PAGING_THREAD_STATS */
+#else
+	ARG_UNUSED(faulting_thread);
+	ARG_UNUSED(count);
+#endif /* CONFIG_DEMAND_PAGING_STATS */
+}
+#endif /* CONFIG_DEMAND_PAGING_READ_AHEAD */
+
 static inline struct z_page_frame *do_eviction_select(bool *dirty)
 {
 	struct z_page_frame *pf;
@@ -1382,14 +1400,136 @@ static inline struct z_page_frame *do_eviction_select(bool *dirty)
 	return pf;
 }
 
-static bool do_page_fault(void *addr, bool pin)
+/* A data page to be paged in, and the page frame it goes to */
+struct page_in_req {
+	void *addr;
+	struct z_page_frame *pf;
+	uintptr_t page_in_location;
+	uintptr_t page_out_location;
+	bool dirty;
+};
+
+#ifdef CONFIG_DEMAND_PAGING_READ_AHEAD
+#define PAGE_IN_BATCH_MAX (1 + CONFIG_DEMAND_PAGING_READ_AHEAD_PAGES)
+#else
+#define PAGE_IN_BATCH_MAX 1
+#endif /* CONFIG_DEMAND_PAGING_READ_AHEAD */
+
+/* Get a page frame for a page-in, evicting a data page if none is free.
+ *
+ * The page frame is marked as busy until the batch it belongs to has been
+ * paged in, so that evictions for the other pages of the batch don't pick
+ * it.
+ */
+static int page_in_prepare_locked(struct page_in_req *req, bool page_fault,
+				  struct k_thread *faulting_thread)
+{
+	struct z_page_frame *pf;
+	bool dirty = false;
+	bool evicted = false;
+	int ret;
+
+	pf = free_page_frame_list_get();
+	if (pf == NULL) {
+		/* Need to evict a page frame */
+		pf = do_eviction_select(&dirty);
+		__ASSERT(pf != NULL, "failed to get a page frame");
+		LOG_DBG("evicting %p at 0x%lx", pf->addr,
+			z_page_frame_to_phys(pf));
+		evicted = true;
+	}
+
+	ret = page_frame_prepare_locked(pf, &dirty, page_fault,
+					&req->page_out_location);
+	if (ret != 0) {
+		if (!evicted) {
+			free_page_frame_list_put(pf);
+		}
+		return ret;
+	}
+
+	if (evicted) {
+		paging_stats_eviction_inc(faulting_thread, dirty);
+	}
+
+	pf->flags |= Z_PAGE_FRAME_BUSY;
+	req->pf = pf;
+	req->dirty = dirty;
+
+	return 0;
+}
+
+#ifdef CONFIG_DEMAND_PAGING_READ_AHEAD
+/* Sequential access detection: the data page whose fault would continue
+ * the current sequential run, and the number of pages read ahead of the
+ * last fault of that run.
+ */
+static uintptr_t read_ahead_next;
+static size_t read_ahead_window;
+
+/* Prepare the page-in of the data pages following a faulting one, if
+ * faults are sequential. The read-ahead window doubles with each fault of
+ * a sequential run, up to CONFIG_DEMAND_PAGING_READ_AHEAD_PAGES. Read-ahead
+ * stops at the first data page which can't be paged in, and data pages
+ * already in memory count towards the window but are skipped.
+ *
+ * Returns the number of read-ahead requests prepared.
+ */
+static size_t read_ahead_prepare_locked(struct page_in_req *reqs, void *addr,
+					struct k_thread *faulting_thread)
 {
+	uintptr_t page = POINTER_TO_UINT(addr) & ~(CONFIG_MMU_PAGE_SIZE - 1);
+	enum arch_page_location status;
+	size_t count = 0;
+
+	if (page == read_ahead_next) {
+		read_ahead_window = CLAMP(read_ahead_window * 2, 1,
+					  CONFIG_DEMAND_PAGING_READ_AHEAD_PAGES);
+	} else {
+		read_ahead_window = 0;
+	}
+	read_ahead_next = page + CONFIG_MMU_PAGE_SIZE;
+
+	for (size_t i = 1; i <= read_ahead_window; i++) {
+		struct page_in_req *req = &reqs[count];
+
+		req->addr = UINT_TO_POINTER(page + (i * CONFIG_MMU_PAGE_SIZE));
+		status = arch_page_location_get(req->addr,
+						&req->page_in_location);
+		if (status == ARCH_PAGE_LOCATION_BAD) {
+			break;
+		}
+
+		if (status == ARCH_PAGE_LOCATION_PAGED_OUT) {
+			/* Not a page fault: don't use the backing store
+			 * space reserved for those
+			 */
+			if (page_in_prepare_locked(req, false,
+						   faulting_thread) != 0) {
+				break;
+			}
+			count++;
+		}
+
+		read_ahead_next += CONFIG_MMU_PAGE_SIZE;
+	}
+
+	paging_stats_read_ahead_inc(faulting_thread, count);
+
+	return count;
+}
+#endif /* CONFIG_DEMAND_PAGING_READ_AHEAD */
+
+static bool do_page_fault(void *addr, bool pin, bool read_ahead)
+{
+	struct page_in_req reqs[PAGE_IN_BATCH_MAX];
 	struct z_page_frame *pf;
 	int key, ret;
-	uintptr_t page_in_location, page_out_location;
+	uintptr_t page_in_location;
 	enum arch_page_location status;
 	bool result;
-	bool dirty = false;
+	bool remap = false;
+	size_t count;
 	struct k_thread *faulting_thread = _current_cpu->current;
 
 	__ASSERT(page_frames_initialized, "page fault at %p happened too early",
@@ -1463,18 +1603,27 @@ static bool do_page_fault(void *addr, bool pin)
 
 	paging_stats_faults_inc(faulting_thread, key);
 
-	pf = free_page_frame_list_get();
-	if (pf == NULL) {
-		/* Need to evict a page frame */
-		pf = do_eviction_select(&dirty);
-		__ASSERT(pf != NULL, "failed to get a page frame");
-		LOG_DBG("evicting %p at 0x%lx", pf->addr,
-			z_page_frame_to_phys(pf));
+	reqs[0].addr = UINT_TO_POINTER(POINTER_TO_UINT(addr)
+				       & ~(CONFIG_MMU_PAGE_SIZE - 1));
+	reqs[0].page_in_location = page_in_location;
+	ret = page_in_prepare_locked(&reqs[0], true, faulting_thread);
+	__ASSERT(ret == 0, "failed to prepare page frame");
+	count = 1;
 
-		paging_stats_eviction_inc(faulting_thread, dirty);
+#ifdef CONFIG_DEMAND_PAGING_READ_AHEAD
+	/* Only real faults read ahead: k_mem_page_in() and k_mem_pin() are
+	 * explicit about the pages they want, and pages read ahead could
+	 * evict the ones just requested. Faults in ISRs must be kept short.
+	 */
+	if (read_ahead && !k_is_in_isr()) {
+		count += read_ahead_prepare_locked(&reqs[1], addr,
+						   faulting_thread);
+		/* Even a failed prepare may have moved the scratch page to
+		 * the page frame of its victim
+		 */
+		remap = true;
 	}
-	ret = page_frame_prepare_locked(pf, &dirty, true, &page_out_location);
-	__ASSERT(ret == 0, "failed to prepare page frame");
+#endif /* CONFIG_DEMAND_PAGING_READ_AHEAD */
 
 #ifdef CONFIG_DEMAND_PAGING_ALLOW_IRQ
 	irq_unlock(key);
@@ -1483,24 +1632,33 @@ static bool do_page_fault(void *addr, bool pin)
 	 * locked.
 	 */
 #endif /* CONFIG_DEMAND_PAGING_ALLOW_IRQ */
-	if (dirty) {
-		do_backing_store_page_out(page_out_location);
+	for (size_t i = 0; i < count; i++) {
+		if (remap) {
+			/* Preparing the batch moved the scratch page */
+			arch_mem_scratch(z_page_frame_to_phys(reqs[i].pf));
+		}
+		if (reqs[i].dirty) {
+			do_backing_store_page_out(reqs[i].page_out_location);
+		}
+		do_backing_store_page_in(reqs[i].page_in_location);
 	}
-	do_backing_store_page_in(page_in_location);
 
 #ifdef CONFIG_DEMAND_PAGING_ALLOW_IRQ
 	key = irq_lock();
-	pf->flags &= ~Z_PAGE_FRAME_BUSY;
 #endif /* CONFIG_DEMAND_PAGING_ALLOW_IRQ */
-	if (pin) {
-		pf->flags |= Z_PAGE_FRAME_PINNED;
-	}
-	pf->flags |= Z_PAGE_FRAME_MAPPED;
-	pf->addr = UINT_TO_POINTER(POINTER_TO_UINT(addr)
-				   & ~(CONFIG_MMU_PAGE_SIZE - 1));
+	for (size_t i = 0; i < count; i++) {
+		pf = reqs[i].pf;
+		pf->flags &= ~Z_PAGE_FRAME_BUSY;
+		if (pin) {
+			pf->flags |= Z_PAGE_FRAME_PINNED;
+		}
+		pf->flags |= Z_PAGE_FRAME_MAPPED;
+		pf->addr = reqs[i].addr;
 
-	arch_mem_page_in(addr, z_page_frame_to_phys(pf));
-	k_mem_paging_backing_store_page_finalize(pf, page_in_location);
+		arch_mem_page_in(reqs[i].addr, z_page_frame_to_phys(pf));
+		k_mem_paging_backing_store_page_finalize(pf,
+							 reqs[i].page_in_location);
+	}
 out:
 	irq_unlock(key);
 #ifdef CONFIG_DEMAND_PAGING_ALLOW_IRQ
@@ -1514,7 +1672,7 @@ static void do_page_in(void *addr)
 {
 	bool ret;
 
-	ret = do_page_fault(addr, false);
+	ret = do_page_fault(addr, false, false);
 	__ASSERT(ret, "unmapped memory address %p", addr);
 	(void)ret;
 }
@@ -1531,7 +1689,7 @@ static void do_mem_pin(void *addr)
 {
 	bool ret;
 
-	ret = do_page_fault(addr, true);
+	ret = do_page_fault(addr, true, false);
 	__ASSERT(ret, "unmapped memory address %p", addr);
 	(void)ret;
 }
@@ -1546,7 +1704,7 @@ void k_mem_pin(void *addr, size_t size)
 
 bool z_page_fault(void *addr)
 {
-	return do_page_fault(addr, false);
+	return do_page_fault(addr, false, true);
 }
 
 static void do_mem_unpin(void *addr)
@@ -293,6 +293,198 @@ static inline int z_vrfy_k_msgq_get(struct k_msgq *msgq, void *data,
 #include <syscalls/k_msgq_get_mrsh.c>
 #endif
 
+/* Copy @a num messages to/from the ring buffer with at most two
+ * memcpy() calls, one on each side of the wrap-around point.
+ */
+static void ring_write(struct k_msgq *msgq, const char *src, uint32_t num)
+{
+	size_t len = num * msgq->msg_size;
+	size_t to_end = msgq->buffer_end - msgq->write_ptr;
+
+	if (len >= to_end) {
+		(void)memcpy(msgq->write_ptr, src, to_end);
+		(void)memcpy(msgq->buffer_start, src + to_end, len - to_end);
+		msgq->write_ptr = msgq->buffer_start + (len - to_end);
+	} else {
+		(void)memcpy(msgq->write_ptr, src, len);
+		msgq->write_ptr += len;
+	}
+	msgq->used_msgs += num;
+}
+
+static void ring_read(struct k_msgq *msgq, char *dst, uint32_t num)
+{
+	size_t len = num * msgq->msg_size;
+	size_t to_end = msgq->buffer_end - msgq->read_ptr;
+
+	if (len >= to_end) {
+		(void)memcpy(dst, msgq->read_ptr, to_end);
+		(void)memcpy(dst + to_end, msgq->buffer_start, len - to_end);
+		msgq->read_ptr = msgq->buffer_start + (len - to_end);
+	} else {
+		(void)memcpy(dst, msgq->read_ptr, len);
+		msgq->read_ptr += len;
+	}
+	msgq->used_msgs -= num;
+}
+
+int z_impl_k_msgq_put_many(struct k_msgq *msgq, const void *data,
+			   uint32_t num_msgs, k_timeout_t timeout)
+{
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	const char *src = data;
+	struct k_thread *pending_thread;
+	k_spinlock_key_t key;
+	bool resched = false;
+	uint32_t count = 0U;
+	uint32_t num;
+	int result;
+
+	key = k_spin_lock(&msgq->lock);
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, put_many, msgq, timeout);
+
+	/* Receivers only ever wait on an empty queue: serve them first */
+	while ((count < num_msgs) && (msgq->used_msgs == 0U)) {
+		pending_thread = z_unpend_first_thread(&msgq->wait_q);
+		if (pending_thread == NULL) {
+			break;
+		}
+
+		(void)memcpy(pending_thread->base.swap_data, src,
+			     msgq->msg_size);
+		arch_thread_return_value_set(pending_thread, 0);
+		z_ready_thread(pending_thread);
+		src += msgq->msg_size;
+		count++;
+		resched = true;
+	}
+
+	/* Then queue as much of the rest as fits */
+	num = MIN(num_msgs - count, msgq->max_msgs - msgq->used_msgs);
+	if (num > 0U) {
+		ring_write(msgq, src, num);
+		count += num;
+#ifdef CONFIG_POLL
+		handle_poll_events(msgq, K_POLL_STATE_MSGQ_DATA_AVAILABLE);
+#endif /* CONFIG_POLL */
+	}
+
+	if ((count > 0U) || (num_msgs == 0U)) {
+		result = (int)count;
+	} else if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		/* don't wait for message space to become available */
+		result = -ENOMSG;
+	} else {
+		SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_msgq, put_many, msgq, timeout);
+
+		/* wait for room for the first message only */
+		_current->base.swap_data = (void *) data;
+
+		result = z_pend_curr(&msgq->lock, key, &msgq->wait_q, timeout);
+		result = (result == 0) ? 1 : result;
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, put_many, msgq, timeout, result);
+		return result;
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, put_many, msgq, timeout, result);
+
+	if (resched) {
+		z_reschedule(&msgq->lock, key);
+	} else {
+		k_spin_unlock(&msgq->lock, key);
+	}
+
+	return result;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_msgq_put_many(struct k_msgq *msgq, const void *data,
+					 uint32_t num_msgs, k_timeout_t timeout)
+{
+	K_OOPS(K_SYSCALL_OBJ(msgq, K_OBJ_MSGQ));
+	K_OOPS(K_SYSCALL_MEMORY_ARRAY_READ(data, num_msgs, msgq->msg_size));
+
+	return z_impl_k_msgq_put_many(msgq, data, num_msgs, timeout);
+}
+#include <syscalls/k_msgq_put_many_mrsh.c>
+#endif
+
+int z_impl_k_msgq_get_many(struct k_msgq *msgq, void *data,
+			   uint32_t num_msgs, k_timeout_t timeout)
+{
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	struct k_thread *pending_thread;
+	k_spinlock_key_t key;
+	bool resched = false;
+	uint32_t num;
+	int result;
+
+	key = k_spin_lock(&msgq->lock);
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, get_many, msgq, timeout);
+
+	num = MIN(num_msgs, msgq->used_msgs);
+	if (num > 0U) {
+		ring_read(msgq, data, num);
+
+		/* Senders only ever wait on a full queue: let as many
+		 * of them in as there are free slots now
+		 */
+		while (msgq->used_msgs < msgq->max_msgs) {
+			pending_thread = z_unpend_first_thread(&msgq->wait_q);
+			if (pending_thread == NULL) {
+				break;
+			}
+
+			ring_write(msgq, pending_thread->base.swap_data, 1U);
+			arch_thread_return_value_set(pending_thread, 0);
+			z_ready_thread(pending_thread);
+			resched = true;
+		}
+		result = (int)num;
+	} else if (num_msgs == 0U) {
+		result = 0;
+	} else if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		/* don't wait for a message to become available */
+		result = -ENOMSG;
+	} else {
+		SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_msgq, get_many, msgq, timeout);
+
+		/* wait for a single message */
+		_current->base.swap_data = data;
+
+		result = z_pend_curr(&msgq->lock, key, &msgq->wait_q, timeout);
+		result = (result == 0) ? 1 : result;
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, get_many, msgq, timeout, result);
+		return result;
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, get_many, msgq, timeout, result);
+
+	if (resched) {
+		z_reschedule(&msgq->lock, key);
+	} else {
+		k_spin_unlock(&msgq->lock, key);
+	}
+
+	return result;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_msgq_get_many(struct k_msgq *msgq, void *data,
+					 uint32_t num_msgs, k_timeout_t timeout)
+{
+	K_OOPS(K_SYSCALL_OBJ(msgq, K_OBJ_MSGQ));
+	K_OOPS(K_SYSCALL_MEMORY_ARRAY_WRITE(data, num_msgs, msgq->msg_size));
+
+	return z_impl_k_msgq_get_many(msgq, data, num_msgs, timeout);
+}
+#include <syscalls/k_msgq_get_many_mrsh.c>
+#endif
+
 int z_impl_k_msgq_peek(struct k_msgq *msgq, void *data)
 {
 	k_spinlock_key_t key;
@@ -51,6 +51,83 @@ static struct k_spinlock lock;
 static struct k_obj_type obj_type_mutex;
 #endif
 
+#ifdef CONFIG_OBJ_CORE_STATS_MUTEX
+static int k_mutex_stats_raw(struct k_obj_core *obj_core, void *stats)
+{
+	__ASSERT((obj_core != NULL) && (stats != NULL), "NULL parameter");
+
+	struct k_mutex *mutex = CONTAINER_OF(obj_core, struct k_mutex, obj_core);
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	memcpy(stats, &mutex->stats, sizeof(mutex->stats));
+	k_spin_unlock(&lock, key);
+
+	return 0;
+}
+
+static int k_mutex_stats_reset(struct k_obj_core *obj_core)
+{
+	__ASSERT(obj_core != NULL, "NULL parameter");
+
+	struct k_mutex *mutex = CONTAINER_OF(obj_core, struct k_mutex, obj_core);
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	memset(&mutex->stats, 0, sizeof(mutex->stats));
+	k_spin_unlock(&lock, key);
+
+	return 0;
+}
+
+static struct k_obj_core_stats_desc mutex_stats_desc = {
+	.raw_size = sizeof(struct k_lock_stats),
+	.query_size = sizeof(struct k_lock_stats),
+	.raw   = k_mutex_stats_raw,
+	.query = k_mutex_stats_raw,
+	.reset = k_mutex_stats_reset,
+	.disable = NULL,
+	.enable = NULL,
+};
+#endif
+
+/* Contention accounting, all called with the lock held */
+static inline uint32_t mutex_stats_now(void)
+{
+#ifdef CONFIG_OBJ_CORE_STATS_MUTEX
+	return k_cycle_get_32();
+#else
+	return 0;
+#endif
+}
+
+static inline void mutex_stats_taken(struct k_mutex *mutex)
+{
+	ARG_UNUSED(mutex);
+#ifdef CONFIG_OBJ_CORE_STATS_MUTEX
+	mutex->stats.acquisitions++;
+	if (mutex->lock_count == 1U) {
+		mutex->held_since = k_cycle_get_32();
+	}
+#endif
+}
+
+static inline void mutex_stats_waited(struct k_mutex *mutex, uint32_t start)
+{
+	ARG_UNUSED(mutex);
+	ARG_UNUSED(start);
+#ifdef CONFIG_OBJ_CORE_STATS_MUTEX
+	z_lock_stats_contended(&mutex->stats, k_cycle_get_32() - start);
+#endif
+}
+
+static inline void mutex_stats_released(struct k_mutex *mutex)
+{
+	ARG_UNUSED(mutex);
+#ifdef CONFIG_OBJ_CORE_STATS_MUTEX
+	z_lock_stats_released(&mutex->stats,
+			      k_cycle_get_32() - mutex->held_since);
+#endif
+}
+
 int z_impl_k_mutex_init(struct k_mutex *mutex)
 {
 	mutex->owner = NULL;
@@ -63,6 +140,11 @@ int z_impl_k_mutex_init(struct k_mutex *mutex)
 #ifdef CONFIG_OBJ_CORE_MUTEX
 	k_obj_core_init_and_link(K_OBJ_CORE(mutex), &obj_type_mutex);
 #endif
+#ifdef CONFIG_OBJ_CORE_STATS_MUTEX
+	mutex->stats = (struct k_lock_stats) {};
+	k_obj_core_stats_register(K_OBJ_CORE(mutex), &mutex->stats,
+				  sizeof(struct k_lock_stats));
+#endif
 
 	SYS_PORT_TRACING_OBJ_INIT(k_mutex, mutex, 0);
 
@@ -101,11 +183,52 @@ static bool adjust_owner_prio(struct k_mutex *mutex, int32_t new_prio)
 	return false;
 }
 
+#ifdef CONFIG_MUTEX_ADAPTIVE_SPIN
+/* Lockless hint: the owner may start or stop running at any time, the
+ * caller rechecks everything under the lock once it stops spinning.
+ */
+static bool owner_running(struct k_thread *owner)
+{
+	unsigned int num_cpus = arch_num_cpus();
+
+	for (unsigned int i = 0; i < num_cpus; i++) {
+		if (*(struct k_thread *volatile *)&_kernel.cpus[i].current == owner) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/* Spin until @a owner releases the mutex, stops running or the budget
+ * runs out.  Returns the remaining budget in cycles.
+ */
+static int32_t spin_on_owner(struct k_mutex *mutex, struct k_thread *owner,
+			     int32_t budget)
+{
+	uint32_t start = k_cycle_get_32();
+	int32_t elapsed = 0;
+
+	while ((*(struct k_thread *volatile *)&mutex->owner == owner) &&
+	       owner_running(owner) && (elapsed < budget)) {
+		arch_spin_relax();
+		elapsed = (int32_t)(k_cycle_get_32() - start);
+	}
+
+	return budget - elapsed;
+}
+#endif /* CONFIG_MUTEX_ADAPTIVE_SPIN */
+
 int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 {
 	int new_prio;
 	k_spinlock_key_t key;
 	bool resched = false;
+	bool waited = false;
+	uint32_t wait_start = 0U;
+#ifdef CONFIG_MUTEX_ADAPTIVE_SPIN
+	int32_t spin_budget = CONFIG_MUTEX_ADAPTIVE_SPIN_CYCLES;
+#endif
 
 	__ASSERT(!arch_is_in_isr(), "mutexes cannot be used inside ISRs");
 
@@ -113,6 +236,9 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 
 	key = k_spin_lock(&lock);
 
+#ifdef CONFIG_MUTEX_ADAPTIVE_SPIN
+retry:
+#endif
 	if (likely((mutex->lock_count == 0U) || (mutex->owner == _current))) {
 
 		mutex->owner_orig_prio = (mutex->lock_count == 0U) ?
@@ -122,6 +248,11 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 		mutex->lock_count++;
 		mutex->owner = _current;
 
+		if (waited) {
+			mutex_stats_waited(mutex, wait_start);
+		}
+		mutex_stats_taken(mutex);
+
 		LOG_DBG("%p took mutex %p, count: %d, orig prio: %d",
 			_current, mutex, mutex->lock_count,
 			mutex->owner_orig_prio);
@@ -134,6 +265,7 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 	}
 
 	if (unlikely(K_TIMEOUT_EQ(timeout, K_NO_WAIT))) {
+		mutex_stats_waited(mutex, mutex_stats_now());
 		k_spin_unlock(&lock, key);
 
 		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mutex, lock, mutex, timeout, -EBUSY);
@@ -141,6 +273,29 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 		return -EBUSY;
 	}
 
+	if (!waited) {
+		waited = true;
+		wait_start = mutex_stats_now();
+	}
+
+#ifdef CONFIG_MUTEX_ADAPTIVE_SPIN
+	/* The owner is running on another CPU and will likely release
+	 * the mutex soon: wait for it rather than paying for a context
+	 * switch.  Ownership is handed directly to the first waiter on
+	 * unlock, so spinning never lets this thread overtake a pended
+	 * one, and priority inheritance only matters once the owner is
+	 * no longer running, at which point we pend below.
+	 */
+	if ((spin_budget > 0) && owner_running(mutex->owner)) {
+		struct k_thread *owner = mutex->owner;
+
+		k_spin_unlock(&lock, key);
+		spin_budget = spin_on_owner(mutex, owner, spin_budget);
+		key = k_spin_lock(&lock);
+		goto retry;
+	}
+#endif
+
 	SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_mutex, lock, mutex, timeout);
 
 	new_prio = new_prio_for_inheritance(_current->base.prio,
@@ -160,6 +315,13 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 		got_mutex ? 'y' : 'n');
 
 	if (got_mutex == 0) {
+#ifdef CONFIG_OBJ_CORE_STATS_MUTEX
+		/* The mutex was handed over to us by k_mutex_unlock() */
+		key = k_spin_lock(&lock);
+		mutex_stats_waited(mutex, wait_start);
+		mutex_stats_taken(mutex);
+		k_spin_unlock(&lock, key);
+#endif
 		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mutex, lock, mutex, timeout, 0);
 		return 0;
 	}
@@ -170,6 +332,8 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 
 	key = k_spin_lock(&lock);
 
+	mutex_stats_waited(mutex, wait_start);
+
 	/*
 	 * Check if mutex was unlocked after this thread was unpended.
 	 * If so, skip adjusting owner's priority down.
@@ -251,6 +415,7 @@ int z_impl_k_mutex_unlock(struct k_mutex *mutex)
 
 	k_spinlock_key_t key = k_spin_lock(&lock);
 
+	mutex_stats_released(mutex);
 	adjust_owner_prio(mutex, mutex->owner_orig_prio);
 
 	/* Get the new owner, if any */
@@ -300,11 +465,18 @@ static int init_mutex_obj_core_list(void)
 
 	z_obj_type_init(&obj_type_mutex, K_OBJ_TYPE_MUTEX_ID,
 			offsetof(struct k_mutex, obj_core));
+#ifdef CONFIG_OBJ_CORE_STATS_MUTEX
+	k_obj_type_stats_init(&obj_type_mutex, &mutex_stats_desc);
+#endif
 
 	/* Initialize and link statically defined mutexs */
 
 	STRUCT_SECTION_FOREACH(k_mutex, mutex) {
 		k_obj_core_init_and_link(K_OBJ_CORE(mutex), &obj_type_mutex);
+#ifdef CONFIG_OBJ_CORE_STATS_MUTEX
+		k_obj_core_stats_register(K_OBJ_CORE(mutex), &mutex->stats,
+					  sizeof(struct k_lock_stats));
+#endif
 	}
 
 	return 0;
@@ -43,6 +43,8 @@ void k_pipe_init(struct k_pipe *pipe, unsigned char *buffer, size_t size)
 	pipe->bytes_used = 0U;
 	pipe->read_index = 0U;
 	pipe->write_index = 0U;
+	pipe->put_claimed = 0U;
+	pipe->get_claimed = 0U;
 	pipe->lock = (struct k_spinlock){};
 	z_waitq_init(&pipe->wait_q.writers);
 	z_waitq_init(&pipe->wait_q.readers);
@@ -184,6 +186,8 @@ int k_pipe_cleanup(struct k_pipe *pipe)
 		pipe->bytes_used = 0U;
 		pipe->read_index = 0U;
 		pipe->write_index = 0U;
+		pipe->put_claimed = 0U;
+		pipe->get_claimed = 0U;
 		pipe->flags &= ~K_PIPE_FLAG_ALLOC;
 	}
 
@@ -409,13 +413,22 @@ int z_impl_k_pipe_put(struct k_pipe *pipe, const void *data,
 	/*
 	 * First, write to any waiting readers, if any exist.
 	 * Second, write to the pipe buffer, if it exists.
+	 *
+	 * Readers are skipped while part of the buffer is claimed for
+	 * reading, as the claimed data may not all be consumed and must
+	 * stay ahead of this data. The buffer is skipped while part of it
+	 * is claimed for writing.
 	 */
 
-	bytes_can_write = pipe_waiter_list_populate(&dest_list,
-						    &pipe->wait_q.readers,
-						    bytes_to_write);
+	bytes_can_write = 0U;
 
-	if (pipe->bytes_used != pipe->size) {
+	if (pipe->get_claimed == 0U) {
+		bytes_can_write = pipe_waiter_list_populate(&dest_list,
+							    &pipe->wait_q.readers,
+							    bytes_to_write);
+	}
+
+	if ((pipe->bytes_used != pipe->size) && (pipe->put_claimed == 0U)) {
 		bytes_can_write += pipe_buffer_list_populate(&dest_list,
 							     pipe_desc,
 							     pipe->buffer,
@@ -552,18 +565,25 @@ static int pipe_get_internal(k_spinlock_key_t key, struct k_pipe *pipe,
 
 	sys_dlist_init(&src_list);
 
-	if (pipe->bytes_used != 0) {
-		bytes_can_read = pipe_buffer_list_populate(&src_list,
-							   pipe_desc,
-							   pipe->buffer,
-							   pipe->size,
-							   pipe->read_index,
-							   pipe->write_index);
-	}
+	/*
+	 * Nothing can be read while part of the buffer is claimed for
+	 * reading: the claimed data comes first and may not all be consumed.
+	 */
 
-	bytes_can_read += pipe_waiter_list_populate(&src_list,
-						    &pipe->wait_q.writers,
-						    bytes_to_read);
+	if (pipe->get_claimed == 0U) {
+		if (pipe->bytes_used != 0) {
+			bytes_can_read = pipe_buffer_list_populate(&src_list,
+								   pipe_desc,
+								   pipe->buffer,
+								   pipe->size,
+								   pipe->read_index,
+								   pipe->write_index);
+		}
+
+		bytes_can_read += pipe_waiter_list_populate(&src_list,
+							    &pipe->wait_q.writers,
+							    bytes_to_read);
+	}
 
 	if ((bytes_can_read < min_xfer) &&
 	    (K_TIMEOUT_EQ(timeout, K_NO_WAIT))) {
@@ -625,7 +645,7 @@ static int pipe_get_internal(k_spinlock_key_t key, struct k_pipe *pipe,
 		src_desc = (struct _pipe_desc *)sys_dlist_get(&src_list);
 	}
 
-	if (pipe->bytes_used != pipe->size) {
+	if ((pipe->bytes_used != pipe->size) && (pipe->put_claimed == 0U)) {
 		sys_dlist_t         pipe_list;
 
 		/*
@@ -810,6 +830,266 @@ size_t z_vrfy_k_pipe_write_avail(struct k_pipe *pipe)
 #include <syscalls/k_pipe_write_avail_mrsh.c>
 #endif
 
+/**
+ * @brief Copy data from the pipe buffer to waiting readers
+ *
+ * @return Number of bytes copied
+ */
+static size_t pipe_buffer_to_readers(struct k_pipe *pipe, bool *reschedule)
+{
+	struct _pipe_desc   pipe_desc[2];
+	struct _pipe_desc  *src;
+	struct _pipe_desc  *dest;
+	sys_dlist_t         src_list;
+	sys_dlist_t         dest_list;
+	size_t              bytes_copied;
+	size_t              num_bytes = 0U;
+
+	if ((pipe->bytes_used == 0U) || (pipe->get_claimed != 0U)) {
+		return 0U;
+	}
+
+	sys_dlist_init(&src_list);
+	sys_dlist_init(&dest_list);
+
+	(void) pipe_waiter_list_populate(&dest_list, &pipe->wait_q.readers,
+					 pipe->bytes_used);
+	(void) pipe_buffer_list_populate(&src_list, pipe_desc, pipe->buffer,
+					 pipe->size, pipe->read_index,
+					 pipe->write_index);
+
+	src = (struct _pipe_desc *)sys_dlist_get(&src_list);
+	dest = (struct _pipe_desc *)sys_dlist_get(&dest_list);
+
+	while ((src != NULL) && (dest != NULL)) {
+		bytes_copied = pipe_xfer(dest->buffer, dest->bytes_to_xfer,
+					 src->buffer, src->bytes_to_xfer);
+
+		num_bytes           += bytes_copied;
+
+		dest->buffer        += bytes_copied;
+		dest->bytes_to_xfer -= bytes_copied;
+
+		src->buffer         += bytes_copied;
+		src->bytes_to_xfer  -= bytes_copied;
+
+		pipe->bytes_used -= bytes_copied;
+		pipe->read_index += bytes_copied;
+		if (pipe->read_index >= pipe->size) {
+			pipe->read_index -= pipe->size;
+		}
+
+		if (dest->bytes_to_xfer == 0U) {
+
+			/* The thread's read request has been satisfied. */
+
+			z_unpend_thread(dest->thread);
+			z_ready_thread(dest->thread);
+
+			*reschedule = true;
+
+			dest = (struct _pipe_desc *)sys_dlist_get(&dest_list);
+		}
+
+		if (src->bytes_to_xfer == 0U) {
+			src = (struct _pipe_desc *)sys_dlist_get(&src_list);
+		}
+	}
+
+	return num_bytes;
+}
+
+/**
+ * @brief Copy data from waiting writers to the pipe buffer
+ *
+ * @return Number of bytes copied
+ */
+static size_t pipe_writers_to_buffer(struct k_pipe *pipe, bool *reschedule)
+{
+	struct _pipe_desc   pipe_desc[2];
+	struct _pipe_desc  *src;
+	struct _pipe_desc  *dest;
+	sys_dlist_t         src_list;
+	sys_dlist_t         dest_list;
+	size_t              bytes_copied;
+	size_t              num_bytes = 0U;
+
+	if ((pipe->bytes_used == pipe->size) || (pipe->put_claimed != 0U)) {
+		return 0U;
+	}
+
+	sys_dlist_init(&src_list);
+	sys_dlist_init(&dest_list);
+
+	(void) pipe_waiter_list_populate(&src_list, &pipe->wait_q.writers,
+					 pipe->size - pipe->bytes_used);
+	(void) pipe_buffer_list_populate(&dest_list, pipe_desc, pipe->buffer,
+					 pipe->size, pipe->write_index,
+					 pipe->read_index);
+
+	src = (struct _pipe_desc *)sys_dlist_get(&src_list);
+	dest = (struct _pipe_desc *)sys_dlist_get(&dest_list);
+
+	while ((src != NULL) && (dest != NULL)) {
+		bytes_copied = pipe_xfer(dest->buffer, dest->bytes_to_xfer,
+					 src->buffer, src->bytes_to_xfer);
+
+		num_bytes           += bytes_copied;
+
+		dest->buffer        += bytes_copied;
+		dest->bytes_to_xfer -= bytes_copied;
+
+		src->buffer         += bytes_copied;
+		src->bytes_to_xfer  -= bytes_copied;
+
+		pipe->bytes_used += bytes_copied;
+		pipe->write_index += bytes_copied;
+		if (pipe->write_index >= pipe->size) {
+			pipe->write_index -= pipe->size;
+		}
+
+		if (src->bytes_to_xfer == 0U) {
+
+			/* The thread's write request has been satisfied. */
+
+			z_unpend_thread(src->thread);
+			z_ready_thread(src->thread);
+
+			*reschedule = true;
+
+			src = (struct _pipe_desc *)sys_dlist_get(&src_list);
+		}
+
+		if (dest->bytes_to_xfer == 0U) {
+			dest = (struct _pipe_desc *)sys_dlist_get(&dest_list);
+		}
+	}
+
+	return num_bytes;
+}
+
+/**
+ * @brief Serve threads that waited on a claim
+ *
+ * Alternate between handing buffered data to waiting readers and refilling
+ * the buffer from waiting writers, until neither makes progress.
+ */
+static void pipe_claim_release(struct k_pipe *pipe, bool *reschedule)
+{
+	size_t  num_bytes;
+
+	do {
+		num_bytes = pipe_buffer_to_readers(pipe, reschedule);
+		num_bytes += pipe_writers_to_buffer(pipe, reschedule);
+	} while (num_bytes != 0U);
+
+	if (pipe->bytes_used != 0U) {
+		handle_poll_events(pipe);
+	}
+}
+
+size_t k_pipe_put_claim(struct k_pipe *pipe, uint8_t **data, size_t size)
+{
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+	size_t  claimed = 0U;
+
+	if ((pipe->put_claimed == 0U) && (pipe->bytes_used != pipe->size)) {
+		if (pipe->write_index < pipe->read_index) {
+			claimed = pipe->read_index - pipe->write_index;
+		} else {
+			claimed = pipe->size - pipe->write_index;
+		}
+		claimed = MIN(claimed, size);
+
+		*data = &pipe->buffer[pipe->write_index];
+		pipe->put_claimed = claimed;
+	}
+
+	k_spin_unlock(&pipe->lock, key);
+
+	return claimed;
+}
+
+int k_pipe_put_commit(struct k_pipe *pipe, size_t size)
+{
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+	bool  reschedule_needed = false;
+
+	CHECKIF(size > pipe->put_claimed) {
+		k_spin_unlock(&pipe->lock, key);
+
+		return -EINVAL;
+	}
+
+	pipe->put_claimed = 0U;
+	pipe->bytes_used += size;
+	pipe->write_index += size;
+	if (pipe->write_index >= pipe->size) {
+		pipe->write_index -= pipe->size;
+	}
+
+	pipe_claim_release(pipe, &reschedule_needed);
+
+	if (reschedule_needed) {
+		z_reschedule(&pipe->lock, key);
+	} else {
+		k_spin_unlock(&pipe->lock, key);
+	}
+
+	return 0;
+}
+
+size_t k_pipe_get_claim(struct k_pipe *pipe, uint8_t **data, size_t size)
+{
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+	size_t  claimed = 0U;
+
+	if ((pipe->get_claimed == 0U) && (pipe->bytes_used != 0U)) {
+		if (pipe->read_index < pipe->write_index) {
+			claimed = pipe->write_index - pipe->read_index;
+		} else {
+			claimed = pipe->size - pipe->read_index;
+		}
+		claimed = MIN(claimed, size);
+
+		*data = &pipe->buffer[pipe->read_index];
+		pipe->get_claimed = claimed;
+	}
+
+	k_spin_unlock(&pipe->lock, key);
+
+	return claimed;
+}
+
+int k_pipe_get_commit(struct k_pipe *pipe, size_t size)
+{
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+	bool  reschedule_needed = false;
+
+	CHECKIF(size > pipe->get_claimed) {
+		k_spin_unlock(&pipe->lock, key);
+
+		return -EINVAL;
+	}
+
+	pipe->get_claimed = 0U;
+	pipe->bytes_used -= size;
+	pipe->read_index += size;
+	if (pipe->read_index >= pipe->size) {
+		pipe->read_index -= pipe->size;
+	}
+
+	pipe_claim_release(pipe, &reschedule_needed);
+
+	if (reschedule_needed) {
+		z_reschedule(&pipe->lock, key);
+	} else {
+		k_spin_unlock(&pipe->lock, key);
+	}
+
+	return 0;
+}
+
 #ifdef CONFIG_OBJ_CORE_PIPE
 static int init_pipe_obj_core_list(void)
 {
@@ -220,6 +220,8 @@ static ALWAYS_INLINE void *thread_runq(struct k_thread *thread)
 	cpu = m == 0 ? 0 : u32_count_trailing_zeros(m);
 
 	return &_kernel.cpus[cpu].ready_q.runq;
+#elif defined(CONFIG_SCHED_PERCPU)
+	return &_kernel.cpus[thread->base.runq_cpu].ready_q.runq;
 #else
 	ARG_UNUSED(thread);
 	return &_kernel.ready_q.runq;
@@ -228,26 +230,265 @@ static ALWAYS_INLINE void *thread_runq(struct k_thread *thread)
 
 static ALWAYS_INLINE void *curr_cpu_runq(void)
 {
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#if defined(CONFIG_SCHED_CPU_MASK_PIN_ONLY) || defined(CONFIG_SCHED_PERCPU)
 	return &arch_curr_cpu()->ready_q.runq;
 #else
 	return &_kernel.ready_q.runq;
 #endif
 }
 
+#ifdef CONFIG_SCHED_PERCPU
+/* Home run queue for a thread becoming runnable: the CPU it last ran
+ * on, to keep its cache footprint warm, unless its affinity mask
+ * forbids that CPU, in which case the first allowed one is used.
+ */
+static ALWAYS_INLINE int runq_home_cpu(struct k_thread *thread)
+{
+	int cpu = thread->base.cpu;
+
+#ifdef CONFIG_SCHED_CPU_MASK
+	uint32_t m = thread->base.cpu_mask;
+
+	/* A thread with all CPUs masked off isn't really runnable,
+	 * any queue will do (see thread_runq() for PIN_ONLY)
+	 */
+	if ((m != 0U) && ((m & BIT(cpu)) == 0U)) {
+		cpu = u32_count_trailing_zeros(m);
+	}
+#endif
+	return cpu;
+}
+
+/* Each run queue has its own lock, which protects its contents and
+ * the scheduling state of the threads it holds or its CPU runs.  A CPU
+ * switching threads only takes its own, sched_spinlock is only needed
+ * when another CPU is involved.  They nest inside sched_spinlock, and
+ * are only held two at a time when stealing, the lock of a queue with
+ * a lower index then being only tried.  Cross-CPU changes to the state
+ * of a thread which may be queued or running anywhere take all of
+ * them, in index order, see runq_lock_all().
+ */
+static struct k_spinlock runq_locks[CONFIG_MP_MAX_NUM_CPUS];
+
+BUILD_ASSERT(CONFIG_MP_MAX_NUM_CPUS <= 32, "runq_held is a 32 bit mask");
+
+/* Run queue locks held by each CPU, so that the run queue operations
+ * done within next_up() or runq_lock_all() don't take them again
+ */
+static uint32_t runq_held[CONFIG_MP_MAX_NUM_CPUS];
+
+/* Head of each run queue, published under its lock so that a CPU can
+ * choose a queue to steal from without locking them all.  Only a hint:
+ * it is checked again under the lock of the queue.
+ */
+static atomic_ptr_t runq_heads[CONFIG_MP_MAX_NUM_CPUS];
+
+/* Interrupts must be masked, returns false if already held */
+static ALWAYS_INLINE bool runq_lock(unsigned int cpu)
+{
+	uint32_t *held = &runq_held[_current_cpu->id];
+
+	if ((*held & BIT(cpu)) != 0U) {
+		return false;
+	}
+	(void)k_spin_lock(&runq_locks[cpu]);
+	*held |= BIT(cpu);
+	return true;
+}
+
+static ALWAYS_INLINE void runq_unlock(unsigned int cpu, bool locked)
+{
+	if (locked) {
+		runq_held[_current_cpu->id] &= ~BIT(cpu);
+		k_spin_release(&runq_locks[cpu]);
+	}
+}
+
+static ALWAYS_INLINE void runq_publish(unsigned int cpu)
+{
+	(void)atomic_ptr_set(&runq_heads[cpu],
+			     _priq_run_best(&_kernel.cpus[cpu].ready_q.runq));
+}
+
+/* Whether a thread at the head of another CPU's run queue should run
+ * here rather than best: strictly higher priority, ties favor the
+ * local queue for cache locality, and its affinity must allow it.
+ */
+static bool runq_should_steal(struct k_thread *thread, struct k_thread *best,
+			      unsigned int cpu)
+{
+	if ((thread == NULL) ||
+	    ((best != NULL) && (z_sched_prio_cmp(thread, best) <= 0))) {
+		return false;
+	}
+#ifdef CONFIG_SCHED_CPU_MASK
+	if ((thread->base.cpu_mask & BIT(cpu)) == 0U) {
+		return false;
+	}
+#endif
+	return true;
+}
+
+/* Best thread for the current CPU, whose run queue lock is held: the
+ * head of its own run queue, unless the published head of another
+ * CPU's queue should run here instead.  That one is stolen, if still
+ * there once the lock of its queue is held: it is moved to the local
+ * queue, for the caller to dequeue it from there.
+ */
+static struct k_thread *runq_steal_best(void)
+{
+	unsigned int currcpu = _current_cpu->id;
+	unsigned int num_cpus = arch_num_cpus();
+	struct k_thread *best = _priq_run_best(curr_cpu_runq());
+	struct k_thread *thread, *hint = best;
+	struct k_spinlock *lock;
+	k_spinlock_key_t key;
+	int victim = -1;
+
+	for (unsigned int i = 0; i < num_cpus; i++) {
+		if (i == currcpu) {
+			continue;
+		}
+
+		thread = atomic_ptr_get(&runq_heads[i]);
+		if (runq_should_steal(thread, hint, currcpu)) {
+			hint = thread;
+			victim = i;
+		}
+	}
+
+	if (victim < 0) {
+		return best;
+	}
+
+	/* See runq_locks for the lock order */
+	lock = &runq_locks[victim];
+	if (victim > currcpu) {
+		key = k_spin_lock(lock);
+	} else if (k_spin_trylock(lock, &key) != 0) {
+		return best;
+	}
+	ARG_UNUSED(key);
+
+	thread = _priq_run_best(&_kernel.cpus[victim].ready_q.runq);
+	if (runq_should_steal(thread, best, currcpu)) {
+		_priq_run_remove(&_kernel.cpus[victim].ready_q.runq, thread);
+		runq_publish(victim);
+		thread->base.runq_cpu = currcpu;
+		_priq_run_add(curr_cpu_runq(), thread);
+		runq_publish(currcpu);
+		best = thread;
+	}
+	k_spin_release(lock);
+
+	return best;
+}
+#endif /* CONFIG_SCHED_PERCPU */
+
+/* With sched_spinlock held, lock out the switches of all CPUs: needed
+ * to change the state of a thread which may be queued or running on
+ * another CPU.
+ */
+static ALWAYS_INLINE void runq_lock_all(void)
+{
+#ifdef CONFIG_SCHED_PERCPU
+	unsigned int num_cpus = arch_num_cpus();
+
+	__ASSERT_NO_MSG(runq_held[_current_cpu->id] == 0U);
+	for (unsigned int i = 0; i < num_cpus; i++) {
+		(void)runq_lock(i);
+	}
+#endif
+}
+
+static ALWAYS_INLINE void runq_unlock_all(void)
+{
+#ifdef CONFIG_SCHED_PERCPU
+	unsigned int num_cpus = arch_num_cpus();
+
+	for (unsigned int i = num_cpus; i > 0; i--) {
+		runq_unlock(i - 1, true);
+	}
+#endif
+}
+
+/* Lock the run queue of the current CPU, which next_up() needs held */
+static ALWAYS_INLINE bool runq_lock_local(void)
+{
+#ifdef CONFIG_SCHED_PERCPU
+	return runq_lock(_current_cpu->id);
+#else
+	return false;
+#endif
+}
+
+static ALWAYS_INLINE void runq_unlock_local(bool locked)
+{
+#ifdef CONFIG_SCHED_PERCPU
+	runq_unlock(_current_cpu->id, locked);
+#else
+	ARG_UNUSED(locked);
+#endif
+}
+
 static ALWAYS_INLINE void runq_add(struct k_thread *thread)
 {
+#ifdef CONFIG_SCHED_PERCPU
+	int cpu = runq_home_cpu(thread);
+	bool locked = runq_lock(cpu);
+
+	thread->base.runq_cpu = cpu;
 	_priq_run_add(thread_runq(thread), thread);
+	runq_publish(cpu);
+	runq_unlock(cpu, locked);
+#else
+	_priq_run_add(thread_runq(thread), thread);
+#endif
 }
 
 static ALWAYS_INLINE void runq_remove(struct k_thread *thread)
 {
+#ifdef CONFIG_SCHED_PERCPU
+	bool removed = false;
+
+	/* A steal moves the thread under the lock of its old queue */
+	while (!removed) {
+		unsigned int cpu = thread->base.runq_cpu;
+		bool locked = runq_lock(cpu);
+
+		if (thread->base.runq_cpu == cpu) {
+			_priq_run_remove(thread_runq(thread), thread);
+			runq_publish(cpu);
+			removed = true;
+		}
+		runq_unlock(cpu, locked);
+	}
+#else
 	_priq_run_remove(thread_runq(thread), thread);
+#endif
+}
+
+/* Whether a queued thread can be dequeued by the current CPU with its
+ * own run queue lock held, i.e. was not stolen by another one
+ */
+static ALWAYS_INLINE bool runq_is_local(struct k_thread *thread)
+{
+#ifdef CONFIG_SCHED_PERCPU
+	return z_is_thread_queued(thread) &&
+	       (thread->base.runq_cpu == _current_cpu->id);
+#else
+	ARG_UNUSED(thread);
+	return true;
+#endif
 }
 
 static ALWAYS_INLINE struct k_thread *runq_best(void)
 {
+#ifdef CONFIG_SCHED_PERCPU
+	return runq_steal_best();
+#else
 	return _priq_run_best(curr_cpu_runq());
+#endif
 }
 
 /* _current is never in the run queue until context switch on
@@ -334,6 +575,41 @@ static inline void clear_halting(struct k_thread *thread)
 	thread->base.thread_state &= ~(_THREAD_ABORTING | _THREAD_SUSPENDING);
 }
 
+#ifdef CONFIG_SCHED_PERCPU
+/* Locks the run queue of the current CPU for a switch which involves
+ * no other one: that is unless _current is being halted from another
+ * CPU, which needs sched_spinlock.  Returns false, with nothing
+ * locked, in that case.  Interrupts must be masked.
+ */
+static bool runq_lock_switch(void)
+{
+	unsigned int cpu = _current_cpu->id;
+
+	(void)runq_lock(cpu);
+	if (is_halting(_current)) {
+		runq_unlock(cpu, true);
+		return false;
+	}
+	return true;
+}
+
+/* Called from do_swap() to end the switch out of k_yield() */
+void z_sched_runq_release(void)
+{
+	unsigned int cpu = _current_cpu->id;
+
+#ifdef CONFIG_SPIN_VALIDATE
+	z_spin_lock_set_owner(&runq_locks[cpu]);
+#endif
+	runq_unlock(cpu, true);
+}
+#else
+static inline bool runq_lock_switch(void)
+{
+	return false;
+}
+#endif /* CONFIG_SCHED_PERCPU */
+
 static ALWAYS_INLINE struct k_thread *next_up(void)
 {
 #ifdef CONFIG_SMP
@@ -355,7 +631,8 @@ static ALWAYS_INLINE struct k_thread *next_up(void)
 	struct k_thread *mirqp = _current_cpu->metairq_preempted;
 
 	if (mirqp != NULL && (thread == NULL || !is_metairq(thread))) {
-		if (!z_is_thread_prevented_from_running(mirqp)) {
+		if (!z_is_thread_prevented_from_running(mirqp) &&
+		    runq_is_local(mirqp)) {
 			thread = mirqp;
 		} else {
 			_current_cpu->metairq_preempted = NULL;
@@ -645,6 +922,9 @@ static void ready_thread(struct k_thread *thread)
 	if (!z_is_thread_queued(thread) && z_is_thread_ready(thread)) {
 		SYS_PORT_TRACING_OBJ_FUNC(k_thread, sched_ready, thread);
 
+#ifdef CONFIG_SCHED_LATENCY_STATS
+		z_sched_latency_ready(thread);
+#endif
 		queue_thread(thread);
 		update_cache(0);
 		flag_ipi();
@@ -663,7 +943,9 @@ void z_ready_thread(struct k_thread *thread)
 void z_move_thread_to_end_of_prio_q(struct k_thread *thread)
 {
 	K_SPINLOCK(&sched_spinlock) {
+		runq_lock_all();
 		move_thread_to_end_of_prio_q(thread);
+		runq_unlock_all();
 	}
 }
 
@@ -700,6 +982,7 @@ void z_sched_start(struct k_thread *thread)
 static void z_thread_halt(struct k_thread *thread, k_spinlock_key_t key,
 			  bool terminate)
 {
+	runq_lock_all();
 #ifdef CONFIG_SMP
 	if (is_halting(_current) && arch_is_in_isr()) {
 		/* Another CPU (in an ISR) or thread is waiting for the
@@ -727,6 +1010,7 @@ static void z_thread_halt(struct k_thread *thread, k_spinlock_key_t key,
 	}
 
 	if (is_halting(thread) && (thread != _current)) {
+		runq_unlock_all();
 		if (arch_is_in_isr()) {
 			/* ISRs can only spin waiting another CPU */
 			k_spin_unlock(&sched_spinlock, key);
@@ -751,6 +1035,7 @@ static void z_thread_halt(struct k_thread *thread, k_spinlock_key_t key,
 	}
 #endif
 	halt_thread(thread, terminate ? _THREAD_DEAD : _THREAD_SUSPENDED);
+	runq_unlock_all();
 	if ((thread == _current) && !arch_is_in_isr()) {
 		z_swap(&sched_spinlock, key);
 		__ASSERT(!terminate, "aborted _current back from dead");
@@ -1022,6 +1307,7 @@ bool z_set_prio(struct k_thread *thread, int prio)
 	bool need_sched = 0;
 
 	K_SPINLOCK(&sched_spinlock) {
+		runq_lock_all();
 		need_sched = z_is_thread_ready(thread);
 
 		if (need_sched) {
@@ -1037,6 +1323,7 @@ bool z_set_prio(struct k_thread *thread, int prio)
 		} else {
 			thread->base.prio = prio;
 		}
+		runq_unlock_all();
 	}
 
 	SYS_PORT_TRACING_OBJ_FUNC(k_thread, sched_priority_set, thread, prio);
@@ -1132,8 +1419,10 @@ void k_sched_unlock(void)
 struct k_thread *z_swap_next_thread(void)
 {
 #ifdef CONFIG_SMP
+	bool locked = runq_lock_local();
 	struct k_thread *ret = next_up();
 
+	runq_unlock_local(locked);
 	if (ret == _current) {
 		/* When not swapping, have to signal IPIs here.  In
 		 * the context switch case it must happen later, after
@@ -1192,55 +1481,73 @@ void *z_get_next_switch_handle(void *interrupted)
 
 #ifdef CONFIG_SMP
 	void *ret = NULL;
+	unsigned int key = arch_irq_lock();
+	bool global = !runq_lock_switch();
+	bool locked = true;
 
-	K_SPINLOCK(&sched_spinlock) {
-		struct k_thread *old_thread = _current, *new_thread;
+	if (global) {
+		(void)k_spin_lock(&sched_spinlock);
+		locked = runq_lock_local();
+	}
 
-		if (IS_ENABLED(CONFIG_SMP)) {
-			old_thread->switch_handle = NULL;
-		}
-		new_thread = next_up();
+	struct k_thread *old_thread = _current, *new_thread;
+
+	if (IS_ENABLED(CONFIG_SMP)) {
+		old_thread->switch_handle = NULL;
+	}
+	new_thread = next_up();
 
-		z_sched_usage_switch(new_thread);
+	z_sched_usage_switch(new_thread);
 
-		if (old_thread != new_thread) {
-			update_metairq_preempt(new_thread);
-			z_sched_switch_spin(new_thread);
-			arch_cohere_stacks(old_thread, interrupted, new_thread);
+	if (old_thread != new_thread) {
+		update_metairq_preempt(new_thread);
+		z_sched_switch_spin(new_thread);
+		arch_cohere_stacks(old_thread, interrupted, new_thread);
 
-			_current_cpu->swap_ok = 0;
-			set_current(new_thread);
+		_current_cpu->swap_ok = 0;
+		set_current(new_thread);
 
 #ifdef CONFIG_TIMESLICING
-			z_reset_time_slice(new_thread);
+		z_reset_time_slice(new_thread);
 #endif
 
 #ifdef CONFIG_SPIN_VALIDATE
-			/* Changed _current!  Update the spinlock
-			 * bookkeeping so the validation doesn't get
-			 * confused when the "wrong" thread tries to
-			 * release the lock.
-			 */
+		/* Changed _current!  Update the spinlock
+		 * bookkeeping so the validation doesn't get
+		 * confused when the "wrong" thread tries to
+		 * release the lock.
+		 */
+		if (global) {
 			z_spin_lock_set_owner(&sched_spinlock);
+		}
+#ifdef CONFIG_SCHED_PERCPU
+		if (locked) {
+			z_spin_lock_set_owner(&runq_locks[_current_cpu->id]);
+		}
+#endif
 #endif
 
-			/* A queued (runnable) old/current thread
-			 * needs to be added back to the run queue
-			 * here, and atomically with its switch handle
-			 * being set below.  This is safe now, as we
-			 * will not return into it.
-			 */
-			if (z_is_thread_queued(old_thread)) {
-				runq_add(old_thread);
-			}
-		}
-		old_thread->switch_handle = interrupted;
-		ret = new_thread->switch_handle;
-		if (IS_ENABLED(CONFIG_SMP)) {
-			/* Active threads MUST have a null here */
-			new_thread->switch_handle = NULL;
+		/* A queued (runnable) old/current thread
+		 * needs to be added back to the run queue
+		 * here, and atomically with its switch handle
+		 * being set below.  This is safe now, as we
+		 * will not return into it.
+		 */
+		if (z_is_thread_queued(old_thread)) {
+			runq_add(old_thread);
 		}
 	}
+	old_thread->switch_handle = interrupted;
+	ret = new_thread->switch_handle;
+	if (IS_ENABLED(CONFIG_SMP)) {
+		/* Active threads MUST have a null here */
+		new_thread->switch_handle = NULL;
+	}
+	runq_unlock_local(locked);
+	if (global) {
+		k_spin_release(&sched_spinlock);
+	}
+	arch_irq_unlock(key);
 	signal_pending_ipi();
 	return ret;
 #else
@@ -1402,7 +1709,7 @@ void init_ready_q(struct _ready_q *rq)
 		}
 	};
 #elif defined(CONFIG_SCHED_MULTIQ)
-	for (int i = 0; i < ARRAY_SIZE(_kernel.ready_q.runq.queues); i++) {
+	for (int i = 0; i < ARRAY_SIZE(rq->runq.queues); i++) {
 		sys_dlist_init(&rq->runq.queues[i]);
 	}
 #else
@@ -1412,7 +1719,7 @@ void init_ready_q(struct _ready_q *rq)
 
 void z_sched_init(void)
 {
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#if defined(CONFIG_SCHED_CPU_MASK_PIN_ONLY) || defined(CONFIG_SCHED_PERCPU)
 	for (int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
 		init_ready_q(&_kernel.cpus[i].ready_q);
 	}
@@ -1470,11 +1777,13 @@ void z_impl_k_thread_deadline_set(k_tid_t tid, int deadline)
 	struct k_thread *thread = tid;
 
 	K_SPINLOCK(&sched_spinlock) {
+		runq_lock_all();
 		thread->base.prio_deadline = k_cycle_get_32() + deadline;
 		if (z_is_thread_queued(thread)) {
 			dequeue_thread(thread);
 			queue_thread(thread);
 		}
+		runq_unlock_all();
 	}
 }
 
@@ -1506,6 +1815,22 @@ void z_impl_k_yield(void)
 
 	SYS_PORT_TRACING_FUNC(k_thread, yield);
 
+#ifdef CONFIG_SCHED_PERCPU
+	unsigned int irq_key = arch_irq_lock();
+
+	/* Yielding only involves the run queue of this CPU */
+	if (runq_lock_switch()) {
+		if (z_is_thread_queued(_current)) {
+			dequeue_thread(_current);
+		}
+		queue_thread(_current);
+		update_cache(1);
+		z_swap_runq(irq_key);
+		return;
+	}
+	arch_irq_unlock(irq_key);
+#endif
+
 	k_spinlock_key_t key = k_spin_lock(&sched_spinlock);
 
 	if (!IS_ENABLED(CONFIG_SMP) ||
@@ -32,16 +32,207 @@
 /* We use a system-wide lock to synchronize semaphores, which has
  * unfortunate performance impact vs. using a per-object lock
  * (semaphores are *very* widely used).  But per-object locks require
- * significant extra RAM.  A properly spin-aware semaphore
- * implementation would spin on atomic access to the count variable,
- * and not a spinlock per se.  Useful optimization for the future...
+ * significant extra RAM.  CONFIG_SEM_FAST_PATH avoids the lock
+ * entirely for the uncontended cases by operating on an atomic count.
  */
 static struct k_spinlock lock;
 
+#ifdef CONFIG_SEM_FAST_PATH
+/* With CONFIG_SEM_FAST_PATH the count lives in an atomic_t and the
+ * uncontended give/take operations are a single compare-and-swap, much
+ * like sys_sem does on top of k_futex. The top bit marks a semaphore
+ * that may have pended threads: it is only ever set with the lock held,
+ * by a thread that is about to pend, and forces every give through the
+ * locked path until the wait queue has been drained.
+ */
+#define SEM_CONTENDED ((atomic_val_t)BIT(31))
+#define SEM_COUNT(v) ((unsigned int)((v) & Z_SEM_COUNT_MAX))
+
+static inline bool sem_fast_take(struct k_sem *sem)
+{
+	atomic_val_t old;
+
+	/* Contention statistics are updated with the lock held */
+	if (IS_ENABLED(CONFIG_OBJ_CORE_STATS_SEM)) {
+		return false;
+	}
+
+	old = atomic_get(&sem->count);
+	while (SEM_COUNT(old) != 0U) {
+		if (atomic_cas(&sem->count, old, old - 1)) {
+			return true;
+		}
+		old = atomic_get(&sem->count);
+	}
+
+	return false;
+}
+
+static inline bool sem_fast_give(struct k_sem *sem)
+{
+	atomic_val_t old;
+
+	/* Pollers register without the semaphore lock, so they can't be
+	 * reliably seen from here: always notify them from the slow path.
+	 */
+	if (IS_ENABLED(CONFIG_POLL)) {
+		return false;
+	}
+
+	old = atomic_get(&sem->count);
+	while ((old & SEM_CONTENDED) == 0) {
+		if (SEM_COUNT(old) == sem->limit) {
+			return true;
+		}
+		if (atomic_cas(&sem->count, old, old + 1)) {
+			return true;
+		}
+		old = atomic_get(&sem->count);
+	}
+
+	return false;
+}
+
+/* Called with the lock held: the count may still be decremented
+ * concurrently by sem_fast_take(), so update it with a CAS loop.
+ */
+static inline bool sem_locked_take(struct k_sem *sem, bool pend)
+{
+	atomic_val_t old, new;
+
+	do {
+		old = atomic_get(&sem->count);
+		if (SEM_COUNT(old) != 0U) {
+			new = old - 1;
+		} else if (pend) {
+			new = old | SEM_CONTENDED;
+		} else {
+			return false;
+		}
+	} while (!atomic_cas(&sem->count, old, new));
+
+	return SEM_COUNT(old) != 0U;
+}
+
+static inline void sem_locked_give(struct k_sem *sem, bool woken)
+{
+	atomic_val_t old, new;
+
+	do {
+		old = atomic_get(&sem->count);
+		new = old & ~SEM_CONTENDED;
+		if (!woken && SEM_COUNT(new) != sem->limit) {
+			new++;
+		}
+		if (woken && z_waitq_head(&sem->wait_q) != NULL) {
+			new |= SEM_CONTENDED;
+		}
+	} while (!atomic_cas(&sem->count, old, new));
+}
+#else
+static inline bool sem_fast_take(struct k_sem *sem)
+{
+	ARG_UNUSED(sem);
+	return false;
+}
+
+static inline bool sem_fast_give(struct k_sem *sem)
+{
+	ARG_UNUSED(sem);
+	return false;
+}
+
+static inline bool sem_locked_take(struct k_sem *sem, bool pend)
+{
+	ARG_UNUSED(pend);
+
+	if (likely(sem->count > 0U)) {
+		sem->count--;
+		return true;
+	}
+
+	return false;
+}
+
+static inline void sem_locked_give(struct k_sem *sem, bool woken)
+{
+	if (!woken) {
+		sem->count += (sem->count != sem->limit) ? 1U : 0U;
+	}
+}
+#endif /* CONFIG_SEM_FAST_PATH */
+
 #ifdef CONFIG_OBJ_CORE_SEM
 static struct k_obj_type obj_type_sem;
 #endif
 
+#ifdef CONFIG_OBJ_CORE_STATS_SEM
+static int k_sem_stats_raw(struct k_obj_core *obj_core, void *stats)
+{
+	__ASSERT((obj_core != NULL) && (stats != NULL), "NULL parameter");
+
+	struct k_sem *sem = CONTAINER_OF(obj_core, struct k_sem, obj_core);
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	memcpy(stats, &sem->stats, sizeof(sem->stats));
+	k_spin_unlock(&lock, key);
+
+	return 0;
+}
+
+static int k_sem_stats_reset(struct k_obj_core *obj_core)
+{
+	__ASSERT(obj_core != NULL, "NULL parameter");
+
+	struct k_sem *sem = CONTAINER_OF(obj_core, struct k_sem, obj_core);
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	memset(&sem->stats, 0, sizeof(sem->stats));
+	k_spin_unlock(&lock, key);
+
+	return 0;
+}
+
+static struct k_obj_core_stats_desc sem_stats_desc = {
+	.raw_size = sizeof(struct k_lock_stats),
+	.query_size = sizeof(struct k_lock_stats),
+	.raw   = k_sem_stats_raw,
+	.query = k_sem_stats_raw,
+	.reset = k_sem_stats_reset,
+	.disable = NULL,
+	.enable = NULL,
+};
+#endif
+
+/* Contention accounting, all called with the lock held. A semaphore
+ * has no owner, so there is no hold time to track.
+ */
+static inline uint32_t sem_stats_now(void)
+{
+#ifdef CONFIG_OBJ_CORE_STATS_SEM
+	return k_cycle_get_32();
+#else
+	return 0;
+#endif
+}
+
+static inline void sem_stats_taken(struct k_sem *sem)
+{
+	ARG_UNUSED(sem);
+#ifdef CONFIG_OBJ_CORE_STATS_SEM
+	sem->stats.acquisitions++;
+#endif
+}
+
+static inline void sem_stats_waited(struct k_sem *sem, uint32_t start)
+{
+	ARG_UNUSED(sem);
+	ARG_UNUSED(start);
+#ifdef CONFIG_OBJ_CORE_STATS_SEM
+	z_lock_stats_contended(&sem->stats, k_cycle_get_32() - start);
+#endif
+}
+
 int z_impl_k_sem_init(struct k_sem *sem, unsigned int initial_count,
 		      unsigned int limit)
 {
@@ -54,8 +245,12 @@ int z_impl_k_sem_init(struct k_sem *sem, unsigned int initial_count,
 		return -EINVAL;
 	}
 
+#ifdef CONFIG_SEM_FAST_PATH
+	atomic_set(&sem->count, (atomic_val_t)MIN(initial_count, Z_SEM_COUNT_MAX));
+#else
 	sem->count = initial_count;
-	sem->limit = limit;
+#endif
+	sem->limit = MIN(limit, Z_SEM_COUNT_MAX);
 
 	SYS_PORT_TRACING_OBJ_FUNC(k_sem, init, sem, 0);
 
@@ -68,6 +263,11 @@ int z_impl_k_sem_init(struct k_sem *sem, unsigned int initial_count,
 #ifdef CONFIG_OBJ_CORE_SEM
 	k_obj_core_init_and_link(K_OBJ_CORE(sem), &obj_type_sem);
 #endif
+#ifdef CONFIG_OBJ_CORE_STATS_SEM
+	sem->stats = (struct k_lock_stats) {};
+	k_obj_core_stats_register(K_OBJ_CORE(sem), &sem->stats,
+				  sizeof(struct k_lock_stats));
+#endif
 
 	return 0;
 }
@@ -95,19 +295,26 @@ static inline bool handle_poll_events(struct k_sem *sem)
 
 void z_impl_k_sem_give(struct k_sem *sem)
 {
-	k_spinlock_key_t key = k_spin_lock(&lock);
+	k_spinlock_key_t key;
 	struct k_thread *thread;
 	bool resched = true;
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_sem, give, sem);
 
+	if (sem_fast_give(sem)) {
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_sem, give, sem);
+		return;
+	}
+
+	key = k_spin_lock(&lock);
 	thread = z_unpend_first_thread(&sem->wait_q);
 
 	if (thread != NULL) {
 		arch_thread_return_value_set(thread, 0);
 		z_ready_thread(thread);
+		sem_locked_give(sem, true);
 	} else {
-		sem->count += (sem->count != sem->limit) ? 1U : 0U;
+		sem_locked_give(sem, false);
 		resched = handle_poll_events(sem);
 	}
 
@@ -131,23 +338,30 @@ static inline void z_vrfy_k_sem_give(struct k_sem *sem)
 
 int z_impl_k_sem_take(struct k_sem *sem, k_timeout_t timeout)
 {
+	k_spinlock_key_t key;
+	uint32_t wait_start;
 	int ret = 0;
 
 	__ASSERT(((arch_is_in_isr() == false) ||
 		  K_TIMEOUT_EQ(timeout, K_NO_WAIT)), "");
 
-	k_spinlock_key_t key = k_spin_lock(&lock);
-
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_sem, take, sem, timeout);
 
-	if (likely(sem->count > 0U)) {
-		sem->count--;
+	if (sem_fast_take(sem)) {
+		goto out;
+	}
+
+	key = k_spin_lock(&lock);
+
+	if (sem_locked_take(sem, !K_TIMEOUT_EQ(timeout, K_NO_WAIT))) {
+		sem_stats_taken(sem);
 		k_spin_unlock(&lock, key);
 		ret = 0;
 		goto out;
 	}
 
 	if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		sem_stats_waited(sem, sem_stats_now());
 		k_spin_unlock(&lock, key);
 		ret = -EBUSY;
 		goto out;
@@ -155,8 +369,21 @@ int z_impl_k_sem_take(struct k_sem *sem, k_timeout_t timeout)
 
 	SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_sem, take, sem, timeout);
 
+	wait_start = sem_stats_now();
+
 	ret = z_pend_curr(&lock, key, &sem->wait_q, timeout);
 
+#ifdef CONFIG_OBJ_CORE_STATS_SEM
+	key = k_spin_lock(&lock);
+	sem_stats_waited(sem, wait_start);
+	if (ret == 0) {
+		sem_stats_taken(sem);
+	}
+	k_spin_unlock(&lock, key);
+#else
+	ARG_UNUSED(wait_start);
+#endif
+
 out:
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_sem, take, sem, timeout, ret);
 
@@ -176,7 +403,11 @@ void z_impl_k_sem_reset(struct k_sem *sem)
 		arch_thread_return_value_set(thread, -EAGAIN);
 		z_ready_thread(thread);
 	}
+#ifdef CONFIG_SEM_FAST_PATH
+	atomic_set(&sem->count, 0);
+#else
 	sem->count = 0;
+#endif
 
 	SYS_PORT_TRACING_OBJ_FUNC(k_sem, reset, sem);
 
@@ -216,11 +447,18 @@ static int init_sem_obj_core_list(void)
 
 	z_obj_type_init(&obj_type_sem, K_OBJ_TYPE_SEM_ID,
 			offsetof(struct k_sem, obj_core));
+#ifdef CONFIG_OBJ_CORE_STATS_SEM
+	k_obj_type_stats_init(&obj_type_sem, &sem_stats_desc);
+#endif
 
 	/* Initialize and link statically defined semaphores */
 
 	STRUCT_SECTION_FOREACH(k_sem, sem) {
 		k_obj_core_init_and_link(K_OBJ_CORE(sem), &obj_type_sem);
+#ifdef CONFIG_OBJ_CORE_STATS_SEM
+		k_obj_core_stats_register(K_OBJ_CORE(sem), &sem->stats,
+					  sizeof(struct k_lock_stats));
+#endif
 	}
 
 	return 0;
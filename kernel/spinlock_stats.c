@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+#include <string.h>
+
+static struct k_obj_type obj_type_spinlock;
+
+/* The statistics are only updated with the lock held, so take it to get
+ * a consistent snapshot. The snapshot includes this acquisition.
+ */
+static int k_spinlock_stats_raw(struct k_obj_core *obj_core, void *stats)
+{
+	__ASSERT((obj_core != NULL) && (stats != NULL), "NULL parameter");
+
+	struct k_spinlock *l = CONTAINER_OF(obj_core, struct k_spinlock,
+					    obj_core);
+	k_spinlock_key_t key = k_spin_lock(l);
+
+	memcpy(stats, &l->stats, sizeof(l->stats));
+	k_spin_unlock(l, key);
+
+	return 0;
+}
+
+static int k_spinlock_stats_reset(struct k_obj_core *obj_core)
+{
+	__ASSERT(obj_core != NULL, "NULL parameter");
+
+	struct k_spinlock *l = CONTAINER_OF(obj_core, struct k_spinlock,
+					    obj_core);
+	k_spinlock_key_t key = k_spin_lock(l);
+
+	memset(&l->stats, 0, sizeof(l->stats));
+	k_spin_unlock(l, key);
+
+	return 0;
+}
+
+static struct k_obj_core_stats_desc spinlock_stats_desc = {
+	.raw_size = sizeof(struct k_lock_stats),
+	.query_size = sizeof(struct k_lock_stats),
+	.raw   = k_spinlock_stats_raw,
+	.query = k_spinlock_stats_raw,
+	.reset = k_spinlock_stats_reset,
+	.disable = NULL,
+	.enable = NULL,
+};
+
+int k_spin_stats_register(struct k_spinlock *l)
+{
+	k_obj_core_init_and_link(&l->obj_core, &obj_type_spinlock);
+
+	return k_obj_core_stats_register(&l->obj_core, &l->stats,
+					 sizeof(struct k_lock_stats));
+}
+
+int k_spin_stats_deregister(struct k_spinlock *l)
+{
+	int rc = k_obj_core_stats_deregister(&l->obj_core);
+
+	k_obj_core_unlink(&l->obj_core);
+
+	return rc;
+}
+
+static int init_spinlock_obj_core_list(void)
+{
+	/* Initialize spinlock object type */
+
+	z_obj_type_init(&obj_type_spinlock, K_OBJ_TYPE_SPINLOCK_ID,
+			offsetof(struct k_spinlock, obj_core));
+	k_obj_type_stats_init(&obj_type_spinlock, &spinlock_stats_desc);
+
+	return 0;
+}
+
+SYS_INIT(init_spinlock_obj_core_list, PRE_KERNEL_1,
+	 CONFIG_KERNEL_INIT_PRIORITY_OBJECTS);
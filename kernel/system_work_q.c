@@ -14,8 +14,15 @@
 #include <zephyr/kernel.h>
 #include <zephyr/init.h>
 
+#if CONFIG_SYSTEM_WORKQUEUE_THREADS > 1
+static K_THREAD_STACK_ARRAY_DEFINE(sys_work_q_stacks,
+				   CONFIG_SYSTEM_WORKQUEUE_THREADS,
+				   CONFIG_SYSTEM_WORKQUEUE_STACK_SIZE);
+static struct k_thread sys_work_q_threads[CONFIG_SYSTEM_WORKQUEUE_THREADS - 1];
+#else
 static K_KERNEL_STACK_DEFINE(sys_work_q_stack,
 			     CONFIG_SYSTEM_WORKQUEUE_STACK_SIZE);
+#endif
 
 struct k_work_q k_sys_work_q;
 
@@ -26,10 +33,18 @@ static int k_sys_work_q_init(void)
 		.no_yield = IS_ENABLED(CONFIG_SYSTEM_WORKQUEUE_NO_YIELD),
 	};
 
+#if CONFIG_SYSTEM_WORKQUEUE_THREADS > 1
+	k_work_queue_pool_start(&k_sys_work_q, sys_work_q_threads,
+				&sys_work_q_stacks[0][0],
+				CONFIG_SYSTEM_WORKQUEUE_STACK_SIZE,
+				CONFIG_SYSTEM_WORKQUEUE_THREADS,
+				CONFIG_SYSTEM_WORKQUEUE_PRIORITY, &cfg);
+#else
 	k_work_queue_start(&k_sys_work_q,
 			    sys_work_q_stack,
 			    K_KERNEL_STACK_SIZEOF(sys_work_q_stack),
 			    CONFIG_SYSTEM_WORKQUEUE_PRIORITY, &cfg);
+#endif
 	return 0;
 }
 
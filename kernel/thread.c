@@ -901,6 +901,7 @@ void z_init_thread_base(struct _thread_base *thread_base, int priority,
 
 #ifdef CONFIG_SMP
 	thread_base->is_idle = 0;
+	thread_base->cpu = 0;
 #endif
 
 #ifdef CONFIG_TIMESLICE_PER_THREAD
@@ -1215,6 +1216,15 @@ int k_thread_runtime_stats_all_get(k_thread_runtime_stats_t *stats)
 		stats->average_cycles   += tmp_stats.average_cycles;
 #endif
 		stats->idle_cycles      += tmp_stats.idle_cycles;
+#ifdef CONFIG_SCHED_LATENCY_STATS
+		stats->latency.total    += tmp_stats.latency.total;
+		stats->latency.count    += tmp_stats.latency.count;
+		stats->latency.max       = MAX(stats->latency.max,
+					       tmp_stats.latency.max);
+		for (int j = 0; j < CONFIG_SCHED_LATENCY_STATS_BUCKETS; j++) {
+			stats->latency.buckets[j] += tmp_stats.latency.buckets[j];
+		}
+#endif
 	}
 #endif
 
@@ -11,11 +11,10 @@
 #include <zephyr/internal/syscall_handler.h>
 #include <zephyr/drivers/timer/system_timer.h>
 #include <zephyr/sys_clock.h>
+#include <zephyr/sys/barrier.h>
 
 static uint64_t curr_tick;
 
-static sys_dlist_t timeout_list = SYS_DLIST_STATIC_INIT(&timeout_list);
-
 static struct k_spinlock timeout_lock;
 
 #define MAX_WAIT (IS_ENABLED(CONFIG_SYSTEM_CLOCK_SLOPPY_IDLE) \
@@ -36,6 +35,238 @@ static inline int z_vrfy_sys_clock_hw_cycles_per_sec_runtime_get(void)
 #endif /* CONFIG_USERSPACE */
 #endif /* CONFIG_TIMER_READS_ITS_FREQUENCY_AT_RUNTIME */
 
+#ifdef CONFIG_TIMEOUT_QUEUE_SCALABLE
+
+/* Red/black tree backend: timeouts are keyed on their absolute
+ * expiry tick (stored in dticks), with order_key breaking ties so
+ * that timeouts expiring on the same tick fire in the order they
+ * were added.  The earliest timeout is cached so that reading the
+ * next expiry does not need to walk the tree.
+ */
+struct timeout_q {
+	struct rbtree tree;
+	struct _timeout *first;
+	uint32_t next_order_key;
+#ifdef CONFIG_TIMEOUT_QUEUE_PERCPU
+	struct k_spinlock lock;
+#endif
+};
+
+static bool timeout_lessthan(struct rbnode *a, struct rbnode *b)
+{
+	struct _timeout *ta = CONTAINER_OF(a, struct _timeout, node);
+	struct _timeout *tb = CONTAINER_OF(b, struct _timeout, node);
+
+	if (ta->dticks != tb->dticks) {
+		return ta->dticks < tb->dticks;
+	}
+
+	return ta->order_key < tb->order_key;
+}
+
+static void q_remove(struct timeout_q *q, struct _timeout *t)
+{
+	rb_remove(&q->tree, &t->node);
+	t->dticks = 0;
+
+	if (t == q->first) {
+		struct rbnode *n = rb_get_min(&q->tree);
+
+		q->first = n == NULL ? NULL
+			: CONTAINER_OF(n, struct _timeout, node);
+	}
+
+	if (q->first == NULL) {
+		q->next_order_key = 0;
+	}
+}
+
+/* to->dticks is an absolute tick on entry.  Returns true if the new
+ * timeout became the first one in the queue.
+ */
+static bool q_insert(struct timeout_q *q, struct _timeout *to)
+{
+	struct _timeout *t;
+
+	to->order_key = q->next_order_key++;
+
+	/* Renumber at wraparound, as the scheduler's rbtree priq
+	 * does.  Walking in tree order preserves the existing order.
+	 */
+	if (q->next_order_key == 0U) {
+		RB_FOR_EACH_CONTAINER(&q->tree, t, node) {
+			t->order_key = q->next_order_key++;
+		}
+		to->order_key = q->next_order_key++;
+	}
+
+	rb_insert(&q->tree, &to->node);
+
+	if ((q->first == NULL) ||
+	    timeout_lessthan(&to->node, &q->first->node)) {
+		q->first = to;
+		return true;
+	}
+
+	return false;
+}
+
+#ifdef CONFIG_TIMEOUT_QUEUE_PERCPU
+
+/* One queue per CPU, each with its own lock, so that arming and
+ * cancelling timeouts on different CPUs does not serialize on
+ * timeout_lock.  A timeout stays in the queue of the CPU that armed
+ * it (recorded in its cpu field) until it expires or is aborted, so
+ * nothing needs to move when the owning thread migrates.  The
+ * global timeout_lock still protects curr_tick and the announce
+ * state, and is always taken before any queue lock.
+ */
+static struct timeout_q timeout_qs[CONFIG_MP_MAX_NUM_CPUS] = {
+	[0 ... (CONFIG_MP_MAX_NUM_CPUS - 1)] = {
+		.tree = {
+			.lessthan_fn = timeout_lessthan,
+		},
+	},
+};
+
+/* Finds the queue holding the earliest timeout, storing its
+ * absolute expiry.  Must be called with timeout_lock held.
+ */
+static struct timeout_q *earliest_q(k_ticks_t *expiry)
+{
+	struct timeout_q *best = NULL;
+
+	for (unsigned int i = 0; i < arch_num_cpus(); i++) {
+		struct timeout_q *q = &timeout_qs[i];
+
+		K_SPINLOCK(&q->lock) {
+			struct _timeout *t = q->first;
+
+			if ((t != NULL) && ((best == NULL) || (t->dticks < *expiry))) {
+				best = q;
+				*expiry = t->dticks;
+			}
+		}
+	}
+
+	return best;
+}
+
+/* must be locked */
+static bool first_dticks(k_ticks_t *dt)
+{
+	k_ticks_t expiry;
+
+	if (earliest_q(&expiry) == NULL) {
+		return false;
+	}
+
+	*dt = expiry - curr_tick;
+	return true;
+}
+
+/* Removes and returns the earliest timeout if it expires within
+ * ticks of curr_tick, storing that distance in dt.  must be locked
+ */
+static struct _timeout *pop_expired(int32_t ticks, int *dt)
+{
+	struct _timeout *t = NULL;
+	k_ticks_t expiry;
+
+	for (;;) {
+		struct timeout_q *q = earliest_q(&expiry);
+
+		if ((q == NULL) || ((k_ticks_t)(expiry - curr_tick) > ticks)) {
+			return NULL;
+		}
+
+		K_SPINLOCK(&q->lock) {
+			t = q->first;
+			if ((t != NULL) &&
+			    ((k_ticks_t)(t->dticks - curr_tick) <= ticks)) {
+				/* A timeout armed on another CPU while
+				 * this announce was in progress may
+				 * already be in the past: never move
+				 * curr_tick backwards for it.
+				 */
+				*dt = MAX(0, t->dticks - curr_tick);
+				q_remove(q, t);
+			} else {
+				t = NULL;
+			}
+		}
+
+		if (t != NULL) {
+			return t;
+		}
+
+		/* Lost a race with an abort on another CPU, rescan */
+	}
+}
+
+/* Moves curr_tick forward without expiring anything */
+static void advance_first(k_ticks_t ticks)
+{
+	/* Expiry ticks are absolute, nothing to rebase */
+	ARG_UNUSED(ticks);
+}
+
+#else /* !CONFIG_TIMEOUT_QUEUE_PERCPU */
+
+static struct timeout_q timeout_q = {
+	.tree = {
+		.lessthan_fn = timeout_lessthan,
+	},
+};
+
+static struct _timeout *first(void)
+{
+	return timeout_q.first;
+}
+
+/* Ticks from curr_tick until the given (queued) timeout expires */
+static k_ticks_t timeout_dticks(const struct _timeout *t)
+{
+	return t->dticks - curr_tick;
+}
+
+static void remove_timeout(struct _timeout *t)
+{
+	q_remove(&timeout_q, t);
+}
+
+/* to->dticks is relative to curr_tick on entry */
+static void insert_timeout(struct _timeout *to)
+{
+	to->dticks += curr_tick;
+	(void)q_insert(&timeout_q, to);
+}
+
+/* Removes the first timeout, which expires exactly at curr_tick */
+static void expire_first(struct _timeout *t)
+{
+	remove_timeout(t);
+}
+
+/* Moves curr_tick forward without expiring anything */
+static void advance_first(k_ticks_t ticks)
+{
+	/* Expiry ticks are absolute, nothing to rebase */
+	ARG_UNUSED(ticks);
+}
+
+/* must be locked */
+static k_ticks_t timeout_ticks(const struct _timeout *timeout)
+{
+	return timeout_dticks(timeout);
+}
+
+#endif /* CONFIG_TIMEOUT_QUEUE_PERCPU */
+
+#else /* CONFIG_TIMEOUT_QUEUE_DUMB */
+
+static sys_dlist_t timeout_list = SYS_DLIST_STATIC_INIT(&timeout_list);
+
 static struct _timeout *first(void)
 {
 	sys_dnode_t *t = sys_dlist_peek_head(&timeout_list);
@@ -50,6 +281,12 @@ static struct _timeout *next(struct _timeout *t)
 	return n == NULL ? NULL : CONTAINER_OF(n, struct _timeout, node);
 }
 
+/* Ticks from curr_tick until the first timeout expires */
+static k_ticks_t timeout_dticks(const struct _timeout *t)
+{
+	return t->dticks;
+}
+
 static void remove_timeout(struct _timeout *t)
 {
 	if (next(t) != NULL) {
@@ -59,6 +296,93 @@ static void remove_timeout(struct _timeout *t)
 	sys_dlist_remove(&t->node);
 }
 
+/* to->dticks is relative to curr_tick on entry */
+static void insert_timeout(struct _timeout *to)
+{
+	struct _timeout *t;
+
+	for (t = first(); t != NULL; t = next(t)) {
+		if (t->dticks > to->dticks) {
+			t->dticks -= to->dticks;
+			sys_dlist_insert(&t->node, &to->node);
+			break;
+		}
+		to->dticks -= t->dticks;
+	}
+
+	if (t == NULL) {
+		sys_dlist_append(&timeout_list, &to->node);
+	}
+}
+
+/* Removes the first timeout, which expires exactly at curr_tick */
+static void expire_first(struct _timeout *t)
+{
+	t->dticks = 0;
+	remove_timeout(t);
+}
+
+/* Moves curr_tick forward without expiring anything */
+static void advance_first(k_ticks_t ticks)
+{
+	struct _timeout *t = first();
+
+	if (t != NULL) {
+		t->dticks -= ticks;
+	}
+}
+
+/* must be locked */
+static k_ticks_t timeout_ticks(const struct _timeout *timeout)
+{
+	k_ticks_t ticks = 0;
+
+	for (struct _timeout *t = first(); t != NULL; t = next(t)) {
+		ticks += t->dticks;
+		if (timeout == t) {
+			break;
+		}
+	}
+
+	return ticks;
+}
+
+#endif /* CONFIG_TIMEOUT_QUEUE_SCALABLE */
+
+#ifndef CONFIG_TIMEOUT_QUEUE_PERCPU
+
+/* must be locked */
+static bool first_dticks(k_ticks_t *dt)
+{
+	struct _timeout *t = first();
+
+	if (t == NULL) {
+		return false;
+	}
+
+	*dt = timeout_dticks(t);
+	return true;
+}
+
+/* Removes and returns the first timeout if it expires within ticks
+ * of curr_tick, storing that distance in dt.  must be locked
+ */
+static struct _timeout *pop_expired(int32_t ticks, int *dt)
+{
+	struct _timeout *t = first();
+
+	if ((t == NULL) || (timeout_dticks(t) > ticks)) {
+		return NULL;
+	}
+
+	*dt = timeout_dticks(t);
+	expire_first(t);
+
+	return t;
+}
+
+#endif /* !CONFIG_TIMEOUT_QUEUE_PERCPU */
+
 static int32_t elapsed(void)
 {
 	/* While sys_clock_announce() is executing, new relative timeouts will be
@@ -82,23 +406,29 @@ static int32_t elapsed(void)
 
 static int32_t next_timeout(void)
 {
-	struct _timeout *to = first();
 	int32_t ticks_elapsed = elapsed();
+	k_ticks_t dt;
 	int32_t ret;
 
-	if ((to == NULL) ||
-	    ((int64_t)(to->dticks - ticks_elapsed) > (int64_t)INT_MAX)) {
+	if (!first_dticks(&dt) ||
+	    ((int64_t)(dt - ticks_elapsed) > (int64_t)INT_MAX)) {
 		ret = MAX_WAIT;
 	} else {
-		ret = MAX(0, to->dticks - ticks_elapsed);
+		ret = MAX(0, dt - ticks_elapsed);
 	}
 
 	return ret;
 }
 
+#ifdef CONFIG_TIMEOUT_QUEUE_PERCPU
+
 void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
 		   k_timeout_t timeout)
 {
+	struct timeout_q *q = NULL;
+	k_ticks_t expiry = 0;
+	bool is_first = false;
+
 	if (K_TIMEOUT_EQ(timeout, K_FOREVER)) {
 		return;
 	}
@@ -107,12 +437,124 @@ void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
 	__ASSERT_NO_MSG(arch_mem_coherent(to));
 #endif
 
-	__ASSERT(!sys_dnode_is_linked(&to->node), "");
+	__ASSERT(z_is_inactive_timeout(to), "");
 	to->fn = fn;
 
+	/* Only the conversion to an absolute tick needs the global
+	 * lock, the tree insertion happens under the queue lock of the
+	 * CPU arming the timeout.
+	 */
 	K_SPINLOCK(&timeout_lock) {
-		struct _timeout *t;
+		if (Z_TICK_ABS(timeout.ticks) >= 0) {
+			k_ticks_t ticks = Z_TICK_ABS(timeout.ticks) - curr_tick;
+
+			expiry = curr_tick + MAX(1, ticks);
+		} else {
+			expiry = curr_tick + timeout.ticks + 1 + elapsed();
+		}
+
+		q = &timeout_qs[_current_cpu->id];
+	}
+
+	K_SPINLOCK(&q->lock) {
+		to->cpu = q - timeout_qs;
+		/* Pairs with the fence in lock_active_q() */
+		barrier_dmem_fence_full();
+		to->dticks = expiry;
+		is_first = q_insert(q, to);
+	}
+
+	if (is_first) {
+		K_SPINLOCK(&timeout_lock) {
+			sys_clock_set_timeout(next_timeout(), false);
+		}
+	}
+}
+
+/* Locks and returns the queue holding an active timeout, or returns
+ * NULL with nothing locked if the timeout is inactive.
+ *
+ * The cpu field is written under the lock of the queue the timeout is
+ * being inserted into, not of the one it was last in, so a concurrent
+ * z_add_timeout() on another CPU (e.g. k_timer_start() racing
+ * k_timer_stop()) can move the timeout between reading the field and
+ * locking that queue.  Check it again with the lock held and retry if
+ * it changed.  The fence pairs with the one in z_add_timeout(), so
+ * that seeing the new expiry implies seeing the new cpu.
+ */
+static struct timeout_q *lock_active_q(const struct _timeout *to,
+				       k_spinlock_key_t *key)
+{
+	for (;;) {
+		unsigned int cpu = to->cpu;
+		struct timeout_q *q = &timeout_qs[cpu];
+
+		*key = k_spin_lock(&q->lock);
 
+		if (z_is_inactive_timeout(to)) {
+			k_spin_unlock(&q->lock, *key);
+			return NULL;
+		}
+
+		barrier_dmem_fence_full();
+
+		if (to->cpu == cpu) {
+			return q;
+		}
+
+		k_spin_unlock(&q->lock, *key);
+	}
+}
+
+int z_abort_timeout(struct _timeout *to)
+{
+	k_spinlock_key_t key;
+	struct timeout_q *q = lock_active_q(to, &key);
+
+	if (q == NULL) {
+		return -EINVAL;
+	}
+
+	q_remove(q, to);
+	k_spin_unlock(&q->lock, key);
+
+	return 0;
+}
+
+/* must be locked */
+static k_ticks_t timeout_rem(const struct _timeout *timeout)
+{
+	k_spinlock_key_t key;
+	struct timeout_q *q = lock_active_q(timeout, &key);
+	k_ticks_t ticks;
+
+	if (q == NULL) {
+		return 0;
+	}
+
+	ticks = timeout->dticks - curr_tick - elapsed();
+	k_spin_unlock(&q->lock, key);
+
+	return ticks;
+}
+
+#else /* !CONFIG_TIMEOUT_QUEUE_PERCPU */
+
+void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
+		   k_timeout_t timeout)
+{
+	if (K_TIMEOUT_EQ(timeout, K_FOREVER)) {
+		return;
+	}
+
+#ifdef CONFIG_KERNEL_COHERENCE
+	__ASSERT_NO_MSG(arch_mem_coherent(to));
+#endif
+
+	__ASSERT(z_is_inactive_timeout(to), "");
+	to->fn = fn;
+
+	K_SPINLOCK(&timeout_lock) {
 		if (IS_ENABLED(CONFIG_TIMEOUT_64BIT) &&
 		    Z_TICK_ABS(timeout.ticks) >= 0) {
 			k_ticks_t ticks = Z_TICK_ABS(timeout.ticks) - curr_tick;
@@ -122,18 +564,7 @@ void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
 			to->dticks = timeout.ticks + 1 + elapsed();
 		}
 
-		for (t = first(); t != NULL; t = next(t)) {
-			if (t->dticks > to->dticks) {
-				t->dticks -= to->dticks;
-				sys_dlist_insert(&t->node, &to->node);
-				break;
-			}
-			to->dticks -= t->dticks;
-		}
-
-		if (t == NULL) {
-			sys_dlist_append(&timeout_list, &to->node);
-		}
+		insert_timeout(to);
 
 		if (to == first()) {
 			sys_clock_set_timeout(next_timeout(), false);
@@ -146,7 +577,7 @@ int z_abort_timeout(struct _timeout *to)
 	int ret = -EINVAL;
 
 	K_SPINLOCK(&timeout_lock) {
-		if (sys_dnode_is_linked(&to->node)) {
+		if (!z_is_inactive_timeout(to)) {
 			remove_timeout(to);
 			ret = 0;
 		}
@@ -158,22 +589,15 @@ int z_abort_timeout(struct _timeout *to)
 /* must be locked */
 static k_ticks_t timeout_rem(const struct _timeout *timeout)
 {
-	k_ticks_t ticks = 0;
-
 	if (z_is_inactive_timeout(timeout)) {
 		return 0;
 	}
 
-	for (struct _timeout *t = first(); t != NULL; t = next(t)) {
-		ticks += t->dticks;
-		if (timeout == t) {
-			break;
-		}
-	}
-
-	return ticks - elapsed();
+	return timeout_ticks(timeout) - elapsed();
 }
 
+#endif /* CONFIG_TIMEOUT_QUEUE_PERCPU */
+
 k_ticks_t z_timeout_remaining(const struct _timeout *timeout)
 {
 	k_ticks_t ticks = 0;
@@ -225,15 +649,10 @@ void sys_clock_announce(int32_t ticks)
 	announce_remaining = ticks;
 
 	struct _timeout *t;
+	int dt;
 
-	for (t = first();
-	     (t != NULL) && (t->dticks <= announce_remaining);
-	     t = first()) {
-		int dt = t->dticks;
-
+	while ((t = pop_expired(announce_remaining, &dt)) != NULL) {
 		curr_tick += dt;
-		t->dticks = 0;
-		remove_timeout(t);
 
 		k_spin_unlock(&timeout_lock, key);
 		t->fn(t);
@@ -241,9 +660,7 @@ void sys_clock_announce(int32_t ticks)
 		announce_remaining -= dt;
 	}
 
-	if (t != NULL) {
-		t->dticks -= announce_remaining;
-	}
+	advance_first(announce_remaining);
 
 	curr_tick += announce_remaining;
 	announce_remaining = 0;
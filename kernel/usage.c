@@ -71,8 +71,112 @@ static void sched_thread_update_usage(struct k_thread *thread, uint32_t cycles)
 #endif
 }
 
+#ifdef CONFIG_SCHED_LATENCY_STATS
+#define NUM_PRIOS (K_LOWEST_THREAD_PRIO - K_HIGHEST_THREAD_PRIO + 1)
+
+static struct k_sched_latency_stats prio_latency[NUM_PRIOS];
+
+static void sched_latency_add(struct k_sched_latency_stats *stats,
+			      uint32_t cycles)
+{
+	unsigned int bucket = find_msb_set(cycles);
+
+	bucket = (bucket > 1U) ? bucket - 1U : 0U;
+	bucket = MIN(bucket, CONFIG_SCHED_LATENCY_STATS_BUCKETS - 1);
+
+	stats->buckets[bucket]++;
+	stats->count++;
+	stats->total += cycles;
+	if (stats->max < cycles) {
+		stats->max = cycles;
+	}
+}
+
+void z_sched_latency_ready(struct k_thread *thread)
+{
+	thread->base.ready_since = usage_now();
+}
+
+/* Called with the usage lock held when @a thread is switched in */
+static void sched_latency_update(struct k_thread *thread)
+{
+	uint32_t since = thread->base.ready_since;
+	uint32_t cycles;
+	int prio;
+
+	if (since == 0) {
+		/* Preempted rather than woken up */
+		return;
+	}
+
+	cycles = usage_now() - since;
+	thread->base.ready_since = 0;
+
+	sched_latency_add(&thread->base.latency, cycles);
+	sched_latency_add(&_current_cpu->latency, cycles);
+
+	prio = thread->base.prio - K_HIGHEST_THREAD_PRIO;
+	if ((prio >= 0) && (prio < NUM_PRIOS)) {
+		sched_latency_add(&prio_latency[prio], cycles);
+	}
+}
+
+int k_sched_latency_prio_get(int prio, struct k_sched_latency_stats *stats)
+{
+	k_spinlock_key_t  key;
+
+	CHECKIF((stats == NULL) || (prio < K_HIGHEST_THREAD_PRIO) ||
+		(prio > K_LOWEST_THREAD_PRIO)) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&usage_lock);
+	*stats = prio_latency[prio - K_HIGHEST_THREAD_PRIO];
+	k_spin_unlock(&usage_lock, key);
+
+	return 0;
+}
+
+int k_sched_latency_cpu_get(unsigned int cpu, struct k_sched_latency_stats *stats)
+{
+	k_spinlock_key_t  key;
+
+	CHECKIF((stats == NULL) || (cpu >= arch_num_cpus())) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&usage_lock);
+	*stats = _kernel.cpus[cpu].latency;
+	k_spin_unlock(&usage_lock, key);
+
+	return 0;
+}
+
+void k_sched_latency_reset(void)
+{
+	k_spinlock_key_t  key;
+	unsigned int num_cpus = arch_num_cpus();
+
+	key = k_spin_lock(&usage_lock);
+
+	memset(prio_latency, 0, sizeof(prio_latency));
+	for (uint8_t i = 0; i < num_cpus; i++) {
+		_kernel.cpus[i].latency = (struct k_sched_latency_stats) {};
+	}
+
+	k_spin_unlock(&usage_lock, key);
+}
+#endif
+
 void z_sched_usage_start(struct k_thread *thread)
 {
+#ifdef CONFIG_SCHED_LATENCY_STATS
+	k_spinlock_key_t  latency_key = k_spin_lock(&usage_lock);
+
+	sched_latency_update(thread);
+	k_spin_unlock(&usage_lock, latency_key);
+#endif
+
 #ifdef CONFIG_SCHED_THREAD_USAGE_ANALYSIS
 	k_spinlock_key_t  key;
 
@@ -104,6 +208,15 @@ void z_sched_usage_stop(void)
 
 	uint32_t u0 = cpu->usage0;
 
+#ifdef CONFIG_SCHED_LATENCY_STATS
+	/* Forget any wake-up that happened before the thread got to
+	 * switch out, it won't wait to run.
+	 */
+	if (cpu->current != NULL) {
+		cpu->current->base.ready_since = 0;
+	}
+#endif
+
 	if (u0 != 0) {
 		uint32_t cycles = usage_now() - u0;
 
@@ -164,6 +277,10 @@ void z_sched_cpu_usage(uint8_t cpu_id, struct k_thread_runtime_stats *stats)
 	stats->idle_cycles =
 		_kernel.cpus[cpu_id].idle_thread->base.usage.total;
 
+#ifdef CONFIG_SCHED_LATENCY_STATS
+	stats->latency = _kernel.cpus[cpu_id].latency;
+#endif
+
 	stats->execution_cycles = stats->total_cycles + stats->idle_cycles;
 
 	k_spin_unlock(&usage_lock, key);
@@ -222,6 +339,10 @@ void z_sched_thread_usage(struct k_thread *thread,
 #endif
 	stats->execution_cycles = thread->base.usage.total;
 
+#ifdef CONFIG_SCHED_LATENCY_STATS
+	stats->latency = thread->base.latency;
+#endif
+
 	k_spin_unlock(&usage_lock, key);
 }
 
@@ -383,6 +504,9 @@ int z_thread_stats_reset(struct k_obj_core *obj_core)
 	stats->longest = 0ULL;
 	stats->num_windows = (thread->base.usage.track_usage) ?  1U : 0U;
 #endif
+#ifdef CONFIG_SCHED_LATENCY_STATS
+	thread->base.latency = (struct k_sched_latency_stats) {};
+#endif
 
 	if (thread != _current_cpu->current) {
 
@@ -76,6 +76,54 @@ static inline void init_flusher(struct z_work_flusher *flusher)
 /* List of pending cancellations. */
 static sys_slist_t pending_cancels;
 
+#ifdef CONFIG_WORKQUEUE_POOL
+/* Flushes of work items on queues with more than one thread.
+ *
+ * A flusher item queued behind the work item can't tell when the work
+ * item completes, as another thread may pick it up first.  Instead a
+ * record is kept for the work item itself, as is done for
+ * cancellations.  It stays in queued_flushes until a queue thread takes
+ * the work item from the queue, and in running_flushes until that
+ * thread is done with it.
+ */
+static sys_slist_t queued_flushes;
+static sys_slist_t running_flushes;
+
+static inline bool queue_is_pool(const struct k_work_q *queue)
+{
+	return queue->num_threads > 1U;
+}
+
+/* Move the flush records for a work item to another list, or release
+ * the waiting threads if there is no other list.
+ *
+ * Invoked with work lock held.
+ *
+ * @param from the list the records are on
+ * @param to the list the records should be moved to, or NULL
+ * @param work the work item the flush records refer to
+ */
+static void move_flushes_locked(sys_slist_t *from, sys_slist_t *to,
+				struct k_work *work)
+{
+	struct z_work_canceller *wc, *tmp;
+	sys_snode_t *prev = NULL;
+
+	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(from, wc, tmp, node) {
+		if (wc->work == work) {
+			sys_slist_remove(from, prev, &wc->node);
+			if (to != NULL) {
+				sys_slist_append(to, &wc->node);
+			} else {
+				k_sem_give(&wc->sem);
+			}
+		} else {
+			prev = &wc->node;
+		}
+	}
+}
+#endif /* CONFIG_WORKQUEUE_POOL */
+
 /* Initialize a canceler record and add it to the list of pending
  * cancels.
  *
@@ -220,9 +268,85 @@ static inline void queue_remove_locked(struct k_work_q *queue,
 {
 	if (flag_test_and_clear(&work->flags, K_WORK_QUEUED_BIT)) {
 		(void)sys_slist_find_and_remove(&queue->pending, &work->node);
+
+#ifdef CONFIG_WORKQUEUE_POOL
+		/* Flushes of the removed submission complete with the
+		 * invocation that is running, if any.
+		 */
+		if (queue_is_pool(queue)) {
+			move_flushes_locked(&queued_flushes,
+					    flag_test(&work->flags,
+						      K_WORK_RUNNING_BIT)
+					    ? &running_flushes : NULL,
+					    work);
+		}
+#endif
 	}
 }
 
+/* Take the next work item that can be processed from a queue.
+ *
+ * On a queue with several threads items that are still running on
+ * another thread are skipped, so handlers aren't re-entered.
+ *
+ * Invoked with work lock held.
+ *
+ * @param queue the queue to take work from
+ *
+ * @return the node of the work item, or NULL if there is none.
+ */
+static inline sys_snode_t *queue_take_locked(struct k_work_q *queue)
+{
+#ifdef CONFIG_WORKQUEUE_POOL
+	if (queue_is_pool(queue)) {
+		struct k_work *work;
+		sys_snode_t *prev = NULL;
+
+		SYS_SLIST_FOR_EACH_CONTAINER(&queue->pending, work, node) {
+			if (!flag_test(&work->flags, K_WORK_RUNNING_BIT)) {
+				sys_slist_remove(&queue->pending, prev,
+						 &work->node);
+				move_flushes_locked(&queued_flushes,
+						    &running_flushes, work);
+				return &work->node;
+			}
+			prev = &work->node;
+		}
+
+		return NULL;
+	}
+#endif
+
+	return sys_slist_get(&queue->pending);
+}
+
+/* Check whether the current thread animates a queue.
+ *
+ * @param queue the queue to check
+ *
+ * @return true if and only if invoked from one of the queue's threads.
+ */
+static inline bool queue_thread_is_current(const struct k_work_q *queue)
+{
+	if (k_is_in_isr()) {
+		return false;
+	}
+
+	if (_current == &queue->thread) {
+		return true;
+	}
+
+#ifdef CONFIG_WORKQUEUE_POOL
+	for (size_t i = 1; i < queue->num_threads; i++) {
+		if (_current == &queue->threads[i - 1]) {
+			return true;
+		}
+	}
+#endif
+
+	return false;
+}
+
 /* Potentially notify a queue that it needs to look for pending work.
  *
  * This may make the work queue thread ready, but as the lock is held it
@@ -272,7 +396,7 @@ static inline int queue_submit_locked(struct k_work_q *queue,
 	}
 
 	int ret = -EBUSY;
-	bool chained = (_current == &queue->thread) && !k_is_in_isr();
+	bool chained = queue_thread_is_current(queue);
 	bool draining = flag_test(&queue->flags, K_WORK_QUEUE_DRAIN_BIT);
 	bool plugged = flag_test(&queue->flags, K_WORK_QUEUE_PLUGGED_BIT);
 
@@ -437,29 +561,43 @@ int k_work_submit(struct k_work *work)
  * Sleeps.
  *
  * @param work the work item that is to be flushed
- * @param flusher state used to synchronize the flush
+ * @param sync state used to synchronize the flush
  *
- * @retval true if work is queued or running.  If this happens the
- * caller must take the flusher semaphore after releasing the lock.
- *
- * @retval false otherwise.  No wait required.
+ * @return the semaphore the caller must take after releasing the lock
+ * if work is queued or running, NULL otherwise.  No wait required.
  */
-static bool work_flush_locked(struct k_work *work,
-			      struct z_work_flusher *flusher)
+static struct k_sem *work_flush_locked(struct k_work *work,
+				       struct k_work_sync *sync)
 {
 	bool need_flush = (flags_get(&work->flags)
 			   & (K_WORK_QUEUED | K_WORK_RUNNING)) != 0U;
 
-	if (need_flush) {
-		struct k_work_q *queue = work->queue;
+	if (!need_flush) {
+		return NULL;
+	}
 
-		__ASSERT_NO_MSG(queue != NULL);
+	struct k_work_q *queue = work->queue;
 
-		queue_flusher_locked(queue, work, flusher);
-		notify_queue_locked(queue);
+	__ASSERT_NO_MSG(queue != NULL);
+
+#ifdef CONFIG_WORKQUEUE_POOL
+	if (queue_is_pool(queue)) {
+		struct z_work_canceller *record = &sync->canceller;
+
+		k_sem_init(&record->sem, 0, 1);
+		record->work = work;
+		sys_slist_append(flag_test(&work->flags, K_WORK_QUEUED_BIT)
+				 ? &queued_flushes : &running_flushes,
+				 &record->node);
+
+		return &record->sem;
 	}
+#endif
 
-	return need_flush;
+	queue_flusher_locked(queue, work, &sync->flusher);
+	notify_queue_locked(queue);
+
+	return &sync->flusher.sem;
 }
 
 bool k_work_flush(struct k_work *work,
@@ -475,10 +613,10 @@ bool k_work_flush(struct k_work *work,
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_work, flush, work);
 
-	struct z_work_flusher *flusher = &sync->flusher;
 	k_spinlock_key_t key = k_spin_lock(&lock);
 
-	bool need_flush = work_flush_locked(work, flusher);
+	struct k_sem *flush_sem = work_flush_locked(work, sync);
+	bool need_flush = (flush_sem != NULL);
 
 	k_spin_unlock(&lock, key);
 
@@ -486,7 +624,7 @@ bool k_work_flush(struct k_work *work,
 	if (need_flush) {
 		SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_work, flush, work, K_FOREVER);
 
-		k_sem_take(&flusher->sem, K_FOREVER);
+		k_sem_take(flush_sem, K_FOREVER);
 	}
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_work, flush, work, need_flush);
@@ -628,12 +766,15 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 		bool yield;
 
 		/* Check for and prepare any new work. */
-		node = sys_slist_get(&queue->pending);
+		node = queue_take_locked(queue);
 		if (node != NULL) {
 			/* Mark that there's some work active that's
 			 * not on the pending list.
 			 */
 			flag_set(&queue->flags, K_WORK_QUEUE_BUSY_BIT);
+#ifdef CONFIG_WORKQUEUE_POOL
+			queue->busy++;
+#endif
 			work = CONTAINER_OF(node, struct k_work, node);
 			flag_set(&work->flags, K_WORK_RUNNING_BIT);
 			flag_clear(&work->flags, K_WORK_QUEUED_BIT);
@@ -651,8 +792,9 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 			 * This means that if node is not NULL, then work will not be NULL.
 			 */
 			handler = work->handler;
-		} else if (flag_test_and_clear(&queue->flags,
-					       K_WORK_QUEUE_DRAIN_BIT)) {
+		} else if (!flag_test(&queue->flags, K_WORK_QUEUE_BUSY_BIT)
+			   && flag_test_and_clear(&queue->flags,
+						  K_WORK_QUEUE_DRAIN_BIT)) {
 			/* Not busy and draining: move threads waiting for
 			 * drain to ready state.  The held spinlock inhibits
 			 * immediate reschedule; released threads get their
@@ -661,6 +803,9 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 			 * We don't touch K_WORK_QUEUE_PLUGGABLE, so getting
 			 * here doesn't mean that the queue will allow new
 			 * submissions.
+			 *
+			 * Other threads of a pool may still be busy, in which
+			 * case the last one to finish gets here.
 			 */
 			(void)z_sched_wake_all(&queue->drainq, 1, NULL);
 		} else {
@@ -702,7 +847,15 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 			finalize_cancel_locked(work);
 		}
 
+#ifdef CONFIG_WORKQUEUE_POOL
+		move_flushes_locked(&running_flushes, NULL, work);
+
+		if (--queue->busy == 0U) {
+			flag_clear(&queue->flags, K_WORK_QUEUE_BUSY_BIT);
+		}
+#else
 		flag_clear(&queue->flags, K_WORK_QUEUE_BUSY_BIT);
+#endif
 		yield = !flag_test(&queue->flags, K_WORK_QUEUE_NO_YIELD_BIT);
 		k_spin_unlock(&lock, key);
 
@@ -726,19 +879,16 @@ void k_work_queue_init(struct k_work_q *queue)
 	SYS_PORT_TRACING_OBJ_INIT(k_work_queue, queue);
 }
 
-void k_work_queue_start(struct k_work_q *queue,
-			k_thread_stack_t *stack,
-			size_t stack_size,
-			int prio,
-			const struct k_work_queue_config *cfg)
+/* Initialize the state of a work queue that is being started.
+ *
+ * @param queue the queue to initialize
+ * @param cfg optional configuration of the queue
+ */
+static void work_queue_setup(struct k_work_q *queue,
+			     const struct k_work_queue_config *cfg)
 {
-	__ASSERT_NO_MSG(queue);
-	__ASSERT_NO_MSG(stack);
-	__ASSERT_NO_MSG(!flag_test(&queue->flags, K_WORK_QUEUE_STARTED_BIT));
 	uint32_t flags = K_WORK_QUEUE_STARTED;
 
-	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_work_queue, start, queue);
-
 	sys_slist_init(&queue->pending);
 	z_waitq_init(&queue->notifyq);
 	z_waitq_init(&queue->drainq);
@@ -752,19 +902,95 @@ void k_work_queue_start(struct k_work_q *queue,
 	 * to roll.
 	 */
 	flags_set(&queue->flags, flags);
+}
 
-	(void)k_thread_create(&queue->thread, stack, stack_size,
+/* Create and start a thread animating a work queue.
+ *
+ * @param queue the queue the thread takes work from
+ * @param thread the thread to start
+ * @param stack the stack of the thread
+ * @param stack_size the size of @p stack
+ * @param prio the priority of the thread
+ * @param cfg optional configuration of the queue
+ */
+static void work_queue_thread_start(struct k_work_q *queue,
+				    struct k_thread *thread,
+				    k_thread_stack_t *stack,
+				    size_t stack_size,
+				    int prio,
+				    const struct k_work_queue_config *cfg)
+{
+	(void)k_thread_create(thread, stack, stack_size,
 			      work_queue_main, queue, NULL, NULL,
 			      prio, 0, K_FOREVER);
 
 	if ((cfg != NULL) && (cfg->name != NULL)) {
-		k_thread_name_set(&queue->thread, cfg->name);
+		k_thread_name_set(thread, cfg->name);
 	}
 
-	k_thread_start(&queue->thread);
+	k_thread_start(thread);
+}
+
+void k_work_queue_start(struct k_work_q *queue,
+			k_thread_stack_t *stack,
+			size_t stack_size,
+			int prio,
+			const struct k_work_queue_config *cfg)
+{
+	__ASSERT_NO_MSG(queue);
+	__ASSERT_NO_MSG(stack);
+	__ASSERT_NO_MSG(!flag_test(&queue->flags, K_WORK_QUEUE_STARTED_BIT));
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_work_queue, start, queue);
+
+	work_queue_setup(queue, cfg);
+
+#ifdef CONFIG_WORKQUEUE_POOL
+	queue->threads = NULL;
+	queue->num_threads = 1U;
+	queue->busy = 0U;
+#endif
+
+	work_queue_thread_start(queue, &queue->thread, stack, stack_size,
+				prio, cfg);
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_work_queue, start, queue);
+}
+
+#ifdef CONFIG_WORKQUEUE_POOL
+void k_work_queue_pool_start(struct k_work_q *queue,
+			     struct k_thread *threads,
+			     k_thread_stack_t *stacks, size_t stack_size,
+			     size_t num_threads, int prio,
+			     const struct k_work_queue_config *cfg)
+{
+	__ASSERT_NO_MSG(queue);
+	__ASSERT_NO_MSG(stacks);
+	__ASSERT_NO_MSG((num_threads > 0U) && (num_threads <= UINT16_MAX));
+	__ASSERT_NO_MSG((threads != NULL) || (num_threads == 1U));
+	__ASSERT_NO_MSG(!flag_test(&queue->flags, K_WORK_QUEUE_STARTED_BIT));
+
+	/* Same layout as used by K_THREAD_STACK_ARRAY_DEFINE() */
+	size_t stride = K_THREAD_STACK_LEN(stack_size);
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_work_queue, start, queue);
+
+	work_queue_setup(queue, cfg);
+	queue->threads = threads;
+	queue->num_threads = (uint16_t)num_threads;
+	queue->busy = 0U;
+
+	for (size_t i = 0; i < num_threads; i++) {
+		struct k_thread *thread = (i == 0U) ? &queue->thread
+						    : &threads[i - 1U];
+
+		work_queue_thread_start(queue, thread, &stacks[stride * i],
+					stack_size, prio, cfg);
+	}
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_work_queue, start, queue);
 }
+#endif /* CONFIG_WORKQUEUE_POOL */
 
 int k_work_queue_drain(struct k_work_q *queue,
 		       bool plug)
@@ -1103,7 +1329,6 @@ bool k_work_flush_delayable(struct k_work_delayable *dwork,
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_work, flush_delayable, dwork, sync);
 
 	struct k_work *work = &dwork->work;
-	struct z_work_flusher *flusher = &sync->flusher;
 	k_spinlock_key_t key = k_spin_lock(&lock);
 
 	/* If it's idle release the lock and return immediately. */
@@ -1125,13 +1350,14 @@ bool k_work_flush_delayable(struct k_work_delayable *dwork,
 	}
 
 	/* Wait for it to finish */
-	bool need_flush = work_flush_locked(work, flusher);
+	struct k_sem *flush_sem = work_flush_locked(work, sync);
+	bool need_flush = (flush_sem != NULL);
 
 	k_spin_unlock(&lock, key);
 
 	/* If necessary wait until the flusher item completes */
 	if (need_flush) {
-		k_sem_take(&flusher->sem, K_FOREVER);
+		k_sem_take(flush_sem, K_FOREVER);
 	}
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_work, flush_delayable, dwork, sync, need_flush);
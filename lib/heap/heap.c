@@ -6,6 +6,7 @@
 #include <zephyr/sys/sys_heap.h>
 #include <zephyr/sys/util.h>
 #include <zephyr/sys/heap_listener.h>
+#include <zephyr/sys/heap_profile.h>
 #include <zephyr/kernel.h>
 #include <string.h>
 #include "heap.h"
@@ -21,6 +22,31 @@ static inline void increase_allocated_bytes(struct z_heap *h, size_t num_bytes)
 }
 #endif
 
+#ifdef CONFIG_SYS_HEAP_PROFILE
+/* The site passed down by a wrapper such as k_heap, if any, otherwise
+ * the caller of the public sys_heap function using this
+ */
+#define HEAP_SITE(heap) \
+	(((heap)->site != NULL) ? (heap)->site : __builtin_return_address(0))
+
+static inline void profile_alloc(struct sys_heap *heap, void *mem,
+				 size_t bytes, void *site)
+{
+	if (heap->profile != NULL) {
+		z_heap_profile_alloc(heap->profile, mem, bytes, site);
+	}
+}
+
+static inline void profile_free(struct sys_heap *heap, void *mem)
+{
+	if (heap->profile != NULL) {
+		z_heap_profile_free(heap->profile, mem);
+	}
+}
+#else
+#define HEAP_SITE(heap) NULL
+#endif
+
 static void *chunk_mem(struct z_heap *h, chunkid_t c)
 {
 	chunk_unit_t *buf = chunk_buf(h);
@@ -37,11 +63,11 @@ static void free_list_remove_bidx(struct z_heap *h, chunkid_t c, int bidx)
 
 	CHECK(!chunk_used(h, c));
 	CHECK(b->next != 0);
-	CHECK(h->avail_buckets & BIT(bidx));
+	CHECK(bucket_avail(h, bidx));
 
 	if (next_free_chunk(h, c) == c) {
 		/* this is the last chunk */
-		h->avail_buckets &= ~BIT(bidx);
+		set_bucket_avail(h, bidx, false);
 		b->next = 0;
 	} else {
 		chunkid_t first = prev_free_chunk(h, c),
@@ -70,15 +96,15 @@ static void free_list_add_bidx(struct z_heap *h, chunkid_t c, int bidx)
 	struct z_heap_bucket *b = &h->buckets[bidx];
 
 	if (b->next == 0U) {
-		CHECK((h->avail_buckets & BIT(bidx)) == 0);
+		CHECK(!bucket_avail(h, bidx));
 
 		/* Empty list, first item */
-		h->avail_buckets |= BIT(bidx);
+		set_bucket_avail(h, bidx, true);
 		b->next = c;
 		set_prev_free_chunk(h, c, c);
 		set_next_free_chunk(h, c, c);
 	} else {
-		CHECK(h->avail_buckets & BIT(bidx));
+		CHECK(bucket_avail(h, bidx));
 
 		/* Insert before (!) the "next" pointer */
 		chunkid_t second = b->next;
@@ -189,6 +215,10 @@ void sys_heap_free(struct sys_heap *heap, void *mem)
 	h->allocated_bytes -= chunksz_to_bytes(h, chunk_size(h, c));
 #endif
 
+#ifdef CONFIG_SYS_HEAP_PROFILE
+	profile_free(heap, mem);
+#endif
+
 #ifdef CONFIG_SYS_HEAP_LISTENER
 	heap_listener_notify_free(HEAP_ID_FROM_POINTER(heap), mem,
 				  chunksz_to_bytes(h, chunk_size(h, c)));
@@ -208,6 +238,63 @@ size_t sys_heap_usable_size(struct sys_heap *heap, void *mem)
 	return chunk_sz - (addr - chunk_base);
 }
 
+#ifdef CONFIG_SYS_HEAP_TLSF
+
+/* Good fit in constant time: every chunk in the first bucket whose
+ * minimum size is at least "sz" fits, so the first non-empty bucket
+ * from there is found with two bitmap scans and its first chunk taken
+ * without looking at any other.
+ */
+static chunkid_t alloc_chunk(struct z_heap *h, chunksz_t sz)
+{
+	int nb_buckets = bucket_idx(h, h->end_chunk) + 1;
+	int sl_bits = tlsf_sl_bits(h);
+	int bi = bucket_idx(h, sz);
+	int bmin = (bucket_min_chunksz(h, bi) == sz) ? bi : bi + 1;
+
+	CHECK(bi < nb_buckets);
+
+	if (bmin < nb_buckets) {
+		int fl = bmin >> sl_bits;
+		uint32_t slmap = sl_avail_bits(h, fl) &
+				 ~BIT_MASK(bmin & (BIT(sl_bits) - 1));
+
+		if (slmap == 0U) {
+			uint32_t flmap = h->avail_buckets & ~BIT_MASK(fl + 1);
+
+			if (flmap != 0U) {
+				fl = __builtin_ctz(flmap);
+				slmap = sl_avail_bits(h, fl);
+			}
+		}
+
+		if (slmap != 0U) {
+			int b = (fl << sl_bits) + __builtin_ctz(slmap);
+			chunkid_t c = h->buckets[b].next;
+
+			free_list_remove_bidx(h, c, b);
+			CHECK(chunk_size(h, c) >= sz);
+			return c;
+		}
+	}
+
+	/* Nothing guaranteed to fit: the first chunk of the request's own
+	 * bucket still might.
+	 */
+	if (bmin != bi && bucket_avail(h, bi)) {
+		chunkid_t c = h->buckets[bi].next;
+
+		if (chunk_size(h, c) >= sz) {
+			free_list_remove_bidx(h, c, bi);
+			return c;
+		}
+	}
+
+	return 0;
+}
+
+#else
+
 static chunkid_t alloc_chunk(struct z_heap *h, chunksz_t sz)
 {
 	int bi = bucket_idx(h, sz);
@@ -260,7 +347,10 @@ static chunkid_t alloc_chunk(struct z_heap *h, chunksz_t sz)
 	return 0;
 }
 
-void *sys_heap_alloc(struct sys_heap *heap, size_t bytes)
+#endif /* CONFIG_SYS_HEAP_TLSF */
+
+static inline void *heap_alloc(struct sys_heap *heap, size_t bytes,
+			       void *site)
 {
 	struct z_heap *h = heap->heap;
 	void *mem;
@@ -294,11 +384,21 @@ void *sys_heap_alloc(struct sys_heap *heap, size_t bytes)
 				   chunksz_to_bytes(h, chunk_size(h, c)));
 #endif
 
+#ifdef CONFIG_SYS_HEAP_PROFILE
+	profile_alloc(heap, mem, bytes, site);
+#endif
+
 	IF_ENABLED(CONFIG_MSAN, (__msan_allocated_memory(mem, bytes)));
 	return mem;
 }
 
-void *sys_heap_aligned_alloc(struct sys_heap *heap, size_t align, size_t bytes)
+void *sys_heap_alloc(struct sys_heap *heap, size_t bytes)
+{
+	return heap_alloc(heap, bytes, HEAP_SITE(heap));
+}
+
+static void *heap_aligned_alloc(struct sys_heap *heap, size_t align,
+				size_t bytes, void *site)
 {
 	struct z_heap *h = heap->heap;
 	size_t gap, rew;
@@ -316,7 +416,7 @@ void *sys_heap_aligned_alloc(struct sys_heap *heap, size_t align, size_t bytes)
 		gap = MIN(rew, chunk_header_bytes(h));
 	} else {
 		if (align <= chunk_header_bytes(h)) {
-			return sys_heap_alloc(heap, bytes);
+			return heap_alloc(heap, bytes, site);
 		}
 		rew = 0;
 		gap = chunk_header_bytes(h);
@@ -372,18 +472,28 @@ void *sys_heap_aligned_alloc(struct sys_heap *heap, size_t align, size_t bytes)
 				   chunksz_to_bytes(h, chunk_size(h, c)));
 #endif
 
+#ifdef CONFIG_SYS_HEAP_PROFILE
+	profile_alloc(heap, mem, bytes, site);
+#endif
+
 	IF_ENABLED(CONFIG_MSAN, (__msan_allocated_memory(mem, bytes)));
 	return mem;
 }
 
+void *sys_heap_aligned_alloc(struct sys_heap *heap, size_t align, size_t bytes)
+{
+	return heap_aligned_alloc(heap, align, bytes, HEAP_SITE(heap));
+}
+
 void *sys_heap_aligned_realloc(struct sys_heap *heap, void *ptr,
 			       size_t align, size_t bytes)
 {
 	struct z_heap *h = heap->heap;
+	void *site = HEAP_SITE(heap);
 
 	/* special realloc semantics */
 	if (ptr == NULL) {
-		return sys_heap_aligned_alloc(heap, align, bytes);
+		return heap_aligned_alloc(heap, align, bytes, site);
 	}
 	if (bytes == 0) {
 		sys_heap_free(heap, ptr);
@@ -428,6 +538,11 @@ void *sys_heap_aligned_realloc(struct sys_heap *heap, void *ptr,
 					  bytes_freed);
 #endif
 
+#ifdef CONFIG_SYS_HEAP_PROFILE
+		profile_free(heap, ptr);
+		profile_alloc(heap, ptr, bytes, site);
+#endif
+
 		return ptr;
 	} else if (!chunk_used(h, rc) &&
 		   (chunk_size(h, c) + chunk_size(h, rc) >= chunks_need)) {
@@ -459,6 +574,11 @@ void *sys_heap_aligned_realloc(struct sys_heap *heap, void *ptr,
 					  bytes_freed);
 #endif
 
+#ifdef CONFIG_SYS_HEAP_PROFILE
+		profile_free(heap, ptr);
+		profile_alloc(heap, ptr, bytes, site);
+#endif
+
 		return ptr;
 	} else {
 		;
@@ -471,7 +591,7 @@ void *sys_heap_aligned_realloc(struct sys_heap *heap, void *ptr,
 	 * The calls to allocation and free functions generate
 	 * notification already, so there is no need to those here.
 	 */
-	void *ptr2 = sys_heap_aligned_alloc(heap, align, bytes);
+	void *ptr2 = heap_aligned_alloc(heap, align, bytes, site);
 
 	if (ptr2 != NULL) {
 		size_t prev_size = chunksz_to_bytes(h, chunk_size(h, c)) - align_gap;
@@ -484,6 +604,11 @@ void *sys_heap_aligned_realloc(struct sys_heap *heap, void *ptr,
 
 void sys_heap_init(struct sys_heap *heap, void *mem, size_t bytes)
 {
+#ifdef CONFIG_SYS_HEAP_PROFILE
+	heap->profile = NULL;
+	heap->site = NULL;
+#endif
+
 	IF_ENABLED(CONFIG_MSAN, (__sanitizer_dtor_callback(mem, bytes)));
 
 	if (IS_ENABLED(CONFIG_SYS_HEAP_SMALL_ONLY)) {
@@ -518,8 +643,14 @@ void sys_heap_init(struct sys_heap *heap, void *mem, size_t bytes)
 #endif
 
 	int nb_buckets = bucket_idx(h, heap_sz) + 1;
-	chunksz_t chunk0_size = chunksz(sizeof(struct z_heap) +
-				     nb_buckets * sizeof(struct z_heap_bucket));
+	size_t meta_bytes = sizeof(struct z_heap) +
+			    nb_buckets * sizeof(struct z_heap_bucket);
+
+#ifdef CONFIG_SYS_HEAP_TLSF
+	meta_bytes += nb_sl_avail(nb_buckets) * sizeof(uint32_t);
+#endif
+
+	chunksz_t chunk0_size = chunksz(meta_bytes);
 
 	__ASSERT(chunk0_size + min_chunk_size(h) <= heap_sz, "heap size is too small");
 
@@ -527,6 +658,12 @@ void sys_heap_init(struct sys_heap *heap, void *mem, size_t bytes)
 		h->buckets[i].next = 0;
 	}
 
+#ifdef CONFIG_SYS_HEAP_TLSF
+	for (int i = 0; i < nb_sl_avail(nb_buckets); i++) {
+		sl_avail(h)[i] = 0U;
+	}
+#endif
+
 	/* chunk containing our struct z_heap */
 	set_chunk_size(h, 0, chunk0_size);
 	set_left_chunk_size(h, 0, 0);
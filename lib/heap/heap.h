@@ -41,7 +41,9 @@
  *   FREE_NEXT: Chunk ID of the next node in a free list.
  *
  * The free lists are circular lists, one for each power-of-two size
- * category.  The free list pointers exist only for free chunks,
+ * category, or with CONFIG_SYS_HEAP_TLSF one for each of up to
+ * 2^CONFIG_SYS_HEAP_TLSF_SL_BITS linear subdivisions of those
+ * categories.  The free list pointers exist only for free chunks,
  * obviously.  This memory is part of the user's buffer when
  * allocated.
  *
@@ -247,12 +249,125 @@ static inline size_t chunksz_to_bytes(struct z_heap *h, chunksz_t chunksz_in)
 	return chunksz_in * CHUNK_UNIT - chunk_header_bytes(h);
 }
 
+#ifdef CONFIG_SYS_HEAP_TLSF
+
+/* Two-level segregated fit: the first level is the power-of-two
+ * category of the size, the second level its next bits below the top
+ * one, tlsf_sl_bits() of them.  Sizes under 2^tlsf_sl_bits() units get
+ * a list each.  The resulting index is monotonic in the size.
+ *
+ * Small heaps get fewer second level bits, so that the free lists
+ * never take more than about 3% of the heap.
+ */
+static inline int tlsf_sl_bits(struct z_heap *h)
+{
+	int heap_log2 = 31 - __builtin_clz(h->end_chunk);
+
+	return CLAMP(heap_log2 - 7, 0, CONFIG_SYS_HEAP_TLSF_SL_BITS);
+}
+
+static inline int bucket_idx(struct z_heap *h, chunksz_t sz)
+{
+	unsigned int usable_sz = sz - min_chunk_size(h) + 1;
+	int sl_bits = tlsf_sl_bits(h);
+	int fl;
+
+	if (usable_sz < BIT(sl_bits)) {
+		return usable_sz;
+	}
+	fl = 31 - __builtin_clz(usable_sz) - sl_bits;
+
+	return (fl << sl_bits) + (usable_sz >> fl);
+}
+
+/* Smallest chunk size going into bucket "bidx" */
+static inline chunksz_t bucket_min_chunksz(struct z_heap *h, int bidx)
+{
+	int sl_bits = tlsf_sl_bits(h);
+	unsigned int usable_sz = bidx;
+
+	if (bidx >= BIT(sl_bits)) {
+		usable_sz = (BIT(sl_bits) + (bidx & (BIT(sl_bits) - 1)))
+			    << ((bidx >> sl_bits) - 1);
+	}
+
+	return usable_sz - 1 + min_chunk_size(h);
+}
+
+/* The second level bitmap, one bit per bucket, follows the bucket
+ * array.  The buckets of a first level never straddle a word.  The
+ * first level bitmap is avail_buckets.
+ */
+static inline uint32_t *sl_avail(struct z_heap *h)
+{
+	return (uint32_t *)&h->buckets[bucket_idx(h, h->end_chunk) + 1];
+}
+
+static inline int nb_sl_avail(int nb_buckets)
+{
+	return (nb_buckets + 31) / 32;
+}
+
+/* The second level bitmap of first level "fl" */
+static inline uint32_t sl_avail_bits(struct z_heap *h, int fl)
+{
+	int sl_bits = tlsf_sl_bits(h);
+	int bidx = fl << sl_bits;
+
+	return (sl_avail(h)[bidx / 32] >> (bidx % 32)) &
+	       (UINT32_MAX >> (32 - BIT(sl_bits)));
+}
+
+static inline bool bucket_avail(struct z_heap *h, int bidx)
+{
+	return (sl_avail(h)[bidx / 32] & BIT(bidx % 32)) != 0U;
+}
+
+static inline void set_bucket_avail(struct z_heap *h, int bidx, bool avail)
+{
+	int fl = bidx >> tlsf_sl_bits(h);
+
+	if (avail) {
+		sl_avail(h)[bidx / 32] |= BIT(bidx % 32);
+		h->avail_buckets |= BIT(fl);
+	} else {
+		sl_avail(h)[bidx / 32] &= ~BIT(bidx % 32);
+		if (sl_avail_bits(h, fl) == 0U) {
+			h->avail_buckets &= ~BIT(fl);
+		}
+	}
+}
+
+#else
+
 static inline int bucket_idx(struct z_heap *h, chunksz_t sz)
 {
 	unsigned int usable_sz = sz - min_chunk_size(h) + 1;
 	return 31 - __builtin_clz(usable_sz);
 }
 
+/* Smallest chunk size going into bucket "bidx" */
+static inline chunksz_t bucket_min_chunksz(struct z_heap *h, int bidx)
+{
+	return (1U << bidx) - 1 + min_chunk_size(h);
+}
+
+static inline bool bucket_avail(struct z_heap *h, int bidx)
+{
+	return (h->avail_buckets & BIT(bidx)) != 0U;
+}
+
+static inline void set_bucket_avail(struct z_heap *h, int bidx, bool avail)
+{
+	if (avail) {
+		h->avail_buckets |= BIT(bidx);
+	} else {
+		h->avail_buckets &= ~BIT(bidx);
+	}
+}
+
+#endif /* CONFIG_SYS_HEAP_TLSF */
+
 static inline bool size_too_big(struct z_heap *h, size_t bytes)
 {
 	/*
@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <zephyr/sys/sys_heap.h>
+#include <zephyr/sys/heap_cache.h>
+#include <zephyr/sys/heap_profile.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/kernel.h>
+#include <string.h>
+#include "heap.h"
+
+/* The cache keeps allocated chunks of up to CONFIG_SYS_HEAP_CACHE_CLASSES
+ * chunk units in per-CPU lists, bin N holding chunks of N + 1 units.  The
+ * free memory of a cached block holds the pointer to the next one.  As
+ * far as the heap is concerned these chunks remain in use, so their
+ * headers never change while cached and can be read without the heap
+ * lock.  The heap profiler sees blocks going into the cache as freed and
+ * blocks coming out of it as allocated, as the heap never does.
+ */
+
+/* Lock the cache of the current CPU.  Interrupts are locked first so
+ * that the thread can't migrate between picking the CPU and taking its
+ * lock.
+ */
+static struct z_heap_cache_cpu *cache_cpu_lock(struct sys_heap_cache *cache,
+					       unsigned int *irq_key,
+					       k_spinlock_key_t *key)
+{
+	struct z_heap_cache_cpu *cc;
+
+	*irq_key = arch_irq_lock();
+	cc = &cache->cpus[_current_cpu->id];
+	*key = k_spin_lock(&cc->lock);
+
+	return cc;
+}
+
+static void cache_cpu_unlock(struct z_heap_cache_cpu *cc,
+			     unsigned int irq_key, k_spinlock_key_t key)
+{
+	k_spin_unlock(&cc->lock, key);
+	arch_irq_unlock(irq_key);
+}
+
+void sys_heap_cache_init(struct sys_heap_cache *cache)
+{
+	memset(cache, 0, sizeof(*cache));
+}
+
+void *sys_heap_cache_alloc(struct sys_heap *heap, struct sys_heap_cache *cache,
+			   size_t align, size_t bytes, void *site)
+{
+	struct z_heap *h = heap->heap;
+	struct z_heap_cache_cpu *cc;
+	unsigned int irq_key;
+	k_spinlock_key_t key;
+	void *mem;
+
+	if ((bytes == 0U) ||
+	    (bytes_to_chunksz(h, bytes) > CONFIG_SYS_HEAP_CACHE_CLASSES)) {
+		return NULL;
+	}
+
+	/* Same align and rewind encoding as sys_heap_aligned_alloc() */
+	size_t rew = align & -align;
+
+	if (align != rew) {
+		align -= rew;
+	} else {
+		rew = 0;
+	}
+
+	int bin = bytes_to_chunksz(h, bytes) - 1;
+
+	cc = cache_cpu_lock(cache, &irq_key, &key);
+
+	/* Cached blocks only have the alignment of sys_heap_alloc(), so a
+	 * larger one is only served if the first cached block has it.
+	 */
+	mem = cc->bins[bin];
+	if ((mem != NULL) && (align > 1U) &&
+	    ((((uintptr_t)mem + rew) & (align - 1U)) != 0U)) {
+		mem = NULL;
+	}
+
+	if (mem != NULL) {
+		cc->bins[bin] = *(void **)mem;
+		cc->counts[bin]--;
+		IF_ENABLED(CONFIG_SYS_HEAP_RUNTIME_STATS, (cc->hits++));
+#ifdef CONFIG_SYS_HEAP_PROFILE
+		if (heap->profile != NULL) {
+			z_heap_profile_alloc(heap->profile, mem, bytes,
+					     (site != NULL) ? site : __builtin_return_address(0));
+		}
+#endif
+	} else {
+		IF_ENABLED(CONFIG_SYS_HEAP_RUNTIME_STATS, (cc->misses++));
+	}
+
+	cache_cpu_unlock(cc, irq_key, key);
+
+	return mem;
+}
+
+bool sys_heap_cache_free(struct sys_heap *heap, struct sys_heap_cache *cache,
+			 void *mem)
+{
+	struct z_heap *h = heap->heap;
+	struct z_heap_cache_cpu *cc;
+	unsigned int irq_key;
+	k_spinlock_key_t key;
+	bool kept = false;
+
+	if (mem == NULL) {
+		return false;
+	}
+
+	uint8_t *base = (uint8_t *)chunk_buf(h);
+	chunkid_t c = ((uint8_t *)mem - chunk_header_bytes(h) - base) / CHUNK_UNIT;
+
+	__ASSERT(chunk_used(h, c),
+		 "unexpected heap state (double-free?) for memory at %p", mem);
+
+	/* Blocks from aligned allocations may not start at their chunk */
+	if (((uint8_t *)mem != base + c * CHUNK_UNIT + chunk_header_bytes(h)) ||
+	    (chunk_size(h, c) > CONFIG_SYS_HEAP_CACHE_CLASSES)) {
+		return false;
+	}
+
+	int bin = chunk_size(h, c) - 1;
+
+	cc = cache_cpu_lock(cache, &irq_key, &key);
+
+	/* Checked with the CPU lock held: a hold set before a flush is then
+	 * seen here unless the flush finds the block in the cache.
+	 */
+	if (atomic_get(&cache->hold) == 0) {
+		if (cc->counts[bin] < CONFIG_SYS_HEAP_CACHE_DEPTH) {
+#ifdef CONFIG_SYS_HEAP_PROFILE
+			/* Before the block can be handed out again */
+			if (heap->profile != NULL) {
+				z_heap_profile_free(heap->profile, mem);
+			}
+#endif
+			*(void **)mem = cc->bins[bin];
+			cc->bins[bin] = mem;
+			cc->counts[bin]++;
+			kept = true;
+			IF_ENABLED(CONFIG_SYS_HEAP_RUNTIME_STATS, (cc->frees++));
+		} else {
+			IF_ENABLED(CONFIG_SYS_HEAP_RUNTIME_STATS, (cc->overflows++));
+		}
+	}
+
+	cache_cpu_unlock(cc, irq_key, key);
+
+	return kept;
+}
+
+size_t sys_heap_cache_flush(struct sys_heap *heap, struct sys_heap_cache *cache)
+{
+	size_t count = 0;
+
+	for (unsigned int cpu = 0; cpu < arch_num_cpus(); cpu++) {
+		struct z_heap_cache_cpu *cc = &cache->cpus[cpu];
+
+		for (int bin = 0; bin < CONFIG_SYS_HEAP_CACHE_CLASSES; bin++) {
+			k_spinlock_key_t key = k_spin_lock(&cc->lock);
+			void *mem = cc->bins[bin];
+
+			cc->bins[bin] = NULL;
+			cc->counts[bin] = 0U;
+			k_spin_unlock(&cc->lock, key);
+
+			while (mem != NULL) {
+				void *next = *(void **)mem;
+
+				sys_heap_free(heap, mem);
+				mem = next;
+				count++;
+			}
+		}
+	}
+
+	return count;
+}
@@ -0,0 +1,244 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <zephyr/sys/heap_profile.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/kernel.h>
+#include <string.h>
+
+#define NUM_SITES CONFIG_SYS_HEAP_PROFILE_SITES
+#define NUM_BLOCKS CONFIG_SYS_HEAP_PROFILE_BLOCKS
+
+BUILD_ASSERT(NUM_SITES <= UINT16_MAX, "site index must fit a uint16_t");
+
+static sys_slist_t profiles = SYS_SLIST_STATIC_INIT(&profiles);
+static struct k_spinlock profiles_lock;
+
+/* Fibonacci hashing of an address, with its alignment bits dropped */
+static inline uint32_t addr_hash(void *addr, uint32_t n)
+{
+	uint32_t key = (uint32_t)((uintptr_t)addr >> 3);
+
+	return (uint32_t)(((uint64_t)(key * 0x9e3779b9U) * n) >> 32);
+}
+
+static inline uint32_t now(void)
+{
+	return (uint32_t)k_uptime_ticks();
+}
+
+/* Sites are never removed, so a linear probe ends at the matching or
+ * the first unused slot.  Returns NUM_SITES if the table is full.
+ */
+static uint32_t site_find(struct sys_heap_profile *p, void *site)
+{
+	uint32_t i = addr_hash(site, NUM_SITES);
+
+	for (uint32_t n = 0; n < NUM_SITES; n++) {
+		if (p->sites[i].site == site) {
+			return i;
+		}
+		if (p->sites[i].site == NULL) {
+			p->sites[i].site = site;
+			return i;
+		}
+		i = (i + 1 == NUM_SITES) ? 0 : i + 1;
+	}
+
+	return NUM_SITES;
+}
+
+/* Returns the slot of a live block, or of the unused slot where it
+ * would go, or NUM_BLOCKS if neither exists.
+ */
+static uint32_t block_find(struct sys_heap_profile *p, void *mem)
+{
+	uint32_t i = addr_hash(mem, NUM_BLOCKS);
+
+	for (uint32_t n = 0; n < NUM_BLOCKS; n++) {
+		if (p->blocks[i].mem == mem || p->blocks[i].mem == NULL) {
+			return i;
+		}
+		i = (i + 1 == NUM_BLOCKS) ? 0 : i + 1;
+	}
+
+	return NUM_BLOCKS;
+}
+
+/* Linear probing deletion without tombstones: move back the entries
+ * following the hole whose probe sequence crosses it
+ */
+static void block_remove(struct sys_heap_profile *p, uint32_t hole)
+{
+	uint32_t i = hole;
+
+	p->blocks[hole].mem = NULL;
+
+	for (;;) {
+		i = (i + 1 == NUM_BLOCKS) ? 0 : i + 1;
+		if (p->blocks[i].mem == NULL) {
+			break;
+		}
+
+		uint32_t home = addr_hash(p->blocks[i].mem, NUM_BLOCKS);
+
+		/* Keep the entry if its home lies cyclically in (hole, i] */
+		if ((hole < i) ? (home > hole && home <= i) :
+				 (home > hole || home <= i)) {
+			continue;
+		}
+
+		p->blocks[hole] = p->blocks[i];
+		p->blocks[i].mem = NULL;
+		hole = i;
+	}
+}
+
+void z_heap_profile_alloc(struct sys_heap_profile *p, void *mem,
+			  size_t bytes, void *site)
+{
+	k_spinlock_key_t key = k_spin_lock(&p->lock);
+	uint32_t b = block_find(p, mem);
+	uint32_t s = (b == NUM_BLOCKS) ? NUM_SITES : site_find(p, site);
+
+	if (s == NUM_SITES || b == NUM_BLOCKS) {
+		p->untracked++;
+		k_spin_unlock(&p->lock, key);
+		return;
+	}
+
+	struct sys_heap_profile_site *ps = &p->sites[s];
+	int bin = MIN(LOG2(bytes), CONFIG_SYS_HEAP_PROFILE_SIZE_BINS - 1);
+
+	ps->allocs++;
+	ps->live_blocks++;
+	ps->live_bytes += bytes;
+	ps->max_live_bytes = MAX(ps->max_live_bytes, ps->live_bytes);
+	ps->sizes[bin]++;
+
+	p->blocks[b].mem = mem;
+	p->blocks[b].bytes = bytes;
+	p->blocks[b].tick = now();
+	p->blocks[b].site = s;
+
+	k_spin_unlock(&p->lock, key);
+}
+
+void z_heap_profile_free(struct sys_heap_profile *p, void *mem)
+{
+	k_spinlock_key_t key = k_spin_lock(&p->lock);
+	uint32_t b = block_find(p, mem);
+
+	/* Blocks allocated before the profile was attached or reset,
+	 * or that did not fit in the tables, are not tracked
+	 */
+	if (b != NUM_BLOCKS && p->blocks[b].mem == mem) {
+		struct z_heap_profile_block *pb = &p->blocks[b];
+		struct sys_heap_profile_site *ps = &p->sites[pb->site];
+		uint32_t lifetime = now() - pb->tick;
+
+		ps->frees++;
+		ps->live_blocks--;
+		ps->live_bytes -= pb->bytes;
+		ps->lifetime_ticks += lifetime;
+		ps->max_lifetime_ticks = MAX(ps->max_lifetime_ticks, lifetime);
+
+		block_remove(p, b);
+	}
+
+	k_spin_unlock(&p->lock, key);
+}
+
+void sys_heap_profile_reset(struct sys_heap_profile *p)
+{
+	k_spinlock_key_t key = k_spin_lock(&p->lock);
+
+	p->untracked = 0;
+	memset(p->sites, 0, sizeof(p->sites));
+	memset(p->blocks, 0, sizeof(p->blocks));
+
+	k_spin_unlock(&p->lock, key);
+}
+
+void sys_heap_profile_attach(struct sys_heap *heap,
+			     struct sys_heap_profile *p)
+{
+	__ASSERT(heap->profile == NULL, "heap %p is already profiled", heap);
+
+	memset(p, 0, sizeof(*p));
+	p->heap = heap;
+
+	k_spinlock_key_t key = k_spin_lock(&profiles_lock);
+
+	sys_slist_append(&profiles, &p->node);
+	k_spin_unlock(&profiles_lock, key);
+
+	heap->profile = p;
+}
+
+void sys_heap_profile_detach(struct sys_heap *heap)
+{
+	struct sys_heap_profile *p = heap->profile;
+
+	if (p == NULL) {
+		return;
+	}
+
+	heap->profile = NULL;
+
+	k_spinlock_key_t key = k_spin_lock(&profiles_lock);
+
+	sys_slist_find_and_remove(&profiles, &p->node);
+	k_spin_unlock(&profiles_lock, key);
+}
+
+uint32_t sys_heap_profile_foreach_site(struct sys_heap_profile *p,
+				       sys_heap_profile_site_cb_t cb,
+				       void *user_data)
+{
+	struct sys_heap_profile_site site;
+	uint32_t untracked;
+
+	for (uint32_t s = 0; s < NUM_SITES; s++) {
+		k_spinlock_key_t key = k_spin_lock(&p->lock);
+
+		site = p->sites[s];
+		untracked = p->untracked;
+
+		if (site.site != NULL && site.live_blocks != 0U) {
+			uint32_t t = now();
+
+			site.oldest_live_ticks = 0U;
+			for (uint32_t b = 0; b < NUM_BLOCKS; b++) {
+				if (p->blocks[b].mem != NULL &&
+				    p->blocks[b].site == s) {
+					site.oldest_live_ticks =
+						MAX(site.oldest_live_ticks,
+						    t - p->blocks[b].tick);
+				}
+			}
+		}
+
+		k_spin_unlock(&p->lock, key);
+
+		if (site.site != NULL) {
+			cb(&site, user_data);
+		}
+	}
+
+	return untracked;
+}
+
+void sys_heap_profile_foreach(sys_heap_profile_cb_t cb, void *user_data)
+{
+	struct sys_heap_profile *p;
+
+	/* The callback runs unlocked so that it may print; profiles are
+	 * not expected to be attached or detached meanwhile
+	 */
+	SYS_SLIST_FOR_EACH_CONTAINER(&profiles, p, node) {
+		cb(p->heap, p, user_data);
+	}
+}
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 #include <zephyr/sys/sys_heap.h>
+#include <zephyr/sys/heap_cache.h>
 #include <zephyr/sys/util.h>
 #include <zephyr/kernel.h>
 #include "heap.h"
@@ -32,3 +33,73 @@ int sys_heap_runtime_stats_reset_max(struct sys_heap *heap)
 
 	return 0;
 }
+
+int sys_heap_fragmentation_get(struct sys_heap *heap,
+			       struct sys_heap_fragmentation *frag)
+{
+	if ((heap == NULL) || (frag == NULL)) {
+		return -EINVAL;
+	}
+
+	struct z_heap *h = heap->heap;
+	int nb_buckets = bucket_idx(h, h->end_chunk) + 1;
+	chunksz_t largest = 0;
+
+	*frag = (struct sys_heap_fragmentation) {0};
+
+	for (int b = 0; b < nb_buckets; b++) {
+		chunkid_t first = h->buckets[b].next;
+		chunkid_t c = first;
+
+		if (first == 0) {
+			continue;
+		}
+
+		do {
+			largest = MAX(largest, chunk_size(h, c));
+			frag->free_bytes += chunksz_to_bytes(h, chunk_size(h, c));
+			frag->free_blocks++;
+			c = next_free_chunk(h, c);
+		} while (c != first);
+	}
+
+	if (frag->free_bytes != 0U) {
+		frag->largest_free_bytes = chunksz_to_bytes(h, largest);
+		frag->index = 100U - (uint32_t)((uint64_t)frag->largest_free_bytes *
+						 100U / frag->free_bytes);
+	}
+
+	return 0;
+}
+
+#ifdef CONFIG_SYS_HEAP_CACHE
+int sys_heap_cache_stats_get(struct sys_heap *heap,
+			     struct sys_heap_cache *cache,
+			     struct sys_heap_cache_stats *stats)
+{
+	if ((heap == NULL) || (cache == NULL) || (stats == NULL)) {
+		return -EINVAL;
+	}
+
+	*stats = (struct sys_heap_cache_stats) {0};
+
+	for (unsigned int cpu = 0; cpu < arch_num_cpus(); cpu++) {
+		struct z_heap_cache_cpu *cc = &cache->cpus[cpu];
+		k_spinlock_key_t key = k_spin_lock(&cc->lock);
+
+		stats->hits += cc->hits;
+		stats->misses += cc->misses;
+		stats->frees += cc->frees;
+		stats->overflows += cc->overflows;
+
+		for (int bin = 0; bin < CONFIG_SYS_HEAP_CACHE_CLASSES; bin++) {
+			stats->cached_bytes += cc->counts[bin] *
+					       chunksz_to_bytes(heap->heap, bin + 1);
+		}
+
+		k_spin_unlock(&cc->lock, key);
+	}
+
+	return 0;
+}
+#endif
@@ -18,6 +18,7 @@ struct z_heap_stress_rec {
 	size_t blocks_alloced;
 	size_t bytes_alloced;
 	uint32_t target_percent;
+	uint64_t *rand_state;
 };
 
 struct z_heap_stress_block {
@@ -25,17 +26,20 @@ struct z_heap_stress_block {
 	size_t sz;
 };
 
+/* State of the random sequence shared by sys_heap_stress() runs */
+static uint64_t rand_state = 123456789; /* seed */
+
 /* Very simple LCRNG (from https://nuclear.llnl.gov/CNP/rng/rngman/node4.html)
  *
  * Here to guarantee cross-platform test repeatability.
  */
-static uint32_t rand32(void)
+static uint32_t rand32(struct z_heap_stress_rec *sr)
 {
-	static uint64_t state = 123456789; /* seed */
+	uint64_t *state = sr->rand_state;
 
-	state = state * 2862933555777941757UL + 3037000493UL;
+	*state = *state * 2862933555777941757UL + 3037000493UL;
 
-	return (uint32_t)(state >> 32);
+	return (uint32_t)(*state >> 32);
 }
 
 static bool rand_alloc_choice(struct z_heap_stress_rec *sr)
@@ -71,7 +75,7 @@ static bool rand_alloc_choice(struct z_heap_stress_rec *sr)
 			free_chance = full_pct * (0x80000000U / target);
 		}
 
-		return rand32() > free_chance;
+		return rand32(sr) > free_chance;
 	}
 }
 
@@ -80,20 +84,53 @@ static bool rand_alloc_choice(struct z_heap_stress_rec *sr)
  */
 static size_t rand_alloc_size(struct z_heap_stress_rec *sr)
 {
-	ARG_UNUSED(sr);
-
 	/* Min scale of 4 means that the half of the requests in the
 	 * smallest size have an average size of 8
 	 */
-	int scale = 4 + __builtin_clz(rand32());
+	int scale = 4 + __builtin_clz(rand32(sr));
 
-	return rand32() & BIT_MASK(scale);
+	return rand32(sr) & BIT_MASK(scale);
 }
 
 /* Returns the index of a randomly chosen block to free */
 static size_t rand_free_choice(struct z_heap_stress_rec *sr)
 {
-	return rand32() % sr->blocks_alloced;
+	return rand32(sr) % sr->blocks_alloced;
+}
+
+static void stress_run(struct z_heap_stress_rec *rec, uint32_t op_count,
+		       struct z_heap_stress_result *result)
+{
+	struct z_heap_stress_rec sr = *rec;
+
+	*result = (struct z_heap_stress_result) {0};
+
+	for (uint32_t i = 0; i < op_count; i++) {
+		if (rand_alloc_choice(&sr)) {
+			size_t sz = rand_alloc_size(&sr);
+			void *p = sr.alloc_fn(sr.arg, sz);
+
+			result->total_allocs++;
+			if (p != NULL) {
+				result->successful_allocs++;
+				sr.blocks[sr.blocks_alloced].ptr = p;
+				sr.blocks[sr.blocks_alloced].sz = sz;
+				sr.blocks_alloced++;
+				sr.bytes_alloced += sz;
+			}
+		} else {
+			int b = rand_free_choice(&sr);
+			void *p = sr.blocks[b].ptr;
+			size_t sz = sr.blocks[b].sz;
+
+			result->total_frees++;
+			sr.blocks[b] = sr.blocks[sr.blocks_alloced - 1];
+			sr.blocks_alloced--;
+			sr.bytes_alloced -= sz;
+			sr.free_fn(sr.arg, p);
+		}
+		result->accumulated_in_use_bytes += sr.bytes_alloced;
+	}
 }
 
 /* General purpose heap stress test.  Takes function pointers to allow
@@ -120,34 +157,85 @@ void sys_heap_stress(void *(*alloc_fn)(void *arg, size_t bytes),
 	       .blocks = scratch_mem,
 	       .nblocks = scratch_bytes / sizeof(struct z_heap_stress_block),
 	       .target_percent = target_percent,
+	       .rand_state = &rand_state,
 	};
 
+	stress_run(&sr, op_count, result);
+}
+
+#ifdef CONFIG_MULTITHREADING
+struct z_heap_stress_thread {
+	struct z_heap_stress_rec sr;
+	uint64_t rand_state;
+	uint32_t op_count;
+	struct z_heap_stress_result result;
+};
+
+static void stress_thread_entry(void *p1, void *p2, void *p3)
+{
+	struct z_heap_stress_thread *st = p1;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	stress_run(&st->sr, st->op_count, &st->result);
+}
+
+void sys_heap_stress_threads(void *(*alloc_fn)(void *arg, size_t bytes),
+			     void (*free_fn)(void *arg, void *p),
+			     void *arg, size_t total_bytes,
+			     uint32_t op_count,
+			     void *scratch_mem, size_t scratch_bytes,
+			     int target_percent,
+			     struct k_thread *threads,
+			     struct z_thread_stack_element *stacks,
+			     size_t stack_size, int num_threads, int prio,
+			     struct z_heap_stress_result *result)
+{
+	/* The per-thread state is carved out of the scratch memory too */
+	size_t share = ROUND_DOWN(scratch_bytes / num_threads, sizeof(void *));
+	size_t stride = K_THREAD_STACK_LEN(stack_size);
+
+	__ASSERT(share > sizeof(struct z_heap_stress_thread), "scratch too small");
+
+	for (int i = 0; i < num_threads; i++) {
+		struct z_heap_stress_thread *st =
+			(void *)((uint8_t *)scratch_mem + i * share);
+
+		*st = (struct z_heap_stress_thread) {
+			.sr = {
+				.alloc_fn = alloc_fn,
+				.free_fn = free_fn,
+				.arg = arg,
+				.total_bytes = total_bytes / num_threads,
+				.blocks = (void *)(st + 1),
+				.nblocks = (share - sizeof(*st)) /
+					   sizeof(struct z_heap_stress_block),
+				.target_percent = target_percent,
+				.rand_state = &st->rand_state,
+			},
+			.rand_state = rand_state + i,
+			.op_count = op_count,
+		};
+
+		k_thread_create(&threads[i], &stacks[stride * i], stack_size,
+				stress_thread_entry, st, NULL, NULL,
+				prio, 0, K_NO_WAIT);
+	}
+
 	*result = (struct z_heap_stress_result) {0};
 
-	for (uint32_t i = 0; i < op_count; i++) {
-		if (rand_alloc_choice(&sr)) {
-			size_t sz = rand_alloc_size(&sr);
-			void *p = sr.alloc_fn(sr.arg, sz);
+	for (int i = 0; i < num_threads; i++) {
+		struct z_heap_stress_thread *st =
+			(void *)((uint8_t *)scratch_mem + i * share);
 
-			result->total_allocs++;
-			if (p != NULL) {
-				result->successful_allocs++;
-				sr.blocks[sr.blocks_alloced].ptr = p;
-				sr.blocks[sr.blocks_alloced].sz = sz;
-				sr.blocks_alloced++;
-				sr.bytes_alloced += sz;
-			}
-		} else {
-			int b = rand_free_choice(&sr);
-			void *p = sr.blocks[b].ptr;
-			size_t sz = sr.blocks[b].sz;
+		k_thread_join(&threads[i], K_FOREVER);
 
-			result->total_frees++;
-			sr.blocks[b] = sr.blocks[sr.blocks_alloced - 1];
-			sr.blocks_alloced--;
-			sr.bytes_alloced -= sz;
-			sr.free_fn(sr.arg, p);
-		}
-		result->accumulated_in_use_bytes += sr.bytes_alloced;
+		result->total_allocs += st->result.total_allocs;
+		result->successful_allocs += st->result.successful_allocs;
+		result->total_frees += st->result.total_frees;
+		result->accumulated_in_use_bytes +=
+			st->result.accumulated_in_use_bytes;
 	}
 }
+#endif /* CONFIG_MULTITHREADING */
@@ -56,7 +56,7 @@ static inline void check_nexts(struct z_heap *h, int bidx)
 {
 	struct z_heap_bucket *b = &h->buckets[bidx];
 
-	bool emptybit = (h->avail_buckets & BIT(bidx)) == 0;
+	bool emptybit = !bucket_avail(h, bidx);
 	bool emptylist = b->next == 0;
 	bool empties_match = emptybit == emptylist;
 
@@ -103,6 +103,21 @@ bool sys_heap_validate(struct sys_heap *heap)
 	}
 #endif
 
+#ifdef CONFIG_SYS_HEAP_TLSF
+	/* A first level bit is set if any of its second level bits is */
+	int sl_bits = tlsf_sl_bits(h);
+	int nb_fl = (bucket_idx(h, h->end_chunk) + BIT(sl_bits)) >> sl_bits;
+
+	for (int fl = 0; fl < 32; fl++) {
+		bool fl_bit = (h->avail_buckets & BIT(fl)) != 0U;
+		bool sl_bit = (fl < nb_fl) && (sl_avail_bits(h, fl) != 0U);
+
+		if (fl_bit != sl_bit) {
+			return false;
+		}
+	}
+#endif
+
 	/* Check the free lists: entry count should match, empty bit
 	 * should be correct, and all chunk entries should point into
 	 * valid unused chunks.  Mark those chunks USED, temporarily.
@@ -121,7 +136,7 @@ bool sys_heap_validate(struct sys_heap *heap)
 			set_chunk_used(h, c, true);
 		}
 
-		bool empty = (h->avail_buckets & BIT(b)) == 0;
+		bool empty = !bucket_avail(h, b);
 		bool zero = n == 0;
 
 		if (empty != zero) {
@@ -13,28 +13,37 @@
 #include <zephyr/init.h>
 #include <string.h>
 
-static void *alloc_blocks(sys_mem_blocks_t *mem_block, size_t num_blocks)
+/* The block offsets found by the bitarray are turned into pointers in
+ * place, in the output array.
+ */
+BUILD_ASSERT(sizeof(size_t) == sizeof(void *));
+
+/*
+ * Allocate @p num_runs runs of @p num_blocks contiguous blocks, all or
+ * none, and store their start addresses in @p out_blocks.
+ */
+static int alloc_blocks(sys_mem_blocks_t *mem_block, size_t num_blocks,
+			size_t num_runs, void **out_blocks)
 {
-	size_t offset;
+	size_t *offsets = (size_t *)out_blocks;
 	int r;
-	uint8_t *blk;
 
 #ifdef CONFIG_SYS_MEM_BLOCKS_RUNTIME_STATS
 	k_spinlock_key_t  key = k_spin_lock(&mem_block->lock);
 #endif
 
-	/* Find an unallocated block */
-	r = sys_bitarray_alloc(mem_block->bitmap, num_blocks, &offset);
+	/* Find unallocated blocks */
+	r = sys_bitarray_alloc_regions(mem_block->bitmap, num_blocks,
+				       num_runs, offsets);
 	if (r != 0) {
 #ifdef CONFIG_SYS_MEM_BLOCKS_RUNTIME_STATS
 		k_spin_unlock(&mem_block->lock, key);
 #endif
-		return NULL;
+		return r;
 	}
 
-
 #ifdef CONFIG_SYS_MEM_BLOCKS_RUNTIME_STATS
-	mem_block->info.used_blocks += (uint32_t)num_blocks;
+	mem_block->info.used_blocks += (uint32_t)(num_blocks * num_runs);
 
 	if (mem_block->info.max_used_blocks < mem_block->info.used_blocks) {
 		mem_block->info.max_used_blocks = mem_block->info.used_blocks;
@@ -43,11 +52,14 @@ static void *alloc_blocks(sys_mem_blocks_t *mem_block, size_t num_blocks)
 	k_spin_unlock(&mem_block->lock, key);
 #endif
 
-	/* Calculate the start address of the newly allocated block */
+	/* Calculate the start addresses of the newly allocated blocks */
 
-	blk = mem_block->buffer + (offset << mem_block->info.blk_sz_shift);
+	for (size_t i = 0; i < num_runs; i++) {
+		out_blocks[i] = mem_block->buffer +
+				(offsets[i] << mem_block->info.blk_sz_shift);
+	}
 
-	return blk;
+	return 0;
 }
 
 static int free_blocks(sys_mem_blocks_t *mem_block, void *ptr,
@@ -106,17 +118,55 @@ int sys_mem_blocks_alloc_contiguous(sys_mem_blocks_t *mem_block, size_t count,
 		goto out;
 	}
 
-	void *ptr = alloc_blocks(mem_block, count);
-
-	if (ptr == NULL) {
+	if (alloc_blocks(mem_block, count, 1, out_block) != 0) {
 		ret = -ENOMEM;
 		goto out;
 	}
 
-	*out_block = ptr;
 #ifdef CONFIG_SYS_MEM_BLOCKS_LISTENER
 	heap_listener_notify_alloc(HEAP_ID_FROM_POINTER(mem_block),
-				   ptr, count << mem_block->info.blk_sz_shift);
+				   *out_block,
+				   count << mem_block->info.blk_sz_shift);
+#endif
+
+out:
+	return ret;
+}
+
+int sys_mem_blocks_alloc_contiguous_batch(sys_mem_blocks_t *mem_block,
+					  size_t count, size_t num_runs,
+					  void **out_blocks)
+{
+	int ret = 0;
+
+	__ASSERT_NO_MSG(mem_block != NULL);
+	__ASSERT_NO_MSG(out_blocks != NULL);
+	__ASSERT_NO_MSG(mem_block->bitmap != NULL);
+	__ASSERT_NO_MSG(mem_block->buffer != NULL);
+
+	if ((count == 0) || (num_runs == 0)) {
+		/* Nothing to allocate */
+		goto out;
+	}
+
+	if ((count > mem_block->info.num_blocks) ||
+	    (num_runs > mem_block->info.num_blocks / count)) {
+		/* Definitely not enough blocks to be allocated */
+		ret = -ENOMEM;
+		goto out;
+	}
+
+	if (alloc_blocks(mem_block, count, num_runs, out_blocks) != 0) {
+		ret = -ENOMEM;
+		goto out;
+	}
+
+#ifdef CONFIG_SYS_MEM_BLOCKS_LISTENER
+	for (size_t i = 0; i < num_runs; i++) {
+		heap_listener_notify_alloc(HEAP_ID_FROM_POINTER(mem_block),
+					   out_blocks[i],
+					   count << mem_block->info.blk_sz_shift);
+	}
 #endif
 
 out:
@@ -127,7 +177,6 @@ int sys_mem_blocks_alloc(sys_mem_blocks_t *mem_block, size_t count,
 			 void **out_blocks)
 {
 	int ret = 0;
-	int i;
 
 	__ASSERT_NO_MSG(mem_block != NULL);
 	__ASSERT_NO_MSG(out_blocks != NULL);
@@ -145,27 +194,19 @@ int sys_mem_blocks_alloc(sys_mem_blocks_t *mem_block, size_t count,
 		goto out;
 	}
 
-	for (i = 0; i < count; i++) {
-		void *ptr = alloc_blocks(mem_block, 1);
-
-		if (ptr == NULL) {
-			break;
-		}
-
-		out_blocks[i] = ptr;
+	/* Blocks are found a bitmap word at a time, all or none */
+	if (alloc_blocks(mem_block, 1, count, out_blocks) != 0) {
+		ret = -ENOMEM;
+		goto out;
+	}
 
 #ifdef CONFIG_SYS_MEM_BLOCKS_LISTENER
+	for (size_t i = 0; i < count; i++) {
 		heap_listener_notify_alloc(HEAP_ID_FROM_POINTER(mem_block),
-					   ptr,
+					   out_blocks[i],
 					   BIT(mem_block->info.blk_sz_shift));
-#endif
-	}
-
-	/* If error, free already allocated blocks. */
-	if (i < count) {
-		(void)sys_mem_blocks_free(mem_block, i, out_blocks);
-		ret = -ENOMEM;
 	}
+#endif
 
 out:
 	return ret;
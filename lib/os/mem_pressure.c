@@ -0,0 +1,305 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+#include <zephyr/sys/mem_pressure.h>
+#include <zephyr/sys/sys_heap.h>
+#include <zephyr/logging/log.h>
+
+#if defined(CONFIG_NET_BUF_POOL_USAGE)
+#include <zephyr/net/buf.h>
+#endif
+
+#if defined(CONFIG_NET_MGMT_EVENT)
+#include <zephyr/net/net_mgmt.h>
+#include <zephyr/net/net_event.h>
+#endif
+
+LOG_MODULE_REGISTER(mem_pressure, CONFIG_MEM_PRESSURE_LOG_LEVEL);
+
+/* Sources and callbacks, and the state of the sources */
+static K_MUTEX_DEFINE(lock);
+static sys_slist_t sources = SYS_SLIST_STATIC_INIT(&sources);
+static sys_slist_t callbacks = SYS_SLIST_STATIC_INIT(&callbacks);
+
+static void check_work_handler(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(check_work, check_work_handler);
+static bool started;
+
+static int source_usage(struct mem_pressure_source *src)
+{
+	struct sys_memory_stats stats;
+	size_t used, total;
+
+	switch (src->type) {
+	case MEM_PRESSURE_K_HEAP: {
+		struct k_heap *h = src->obj;
+#ifdef CONFIG_SYS_HEAP_CACHE
+		struct sys_heap_cache_stats cache_stats;
+#endif
+		k_spinlock_key_t key = k_spin_lock(&h->lock);
+
+		(void)sys_heap_runtime_stats_get(&h->heap, &stats);
+#ifdef CONFIG_SYS_HEAP_CACHE
+		/* Cached blocks are allocated for the heap but free for users */
+		(void)sys_heap_cache_stats_get(&h->heap, &h->cache, &cache_stats);
+		stats.allocated_bytes -= cache_stats.cached_bytes;
+		stats.free_bytes += cache_stats.cached_bytes;
+#endif
+		k_spin_unlock(&h->lock, key);
+
+		used = stats.allocated_bytes;
+		total = stats.allocated_bytes + stats.free_bytes;
+		break;
+	}
+	case MEM_PRESSURE_SYS_HEAP:
+		(void)sys_heap_runtime_stats_get(src->obj, &stats);
+
+		used = stats.allocated_bytes;
+		total = stats.allocated_bytes + stats.free_bytes;
+		break;
+	case MEM_PRESSURE_K_MEM_SLAB: {
+		struct k_mem_slab *slab = src->obj;
+
+		used = k_mem_slab_num_used_get(slab);
+		total = slab->info.num_blocks;
+		break;
+	}
+#if defined(CONFIG_NET_BUF_POOL_USAGE)
+	case MEM_PRESSURE_NET_BUF_POOL: {
+		struct net_buf_pool *pool = src->obj;
+
+		used = pool->buf_count - atomic_get(&pool->avail_count);
+		total = pool->buf_count;
+		break;
+	}
+#endif
+	default:
+		return -ENOTSUP;
+	}
+
+	return (total == 0U) ? 0 : (int)((used * 100U) / total);
+}
+
+static enum mem_pressure_level usage_level(struct mem_pressure_source *src,
+					   int usage)
+{
+	if (usage >= src->critical) {
+		return MEM_PRESSURE_CRITICAL;
+	} else if (usage >= src->low) {
+		return MEM_PRESSURE_LOW;
+	}
+
+	return MEM_PRESSURE_NONE;
+}
+
+static void notify_event(struct mem_pressure_source *src)
+{
+#if defined(CONFIG_NET_MGMT_EVENT_INFO)
+	struct net_event_mem_pressure info = {
+		.name = src->name,
+		.level = src->level,
+		.usage = src->usage,
+	};
+
+	net_mgmt_event_notify_with_info(NET_EVENT_MEM_PRESSURE, NULL,
+					&info, sizeof(info));
+#elif defined(CONFIG_NET_MGMT_EVENT)
+	net_mgmt_event_notify(NET_EVENT_MEM_PRESSURE, NULL);
+#else
+	ARG_UNUSED(src);
+#endif
+}
+
+/* Return the blocks held in the per-CPU caches of a k_heap, so that
+ * allocations of any size can use them again
+ */
+static void source_flush(struct mem_pressure_source *src)
+{
+#ifdef CONFIG_SYS_HEAP_CACHE
+	if (src->type == MEM_PRESSURE_K_HEAP) {
+		struct k_heap *h = src->obj;
+		k_spinlock_key_t key = k_spin_lock(&h->lock);
+
+		(void)sys_heap_cache_flush(&h->heap, &h->cache);
+		k_spin_unlock(&h->lock, key);
+	}
+#else
+	ARG_UNUSED(src);
+#endif
+}
+
+/* Called with the lock held */
+static void check_source(struct mem_pressure_source *src)
+{
+	struct mem_pressure_callback *cb;
+	enum mem_pressure_level level;
+	int usage = source_usage(src);
+
+	if (usage < 0) {
+		return;
+	}
+
+	src->usage = usage;
+	level = usage_level(src, usage);
+
+	/* Only drop once usage is clearly below the threshold, so that
+	 * usage hovering around it does not flood the callbacks
+	 */
+	if (level < src->level) {
+		level = MIN((enum mem_pressure_level)src->level,
+			    usage_level(src, usage + CONFIG_MEM_PRESSURE_HYSTERESIS));
+	}
+
+	if (level == src->level) {
+		return;
+	}
+
+	if (level > src->level) {
+		src->events++;
+		source_flush(src);
+	}
+
+	LOG_DBG("%s: %s (%u%% used)", src->name, mem_pressure_level_str(level),
+		src->usage);
+
+	src->level = level;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&callbacks, cb, node) {
+		if ((cb->types & BIT(src->type)) != 0U) {
+			cb->reclaim(src, level, cb->user_data);
+		}
+	}
+
+	notify_event(src);
+}
+
+void mem_pressure_check(void)
+{
+	struct mem_pressure_source *src;
+
+	k_mutex_lock(&lock, K_FOREVER);
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&sources, src, node) {
+		check_source(src);
+	}
+
+	k_mutex_unlock(&lock);
+}
+
+static void check_work_handler(struct k_work *work)
+{
+	mem_pressure_check();
+
+	if (CONFIG_MEM_PRESSURE_POLL_INTERVAL > 0) {
+		k_work_reschedule(k_work_delayable_from_work(work),
+				  K_MSEC(CONFIG_MEM_PRESSURE_POLL_INTERVAL));
+	}
+}
+
+void z_mem_pressure_exhausted(void)
+{
+	/* Allocations may fail before the work queue exists, or from
+	 * the work queue itself while checking
+	 */
+	if (started) {
+		k_work_reschedule(&check_work, K_NO_WAIT);
+	}
+}
+
+int mem_pressure_source_register(struct mem_pressure_source *src)
+{
+	if ((src->low > src->critical) || (src->critical > 100U)) {
+		return -EINVAL;
+	}
+
+	if ((src->type == MEM_PRESSURE_NET_BUF_POOL) &&
+	    !IS_ENABLED(CONFIG_NET_BUF_POOL_USAGE)) {
+		return -ENOTSUP;
+	}
+
+	src->level = MEM_PRESSURE_NONE;
+	src->usage = 0U;
+	src->events = 0U;
+
+	k_mutex_lock(&lock, K_FOREVER);
+	sys_slist_append(&sources, &src->node);
+	k_mutex_unlock(&lock);
+
+	return 0;
+}
+
+void mem_pressure_source_unregister(struct mem_pressure_source *src)
+{
+	k_mutex_lock(&lock, K_FOREVER);
+	(void)sys_slist_find_and_remove(&sources, &src->node);
+	k_mutex_unlock(&lock);
+}
+
+void mem_pressure_callback_register(struct mem_pressure_callback *cb)
+{
+	k_mutex_lock(&lock, K_FOREVER);
+	sys_slist_append(&callbacks, &cb->node);
+	k_mutex_unlock(&lock);
+}
+
+void mem_pressure_callback_unregister(struct mem_pressure_callback *cb)
+{
+	k_mutex_lock(&lock, K_FOREVER);
+	(void)sys_slist_find_and_remove(&callbacks, &cb->node);
+	k_mutex_unlock(&lock);
+}
+
+void mem_pressure_source_foreach(mem_pressure_source_cb_t cb, void *user_data)
+{
+	struct mem_pressure_source *src;
+
+	k_mutex_lock(&lock, K_FOREVER);
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&sources, src, node) {
+		cb(src, user_data);
+	}
+
+	k_mutex_unlock(&lock);
+}
+
+const char *mem_pressure_level_str(enum mem_pressure_level level)
+{
+	switch (level) {
+	case MEM_PRESSURE_NONE:
+		return "none";
+	case MEM_PRESSURE_LOW:
+		return "low";
+	case MEM_PRESSURE_CRITICAL:
+		return "critical";
+	}
+
+	return "<unknown>";
+}
+
+#if defined(CONFIG_MEM_PRESSURE_SYSTEM_HEAP)
+extern struct k_heap _system_heap;
+
+static MEM_PRESSURE_SOURCE_DEFINE(system_heap, MEM_PRESSURE_K_HEAP,
+				  &_system_heap,
+				  CONFIG_MEM_PRESSURE_LOW_THRESHOLD,
+				  CONFIG_MEM_PRESSURE_CRITICAL_THRESHOLD);
+#endif
+
+static int mem_pressure_init(void)
+{
+#if defined(CONFIG_MEM_PRESSURE_SYSTEM_HEAP)
+	(void)mem_pressure_source_register(&system_heap);
+#endif
+
+	started = true;
+	k_work_reschedule(&check_work, K_NO_WAIT);
+
+	return 0;
+}
+
+SYS_INIT(mem_pressure_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/sys/mem_pressure.h>
+
+static const char *type_str(uint8_t type)
+{
+	switch (type) {
+	case MEM_PRESSURE_K_HEAP:
+		return "k_heap";
+	case MEM_PRESSURE_SYS_HEAP:
+		return "sys_heap";
+	case MEM_PRESSURE_K_MEM_SLAB:
+		return "k_mem_slab";
+	case MEM_PRESSURE_NET_BUF_POOL:
+		return "net_buf";
+	}
+
+	return "?";
+}
+
+static void source_print(const struct mem_pressure_source *src,
+			 void *user_data)
+{
+	const struct shell *sh = user_data;
+
+	shell_print(sh, "%-20s %-10s %5u%% %5u%% %5u%% %-8s %8u",
+		    src->name, type_str(src->type), src->usage, src->low,
+		    src->critical, mem_pressure_level_str(src->level),
+		    src->events);
+}
+
+static int cmd_mem_pressure_show(const struct shell *sh,
+				 size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	shell_print(sh, "%-20s %-10s %6s %6s %6s %-8s %8s",
+		    "Source", "Type", "Used", "Low", "Crit", "Level", "Events");
+	mem_pressure_source_foreach(source_print, (void *)sh);
+
+	return 0;
+}
+
+static int cmd_mem_pressure_check(const struct shell *sh,
+				  size_t argc, char **argv)
+{
+	mem_pressure_check();
+
+	return cmd_mem_pressure_show(sh, argc, argv);
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_mem_pressure,
+	SHELL_CMD(show, NULL, "Show memory pressure sources.",
+		  cmd_mem_pressure_show),
+	SHELL_CMD(check, NULL, "Check all sources now and show them.",
+		  cmd_mem_pressure_check),
+	SHELL_SUBCMD_SET_END /* Array terminated. */
+);
+
+SHELL_CMD_REGISTER(mem_pressure, &sub_mem_pressure,
+		   "Memory pressure commands", cmd_mem_pressure_show);
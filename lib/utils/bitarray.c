@@ -381,15 +381,128 @@ out:
 	return ret;
 }
 
+/*
+ * Find the first set or clear bit at or after a given bit, a bundle
+ * at a time.
+ *
+ * @param bitarray Bitarray struct
+ * @param bit      Bit to start searching from
+ * @param set      True to find a set bit, false to find a clear bit
+ *
+ * @return Offset of the bit found, or the number of bits in the
+ *         bitarray if there is none.
+ */
+static size_t find_next(sys_bitarray_t *bitarray, size_t bit, bool set)
+{
+	size_t idx = bit / bundle_bitness(bitarray);
+	uint32_t before;
+	uint32_t bundle;
+
+	if (bit >= bitarray->num_bits) {
+		return bitarray->num_bits;
+	}
+
+	/* Look for set bits, in the inverted bundles when looking for
+	 * clear ones, and ignore those before the starting bit.  Bits
+	 * past the end of the bitarray are clear, so a clear one found
+	 * there means there is none.
+	 */
+	before = BIT(bit % bundle_bitness(bitarray)) - 1;
+	bundle = set ? bitarray->bundles[idx] : ~bitarray->bundles[idx];
+	bundle &= ~before;
+
+	while (bundle == 0U) {
+		idx++;
+		if (idx == bitarray->num_bundles) {
+			return bitarray->num_bits;
+		}
+
+		bundle = set ? bitarray->bundles[idx] : ~bitarray->bundles[idx];
+	}
+
+	bit = idx * bundle_bitness(bitarray) + find_lsb_set(bundle) - 1;
+
+	return MIN(bit, bitarray->num_bits);
+}
+
+/*
+ * Find the first clear region at or after a given bit and set it.
+ * Must be called with the bitarray lock held.
+ *
+ * @param[in]  bitarray Bitarray struct
+ * @param[in]  num_bits Number of bits in the region
+ * @param[in]  bit      Bit to start searching from
+ * @param[out] offset   Offset to the start of the region
+ *
+ * @retval 0       Region found and set
+ * @retval -ENOSPC No such region
+ */
+static int alloc_region(sys_bitarray_t *bitarray, size_t num_bits,
+			size_t bit, size_t *offset)
+{
+	struct bundle_data bd;
+	size_t off_end = bitarray->num_bits - num_bits;
+	size_t mismatch;
+
+	bit = find_next(bitarray, bit, false);
+	while (bit <= off_end) {
+		if (match_region(bitarray, bit, num_bits, false,
+				 &bd, &mismatch)) {
+			set_region(bitarray, bit, num_bits, true, &bd);
+			*offset = bit;
+			return 0;
+		}
+
+		/* No region can start before the first clear bit
+		 * after the mismatched one.
+		 */
+		bit = find_next(bitarray, mismatch + 1, false);
+	}
+
+	return -ENOSPC;
+}
+
+/*
+ * Set up to @p num clear bits, scanning a bundle at a time.
+ * Must be called with the bitarray lock held.
+ *
+ * @return Number of bits set, whose offsets are stored in @p offsets
+ */
+static size_t alloc_bits(sys_bitarray_t *bitarray, size_t num,
+			 size_t *offsets)
+{
+	size_t last = bitarray->num_bundles - 1;
+	size_t tail = bitarray->num_bits % bundle_bitness(bitarray);
+	size_t n = 0;
+
+	for (size_t idx = 0; (idx <= last) && (n < num); idx++) {
+		uint32_t clear = ~bitarray->bundles[idx];
+		uint32_t taken = 0U;
+
+		if ((idx == last) && (tail != 0U)) {
+			/* Bits past the end of the bitarray */
+			clear &= BIT(tail) - 1;
+		}
+
+		while ((clear != 0U) && (n < num)) {
+			uint32_t b = find_lsb_set(clear) - 1;
+
+			offsets[n++] = idx * bundle_bitness(bitarray) + b;
+			taken |= BIT(b);
+			clear &= clear - 1U;
+		}
+
+		bitarray->bundles[idx] |= taken;
+	}
+
+	return n;
+}
+
 int sys_bitarray_alloc(sys_bitarray_t *bitarray, size_t num_bits,
 		       size_t *offset)
 {
 	k_spinlock_key_t key;
-	uint32_t bit_idx;
 	int ret;
-	struct bundle_data bd;
-	size_t off_start, off_end;
-	size_t mismatch;
 
 	__ASSERT_NO_MSG(bitarray != NULL);
 	__ASSERT_NO_MSG(bitarray->num_bits > 0);
@@ -406,46 +519,61 @@ int sys_bitarray_alloc(sys_bitarray_t *bitarray, size_t num_bits,
 		goto out;
 	}
 
-	bit_idx = 0;
+	ret = alloc_region(bitarray, num_bits, 0, offset);
 
-	/* Find the first non-allocated bit by looking at bundles
-	 * instead of individual bits.
-	 *
-	 * On RISC-V 64-bit, it complains about undefined reference to `ffs`.
-	 * So don't use this on RISCV64.
-	 */
-	for (size_t idx = 0; idx < bitarray->num_bundles; idx++) {
-		if (~bitarray->bundles[idx] == 0U) {
-			/* bundle is all 1s => all allocated, skip */
-			bit_idx += bundle_bitness(bitarray);
-			continue;
-		}
+out:
+	k_spin_unlock(&bitarray->lock, key);
+	return ret;
+}
 
-		if (bitarray->bundles[idx] != 0U) {
-			/* Find the first free bit in bundle if not all free */
-			off_start = find_lsb_set(~bitarray->bundles[idx]) - 1;
-			bit_idx += off_start;
-		}
+int sys_bitarray_alloc_regions(sys_bitarray_t *bitarray, size_t num_bits,
+			       size_t num_regions, size_t *offsets)
+{
+	k_spinlock_key_t key;
+	size_t n = 0;
+	int ret = 0;
+
+	__ASSERT_NO_MSG(bitarray != NULL);
+	__ASSERT_NO_MSG(bitarray->num_bits > 0);
 
-		break;
+	key = k_spin_lock(&bitarray->lock);
+
+	CHECKIF(offsets == NULL) {
+		ret = -EINVAL;
+		goto out;
 	}
 
-	off_end = bitarray->num_bits - num_bits;
-	ret = -ENOSPC;
-	while (bit_idx <= off_end) {
-		if (match_region(bitarray, bit_idx, num_bits, false,
-				 &bd, &mismatch)) {
-			set_region(bitarray, bit_idx, num_bits, true, &bd);
+	if ((num_bits == 0) || (num_bits > bitarray->num_bits)) {
+		ret = -EINVAL;
+		goto out;
+	}
 
-			*offset = bit_idx;
-			ret = 0;
-			break;
-		}
+	if (num_bits == 1) {
+		n = alloc_bits(bitarray, num_regions, offsets);
+	} else {
+		size_t bit = 0;
 
-		/* Fast-forward to the bit just after
-		 * the mismatched bit.
+		/* Regions are found in increasing order, so each search
+		 * resumes where the previous region ends.
 		 */
-		bit_idx = mismatch + 1;
+		while (n < num_regions) {
+			if (alloc_region(bitarray, num_bits, bit,
+					 &offsets[n]) != 0) {
+				break;
+			}
+
+			bit = offsets[n] + num_bits;
+			n++;
+		}
+	}
+
+	if (n < num_regions) {
+		/* Not enough space: release the regions already set */
+		for (size_t i = 0; i < n; i++) {
+			set_region(bitarray, offsets[i], num_bits, false, NULL);
+		}
+
+		ret = -ENOSPC;
 	}
 
 out:
@@ -600,3 +728,97 @@ int sys_bitarray_clear_region(sys_bitarray_t *bitarray, size_t num_bits,
 {
 	return set_clear_region(bitarray, num_bits, offset, false);
 }
+
+static int find_first(sys_bitarray_t *bitarray, size_t offset, size_t *bit,
+		      bool set)
+{
+	k_spinlock_key_t key;
+	size_t found;
+	int ret;
+
+	__ASSERT_NO_MSG(bitarray != NULL);
+	__ASSERT_NO_MSG(bitarray->num_bits > 0);
+
+	key = k_spin_lock(&bitarray->lock);
+
+	CHECKIF(bit == NULL) {
+		ret = -EINVAL;
+		goto out;
+	}
+
+	if (offset >= bitarray->num_bits) {
+		ret = -EINVAL;
+		goto out;
+	}
+
+	found = find_next(bitarray, offset, set);
+	if (found == bitarray->num_bits) {
+		ret = -ENOENT;
+	} else {
+		*bit = found;
+		ret = 0;
+	}
+
+out:
+	k_spin_unlock(&bitarray->lock, key);
+	return ret;
+}
+
+int sys_bitarray_find_first_set(sys_bitarray_t *bitarray, size_t offset,
+				size_t *bit)
+{
+	return find_first(bitarray, offset, bit, true);
+}
+
+int sys_bitarray_find_first_clear(sys_bitarray_t *bitarray, size_t offset,
+				  size_t *bit)
+{
+	return find_first(bitarray, offset, bit, false);
+}
+
+int sys_bitarray_popcount_region(sys_bitarray_t *bitarray, size_t num_bits,
+				 size_t offset, size_t *count)
+{
+	k_spinlock_key_t key;
+	size_t off_end = offset + num_bits - 1;
+	struct bundle_data bd;
+	size_t idx;
+	int ret;
+
+	__ASSERT_NO_MSG(bitarray != NULL);
+	__ASSERT_NO_MSG(bitarray->num_bits > 0);
+
+	key = k_spin_lock(&bitarray->lock);
+
+	CHECKIF(count == NULL) {
+		ret = -EINVAL;
+		goto out;
+	}
+
+	if ((num_bits == 0)
+	    || (num_bits > bitarray->num_bits)
+	    || (offset >= bitarray->num_bits)
+	    || (off_end >= bitarray->num_bits)) {
+		ret = -EINVAL;
+		goto out;
+	}
+
+	setup_bundle_data(bitarray, &bd, offset, num_bits);
+
+	if (bd.sidx == bd.eidx) {
+		*count = POPCOUNT(bitarray->bundles[bd.sidx] & bd.smask);
+	} else {
+		*count = POPCOUNT(bitarray->bundles[bd.sidx] & bd.smask) +
+			 POPCOUNT(bitarray->bundles[bd.eidx] & bd.emask);
+
+		for (idx = bd.sidx + 1; idx < bd.eidx; idx++) {
+			*count += POPCOUNT(bitarray->bundles[idx]);
+		}
+	}
+
+	ret = 0;
+
+out:
+	k_spin_unlock(&bitarray->lock, key);
+	return ret;
+}
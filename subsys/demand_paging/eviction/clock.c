@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Clock (second chance) eviction algorithm for demand paging
+ */
+#include <zephyr/kernel.h>
+#include <mmu.h>
+#include <kernel_arch_interface.h>
+
+#include <zephyr/kernel/mm/demand_paging.h>
+
+/* The page frames form a circle swept by a clock hand. Each page frame
+ * has an age, which is incremented (up to CONFIG_EVICTION_CLOCK_MAX_AGE)
+ * whenever the hand finds the page accessed since its last visit, and
+ * decremented when it does not. The first page found not accessed with
+ * an age of zero is evicted, so that frequently used pages survive more
+ * sweeps than pages used once. With a maximum age of 0 this is the
+ * classic second chance algorithm.
+ *
+ * Sweeping stops after the hand has gone around enough times for every
+ * age to drop to zero, which can only fail to find a page if others keep
+ * accessing them concurrently. The page under the hand is evicted then.
+ */
+#define MAX_SWEEPS (CONFIG_EVICTION_CLOCK_MAX_AGE + 2)
+
+static uint8_t ages[Z_NUM_PAGE_FRAMES];
+static size_t hand;
+
+struct z_page_frame *k_mem_paging_eviction_select(bool *dirty_ptr)
+{
+	struct z_page_frame *pf, *last_pf = NULL;
+	bool last_dirty = false;
+	uintptr_t flags;
+
+	for (size_t n = 0; n < MAX_SWEEPS * Z_NUM_PAGE_FRAMES; n++) {
+		size_t i = hand;
+
+		hand = (hand + 1) % Z_NUM_PAGE_FRAMES;
+		pf = &z_page_frames[i];
+
+		if (!z_page_frame_is_evictable(pf)) {
+			continue;
+		}
+
+		/* Clears the accessed bit in the page tables */
+		flags = arch_page_info_get(pf->addr, NULL, true);
+
+		__ASSERT((flags & ARCH_DATA_PAGE_LOADED) != 0U,
+			 "non-present page, %s",
+			 ((flags & ARCH_DATA_PAGE_NOT_MAPPED) != 0U) ?
+			 "un-mapped" : "paged out");
+
+		last_pf = pf;
+		last_dirty = (flags & ARCH_DATA_PAGE_DIRTY) != 0UL;
+
+		if ((flags & ARCH_DATA_PAGE_ACCESSED) != 0UL) {
+			if (ages[i] < CONFIG_EVICTION_CLOCK_MAX_AGE) {
+				ages[i]++;
+			}
+		} else if (ages[i] > 0U) {
+			ages[i]--;
+		} else {
+			break;
+		}
+	}
+	/* Shouldn't ever happen unless every page is pinned */
+	__ASSERT(last_pf != NULL, "no page to evict");
+
+	/* The page about to be loaded in this frame starts afresh */
+	ages[last_pf - z_page_frames] = 0U;
+
+	*dirty_ptr = last_dirty;
+
+	return last_pf;
+}
+
+void k_mem_paging_eviction_init(void)
+{
+}
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Least Recently Used (LRU) approximation eviction algorithm for demand
+ * paging
+ */
+#include <zephyr/kernel.h>
+#include <mmu.h>
+#include <kernel_arch_interface.h>
+
+#include <zephyr/kernel/mm/demand_paging.h>
+
+/* Time is counted in evictions, i.e. in page faults that had to replace
+ * a page, rather than with a timer: that is the rate at which the
+ * working set changes, and nothing needs to run while no page faults.
+ *
+ * At each eviction the accessed state of every page is sampled and
+ * cleared, and pages found accessed are stamped with the current time.
+ * The page with the oldest stamp is the least recently used one, to the
+ * resolution of one eviction. However, a clean page left out of the
+ * working set, i.e. not used for more than
+ * CONFIG_EVICTION_LRU_WORKING_SET_WINDOW evictions, is preferred over
+ * an older dirty page, since evicting it does not need a page out.
+ */
+static uint32_t last_used[Z_NUM_PAGE_FRAMES];
+static uint32_t now;
+
+struct z_page_frame *k_mem_paging_eviction_select(bool *dirty_ptr)
+{
+	struct z_page_frame *lru_pf = NULL, *clean_pf = NULL, *pf;
+	uint32_t lru_age = 0U, clean_age = 0U, age;
+	bool lru_dirty = false;
+	bool dirty;
+	uintptr_t flags, phys;
+
+	now++;
+
+	Z_PAGE_FRAME_FOREACH(phys, pf) {
+		size_t i = pf - z_page_frames;
+
+		if (!z_page_frame_is_evictable(pf)) {
+			continue;
+		}
+
+		/* Clears the accessed bit in the page tables */
+		flags = arch_page_info_get(pf->addr, NULL, true);
+		dirty = (flags & ARCH_DATA_PAGE_DIRTY) != 0UL;
+
+		__ASSERT((flags & ARCH_DATA_PAGE_LOADED) != 0U,
+			 "non-present page, %s",
+			 ((flags & ARCH_DATA_PAGE_NOT_MAPPED) != 0U) ?
+			 "un-mapped" : "paged out");
+
+		if ((flags & ARCH_DATA_PAGE_ACCESSED) != 0UL) {
+			last_used[i] = now;
+		}
+
+		age = now - last_used[i];
+
+		if ((lru_pf == NULL) || (age > lru_age) ||
+		    ((age == lru_age) && lru_dirty && !dirty)) {
+			lru_pf = pf;
+			lru_age = age;
+			lru_dirty = dirty;
+		}
+
+		if (!dirty && (age > CONFIG_EVICTION_LRU_WORKING_SET_WINDOW) &&
+		    ((clean_pf == NULL) || (age > clean_age))) {
+			clean_pf = pf;
+			clean_age = age;
+		}
+	}
+	/* Shouldn't ever happen unless every page is pinned */
+	__ASSERT(lru_pf != NULL, "no page to evict");
+
+	if ((clean_pf != NULL) && lru_dirty) {
+		lru_pf = clean_pf;
+		lru_dirty = false;
+	}
+
+	/* The page about to be loaded in this frame is the most recent */
+	last_used[lru_pf - z_page_frames] = now;
+
+	*dirty_ptr = lru_dirty;
+
+	return lru_pf;
+}
+
+void k_mem_paging_eviction_init(void)
+{
+}
@@ -62,7 +62,16 @@ LOG_MODULE_REGISTER(net_conn, CONFIG_NET_CONN_LOG_LEVEL);
 static struct net_conn conns[CONFIG_NET_MAX_CONN];
 
 static sys_slist_t conn_unused;
-static sys_slist_t conn_used;
+
+/* The used TCP and UDP connections are spread over hash buckets, keyed
+ * on the protocol, the local port (0 if not set) and, if both are set,
+ * the remote address and port. The other connections are kept in the
+ * extra list at CONN_UNHASHED. A packet only needs to be matched against
+ * the buckets of its exact and wildcard keys, see conn_pkt_lists().
+ */
+#define CONN_UNHASHED CONFIG_NET_CONN_HASH_SIZE
+
+static sys_slist_t conn_used[CONFIG_NET_CONN_HASH_SIZE + 1];
 
 #if (CONFIG_NET_CONN_LOG_LEVEL >= LOG_LEVEL_DBG)
 static inline
@@ -116,6 +125,120 @@ void conn_register_debug(struct net_conn *conn,
 
 static K_MUTEX_DEFINE(conn_lock);
 
+static inline uint32_t conn_hash_mix(uint32_t hash, uint32_t value)
+{
+	hash = (hash ^ value) * 0x9e3779b1U;
+
+	return hash ^ (hash >> 16);
+}
+
+/* The ports are in network byte order, and the remote port is only
+ * hashed along with a remote address.
+ */
+static size_t conn_hash(uint16_t proto, uint16_t local_port,
+			const uint8_t *remote_addr, size_t addr_len,
+			uint16_t remote_port)
+{
+	uint32_t hash = conn_hash_mix(proto, local_port);
+
+	if (remote_addr != NULL) {
+		hash = conn_hash_mix(hash, remote_port);
+
+		for (size_t i = 0; i < addr_len; i += sizeof(uint32_t)) {
+			hash = conn_hash_mix(hash,
+					     UNALIGNED_GET((const uint32_t *)&remote_addr[i]));
+		}
+	}
+
+	return hash % CONFIG_NET_CONN_HASH_SIZE;
+}
+
+static size_t conn_list_index(uint16_t proto, uint8_t family,
+			      const struct sockaddr *remote_addr,
+			      uint16_t remote_port, uint16_t local_port)
+{
+	const uint8_t *addr = NULL;
+	size_t addr_len = 0;
+
+	if ((proto != IPPROTO_TCP && proto != IPPROTO_UDP) ||
+	    (family != AF_INET && family != AF_INET6 && family != AF_UNSPEC)) {
+		return CONN_UNHASHED;
+	}
+
+	if (remote_addr != NULL && remote_port != 0U) {
+		if (IS_ENABLED(CONFIG_NET_IPV6) &&
+		    remote_addr->sa_family == AF_INET6 &&
+		    !net_ipv6_is_addr_unspecified(&net_sin6(remote_addr)->sin6_addr)) {
+			addr = net_sin6(remote_addr)->sin6_addr.s6_addr;
+			addr_len = sizeof(struct in6_addr);
+		} else if (IS_ENABLED(CONFIG_NET_IPV4) &&
+			   remote_addr->sa_family == AF_INET &&
+			   net_sin(remote_addr)->sin_addr.s_addr != 0U) {
+			addr = (const uint8_t *)&net_sin(remote_addr)->sin_addr;
+			addr_len = sizeof(struct in_addr);
+		}
+	}
+
+	return conn_hash(proto, local_port, addr, addr_len, remote_port);
+}
+
+static sys_slist_t *conn_list(struct net_conn *conn)
+{
+	const struct sockaddr *remote_addr = NULL;
+
+	if (conn->flags & NET_CONN_REMOTE_ADDR_SET) {
+		remote_addr = &conn->remote_addr;
+	}
+
+	return &conn_used[conn_list_index(conn->proto, conn->family, remote_addr,
+					  net_sin(&conn->remote_addr)->sin_port,
+					  net_sin(&conn->local_addr)->sin_port)];
+}
+
+/* Collect the buckets that can hold a TCP or UDP connection matching
+ * the packet, from the most to the least specific key. Connections of
+ * the same rank have the same key, so they are all in the same bucket
+ * and are matched in the same order as with a single list.
+ */
+static size_t conn_pkt_lists(struct net_pkt *pkt, union net_ip_header *ip_hdr,
+			     uint8_t proto, uint16_t src_port, uint16_t dst_port,
+			     size_t lists[4])
+{
+	const uint8_t *src;
+	size_t src_len;
+	size_t candidates[4];
+	size_t count = 0;
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) && net_pkt_family(pkt) == AF_INET6) {
+		src = ip_hdr->ipv6->src;
+		src_len = sizeof(struct in6_addr);
+	} else {
+		src = ip_hdr->ipv4->src;
+		src_len = sizeof(struct in_addr);
+	}
+
+	candidates[0] = conn_hash(proto, dst_port, src, src_len, src_port);
+	candidates[1] = conn_hash(proto, dst_port, NULL, 0, 0);
+	candidates[2] = conn_hash(proto, 0, src, src_len, src_port);
+	candidates[3] = conn_hash(proto, 0, NULL, 0, 0);
+
+	for (size_t i = 0; i < ARRAY_SIZE(candidates); i++) {
+		size_t j;
+
+		for (j = 0; j < count; j++) {
+			if (lists[j] == candidates[i]) {
+				break;
+			}
+		}
+
+		if (j == count) {
+			lists[count++] = candidates[i];
+		}
+	}
+
+	return count;
+}
+
 static struct net_conn *conn_get_unused(void)
 {
 	sys_snode_t *node;
@@ -140,7 +263,7 @@ static void conn_set_used(struct net_conn *conn)
 	conn->flags |= NET_CONN_IN_USE;
 
 	k_mutex_lock(&conn_lock, K_FOREVER);
-	sys_slist_prepend(&conn_used, &conn->node);
+	sys_slist_prepend(conn_list(conn), &conn->node);
 	k_mutex_unlock(&conn_lock);
 }
 
@@ -162,12 +285,15 @@ static struct net_conn *conn_find_handler(struct net_if *iface,
 					  uint16_t local_port,
 					  bool reuseport_set)
 {
+	sys_slist_t *list = &conn_used[conn_list_index(proto, family, remote_addr,
+							htons(remote_port),
+							htons(local_port))];
 	struct net_conn *conn;
 	struct net_conn *tmp;
 
 	k_mutex_lock(&conn_lock, K_FOREVER);
 
-	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&conn_used, conn, tmp, node) {
+	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(list, conn, tmp, node) {
 		if (conn->proto != proto) {
 			continue;
 		}
@@ -414,7 +540,7 @@ int net_conn_unregister(struct net_conn_handle *handle)
 	NET_DBG("Connection handler %p removed", conn);
 
 	k_mutex_lock(&conn_lock, K_FOREVER);
-	sys_slist_find_and_remove(&conn_used, &conn->node);
+	sys_slist_find_and_remove(conn_list(conn), &conn->node);
 	k_mutex_unlock(&conn_lock);
 
 	conn_set_unused(conn);
@@ -642,6 +768,9 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 	struct net_conn *conn;
 	net_conn_cb_t cb = NULL;
 	void *user_data = NULL;
+	size_t lists[4];
+	size_t num_lists = ARRAY_SIZE(conn_used);
+	bool hashed = false;
 
 	if (IS_ENABLED(CONFIG_NET_IP)) {
 		/* If we receive a packet with multicast destination address, we might
@@ -657,177 +786,199 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 		} else if (IS_ENABLED(CONFIG_NET_IPV6) && pkt_family == AF_INET6) {
 			is_mcast_pkt = net_ipv6_is_addr_mcast((struct in6_addr *)ip_hdr->ipv6->dst);
 		}
+
+		if ((pkt_family == AF_INET || pkt_family == AF_INET6) &&
+		    (proto == IPPROTO_TCP || proto == IPPROTO_UDP)) {
+			num_lists = conn_pkt_lists(pkt, ip_hdr, proto, src_port, dst_port, lists);
+			hashed = true;
+		}
 	}
 
 	k_mutex_lock(&conn_lock, K_FOREVER);
 
-	SYS_SLIST_FOR_EACH_CONTAINER(&conn_used, conn, node) {
-		/* Is the candidate connection matching the packet's interface? */
-		if (conn->context != NULL &&
-		    net_context_is_bound_to_iface(conn->context) &&
-		    net_pkt_iface(pkt) != net_context_get_iface(conn->context)) {
-			continue; /* wrong interface */
-		}
-
-		/* Is the candidate connection matching the packet's protocol family? */
-		if (conn->family != AF_UNSPEC &&
-		    conn->family != pkt_family) {
-			if (IS_ENABLED(CONFIG_NET_SOCKETS_PACKET)) {
-				/* If there are other listening connections than
-				 * AF_PACKET, the packet shall be also passed back to
-				 * net_conn_input() in upper layer processing in order to
-				 * re-check if there is any listening socket interested
-				 * in this packet.
-				 */
-				if (conn->family != AF_PACKET) {
-					raw_pkt_continue = true;
-				}
+	for (size_t i = 0; i < num_lists; i++) {
+		size_t list = hashed ? lists[i] : i;
+
+		/* Nothing can beat a fully specified unicast match */
+		if (!is_mcast_pkt && best_rank == NET_CONN_RANK(0xff)) {
+			break;
+		}
+
+		SYS_SLIST_FOR_EACH_CONTAINER(&conn_used[list], conn, node) {
+			/* Is the candidate connection matching the packet's interface? */
+			if (conn->context != NULL &&
+			    net_context_is_bound_to_iface(conn->context) &&
+			    net_pkt_iface(pkt) != net_context_get_iface(conn->context)) {
+				continue; /* wrong interface */
 			}
 
-			if (IS_ENABLED(CONFIG_NET_IPV4_MAPPING_TO_IPV6)) {
-				if (!(conn->family == AF_INET6 && pkt_family == AF_INET &&
-				      !conn->v6only)) {
-					continue;
+			/* Is the candidate connection matching the packet's protocol family? */
+			if (conn->family != AF_UNSPEC &&
+			    conn->family != pkt_family) {
+				if (IS_ENABLED(CONFIG_NET_SOCKETS_PACKET)) {
+					/* If there are other listening connections than
+					 * AF_PACKET, the packet shall be also passed back to
+					 * net_conn_input() in upper layer processing in order to
+					 * re-check if there is any listening socket interested
+					 * in this packet.
+					 */
+					if (conn->family != AF_PACKET) {
+						raw_pkt_continue = true;
+					}
 				}
-			} else {
-				continue; /* wrong protocol family */
-			}
 
-			/* We might have a match for v4-to-v6 mapping, check more */
-		}
+				if (IS_ENABLED(CONFIG_NET_IPV4_MAPPING_TO_IPV6)) {
+					if (!(conn->family == AF_INET6 && pkt_family == AF_INET &&
+					      !conn->v6only)) {
+						continue;
+					}
+				} else {
+					continue; /* wrong protocol family */
+				}
 
-		/* Is the candidate connection matching the packet's protocol wihin the family? */
-		if (conn->proto != proto) {
-			/* For packet socket data, the proto is set to ETH_P_ALL
-			 * or IPPROTO_RAW but the listener might have a specific
-			 * protocol set. This is ok and let the packet pass this
-			 * check in this case.
+				/* We might have a match for v4-to-v6 mapping, check more */
+			}
+
+			/* Is the candidate connection matching the packet's protocol
+			 * wihin the family?
 			 */
-			if (IS_ENABLED(CONFIG_NET_SOCKETS_PACKET) && pkt_family == AF_PACKET) {
-				if (proto != ETH_P_ALL && proto != IPPROTO_RAW) {
+			if (conn->proto != proto) {
+				/* For packet socket data, the proto is set to ETH_P_ALL
+				 * or IPPROTO_RAW but the listener might have a specific
+				 * protocol set. This is ok and let the packet pass this
+				 * check in this case.
+				 */
+				if (IS_ENABLED(CONFIG_NET_SOCKETS_PACKET) &&
+				    pkt_family == AF_PACKET) {
+					if (proto != ETH_P_ALL && proto != IPPROTO_RAW) {
+						continue; /* wrong protocol */
+					}
+				} else {
 					continue; /* wrong protocol */
 				}
-			} else {
-				continue; /* wrong protocol */
 			}
-		}
 
-		/* Apply protocol-specific matching criteria... */
-		uint8_t conn_family = conn->family;
+			/* Apply protocol-specific matching criteria... */
+			uint8_t conn_family = conn->family;
+
+			if (IS_ENABLED(CONFIG_NET_SOCKETS_PACKET) && conn_family == AF_PACKET) {
+				/* This code shall be only executed when one enters
+				 * the net_conn_input() from net_packet_socket() which
+				 * targets AF_PACKET sockets.
+				 *
+				 * All AF_PACKET connections will receive the packet if
+				 * their socket type and - in case of IPPROTO - protocol
+				 * also matches.
+				 */
+				if (proto == ETH_P_ALL) {
+					/* We shall continue with ETH_P_ALL to IPPROTO_RAW: */
+					raw_pkt_continue = true;
+				}
 
-		if (IS_ENABLED(CONFIG_NET_SOCKETS_PACKET) && conn_family == AF_PACKET) {
-			/* This code shall be only executed when one enters
-			 * the net_conn_input() from net_packet_socket() which
-			 * targets AF_PACKET sockets.
-			 *
-			 * All AF_PACKET connections will receive the packet if
-			 * their socket type and - in case of IPPROTO - protocol
-			 * also matches.
-			 */
-			if (proto == ETH_P_ALL) {
-				/* We shall continue with ETH_P_ALL to IPPROTO_RAW: */
-				raw_pkt_continue = true;
-			}
+				/* With IPPROTO_RAW deliver only if protocol match: */
+				if ((proto == ETH_P_ALL && conn->proto != IPPROTO_RAW) ||
+				    conn->proto == proto) {
+					enum net_verdict ret = conn_raw_socket(pkt, conn, proto);
 
-			/* With IPPROTO_RAW deliver only if protocol match: */
-			if ((proto == ETH_P_ALL && conn->proto != IPPROTO_RAW) ||
-			    conn->proto == proto) {
-				enum net_verdict ret = conn_raw_socket(pkt, conn, proto);
+					if (ret == NET_DROP) {
+						k_mutex_unlock(&conn_lock);
+						goto drop;
+					} else if (ret == NET_OK) {
+						raw_pkt_delivered = true;
+					}
 
-				if (ret == NET_DROP) {
-					k_mutex_unlock(&conn_lock);
-					goto drop;
-				} else if (ret == NET_OK) {
-					raw_pkt_delivered = true;
+					continue; /* packet was consumed */
+				}
+			} else if ((IS_ENABLED(CONFIG_NET_UDP) || IS_ENABLED(CONFIG_NET_TCP)) &&
+				   (conn_family == AF_INET || conn_family == AF_INET6 ||
+				    conn_family == AF_UNSPEC)) {
+				/* Is the candidate connection matching the packet's TCP/UDP
+				 * address and port?
+				 */
+				if (net_sin(&conn->remote_addr)->sin_port &&
+				    net_sin(&conn->remote_addr)->sin_port != src_port) {
+					continue; /* wrong remote port */
 				}
 
-				continue; /* packet was consumed */
-			}
-		} else if ((IS_ENABLED(CONFIG_NET_UDP) || IS_ENABLED(CONFIG_NET_TCP)) &&
-			   (conn_family == AF_INET || conn_family == AF_INET6 ||
-			    conn_family == AF_UNSPEC)) {
-			/* Is the candidate connection matching the packet's TCP/UDP
-			 * address and port?
-			 */
-			if (net_sin(&conn->remote_addr)->sin_port &&
-			    net_sin(&conn->remote_addr)->sin_port != src_port) {
-				continue; /* wrong remote port */
-			}
-
-			if (net_sin(&conn->local_addr)->sin_port &&
-			    net_sin(&conn->local_addr)->sin_port != dst_port) {
-				continue; /* wrong local port */
-			}
-
-			if ((conn->flags & NET_CONN_REMOTE_ADDR_SET) &&
-			    !conn_addr_cmp(pkt, ip_hdr, &conn->remote_addr, true)) {
-				continue; /* wrong remote address */
-			}
+				if (net_sin(&conn->local_addr)->sin_port &&
+				    net_sin(&conn->local_addr)->sin_port != dst_port) {
+					continue; /* wrong local port */
+				}
 
-			if ((conn->flags & NET_CONN_LOCAL_ADDR_SET) &&
-			    !conn_addr_cmp(pkt, ip_hdr, &conn->local_addr, false)) {
+				if ((conn->flags & NET_CONN_REMOTE_ADDR_SET) &&
+				    !conn_addr_cmp(pkt, ip_hdr, &conn->remote_addr, true)) {
+					continue; /* wrong remote address */
+				}
 
-				/* Check if we could do a v4-mapping-to-v6 and the IPv6 socket
-				 * has no IPV6_V6ONLY option set and if the local IPV6 address
-				 * is unspecified, then we could accept a connection from IPv4
-				 * address by mapping it to IPv6 address.
-				 */
-				if (IS_ENABLED(CONFIG_NET_IPV4_MAPPING_TO_IPV6)) {
-					if (!(conn->family == AF_INET6 && pkt_family == AF_INET &&
-					      !conn->v6only &&
-					      net_ipv6_is_addr_unspecified(
-						      &net_sin6(&conn->local_addr)->sin6_addr))) {
+				if ((conn->flags & NET_CONN_LOCAL_ADDR_SET) &&
+				    !conn_addr_cmp(pkt, ip_hdr, &conn->local_addr, false)) {
+
+					/* Check if we could do a v4-mapping-to-v6 and the IPv6
+					 * socket has no IPV6_V6ONLY option set and if the local
+					 * IPV6 address is unspecified, then we could accept a
+					 * connection from IPv4 address by mapping it to IPv6
+					 * address.
+					 */
+					if (IS_ENABLED(CONFIG_NET_IPV4_MAPPING_TO_IPV6)) {
+						if (!(conn->family == AF_INET6 &&
+						      pkt_family == AF_INET &&
+						      !conn->v6only &&
+						      net_ipv6_is_addr_unspecified(
+							      &net_sin6(&conn->local_addr)->
+							      sin6_addr))) {
+							continue; /* wrong local address */
+						}
+					} else {
 						continue; /* wrong local address */
 					}
-				} else {
-					continue; /* wrong local address */
+
+					/* We might have a match for v4-to-v6 mapping,
+					 * continue with rank checking.
+					 */
 				}
 
-				/* We might have a match for v4-to-v6 mapping,
-				 * continue with rank checking.
-				 */
-			}
+				if (best_rank < NET_CONN_RANK(conn->flags)) {
+					struct net_pkt *mcast_pkt;
 
-			if (best_rank < NET_CONN_RANK(conn->flags)) {
-				struct net_pkt *mcast_pkt;
+					if (!is_mcast_pkt) {
+						best_rank = NET_CONN_RANK(conn->flags);
+						best_match = conn;
 
-				if (!is_mcast_pkt) {
-					best_rank = NET_CONN_RANK(conn->flags);
-					best_match = conn;
+						/* found a match - but maybe not yet the best */
+						continue;
+					}
 
-					continue; /* found a match - but maybe not yet the best */
-				}
+					/* If we have a multicast packet, and we found
+					 * a match, then deliver the packet immediately
+					 * to the handler. As there might be several
+					 * sockets interested about these, we need to
+					 * clone the received pkt.
+					 */
 
-				/* If we have a multicast packet, and we found
-				 * a match, then deliver the packet immediately
-				 * to the handler. As there might be several
-				 * sockets interested about these, we need to
-				 * clone the received pkt.
-				 */
+					NET_DBG("[%p] mcast match found cb %p ud %p", conn,
+						conn->cb, conn->user_data);
 
-				NET_DBG("[%p] mcast match found cb %p ud %p", conn, conn->cb,
-					conn->user_data);
+					mcast_pkt = net_pkt_clone(pkt, CLONE_TIMEOUT);
+					if (!mcast_pkt) {
+						k_mutex_unlock(&conn_lock);
+						goto drop;
+					}
 
-				mcast_pkt = net_pkt_clone(pkt, CLONE_TIMEOUT);
-				if (!mcast_pkt) {
-					k_mutex_unlock(&conn_lock);
-					goto drop;
-				}
+					if (conn->cb(conn, mcast_pkt, ip_hdr, proto_hdr,
+						     conn->user_data) == NET_DROP) {
+						net_stats_update_per_proto_drop(pkt_iface, proto);
+						net_pkt_unref(mcast_pkt);
+					} else {
+						net_stats_update_per_proto_recv(pkt_iface, proto);
+					}
 
-				if (conn->cb(conn, mcast_pkt, ip_hdr, proto_hdr, conn->user_data) ==
-				    NET_DROP) {
-					net_stats_update_per_proto_drop(pkt_iface, proto);
-					net_pkt_unref(mcast_pkt);
-				} else {
-					net_stats_update_per_proto_recv(pkt_iface, proto);
+					mcast_pkt_delivered = true;
 				}
-
-				mcast_pkt_delivered = true;
+			} else if (IS_ENABLED(CONFIG_NET_SOCKETS_CAN) && conn_family == AF_CAN) {
+				best_match = conn;
 			}
-		} else if (IS_ENABLED(CONFIG_NET_SOCKETS_CAN) && conn_family == AF_CAN) {
-			best_match = conn;
-		}
-	} /* loop end */
+		} /* loop end */
+	}
 
 	if (best_match) {
 		cb = best_match->cb;
@@ -902,8 +1053,10 @@ void net_conn_foreach(net_conn_foreach_cb_t cb, void *user_data)
 
 	k_mutex_lock(&conn_lock, K_FOREVER);
 
-	SYS_SLIST_FOR_EACH_CONTAINER(&conn_used, conn, node) {
-		cb(conn, user_data);
+	ARRAY_FOR_EACH(conn_used, i) {
+		SYS_SLIST_FOR_EACH_CONTAINER(&conn_used[i], conn, node) {
+			cb(conn, user_data);
+		}
 	}
 
 	k_mutex_unlock(&conn_lock);
@@ -914,7 +1067,9 @@ void net_conn_init(void)
 	int i;
 
 	sys_slist_init(&conn_unused);
-	sys_slist_init(&conn_used);
+	for (i = 0; i < ARRAY_SIZE(conn_used); i++) {
+		sys_slist_init(&conn_used[i]);
+	}
 
 	for (i = 0; i < CONFIG_NET_MAX_CONN; i++) {
 		sys_slist_prepend(&conn_unused, &conns[i].node);
@@ -37,6 +37,7 @@ LOG_MODULE_REGISTER(net_pkt, CONFIG_NET_PKT_LOG_LEVEL);
 #include <zephyr/net/net_pkt.h>
 #include <zephyr/net/ethernet.h>
 #include <zephyr/net/udp.h>
+#include <zephyr/sys/mem_pressure.h>
 
 #include "net_private.h"
 #include "tcp_internal.h"
@@ -136,6 +137,21 @@ NET_BUF_POOL_VAR_DEFINE(tx_bufs, CONFIG_NET_BUF_TX_COUNT, CONFIG_NET_BUF_DATA_PO
 
 #endif /* CONFIG_NET_BUF_FIXED_DATA_SIZE */
 
+#if defined(CONFIG_NET_MEM_PRESSURE)
+static MEM_PRESSURE_SOURCE_DEFINE(net_rx_pkts, MEM_PRESSURE_K_MEM_SLAB, &rx_pkts,
+				  CONFIG_MEM_PRESSURE_LOW_THRESHOLD,
+				  CONFIG_MEM_PRESSURE_CRITICAL_THRESHOLD);
+static MEM_PRESSURE_SOURCE_DEFINE(net_tx_pkts, MEM_PRESSURE_K_MEM_SLAB, &tx_pkts,
+				  CONFIG_MEM_PRESSURE_LOW_THRESHOLD,
+				  CONFIG_MEM_PRESSURE_CRITICAL_THRESHOLD);
+static MEM_PRESSURE_SOURCE_DEFINE(net_rx_bufs, MEM_PRESSURE_NET_BUF_POOL, &rx_bufs,
+				  CONFIG_MEM_PRESSURE_LOW_THRESHOLD,
+				  CONFIG_MEM_PRESSURE_CRITICAL_THRESHOLD);
+static MEM_PRESSURE_SOURCE_DEFINE(net_tx_bufs, MEM_PRESSURE_NET_BUF_POOL, &tx_bufs,
+				  CONFIG_MEM_PRESSURE_LOW_THRESHOLD,
+				  CONFIG_MEM_PRESSURE_CRITICAL_THRESHOLD);
+#endif /* CONFIG_NET_MEM_PRESSURE */
+
 /* Allocation tracking is only available if separately enabled */
 #if defined(CONFIG_NET_DEBUG_NET_PKT_ALLOC)
 struct net_pkt_alloc {
@@ -2199,4 +2215,11 @@ void net_pkt_init(void)
 		get_frees(&rx_bufs), get_size(&rx_bufs),
 		get_frees(&tx_bufs), get_size(&tx_bufs));
 #endif
+
+#if defined(CONFIG_NET_MEM_PRESSURE)
+	(void)mem_pressure_source_register(&net_rx_pkts);
+	(void)mem_pressure_source_register(&net_tx_pkts);
+	(void)mem_pressure_source_register(&net_rx_bufs);
+	(void)mem_pressure_source_register(&net_tx_bufs);
+#endif
 }
@@ -18,6 +18,7 @@ LOG_MODULE_REGISTER(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
 #endif
 #include <zephyr/net/net_pkt.h>
 #include <zephyr/net/net_context.h>
+#include <zephyr/net/socket.h>
 #include <zephyr/net/udp.h>
 #include "ipv4.h"
 #include "ipv6.h"
@@ -58,7 +59,12 @@ static int tcp_tx_window =
 	CONFIG_NET_BUF_DATA_POOL_SIZE / 3;
 #endif /* CONFIG_NET_BUF_FIXED_DATA_SIZE */
 #endif
-#ifdef CONFIG_NET_TCP_RANDOMIZED_RTO
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+#define TCP_MAX_WINDOW ((uint32_t)UINT16_MAX << NET_TCP_MAX_WINDOW_SCALE)
+#else
+#define TCP_MAX_WINDOW UINT16_MAX
+#endif
+#if defined(CONFIG_NET_TCP_RANDOMIZED_RTO) || defined(CONFIG_NET_TCP_ADAPTIVE_RTO)
 #define TCP_RTO_MS (conn->rto)
 #else
 #define TCP_RTO_MS (tcp_rto)
@@ -376,88 +382,425 @@ out:
 	tcp_pkt_unref(pkt);
 }
 
-static void tcp_derive_rto(struct tcp *conn)
+static void tcp_rto_update(struct tcp *conn)
 {
+#if defined(CONFIG_NET_TCP_RANDOMIZED_RTO) || defined(CONFIG_NET_TCP_ADAPTIVE_RTO)
+	uint32_t rto = (uint32_t)tcp_rto;
+
+#ifdef CONFIG_NET_TCP_ADAPTIVE_RTO
+	if (conn->srtt != 0U) {
+		/* RTO = SRTT + max(G, 4 * RTTVAR), RFC 6298 ch 2, with a
+		 * clock granularity G of 1 ms.
+		 */
+		rto = (conn->srtt >> 3) + MAX(conn->rttvar, 1U);
+		rto = CLAMP(rto, CONFIG_NET_TCP_MIN_RETRANSMISSION_TIMEOUT,
+			    CONFIG_NET_TCP_MAX_RETRANSMISSION_TIMEOUT);
+	}
+#endif
 #ifdef CONFIG_NET_TCP_RANDOMIZED_RTO
-	/* Compute a randomized rto 1 and 1.5 times tcp_rto */
-	uint32_t gain;
-	uint8_t gain8;
-	uint32_t rto;
+	/* Between 1 and 1.5 times the rto */
+	rto = (((uint32_t)conn->rto_gain + (1 << 9)) * rto) >> 9;
+#endif
+
+	conn->rto = rto;
+#else
+	ARG_UNUSED(conn);
+#endif
+}
 
+static void tcp_derive_rto(struct tcp *conn)
+{
+#ifdef CONFIG_NET_TCP_RANDOMIZED_RTO
 	/* Getting random is computational expensive, so only use 8 bits */
-	sys_rand_get(&gain8, sizeof(uint8_t));
+	sys_rand_get(&conn->rto_gain, sizeof(uint8_t));
+#endif
 
-	gain = (uint32_t)gain8;
-	gain += 1 << 9;
+	tcp_rto_update(conn);
+}
+
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+/* The timestamp clock ticks every ms, from a random offset per
+ * connection, RFC 7323 ch 7.1.
+ */
+static uint32_t tcp_ts_now(struct tcp *conn)
+{
+	return k_uptime_get_32() + conn->ts_offset;
+}
 
-	rto = (uint32_t)tcp_rto;
-	rto = (gain * rto) >> 9;
-	conn->rto = (uint16_t)rto;
+/* Timestamps are sent in the SYNs that offer them and, once both ends
+ * did, in every segment.
+ */
+static bool tcp_ts_enabled(struct tcp *conn)
+{
+	return conn->send_options.ts_found || conn->ts_ok;
+}
 #else
-	ARG_UNUSED(conn);
+static inline bool tcp_ts_enabled(struct tcp *conn) { return false; }
 #endif
+
+#if defined(CONFIG_NET_TCP_ADAPTIVE_RTO)
+/* Update the smoothed RTT and its variation with a new measurement of
+ * rtt ms, RFC 6298 ch 2. The values are kept scaled by 8 and 4, as in
+ * the original algorithm of Jacobson, so that the gains of 1/8 and 1/4
+ * are shifts.
+ */
+static void tcp_rtt_sample(struct tcp *conn, uint32_t rtt)
+{
+	int32_t delta;
+
+	NET_DBG("conn: %p RTT %u ms", conn, rtt);
+
+	if (conn->srtt == 0U) {
+		conn->srtt = rtt << 3;
+		conn->rttvar = rtt << 1;
+	} else {
+		delta = (int32_t)rtt - (int32_t)(conn->srtt >> 3);
+		conn->srtt = (uint32_t)((int32_t)conn->srtt + delta);
+		conn->rttvar += abs(delta) - (conn->rttvar >> 2);
+	}
+
+	/* Zero means that no RTT was measured yet */
+	conn->srtt = MAX(conn->srtt, 1U);
+
+	tcp_rto_update(conn);
 }
 
-#ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
+/* Without timestamps one segment at a time is timed, from when it is
+ * sent until seq is acknowledged.
+ */
+static void tcp_rtt_start(struct tcp *conn, uint32_t seq)
+{
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+	if (conn->ts_ok) {
+		return;
+	}
+#endif
 
-/* Implementation according to RFC6582 */
+	if (!conn->rtt_timing) {
+		conn->rtt_seq = seq;
+		conn->rtt_start = k_uptime_get_32();
+		conn->rtt_timing = true;
+	}
+}
 
-static void tcp_new_reno_log(struct tcp *conn, char *step)
+/* The ACK of a retransmitted segment may be for either transmission, so
+ * it cannot be timed (Karn's algorithm).
+ */
+static void tcp_rtt_cancel(struct tcp *conn)
 {
-	NET_DBG("conn: %p, ca %s, cwnd=%d, ssthres=%d, fast_pend=%i",
-		conn, step, conn->ca.cwnd, conn->ca.ssthresh,
-		conn->ca.pending_fast_retransmit_bytes);
+	conn->rtt_timing = false;
 }
 
-static void tcp_new_reno_init(struct tcp *conn)
+/* Measure the RTT from an ACK that acknowledges new data */
+static void tcp_rtt_ack(struct tcp *conn, struct tcphdr *th)
+{
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+	if (conn->ts_ok) {
+		uint32_t rtt = tcp_ts_now(conn) - conn->recv_options.tsecr;
+
+		if (conn->recv_options.ts_found &&
+		    conn->recv_options.tsecr != 0U && (int32_t)rtt >= 0) {
+			tcp_rtt_sample(conn, rtt);
+		}
+
+		return;
+	}
+#endif
+
+	if (conn->rtt_timing &&
+	    net_tcp_seq_cmp(th_ack(th), conn->rtt_seq) >= 0) {
+		conn->rtt_timing = false;
+		tcp_rtt_sample(conn, k_uptime_get_32() - conn->rtt_start);
+	}
+}
+#else
+static inline void tcp_rtt_start(struct tcp *conn, uint32_t seq) { }
+static inline void tcp_rtt_cancel(struct tcp *conn) { }
+static inline void tcp_rtt_ack(struct tcp *conn, struct tcphdr *th) { }
+#endif /* CONFIG_NET_TCP_ADAPTIVE_RTO */
+
+#ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
+
+static void tcp_ca_log(struct tcp *conn, char *step)
+{
+	NET_DBG("conn: %p, ca %s %s, cwnd=%u, ssthres=%u, fast_pend=%u",
+		conn, conn->ca.ops->name, step, conn->ca.cwnd,
+		conn->ca.ssthresh, conn->ca.pending_fast_retransmit_bytes);
+}
+
+static void tcp_ca_initial_win(struct tcp *conn)
 {
 	conn->ca.cwnd = conn_mss(conn) * TCP_CONGESTION_INITIAL_WIN;
 	conn->ca.ssthresh = conn_mss(conn) * TCP_CONGESTION_INITIAL_SSTHRESH;
+}
+
+/* Grow the window by up to a MSS per ACK below the slow start threshold,
+ * returns false when above it.
+ */
+static bool tcp_ca_slow_start(struct tcp *conn, uint32_t acked_len)
+{
+	if (conn->ca.cwnd >= conn->ca.ssthresh) {
+		return false;
+	}
+
+	conn->ca.cwnd = MIN(conn->ca.cwnd + MIN(acked_len, conn_mss(conn)),
+			    TCP_MAX_WINDOW);
+
+	return true;
+}
+
+/* Implementation according to RFC6582 */
+
+static void tcp_new_reno_init(struct tcp *conn)
+{
+	tcp_ca_initial_win(conn);
+}
+
+static void tcp_new_reno_on_ack(struct tcp *conn, uint32_t acked_len)
+{
+	uint32_t win_inc = MIN(acked_len, conn_mss(conn));
+
+	if (tcp_ca_slow_start(conn, acked_len)) {
+		return;
+	}
+
+	/* Implement a div_ceil	to avoid rounding to 0 */
+	conn->ca.cwnd = MIN(conn->ca.cwnd + ((win_inc * win_inc) + conn->ca.cwnd - 1) /
+			    conn->ca.cwnd, TCP_MAX_WINDOW);
+}
+
+static void tcp_new_reno_on_loss(struct tcp *conn)
+{
+	conn->ca.ssthresh = MAX(conn_mss(conn) * 2, conn->unacked_len / 2);
+}
+
+static void tcp_new_reno_on_timeout(struct tcp *conn)
+{
+	tcp_new_reno_on_loss(conn);
+	conn->ca.cwnd = conn_mss(conn);
+}
+
+static const struct tcp_ca_ops tcp_new_reno = {
+	.name = "reno",
+	.init = tcp_new_reno_init,
+	.on_ack = tcp_new_reno_on_ack,
+	.on_loss = tcp_new_reno_on_loss,
+	.on_timeout = tcp_new_reno_on_timeout,
+};
+
+#ifdef CONFIG_NET_TCP_CONGESTION_CUBIC
+
+/* Implementation according to RFC9438, with C = 0.4 and beta = 0.7. The
+ * window is computed in bytes and the time in ms.
+ */
+#define CUBIC_BETA_NUM 7
+#define CUBIC_BETA_DEN 10
+/* 1 / C in ms^3 per segment */
+#define CUBIC_C_INV_MS 2500000000ULL
+/* Far past the time that any window takes to reach TCP_MAX_WINDOW, and
+ * small enough for t^3 * mss not to overflow.
+ */
+#define CUBIC_MAX_T_MS (1 << 19)
+
+static uint32_t cubic_cbrt(uint64_t x)
+{
+	uint64_t y = 0U;
+
+	for (int shift = 63; shift >= 0; shift -= 3) {
+		uint64_t b;
+
+		y <<= 1;
+		b = 3U * y * (y + 1U) + 1U;
+		if ((x >> shift) >= b) {
+			x -= b << shift;
+			y++;
+		}
+	}
+
+	return y;
+}
+
+static uint32_t tcp_cubic_rtt(struct tcp *conn)
+{
+#if defined(CONFIG_NET_TCP_ADAPTIVE_RTO)
+	return conn->srtt >> 3;
+#else
+	return 0U;
+#endif
+}
+
+static void tcp_cubic_init(struct tcp *conn)
+{
+	tcp_ca_initial_win(conn);
+	memset(&conn->ca.cubic, 0, sizeof(conn->ca.cubic));
+}
+
+static void tcp_cubic_epoch_start(struct tcp *conn)
+{
+	struct tcp_cubic *cubic = &conn->ca.cubic;
+
+	cubic->in_epoch = true;
+	cubic->epoch_start = k_uptime_get_32();
+	cubic->w_est = conn->ca.cwnd;
+
+	if (conn->ca.cwnd < cubic->w_max) {
+		/* K = cbrt((W_max - cwnd) / C) */
+		cubic->k = cubic_cbrt((uint64_t)(cubic->w_max - conn->ca.cwnd) *
+				      CUBIC_C_INV_MS / conn_mss(conn));
+		cubic->origin = cubic->w_max;
+	} else {
+		cubic->k = 0U;
+		cubic->origin = conn->ca.cwnd;
+	}
+}
+
+/* W_cubic(t) = C * (t - K)^3 + W_max, t being one RTT from now */
+static uint32_t tcp_cubic_target(struct tcp *conn)
+{
+	struct tcp_cubic *cubic = &conn->ca.cubic;
+	int32_t t = k_uptime_get_32() - cubic->epoch_start +
+		    tcp_cubic_rtt(conn) - cubic->k;
+	uint64_t dt = MIN(abs(t), CUBIC_MAX_T_MS);
+	uint64_t offs;
+
+	offs = (dt * dt * dt / 1000U) * conn_mss(conn) / (CUBIC_C_INV_MS / 1000U);
+	offs = MIN(offs, TCP_MAX_WINDOW);
+
+	if (t < 0) {
+		return cubic->origin > offs ? cubic->origin - offs : 0U;
+	}
+
+	return MIN(cubic->origin + offs, TCP_MAX_WINDOW);
+}
+
+static void tcp_cubic_on_ack(struct tcp *conn, uint32_t acked_len)
+{
+	struct tcp_cubic *cubic = &conn->ca.cubic;
+	uint32_t cwnd = conn->ca.cwnd;
+	uint32_t alpha_num, alpha_den;
+	uint32_t target;
+
+	if (tcp_ca_slow_start(conn, acked_len)) {
+		return;
+	}
+
+	if (!cubic->in_epoch) {
+		tcp_cubic_epoch_start(conn);
+	}
+
+	/* Window of a Reno flow with the same loss rate, which grows by
+	 * alpha = 3 * (1 - beta) / (1 + beta) segments per RTT until W_max.
+	 */
+	if (cubic->w_est < cubic->w_max) {
+		alpha_num = 3U * (CUBIC_BETA_DEN - CUBIC_BETA_NUM);
+		alpha_den = CUBIC_BETA_DEN + CUBIC_BETA_NUM;
+	} else {
+		alpha_num = 1U;
+		alpha_den = 1U;
+	}
+
+	cubic->w_est = MIN(cubic->w_est + DIV_ROUND_UP((uint64_t)alpha_num * acked_len *
+						       conn_mss(conn),
+						       (uint64_t)alpha_den * cwnd),
+			   TCP_MAX_WINDOW);
+
+	target = tcp_cubic_target(conn);
+
+	if (cubic->w_est >= target) {
+		/* Reno-friendly region */
+		conn->ca.cwnd = MAX(cwnd, cubic->w_est);
+	} else if (target > cwnd) {
+		/* Concave or convex region, reach the target in a RTT but do
+		 * not grow by more than half of the window.
+		 */
+		target = MIN(target, cwnd + cwnd / 2U);
+		conn->ca.cwnd = MIN(cwnd + (uint64_t)(target - cwnd) * acked_len / cwnd,
+				    target);
+	}
+}
+
+static void tcp_cubic_on_loss(struct tcp *conn)
+{
+	struct tcp_cubic *cubic = &conn->ca.cubic;
+	uint32_t flight = conn->unacked_len;
+
+	cubic->in_epoch = false;
+
+	/* Fast convergence, release bandwidth to newer flows */
+	if (flight < cubic->w_max) {
+		cubic->w_max = (uint64_t)flight * (CUBIC_BETA_DEN + CUBIC_BETA_NUM) /
+			       (2U * CUBIC_BETA_DEN);
+	} else {
+		cubic->w_max = flight;
+	}
+
+	conn->ca.ssthresh = MAX(conn_mss(conn) * 2,
+				(uint64_t)flight * CUBIC_BETA_NUM / CUBIC_BETA_DEN);
+}
+
+static void tcp_cubic_on_timeout(struct tcp *conn)
+{
+	tcp_cubic_on_loss(conn);
+	conn->ca.cwnd = conn_mss(conn);
+}
+
+static const struct tcp_ca_ops tcp_cubic = {
+	.name = "cubic",
+	.init = tcp_cubic_init,
+	.on_ack = tcp_cubic_on_ack,
+	.on_loss = tcp_cubic_on_loss,
+	.on_timeout = tcp_cubic_on_timeout,
+};
+#endif /* CONFIG_NET_TCP_CONGESTION_CUBIC */
+
+static const struct tcp_ca_ops *const tcp_ca_algorithms[] = {
+	&tcp_new_reno,
+#ifdef CONFIG_NET_TCP_CONGESTION_CUBIC
+	&tcp_cubic,
+#endif
+};
+
+#if defined(CONFIG_NET_TCP_CONGESTION_DEFAULT_CUBIC)
+#define TCP_CA_DEFAULT (&tcp_cubic)
+#else
+#define TCP_CA_DEFAULT (&tcp_new_reno)
+#endif
+
+static void tcp_ca_init(struct tcp *conn)
+{
 	conn->ca.pending_fast_retransmit_bytes = 0;
-	tcp_new_reno_log(conn, "init");
+	conn->ca.ops->init(conn);
+	tcp_ca_log(conn, "init");
 }
 
-static void tcp_new_reno_fast_retransmit(struct tcp *conn)
+static void tcp_ca_fast_retransmit(struct tcp *conn)
 {
 	if (conn->ca.pending_fast_retransmit_bytes == 0) {
-		conn->ca.ssthresh = MAX(conn_mss(conn) * 2, conn->unacked_len / 2);
+		conn->ca.ops->on_loss(conn);
 		/* Account for the lost segments */
 		conn->ca.cwnd = conn_mss(conn) * 3 + conn->ca.ssthresh;
 		conn->ca.pending_fast_retransmit_bytes = conn->unacked_len;
-		tcp_new_reno_log(conn, "fast_retransmit");
+		tcp_ca_log(conn, "fast_retransmit");
 	}
 }
 
-static void tcp_new_reno_timeout(struct tcp *conn)
+static void tcp_ca_timeout(struct tcp *conn)
 {
-	conn->ca.ssthresh = MAX(conn_mss(conn) * 2, conn->unacked_len / 2);
-	conn->ca.cwnd = conn_mss(conn);
-	tcp_new_reno_log(conn, "timeout");
+	conn->ca.ops->on_timeout(conn);
+	tcp_ca_log(conn, "timeout");
 }
 
 /* For every duplicate ack increment the cwnd by mss */
-static void tcp_new_reno_dup_ack(struct tcp *conn)
+static void tcp_ca_dup_ack(struct tcp *conn)
 {
-	int32_t new_win = conn->ca.cwnd;
-
-	new_win += conn_mss(conn);
-	conn->ca.cwnd = MIN(new_win, UINT16_MAX);
-	tcp_new_reno_log(conn, "dup_ack");
+	conn->ca.cwnd = MIN(conn->ca.cwnd + conn_mss(conn), TCP_MAX_WINDOW);
+	tcp_ca_log(conn, "dup_ack");
 }
 
-static void tcp_new_reno_pkts_acked(struct tcp *conn, uint32_t acked_len)
+static void tcp_ca_pkts_acked(struct tcp *conn, uint32_t acked_len)
 {
-	int32_t new_win = conn->ca.cwnd;
-	int32_t win_inc = MIN(acked_len, conn_mss(conn));
-
 	if (conn->ca.pending_fast_retransmit_bytes == 0) {
-		if (conn->ca.cwnd < conn->ca.ssthresh) {
-			new_win += win_inc;
-		} else {
-			/* Implement a div_ceil	to avoid rounding to 0 */
-			new_win += ((win_inc * win_inc) + conn->ca.cwnd - 1) / conn->ca.cwnd;
-		}
-		conn->ca.cwnd = MIN(new_win, UINT16_MAX);
+		conn->ca.ops->on_ack(conn, acked_len);
 	} else {
 		/* Check if it is still in fast recovery mode */
 		if (conn->ca.pending_fast_retransmit_bytes <= acked_len) {
@@ -465,35 +808,68 @@ static void tcp_new_reno_pkts_acked(struct tcp *conn, uint32_t acked_len)
 			conn->ca.cwnd = conn->ca.ssthresh;
 		} else {
 			conn->ca.pending_fast_retransmit_bytes -= acked_len;
-			conn->ca.cwnd -= acked_len;
+			conn->ca.cwnd -= MIN(acked_len, conn->ca.cwnd - conn_mss(conn));
 		}
 	}
-	tcp_new_reno_log(conn, "pkts_acked");
+	tcp_ca_log(conn, "pkts_acked");
 }
 
-static void tcp_ca_init(struct tcp *conn)
+static void tcp_ca_param_copy(struct tcp *to, struct tcp *from)
 {
-	tcp_new_reno_init(conn);
+	to->ca.ops = from->ca.ops;
 }
 
-static void tcp_ca_fast_retransmit(struct tcp *conn)
+static int set_tcp_congestion(struct tcp *conn, const void *value, size_t len)
 {
-	tcp_new_reno_fast_retransmit(conn);
-}
+	const char *end;
+	size_t name_len;
 
-static void tcp_ca_timeout(struct tcp *conn)
-{
-	tcp_new_reno_timeout(conn);
-}
+	if (conn == NULL || value == NULL) {
+		return -EINVAL;
+	}
 
-static void tcp_ca_dup_ack(struct tcp *conn)
-{
-	tcp_new_reno_dup_ack(conn);
+	/* The name does not need to be NUL terminated */
+	end = memchr(value, '\0', len);
+	name_len = end != NULL ? end - (const char *)value : len;
+
+	ARRAY_FOR_EACH(tcp_ca_algorithms, i) {
+		const struct tcp_ca_ops *ops = tcp_ca_algorithms[i];
+
+		if (strlen(ops->name) != name_len ||
+		    strncmp(ops->name, value, name_len) != 0) {
+			continue;
+		}
+
+		if (ops != conn->ca.ops) {
+			conn->ca.ops = ops;
+
+			/* Start afresh if the window is already in use */
+			if (conn->state >= TCP_ESTABLISHED &&
+			    conn->state <= TCP_CLOSE_WAIT) {
+				tcp_ca_init(conn);
+			}
+		}
+
+		return 0;
+	}
+
+	return -ENOENT;
 }
 
-static void tcp_ca_pkts_acked(struct tcp *conn, uint32_t acked_len)
+static int get_tcp_congestion(struct tcp *conn, void *value, size_t *len)
 {
-	tcp_new_reno_pkts_acked(conn, acked_len);
+	const char *name;
+
+	if (conn == NULL || value == NULL || len == NULL || *len == 0) {
+		return -EINVAL;
+	}
+
+	name = conn->ca.ops->name;
+
+	*len = MIN(*len, strlen(name) + 1);
+	memcpy(value, name, *len);
+
+	return 0;
 }
 #else
 
@@ -507,6 +883,11 @@ static void tcp_ca_dup_ack(struct tcp *conn) { }
 
 static void tcp_ca_pkts_acked(struct tcp *conn, uint32_t acked_len) { }
 
+static void tcp_ca_param_copy(struct tcp *to, struct tcp *from) { }
+
+#define set_tcp_congestion(...) (-ENOPROTOOPT)
+#define get_tcp_congestion(...) (-ENOPROTOOPT)
+
 #endif
 
 #if defined(CONFIG_NET_TCP_KEEPALIVE)
@@ -868,6 +1249,7 @@ static bool tcp_send_process_no_lock(struct tcp *conn)
 			struct net_pkt *clone = tcp_pkt_clone(pkt);
 
 			if (clone) {
+				tcp_rtt_cancel(conn);
 				tcp_send(clone);
 				conn->send_retries--;
 			}
@@ -1052,8 +1434,12 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 
 	NET_DBG("len=%zd", len);
 
-	recv_options->mss_found = false;
-	recv_options->wnd_found = false;
+	/* The options of the SYN apply to the whole connection, so they are
+	 * kept when later segments carry other options such as SACK blocks.
+	 */
+#if defined(CONFIG_NET_TCP_SACK)
+	recv_options->sack_blocks = 0U;
+#endif
 
 	for ( ; options && len >= 1; options += opt_len, len -= opt_len) {
 		opt = options[0];
@@ -1099,9 +1485,63 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 				goto end;
 			}
 
-			recv_options->window = opt;
+			recv_options->window = options[2];
+			if (recv_options->window > NET_TCP_MAX_WINDOW_SCALE) {
+				NET_DBG("Window scale %hu limited to %d",
+					recv_options->window,
+					NET_TCP_MAX_WINDOW_SCALE);
+				recv_options->window = NET_TCP_MAX_WINDOW_SCALE;
+			}
 			recv_options->wnd_found = true;
+			NET_DBG("WS=%hu", recv_options->window);
 			break;
+#if defined(CONFIG_NET_TCP_SACK)
+		case NET_TCP_SACK_PERM_OPT:
+			if (opt_len != NET_TCP_SACK_PERM_SIZE) {
+				result = false;
+				goto end;
+			}
+
+			recv_options->sack_perm_found = true;
+			break;
+		case NET_TCP_SACK_OPT:
+			if (opt_len < 2 + NET_TCP_SACK_BLOCK_SIZE ||
+			    ((opt_len - 2) % NET_TCP_SACK_BLOCK_SIZE) != 0) {
+				result = false;
+				goto end;
+			}
+
+			recv_options->sack_blocks =
+				MIN((opt_len - 2) / NET_TCP_SACK_BLOCK_SIZE,
+				    NET_TCP_MAX_SACK_BLOCKS);
+
+			for (int i = 0; i < recv_options->sack_blocks; i++) {
+				uint8_t *block = options + 2 +
+						 i * NET_TCP_SACK_BLOCK_SIZE;
+
+				recv_options->sack[i].left =
+					ntohl(UNALIGNED_GET((uint32_t *)block));
+				recv_options->sack[i].right =
+					ntohl(UNALIGNED_GET((uint32_t *)(block + 4)));
+				NET_DBG("SACK %u-%u", recv_options->sack[i].left,
+					recv_options->sack[i].right);
+			}
+			break;
+#endif
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+		case NET_TCP_TIMESTAMPS_OPT:
+			if (opt_len != NET_TCP_TIMESTAMPS_SIZE) {
+				result = false;
+				goto end;
+			}
+
+			recv_options->tsval =
+				ntohl(UNALIGNED_GET((uint32_t *)(options + 2)));
+			recv_options->tsecr =
+				ntohl(UNALIGNED_GET((uint32_t *)(options + 6)));
+			recv_options->ts_found = true;
+			break;
+#endif
 		default:
 			continue;
 		}
@@ -1140,10 +1580,10 @@ static int tcp_update_recv_wnd(struct tcp *conn, int32_t delta)
 	bool short_win_before;
 	bool short_win_after;
 
-	new_win = conn->recv_win + delta;
+	new_win = (int32_t)conn->recv_win + delta;
 	if (new_win < 0) {
 		new_win = 0;
-	} else if (new_win > conn->recv_win_max) {
+	} else if (new_win > (int32_t)conn->recv_win_max) {
 		new_win = conn->recv_win_max;
 	}
 
@@ -1275,6 +1715,22 @@ static int tcp_finalize_pkt(struct net_pkt *pkt)
 	return -EINVAL;
 }
 
+/* Window to advertise in a segment. The window in a SYN segment is never
+ * scaled, RFC 7323 ch 2.2.
+ */
+static uint16_t tcp_adv_win(struct tcp *conn, uint8_t flags)
+{
+	uint32_t win = conn->recv_win;
+
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+	if (!(flags & SYN)) {
+		win >>= conn->recv_win_scale;
+	}
+#endif
+
+	return MIN(win, UINT16_MAX);
+}
+
 static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
 			  uint32_t seq)
 {
@@ -1296,82 +1752,345 @@ static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
 		th->th_off++;
 	}
 
+	if (conn->send_options.wnd_found) {
+		th->th_off++;
+	}
+
+#if defined(CONFIG_NET_TCP_SACK)
+	if (conn->send_options.sack_perm_found) {
+		th->th_off++;
+	}
+
+	if (conn->send_options.sack_blocks > 0) {
+		th->th_off += 1 + conn->send_options.sack_blocks *
+				  NET_TCP_SACK_BLOCK_SIZE / 4;
+	}
+#endif
+
+	if (tcp_ts_enabled(conn)) {
+		th->th_off += 3;
+	}
+
 	UNALIGNED_PUT(flags, &th->th_flags);
-	UNALIGNED_PUT(htons(conn->recv_win), &th->th_win);
+	UNALIGNED_PUT(htons(tcp_adv_win(conn, flags)), &th->th_win);
 	UNALIGNED_PUT(htonl(seq), &th->th_seq);
 
-	if (ACK & flags) {
-		UNALIGNED_PUT(htonl(conn->ack), &th->th_ack);
+	if (ACK & flags) {
+		UNALIGNED_PUT(htonl(conn->ack), &th->th_ack);
+	}
+
+	return net_pkt_set_data(pkt, &tcp_access);
+}
+
+static int ip_header_add(struct tcp *conn, struct net_pkt *pkt)
+{
+	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == AF_INET) {
+		return net_context_create_ipv4_new(conn->context, pkt,
+						&conn->src.sin.sin_addr,
+						&conn->dst.sin.sin_addr);
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) && net_pkt_family(pkt) == AF_INET6) {
+		return net_context_create_ipv6_new(conn->context, pkt,
+						&conn->src.sin6.sin6_addr,
+						&conn->dst.sin6.sin6_addr);
+	}
+
+	return -EINVAL;
+}
+
+static int set_tcp_nodelay(struct tcp *conn, const void *value, size_t len)
+{
+	int no_delay_int;
+
+	if (len != sizeof(int)) {
+		return -EINVAL;
+	}
+
+	no_delay_int = *(int *)value;
+
+	if ((no_delay_int < 0) || (no_delay_int > 1)) {
+		return -EINVAL;
+	}
+
+	conn->tcp_nodelay = (bool)no_delay_int;
+
+	return 0;
+}
+
+static int get_tcp_nodelay(struct tcp *conn, void *value, size_t *len)
+{
+	int no_delay_int = (int)conn->tcp_nodelay;
+
+	*((int *)value) = no_delay_int;
+
+	if (len) {
+		*len = sizeof(int);
+	}
+	return 0;
+}
+
+static int get_tcp_info(struct tcp *conn, void *value, size_t *len)
+{
+	struct tcp_info info = { 0 };
+
+	if (value == NULL || len == NULL) {
+		return -EINVAL;
+	}
+
+	info.tcpi_retransmits = conn->send_data_retries;
+	info.tcpi_rto = TCP_RTO_MS * USEC_PER_MSEC;
+	info.tcpi_snd_mss = conn_mss(conn);
+	info.tcpi_snd_wnd = conn->send_win;
+	info.tcpi_rcv_wnd = conn->recv_win;
+	info.tcpi_bytes_in_flight = conn->unacked_len;
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+	if (conn->recv_options.wnd_found) {
+		info.tcpi_options |= TCPI_OPT_WSCALE;
+		info.tcpi_snd_wscale = conn->send_win_scale;
+		info.tcpi_rcv_wscale = conn->recv_win_scale;
+	}
+#endif
+#if defined(CONFIG_NET_TCP_SACK)
+	if (conn->sack_ok) {
+		info.tcpi_options |= TCPI_OPT_SACK;
+	}
+#endif
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+	if (conn->ts_ok) {
+		info.tcpi_options |= TCPI_OPT_TIMESTAMPS;
+	}
+#endif
+#if defined(CONFIG_NET_TCP_ADAPTIVE_RTO)
+	info.tcpi_rtt = (conn->srtt * USEC_PER_MSEC) >> 3;
+	info.tcpi_rttvar = (conn->rttvar * USEC_PER_MSEC) >> 2;
+#endif
+#ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
+	info.tcpi_snd_cwnd = conn->ca.cwnd;
+	info.tcpi_snd_ssthresh = conn->ca.ssthresh;
+#endif
+
+	*len = MIN(*len, sizeof(info));
+	memcpy(value, &info, *len);
+
+	return 0;
+}
+
+static int net_tcp_set_mss_opt(struct tcp *conn, struct net_pkt *pkt)
+{
+	NET_PKT_DATA_ACCESS_DEFINE(mss_opt_access, struct tcp_mss_option);
+	struct tcp_mss_option *mss;
+	uint32_t recv_mss;
+
+	mss = net_pkt_get_data(pkt, &mss_opt_access);
+	if (!mss) {
+		return -ENOBUFS;
+	}
+
+	recv_mss = net_tcp_get_supported_mss(conn);
+	recv_mss |= (NET_TCP_MSS_OPT << 24) | (NET_TCP_MSS_SIZE << 16);
+
+	UNALIGNED_PUT(htonl(recv_mss), (uint32_t *)mss);
+
+	return net_pkt_set_data(pkt, &mss_opt_access);
+}
+
+static int net_tcp_set_wnd_scale_opt(struct tcp *conn, struct net_pkt *pkt)
+{
+	NET_PKT_DATA_ACCESS_DEFINE(wnd_opt_access, uint32_t);
+	uint32_t *opt;
+	uint32_t wnd_scale;
+
+	opt = net_pkt_get_data(pkt, &wnd_opt_access);
+	if (!opt) {
+		return -ENOBUFS;
+	}
+
+	/* Preceded by a NOP to keep the options aligned */
+	wnd_scale = conn->send_options.window;
+	wnd_scale |= (NET_TCP_NOP_OPT << 24) | (NET_TCP_WINDOW_SCALE_OPT << 16) |
+		     (NET_TCP_WINDOW_SCALE_SIZE << 8);
+
+	UNALIGNED_PUT(htonl(wnd_scale), opt);
+
+	return net_pkt_set_data(pkt, &wnd_opt_access);
+}
+
+#if defined(CONFIG_NET_TCP_SACK)
+static int net_tcp_set_sack_perm_opt(struct tcp *conn, struct net_pkt *pkt)
+{
+	NET_PKT_DATA_ACCESS_DEFINE(sack_perm_opt_access, uint32_t);
+	uint32_t *opt;
+	uint32_t sack_perm;
+
+	opt = net_pkt_get_data(pkt, &sack_perm_opt_access);
+	if (!opt) {
+		return -ENOBUFS;
+	}
+
+	sack_perm = (NET_TCP_NOP_OPT << 24) | (NET_TCP_NOP_OPT << 16) |
+		    (NET_TCP_SACK_PERM_OPT << 8) | NET_TCP_SACK_PERM_SIZE;
+
+	UNALIGNED_PUT(htonl(sack_perm), opt);
+
+	return net_pkt_set_data(pkt, &sack_perm_opt_access);
+}
+
+static int net_tcp_set_sack_opt(struct tcp *conn, struct net_pkt *pkt)
+{
+	struct tcp_options *opts = &conn->send_options;
+	uint32_t sack;
+	int ret;
+
+	sack = (NET_TCP_NOP_OPT << 24) | (NET_TCP_NOP_OPT << 16) |
+	       (NET_TCP_SACK_OPT << 8) |
+	       (2 + opts->sack_blocks * NET_TCP_SACK_BLOCK_SIZE);
+	sack = htonl(sack);
+
+	ret = net_pkt_write(pkt, &sack, sizeof(sack));
+
+	for (int i = 0; ret == 0 && i < opts->sack_blocks; i++) {
+		ret = net_pkt_write_be32(pkt, opts->sack[i].left);
+		if (ret == 0) {
+			ret = net_pkt_write_be32(pkt, opts->sack[i].right);
+		}
+	}
+
+	return ret;
+}
+
+/* The out-of-order queue holds a single contiguous block of data, which
+ * is reported in the pure ACKs sent while it is not empty.
+ */
+static void tcp_sack_blocks_set(struct tcp *conn, uint8_t flags,
+				struct net_pkt *data)
+{
+	struct tcp_options *opts = &conn->send_options;
+
+	opts->sack_blocks = 0U;
+
+	if (!conn->sack_ok || data != NULL || (flags & (SYN | RST)) ||
+	    !(flags & ACK) || CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT == 0 ||
+	    net_pkt_is_empty(conn->queue_recv_data)) {
+		return;
 	}
 
-	return net_pkt_set_data(pkt, &tcp_access);
+	opts->sack[0].left = tcp_get_seq(conn->queue_recv_data->buffer);
+	opts->sack[0].right = opts->sack[0].left +
+			      net_pkt_get_len(conn->queue_recv_data);
+	opts->sack_blocks = 1U;
 }
+#endif /* CONFIG_NET_TCP_SACK */
 
-static int ip_header_add(struct tcp *conn, struct net_pkt *pkt)
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+static int net_tcp_set_ts_opt(struct tcp *conn, struct net_pkt *pkt,
+			      uint8_t flags)
 {
-	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == AF_INET) {
-		return net_context_create_ipv4_new(conn->context, pkt,
-						&conn->src.sin.sin_addr,
-						&conn->dst.sin.sin_addr);
+	uint32_t ts;
+	int ret;
+
+	ts = (NET_TCP_NOP_OPT << 24) | (NET_TCP_NOP_OPT << 16) |
+	     (NET_TCP_TIMESTAMPS_OPT << 8) | NET_TCP_TIMESTAMPS_SIZE;
+	ts = htonl(ts);
+
+	ret = net_pkt_write(pkt, &ts, sizeof(ts));
+	if (ret == 0) {
+		ret = net_pkt_write_be32(pkt, tcp_ts_now(conn));
 	}
 
-	if (IS_ENABLED(CONFIG_NET_IPV6) && net_pkt_family(pkt) == AF_INET6) {
-		return net_context_create_ipv6_new(conn->context, pkt,
-						&conn->src.sin6.sin6_addr,
-						&conn->dst.sin6.sin6_addr);
+	/* Only the timestamps of an ACK are echoes, RFC 7323 ch 3.2 */
+	if (ret == 0) {
+		ret = net_pkt_write_be32(pkt, (flags & ACK) ? conn->ts_recent : 0U);
 	}
 
-	return -EINVAL;
+	return ret;
 }
 
-static int set_tcp_nodelay(struct tcp *conn, const void *value, size_t len)
+/* Keep the timestamp to echo from the segments that cover the left edge
+ * of the receive window, RFC 7323 ch 4.3.
+ */
+static void tcp_ts_recv(struct tcp *conn, struct tcphdr *th)
 {
-	int no_delay_int;
+	struct tcp_options *opts = &conn->recv_options;
 
-	if (len != sizeof(int)) {
-		return -EINVAL;
+	if (!opts->ts_found) {
+		return;
 	}
 
-	no_delay_int = *(int *)value;
-
-	if ((no_delay_int < 0) || (no_delay_int > 1)) {
-		return -EINVAL;
+	if ((th_flags(th) & SYN) ||
+	    (net_tcp_seq_cmp(th_seq(th), conn->ack) <= 0 &&
+	     (int32_t)(opts->tsval - conn->ts_recent) >= 0)) {
+		conn->ts_recent = opts->tsval;
 	}
-
-	conn->tcp_nodelay = (bool)no_delay_int;
-
-	return 0;
 }
+#else
+static inline void tcp_ts_recv(struct tcp *conn, struct tcphdr *th) { }
+#endif /* CONFIG_NET_TCP_TIMESTAMPS */
 
-static int get_tcp_nodelay(struct tcp *conn, void *value, size_t *len)
+/* Set up the options of an outgoing SYN. Our window scale shift is the
+ * smallest one that fits the largest receive window in the 16-bit window
+ * field. A SYN-ACK only carries the window scale, SACK permitted and
+ * timestamps options if the peer's SYN did.
+ */
+static void tcp_syn_options_offer(struct tcp *conn, bool syn_ack)
 {
-	int no_delay_int = (int)conn->tcp_nodelay;
-
-	*((int *)value) = no_delay_int;
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+	uint8_t scale = 0U;
 
-	if (len) {
-		*len = sizeof(int);
+	while (scale < NET_TCP_MAX_WINDOW_SCALE &&
+	       (conn->recv_win_max >> scale) > UINT16_MAX) {
+		scale++;
 	}
-	return 0;
+
+	conn->send_options.window = scale;
+	conn->send_options.wnd_found = !syn_ack || conn->recv_options.wnd_found;
+#endif
+#if defined(CONFIG_NET_TCP_SACK)
+	conn->send_options.sack_perm_found =
+		!syn_ack || conn->recv_options.sack_perm_found;
+#endif
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+	conn->send_options.ts_found = !syn_ack || conn->recv_options.ts_found;
+#endif
 }
 
-static int net_tcp_set_mss_opt(struct tcp *conn, struct net_pkt *pkt)
+/* Windows are scaled from the first segment after the SYNs on, if both
+ * ends sent the window scale option, RFC 7323 ch 2.2. SACK is used if
+ * both ends sent the SACK permitted option, RFC 2018 ch 2, and timestamps
+ * if both sent the timestamps option, RFC 7323 ch 3.2.
+ */
+static void tcp_syn_options_set(struct tcp *conn)
 {
-	NET_PKT_DATA_ACCESS_DEFINE(mss_opt_access, struct tcp_mss_option);
-	struct tcp_mss_option *mss;
-	uint32_t recv_mss;
-
-	mss = net_pkt_get_data(pkt, &mss_opt_access);
-	if (!mss) {
-		return -ENOBUFS;
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+	if (conn->recv_options.wnd_found) {
+		conn->recv_win_scale = conn->send_options.window;
+		conn->send_win_scale = conn->recv_options.window;
+	} else {
+		conn->recv_win_scale = 0U;
+		conn->send_win_scale = 0U;
 	}
 
-	recv_mss = net_tcp_get_supported_mss(conn);
-	recv_mss |= (NET_TCP_MSS_OPT << 24) | (NET_TCP_MSS_SIZE << 16);
+	NET_DBG("conn: %p window scale recv %hu send %hu", conn,
+		(uint16_t)conn->recv_win_scale, (uint16_t)conn->send_win_scale);
+#endif
+#if defined(CONFIG_NET_TCP_SACK)
+	conn->sack_ok = conn->recv_options.sack_perm_found;
 
-	UNALIGNED_PUT(htonl(recv_mss), (uint32_t *)mss);
+	NET_DBG("conn: %p SACK %s", conn, conn->sack_ok ? "on" : "off");
+#endif
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+	conn->ts_ok = conn->recv_options.ts_found;
 
-	return net_pkt_set_data(pkt, &mss_opt_access);
+	NET_DBG("conn: %p timestamps %s", conn, conn->ts_ok ? "on" : "off");
+#endif
+}
+
+static void tcp_syn_options_clear(struct tcp *conn)
+{
+	conn->send_options.mss_found = false;
+	conn->send_options.wnd_found = false;
+	conn->send_options.sack_perm_found = false;
+	conn->send_options.ts_found = false;
 }
 
 static bool is_destination_local(struct net_pkt *pkt)
@@ -1484,6 +2203,26 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		alloc_len += sizeof(uint32_t);
 	}
 
+	if (conn->send_options.wnd_found) {
+		alloc_len += sizeof(uint32_t);
+	}
+
+#if defined(CONFIG_NET_TCP_SACK)
+	if (conn->send_options.sack_perm_found) {
+		alloc_len += sizeof(uint32_t);
+	}
+
+	tcp_sack_blocks_set(conn, flags, data);
+	if (conn->send_options.sack_blocks > 0) {
+		alloc_len += sizeof(uint32_t) +
+			     conn->send_options.sack_blocks * NET_TCP_SACK_BLOCK_SIZE;
+	}
+#endif
+
+	if (tcp_ts_enabled(conn)) {
+		alloc_len += 3 * sizeof(uint32_t);
+	}
+
 	pkt = tcp_pkt_alloc(conn, alloc_len);
 	if (!pkt) {
 		ret = -ENOBUFS;
@@ -1516,6 +2255,42 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		}
 	}
 
+	if (conn->send_options.wnd_found) {
+		ret = net_tcp_set_wnd_scale_opt(conn, pkt);
+		if (ret < 0) {
+			tcp_pkt_unref(pkt);
+			goto out;
+		}
+	}
+
+#if defined(CONFIG_NET_TCP_SACK)
+	if (conn->send_options.sack_perm_found) {
+		ret = net_tcp_set_sack_perm_opt(conn, pkt);
+		if (ret < 0) {
+			tcp_pkt_unref(pkt);
+			goto out;
+		}
+	}
+
+	if (conn->send_options.sack_blocks > 0) {
+		ret = net_tcp_set_sack_opt(conn, pkt);
+		if (ret < 0) {
+			tcp_pkt_unref(pkt);
+			goto out;
+		}
+	}
+#endif
+
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+	if (tcp_ts_enabled(conn)) {
+		ret = net_tcp_set_ts_opt(conn, pkt, flags);
+		if (ret < 0) {
+			tcp_pkt_unref(pkt);
+			goto out;
+		}
+	}
+#endif
+
 	ret = tcp_finalize_pkt(pkt);
 	if (ret < 0) {
 		tcp_pkt_unref(pkt);
@@ -1669,11 +2444,39 @@ static int tcp_unsent_len(struct tcp *conn)
 	return unsent_len;
 }
 
+/* Send len bytes of the queued data, starting offset bytes after seq */
+static int tcp_send_segment(struct tcp *conn, size_t offset, int len)
+{
+	struct net_pkt *pkt;
+	int ret;
+
+	pkt = tcp_pkt_alloc(conn, len);
+	if (!pkt) {
+		NET_ERR("conn: %p packet allocation failed, len=%d", conn, len);
+		return -ENOBUFS;
+	}
+
+	ret = tcp_pkt_peek(pkt, conn->send_data, offset, len);
+	if (ret < 0) {
+		tcp_pkt_unref(pkt);
+		return -ENOBUFS;
+	}
+
+	ret = tcp_out_ext(conn, PSH | ACK, pkt, conn->seq + offset);
+
+	/* The data we want to send, has been moved to the send queue so we
+	 * can unref the head net_pkt. If there was an error, we need to remove
+	 * the packet anyway.
+	 */
+	tcp_pkt_unref(pkt);
+
+	return ret;
+}
+
 static int tcp_send_data(struct tcp *conn)
 {
 	int ret = 0;
 	int len;
-	struct net_pkt *pkt;
 
 	len = MIN(tcp_unsent_len(conn), conn_mss(conn));
 	if (len < 0) {
@@ -1686,24 +2489,14 @@ static int tcp_send_data(struct tcp *conn)
 		goto out;
 	}
 
-	pkt = tcp_pkt_alloc(conn, len);
-	if (!pkt) {
-		NET_ERR("conn: %p packet allocation failed, len=%d", conn, len);
-		ret = -ENOBUFS;
-		goto out;
-	}
-
-	ret = tcp_pkt_peek(pkt, conn->send_data, conn->unacked_len, len);
-	if (ret < 0) {
-		tcp_pkt_unref(pkt);
-		ret = -ENOBUFS;
-		goto out;
-	}
-
-	ret = tcp_out_ext(conn, PSH | ACK, pkt, conn->seq + conn->unacked_len);
+	ret = tcp_send_segment(conn, conn->unacked_len, len);
 	if (ret == 0) {
 		conn->unacked_len += len;
 
+		if (conn->data_mode == TCP_DATA_MODE_SEND) {
+			tcp_rtt_start(conn, conn->seq + conn->unacked_len);
+		}
+
 		if (conn->data_mode == TCP_DATA_MODE_RESEND) {
 			net_stats_update_tcp_resent(conn->iface, len);
 			net_stats_update_tcp_seg_rexmit(conn->iface);
@@ -1713,12 +2506,6 @@ static int tcp_send_data(struct tcp *conn)
 		}
 	}
 
-	/* The data we want to send, has been moved to the send queue so we
-	 * can unref the head net_pkt. If there was an error, we need to remove
-	 * the packet anyway.
-	 */
-	tcp_pkt_unref(pkt);
-
 	conn_send_data_dump(conn);
 
  out:
@@ -1773,6 +2560,183 @@ static int tcp_send_queued_data(struct tcp *conn)
 	return ret;
 }
 
+#if defined(CONFIG_NET_TCP_SACK)
+/* The scoreboard is a sorted list of disjoint blocks. Sequence numbers
+ * are compared as offsets from seq, which are all within the send queue.
+ */
+static void tcp_sack_add(struct tcp *conn, uint32_t start, uint32_t end)
+{
+	struct tcp_sack_block *sb = conn->sacked;
+	int i, j;
+
+	for (i = 0; i < conn->sacked_blocks &&
+		    (sb[i].right - conn->seq) < start; i++) {
+	}
+
+	/* Merge the blocks overlapping or adjacent to the new one */
+	for (j = i; j < conn->sacked_blocks &&
+		    (sb[j].left - conn->seq) <= end; j++) {
+		start = MIN(start, sb[j].left - conn->seq);
+		end = MAX(end, sb[j].right - conn->seq);
+	}
+
+	if (i == j) {
+		/* Nothing merged, when the scoreboard is full the block
+		 * furthest from seq is forgotten.
+		 */
+		if (conn->sacked_blocks == NET_TCP_MAX_SACK_BLOCKS) {
+			if (i == NET_TCP_MAX_SACK_BLOCKS) {
+				return;
+			}
+
+			conn->sacked_blocks--;
+		}
+
+		memmove(&sb[i + 1], &sb[i],
+			(conn->sacked_blocks - i) * sizeof(sb[0]));
+		conn->sacked_blocks++;
+	} else {
+		memmove(&sb[i + 1], &sb[j],
+			(conn->sacked_blocks - j) * sizeof(sb[0]));
+		conn->sacked_blocks -= j - i - 1;
+	}
+
+	sb[i].left = conn->seq + start;
+	sb[i].right = conn->seq + end;
+}
+
+/* Add the SACK blocks of a received ACK to the scoreboard */
+static void tcp_sack_update(struct tcp *conn)
+{
+	struct tcp_options *opts = &conn->recv_options;
+
+	for (int i = 0; conn->sack_ok && i < opts->sack_blocks; i++) {
+		uint32_t start = opts->sack[i].left - conn->seq;
+		uint32_t end = opts->sack[i].right - conn->seq;
+
+		/* Ignore blocks that are already acknowledged or that do
+		 * not match the data sent.
+		 */
+		if (end == 0U || end > conn->send_data_total) {
+			continue;
+		}
+
+		if (start >= end) {
+			start = 0U;
+		}
+
+		tcp_sack_add(conn, start, end);
+	}
+
+	/* The blocks are only valid for the segment that carried them */
+	opts->sack_blocks = 0U;
+}
+
+/* Drop the acknowledged data from the scoreboard, called before seq
+ * is advanced by len_acked.
+ */
+static void tcp_sack_acked(struct tcp *conn, uint32_t len_acked)
+{
+	struct tcp_sack_block *sb = conn->sacked;
+	int i;
+
+	for (i = 0; i < conn->sacked_blocks &&
+		    (sb[i].right - conn->seq) <= len_acked; i++) {
+	}
+
+	memmove(&sb[0], &sb[i], (conn->sacked_blocks - i) * sizeof(sb[0]));
+	conn->sacked_blocks -= i;
+
+	if (conn->sacked_blocks > 0 && (sb[0].left - conn->seq) < len_acked) {
+		sb[0].left = conn->seq + len_acked;
+	}
+}
+
+static void tcp_sack_reset(struct tcp *conn)
+{
+	conn->sacked_blocks = 0U;
+	conn->sack_recovery = false;
+}
+
+/* Start loss recovery after a fast retransmit trigger, RFC 6675 */
+static bool tcp_sack_recovery_start(struct tcp *conn)
+{
+	if (!conn->sack_ok) {
+		return false;
+	}
+
+	conn->sack_recovery = true;
+	conn->sack_recovery_point = conn->seq + conn->unacked_len;
+	conn->sack_high_rxt = conn->seq;
+
+	NET_DBG("conn: %p SACK recovery until %u", conn,
+		conn->sack_recovery_point);
+
+	return true;
+}
+
+/* Retransmit the next segment the scoreboard reports missing, that is
+ * not SACKed, not retransmitted yet in this recovery and below the
+ * highest SACKed data. Without SACK information, a partial ACK means
+ * that the data at seq is missing too.
+ */
+static void tcp_sack_retransmit(struct tcp *conn)
+{
+	struct tcp_sack_block *sb = conn->sacked;
+	uint32_t from = 0U;
+	uint32_t len = 0U;
+	int ret;
+
+	if (!conn->sack_recovery) {
+		return;
+	}
+
+	if (net_tcp_seq_cmp(conn->seq, conn->sack_recovery_point) >= 0) {
+		NET_DBG("conn: %p SACK recovery done", conn);
+		conn->sack_recovery = false;
+		return;
+	}
+
+	if (net_tcp_seq_cmp(conn->sack_high_rxt, conn->seq) > 0) {
+		from = conn->sack_high_rxt - conn->seq;
+	}
+
+	for (int i = 0; i < conn->sacked_blocks; i++) {
+		uint32_t left = sb[i].left - conn->seq;
+
+		if (from < left) {
+			len = left - from;
+			break;
+		}
+
+		from = MAX(from, sb[i].right - conn->seq);
+	}
+
+	if (len == 0U && from == 0U) {
+		len = conn->unacked_len;
+	}
+
+	len = MIN(len, conn_mss(conn));
+	if (len == 0U) {
+		return;
+	}
+
+	ret = tcp_send_segment(conn, from, len);
+	if (ret == 0) {
+		tcp_rtt_cancel(conn);
+		conn->sack_high_rxt = conn->seq + from + len;
+		net_stats_update_tcp_resent(conn->iface, len);
+		net_stats_update_tcp_seg_rexmit(conn->iface);
+	}
+}
+#else
+static inline void tcp_sack_update(struct tcp *conn) { }
+static inline void tcp_sack_acked(struct tcp *conn, uint32_t len_acked) { }
+static inline void tcp_sack_reset(struct tcp *conn) { }
+static inline bool tcp_sack_recovery_start(struct tcp *conn) { return false; }
+static inline void tcp_sack_retransmit(struct tcp *conn) { }
+#endif /* CONFIG_NET_TCP_SACK */
+
 static void tcp_cleanup_recv_queue(struct k_work *work)
 {
 	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
@@ -1808,6 +2772,9 @@ static void tcp_resend_data(struct k_work *work)
 		goto out;
 	}
 
+	/* The peer may have discarded the data it SACKed, RFC 2018 ch 8 */
+	tcp_sack_reset(conn);
+
 	if (IS_ENABLED(CONFIG_NET_TCP_CONGESTION_AVOIDANCE) &&
 	    (conn->send_data_retries == 0)) {
 		tcp_ca_timeout(conn);
@@ -1818,6 +2785,7 @@ static void tcp_resend_data(struct k_work *work)
 
 	conn->data_mode = TCP_DATA_MODE_RESEND;
 	conn->unacked_len = 0;
+	tcp_rtt_cancel(conn);
 
 	ret = tcp_send_data(conn);
 	conn->send_data_retries++;
@@ -1859,6 +2827,10 @@ static void tcp_resend_data(struct k_work *work)
 		}
 	}
 
+#if defined(CONFIG_NET_TCP_ADAPTIVE_RTO)
+	exp_tcp_rto = MIN(exp_tcp_rto, CONFIG_NET_TCP_MAX_RETRANSMISSION_TIMEOUT);
+#endif
+
 	k_work_reschedule_for_queue(&tcp_work_q, &conn->send_data_timer,
 				    K_MSEC(exp_tcp_rto));
 
@@ -2058,7 +3030,7 @@ static struct tcp *tcp_conn_alloc(void)
 
 	conn->in_connect = false;
 	conn->state = TCP_LISTEN;
-	conn->recv_win_max = tcp_rx_window;
+	conn->recv_win_max = MIN(tcp_rx_window, TCP_MAX_WINDOW);
 	conn->recv_win = conn->recv_win_max;
 	conn->send_win_max = MAX(tcp_tx_window, NET_IPV6_MTU);
 	conn->send_win = conn->send_win_max;
@@ -2070,7 +3042,11 @@ static struct tcp *tcp_conn_alloc(void)
 	/* Initially set the congestion window at its max size, since only the MSS
 	 * is available as soon as the connection is established
 	 */
-	conn->ca.cwnd = UINT16_MAX;
+	conn->ca.ops = TCP_CA_DEFAULT;
+	conn->ca.cwnd = TCP_MAX_WINDOW;
+#endif
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+	conn->ts_offset = sys_rand32_get();
 #endif
 
 	/* The ISN value will be set when we get the connection attempt or
@@ -2706,6 +3682,7 @@ static void tcp_check_sock_options(struct tcp *conn)
 
 		k_mutex_lock(&conn->lock, K_FOREVER);
 
+		rcvbuf_opt = MIN(rcvbuf_opt, TCP_MAX_WINDOW);
 		diff = rcvbuf_opt - conn->recv_win_max;
 		conn->recv_win_max = rcvbuf_opt;
 		tcp_update_recv_wnd(conn, diff);
@@ -2785,6 +3762,13 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 		goto out;
 	}
 
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+	/* Unlike the options of the SYN, the timestamps are only valid for
+	 * the segment that carried them.
+	 */
+	conn->recv_options.ts_found = false;
+#endif
+
 	if (tcp_options_len && !tcp_options_check(&conn->recv_options, pkt,
 						  tcp_options_len)) {
 		NET_DBG("DROP: Invalid TCP option list");
@@ -2794,6 +3778,10 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 		goto out;
 	}
 
+	if (th) {
+		tcp_ts_recv(conn, th);
+	}
+
 	if (th && (conn->state != TCP_LISTEN) && (conn->state != TCP_SYN_SENT) &&
 	    tcp_validate_seq(conn, th) && FL(&fl, &, SYN)) {
 		/* According to RFC 793, ch 3.9 Event Processing, receiving SYN
@@ -2811,6 +3799,11 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 
 	if (th) {
 		conn->send_win = ntohs(th_win(th));
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+		if (!(th_flags(th) & SYN)) {
+			conn->send_win <<= conn->send_win_scale;
+		}
+#endif
 		if (conn->send_win > conn->send_win_max) {
 			NET_DBG("Lowering send window from %u to %u",
 				conn->send_win, conn->send_win_max);
@@ -2844,9 +3837,12 @@ next_state:
 		if (FL(&fl, ==, SYN)) {
 			/* Make sure our MSS is also sent in the ACK */
 			conn->send_options.mss_found = true;
+			tcp_syn_options_offer(conn, true);
+			tcp_syn_options_set(conn);
 			conn_ack(conn, th_seq(th) + 1); /* capture peer's isn */
+			tcp_rtt_start(conn, conn->seq + 1);
 			tcp_out(conn, SYN | ACK);
-			conn->send_options.mss_found = false;
+			tcp_syn_options_clear(conn);
 			conn_seq(conn, + 1);
 			next = TCP_SYN_RECEIVED;
 
@@ -2858,8 +3854,10 @@ next_state:
 			verdict = NET_OK;
 		} else {
 			conn->send_options.mss_found = true;
+			tcp_syn_options_offer(conn, false);
+			tcp_rtt_start(conn, conn->seq + 1);
 			tcp_out(conn, SYN);
-			conn->send_options.mss_found = false;
+			tcp_syn_options_clear(conn);
 			conn_seq(conn, + 1);
 			next = TCP_SYN_SENT;
 			tcp_conn_ref(conn);
@@ -2875,10 +3873,12 @@ next_state:
 				accept_cb = conn->accepted_conn->accept_cb;
 				context = conn->accepted_conn->context;
 				keep_alive_param_copy(conn, conn->accepted_conn);
+				tcp_ca_param_copy(conn, conn->accepted_conn);
 			}
 
 			k_work_cancel_delayable(&conn->establish_timer);
 			tcp_send_timer_cancel(conn);
+			tcp_rtt_ack(conn, th);
 			tcp_conn_ref(conn);
 			net_context_set_state(conn->context,
 					      NET_CONTEXT_CONNECTED);
@@ -2964,6 +3964,8 @@ next_state:
 		 */
 		if (FL(&fl, &, SYN | ACK, th && th_ack(th) == conn->seq)) {
 			tcp_send_timer_cancel(conn);
+			tcp_syn_options_set(conn);
+			tcp_rtt_ack(conn, th);
 			conn_ack(conn, th_seq(th) + 1);
 			if (len) {
 				verdict = tcp_data_get(conn, pkt, &len);
@@ -3049,6 +4051,10 @@ next_state:
 		 */
 		keep_alive_timer_restart(conn);
 
+		if (th) {
+			tcp_sack_update(conn);
+		}
+
 #ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
 		if (th && (net_tcp_seq_cmp(th_ack(th), conn->seq) == 0)) {
 			/* Only if there is pending data, increment the duplicate ack count */
@@ -3069,16 +4075,21 @@ next_state:
 			/* Only do fast retransmit when not already in a resend state */
 			if ((conn->data_mode == TCP_DATA_MODE_SEND) &&
 			    (conn->dup_ack_cnt == DUPLICATE_ACK_RETRANSMIT_TRHESHOLD)) {
-				/* Apply a fast retransmit */
-				int temp_unacked_len = conn->unacked_len;
+				/* Apply a fast retransmit, with SACK the
+				 * recovery below retransmits the missing data.
+				 */
+				if (!tcp_sack_recovery_start(conn)) {
+					int temp_unacked_len = conn->unacked_len;
 
-				conn->unacked_len = 0;
+					conn->unacked_len = 0;
 
-				(void)tcp_send_data(conn);
+					(void)tcp_send_data(conn);
 
-				/* Restore the current transmission */
-				conn->unacked_len = temp_unacked_len;
+					/* Restore the current transmission */
+					conn->unacked_len = temp_unacked_len;
+				}
 
+				tcp_rtt_cancel(conn);
 				tcp_ca_fast_retransmit(conn);
 				if (tcp_window_full(conn)) {
 					(void)k_sem_take(&conn->tx_sem, K_NO_WAIT);
@@ -3114,6 +4125,8 @@ next_state:
 			conn->dup_ack_cnt = 0;
 #endif
 			tcp_ca_pkts_acked(conn, len_acked);
+			tcp_sack_acked(conn, len_acked);
+			tcp_rtt_ack(conn, th);
 
 			conn->send_data_total -= len_acked;
 			if (conn->unacked_len < len_acked) {
@@ -3179,6 +4192,9 @@ next_state:
 		}
 
 		if (th) {
+			/* Continue a SACK loss recovery */
+			tcp_sack_retransmit(conn);
+
 			if (th_seq(th) == conn->ack) {
 				if (len > 0) {
 					verdict = tcp_data_received(conn, pkt, &len);
@@ -4359,6 +5375,13 @@ int net_tcp_set_option(struct net_context *context,
 	case TCP_OPT_KEEPCNT:
 		ret = set_tcp_keep_cnt(conn, value, len);
 		break;
+	case TCP_OPT_INFO:
+		/* Read-only */
+		ret = -EINVAL;
+		break;
+	case TCP_OPT_CONGESTION:
+		ret = set_tcp_congestion(conn, value, len);
+		break;
 	}
 
 	k_mutex_unlock(&conn->lock);
@@ -4396,6 +5419,12 @@ int net_tcp_get_option(struct net_context *context,
 	case TCP_OPT_KEEPCNT:
 		ret = get_tcp_keep_cnt(conn, value, len);
 		break;
+	case TCP_OPT_INFO:
+		ret = get_tcp_info(conn, value, len);
+		break;
+	case TCP_OPT_CONGESTION:
+		ret = get_tcp_congestion(conn, value, len);
+		break;
 	}
 
 	k_mutex_unlock(&conn->lock);
@@ -130,10 +130,18 @@
 
 #define NET_TCP_DEFAULT_MSS 536
 
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+/* Length of the options sent in every data segment, RFC 6691 */
+#define conn_opts_len(_conn)						\
+	((_conn)->ts_ok ? NET_TCP_TIMESTAMPS_SIZE + 2 : 0)
+#else
+#define conn_opts_len(_conn) 0
+#endif
+
 #define conn_mss(_conn)							\
-	MIN((_conn)->recv_options.mss_found ? (_conn)->recv_options.mss	\
-					    : NET_TCP_DEFAULT_MSS,	\
-	    net_tcp_get_supported_mss(_conn))
+	(MIN((_conn)->recv_options.mss_found ? (_conn)->recv_options.mss \
+					     : NET_TCP_DEFAULT_MSS,	\
+	     net_tcp_get_supported_mss(_conn)) - conn_opts_len(_conn))
 
 #define conn_state(_conn, _s)						\
 ({									\
@@ -146,7 +154,7 @@
 #define conn_send_data_dump(_conn)                                             \
 	({                                                                     \
 		NET_DBG("conn: %p total=%zd, unacked_len=%d, "                 \
-			"send_win=%hu, mss=%hu",                               \
+			"send_win=%u, mss=%hu",                                \
 			(_conn), net_pkt_get_len((_conn)->send_data),          \
 			_conn->unacked_len, _conn->send_win,                   \
 			(uint16_t)conn_mss((_conn)));                          \
@@ -227,30 +235,89 @@ union tcp_endpoint {
 #define NET_TCP_NOP_OPT          1
 #define NET_TCP_MSS_OPT          2
 #define NET_TCP_WINDOW_SCALE_OPT 3
+#define NET_TCP_SACK_PERM_OPT    4
+#define NET_TCP_SACK_OPT         5
+#define NET_TCP_TIMESTAMPS_OPT   8
 
 /* TCP Option sizes */
 #define NET_TCP_END_SIZE          1
 #define NET_TCP_NOP_SIZE          1
 #define NET_TCP_MSS_SIZE          4
 #define NET_TCP_WINDOW_SCALE_SIZE 3
+#define NET_TCP_SACK_PERM_SIZE    2
+#define NET_TCP_SACK_BLOCK_SIZE   8
+#define NET_TCP_TIMESTAMPS_SIZE   10
+
+/* Largest window scale shift allowed by RFC 7323 */
+#define NET_TCP_MAX_WINDOW_SCALE 14
+
+/* Largest number of blocks in a SACK option, RFC 2018 */
+#define NET_TCP_MAX_SACK_BLOCKS 4
+
+struct tcp_sack_block {
+	uint32_t left;
+	uint32_t right;
+};
 
 struct tcp_options {
 	uint16_t mss;
 	uint16_t window;
+#if defined(CONFIG_NET_TCP_SACK)
+	struct tcp_sack_block sack[NET_TCP_MAX_SACK_BLOCKS];
+	uint8_t sack_blocks;
+#endif
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+	uint32_t tsval;
+	uint32_t tsecr;
+#endif
 	bool mss_found : 1;
 	bool wnd_found : 1;
+	bool sack_perm_found : 1;
+	bool ts_found : 1;
 };
 
+struct tcp;
+
 #ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
 
-struct tcp_collision_avoidance_reno {
-	uint16_t cwnd;
-	uint16_t ssthresh;
-	uint16_t pending_fast_retransmit_bytes;
+/* Congestion control algorithm. The fast recovery of RFC 6582 is common
+ * to all of them, the algorithm sets the congestion window on ACKs that
+ * are not part of a recovery and the slow start threshold on losses.
+ */
+struct tcp_ca_ops {
+	const char *name;
+	/* Set the initial window when the connection is established */
+	void (*init)(struct tcp *conn);
+	/* Grow the window when new data is acknowledged */
+	void (*on_ack)(struct tcp *conn, uint32_t acked_len);
+	/* Set the slow start threshold on the third duplicate ACK */
+	void (*on_loss)(struct tcp *conn);
+	/* Set the slow start threshold and window on a retransmission timeout */
+	void (*on_timeout)(struct tcp *conn);
+};
+
+#ifdef CONFIG_NET_TCP_CONGESTION_CUBIC
+struct tcp_cubic {
+	uint32_t w_max;       /* Window before the last reduction */
+	uint32_t w_est;       /* Window of an equivalent Reno flow */
+	uint32_t origin;      /* Window at the plateau of the cubic function */
+	uint32_t k;           /* Time to reach the plateau (ms) */
+	uint32_t epoch_start; /* Start of the current growth epoch (ms) */
+	bool in_epoch : 1;
+};
+#endif
+
+struct tcp_congestion_avoidance {
+	const struct tcp_ca_ops *ops;
+	uint32_t cwnd;
+	uint32_t ssthresh;
+	uint32_t pending_fast_retransmit_bytes;
+#ifdef CONFIG_NET_TCP_CONGESTION_CUBIC
+	struct tcp_cubic cubic;
+#endif
 };
 #endif
 
-struct tcp;
 typedef void (*net_tcp_closed_cb_t)(struct tcp *conn, void *user_data);
 
 struct tcp { /* TCP connection */
@@ -314,15 +381,43 @@ struct tcp { /* TCP connection */
 	uint32_t keep_cnt;
 	uint32_t keep_cur;
 #endif /* CONFIG_NET_TCP_KEEPALIVE */
-	uint16_t recv_win_max;
-	uint16_t recv_win;
-	uint16_t send_win_max;
-	uint16_t send_win;
+	uint32_t recv_win_max;
+	uint32_t recv_win;
+	uint32_t send_win_max;
+	uint32_t send_win;
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+	uint8_t recv_win_scale;
+	uint8_t send_win_scale;
+#endif
+#if defined(CONFIG_NET_TCP_SACK)
+	/* SACK scoreboard, the data above seq the peer has reported */
+	struct tcp_sack_block sacked[NET_TCP_MAX_SACK_BLOCKS];
+	uint32_t sack_recovery_point;
+	uint32_t sack_high_rxt;
+	uint8_t sacked_blocks;
+	bool sack_ok : 1;
+	bool sack_recovery : 1;
+#endif
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+	uint32_t ts_offset; /* Random offset of our timestamps */
+	uint32_t ts_recent; /* Last timestamp of the peer to echo */
+	bool ts_ok : 1;
+#endif
+#if defined(CONFIG_NET_TCP_ADAPTIVE_RTO)
+	uint32_t srtt;      /* Smoothed RTT in ms, scaled by 8, 0 if unknown */
+	uint32_t rttvar;    /* RTT variation in ms, scaled by 4 */
+	uint32_t rtt_seq;   /* End of the segment timed, without timestamps */
+	uint32_t rtt_start; /* Uptime in ms the timed segment was sent at */
+	bool rtt_timing : 1;
+#endif
+#if defined(CONFIG_NET_TCP_RANDOMIZED_RTO) || defined(CONFIG_NET_TCP_ADAPTIVE_RTO)
+	uint32_t rto;
+#endif
 #ifdef CONFIG_NET_TCP_RANDOMIZED_RTO
-	uint16_t rto;
+	uint8_t rto_gain;
 #endif
 #ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
-	struct tcp_collision_avoidance_reno ca;
+	struct tcp_congestion_avoidance ca;
 #endif
 	uint8_t send_data_retries;
 #ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
@@ -16,6 +16,7 @@ LOG_MODULE_REGISTER(net_arp, CONFIG_NET_ARP_LOG_LEVEL);
 #include <zephyr/net/net_pkt.h>
 #include <zephyr/net/net_if.h>
 #include <zephyr/net/net_stats.h>
+#include <zephyr/sys/mem_pressure.h>
 
 #include "arp.h"
 #include "net_private.h"
@@ -34,20 +35,25 @@ static struct k_work_delayable arp_request_timer;
 
 static struct k_mutex arp_mutex;
 
+static void arp_entry_release_pending(struct arp_entry *entry)
+{
+	struct net_pkt *pkt;
+
+	while (!k_fifo_is_empty(&entry->pending_queue)) {
+		pkt = k_fifo_get(&entry->pending_queue, K_FOREVER);
+		NET_DBG("Releasing pending pkt %p (ref %ld)",
+			pkt,
+			atomic_get(&pkt->atomic_ref) - 1);
+		net_pkt_unref(pkt);
+	}
+}
+
 static void arp_entry_cleanup(struct arp_entry *entry, bool pending)
 {
 	NET_DBG("%p", entry);
 
 	if (pending) {
-		struct net_pkt *pkt;
-
-		while (!k_fifo_is_empty(&entry->pending_queue)) {
-			pkt = k_fifo_get(&entry->pending_queue, K_FOREVER);
-			NET_DBG("Releasing pending pkt %p (ref %ld)",
-				pkt,
-				atomic_get(&pkt->atomic_ref) - 1);
-			net_pkt_unref(pkt);
-		}
+		arp_entry_release_pending(entry);
 	}
 
 	entry->iface = NULL;
@@ -800,6 +806,38 @@ int net_arp_foreach(net_arp_cb_t cb, void *user_data)
 	return ret;
 }
 
+#if defined(CONFIG_NET_MEM_PRESSURE)
+/* Packets waiting for a resolution hold network buffers, drop them when
+ * those run out. The requests themselves stay pending and the packets
+ * are expected to be retransmitted by the upper layers.
+ */
+static void arp_mem_pressure(const struct mem_pressure_source *src,
+			     enum mem_pressure_level level, void *user_data)
+{
+	struct arp_entry *entry;
+
+	ARG_UNUSED(user_data);
+
+	if (level != MEM_PRESSURE_CRITICAL) {
+		return;
+	}
+
+	NET_DBG("Releasing ARP pending packets (%s)", src->name);
+
+	k_mutex_lock(&arp_mutex, K_FOREVER);
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&arp_pending_entries, entry, node) {
+		arp_entry_release_pending(entry);
+	}
+
+	k_mutex_unlock(&arp_mutex);
+}
+
+static MEM_PRESSURE_CALLBACK_DEFINE(arp_mem_pressure_cb,
+				    BIT(MEM_PRESSURE_NET_BUF_POOL),
+				    arp_mem_pressure, NULL);
+#endif /* CONFIG_NET_MEM_PRESSURE */
+
 void net_arp_init(void)
 {
 	int i;
@@ -822,5 +860,9 @@ void net_arp_init(void)
 
 	k_mutex_init(&arp_mutex);
 
+#if defined(CONFIG_NET_MEM_PRESSURE)
+	mem_pressure_callback_register(&arp_mem_pressure_cb);
+#endif
+
 	arp_cache_initialized = true;
 }
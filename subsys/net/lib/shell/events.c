@@ -264,6 +264,9 @@ static const char *get_l4_desc(uint32_t event)
 	case NET_EVENT_COAP_OBSERVER_REMOVED:
 		desc = "CoAP observer removed";
 		break;
+	case NET_EVENT_MEM_PRESSURE:
+		desc = "memory pressure";
+		break;
 	}
 
 	return desc;
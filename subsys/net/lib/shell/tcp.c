@@ -9,10 +9,13 @@
 LOG_MODULE_DECLARE(net_shell);
 
 #include <stdlib.h>
+#include <zephyr/net/socket.h>
 
 #include "net_shell_private.h"
 
 #if defined(CONFIG_NET_TCP) && defined(CONFIG_NET_NATIVE_TCP)
+#include "tcp_internal.h"
+
 static struct net_context *tcp_ctx;
 static const struct shell *tcp_shell;
 
@@ -389,6 +392,59 @@ static int cmd_net_tcp_close(const struct shell *sh, size_t argc, char *argv[])
 	return 0;
 }
 
+#if defined(CONFIG_NET_TCP) && defined(CONFIG_NET_NATIVE_TCP)
+static void tcp_info_cb(struct tcp *conn, void *user_data)
+{
+	struct net_shell_user_data *data = user_data;
+	const struct shell *sh = data->sh;
+	int *count = data->user_data;
+	char ca[TCP_CA_NAME_MAX] = "-";
+	struct tcp_info info;
+	size_t len = sizeof(info);
+
+	if (net_tcp_get_option(conn->context, TCP_OPT_INFO, &info, &len) < 0) {
+		return;
+	}
+
+	len = sizeof(ca) - 1;
+	(void)net_tcp_get_option(conn->context, TCP_OPT_CONGESTION, ca, &len);
+
+	PR("%p %-11s %6u %6u %6u %8u %8u %8u %8u %6u %s\n",
+	   conn, net_tcp_state_str(net_tcp_get_state(conn)),
+	   info.tcpi_rtt / USEC_PER_MSEC, info.tcpi_rttvar / USEC_PER_MSEC,
+	   info.tcpi_rto / USEC_PER_MSEC, info.tcpi_snd_cwnd,
+	   info.tcpi_snd_ssthresh, info.tcpi_snd_wnd, info.tcpi_rcv_wnd,
+	   info.tcpi_retransmits, ca);
+
+	(*count)++;
+}
+#endif
+
+static int cmd_net_tcp_info(const struct shell *sh, size_t argc, char *argv[])
+{
+#if defined(CONFIG_NET_TCP) && defined(CONFIG_NET_NATIVE_TCP)
+	struct net_shell_user_data user_data;
+	int count = 0;
+
+	user_data.sh = sh;
+	user_data.user_data = &count;
+
+	PR("TCP        State          RTT RTTvar    RTO     Cwnd Ssthresh  "
+	   "Snd_win  Rcv_win Rexmit CA\n");
+
+	net_tcp_foreach(tcp_info_cb, &user_data);
+
+	if (count == 0) {
+		PR("No TCP connections\n");
+	}
+#else
+	PR_INFO("Set %s to enable %s support.\n",
+		"CONFIG_NET_TCP and CONFIG_NET_NATIVE", "TCP");
+#endif /* CONFIG_NET_NATIVE_TCP */
+
+	return 0;
+}
+
 static int cmd_net_tcp(const struct shell *sh, size_t argc, char *argv[])
 {
 	ARG_UNUSED(argc);
@@ -409,9 +465,14 @@ SHELL_STATIC_SUBCMD_SET_CREATE(net_cmd_tcp,
 		  cmd_net_tcp_recv),
 	SHELL_CMD(close, NULL,
 		  "'net tcp close' closes TCP connection.", cmd_net_tcp_close),
+	SHELL_CMD(info, NULL,
+		  "'net tcp info' prints the round-trip time, retransmission "
+		  "timeout, windows (in ms and bytes) and congestion control "
+		  "algorithm of the TCP connections.",
+		  cmd_net_tcp_info),
 	SHELL_SUBCMD_SET_END
 );
 
 SHELL_SUBCMD_ADD((net), tcp, &net_cmd_tcp,
-		 "Connect/send/close TCP connection.",
+		 "Connect/send/close TCP connection, print TCP connection info.",
 		 cmd_net_tcp, 1, 0);
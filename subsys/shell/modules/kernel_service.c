@@ -20,6 +20,7 @@
 #include <stdlib.h>
 #if defined(CONFIG_SYS_HEAP_RUNTIME_STATS) && (K_HEAP_MEM_POOL_SIZE > 0)
 #include <zephyr/sys/sys_heap.h>
+#include <zephyr/sys/heap_profile.h>
 #endif
 #if defined(CONFIG_LOG_RUNTIME_FILTERING)
 #include <zephyr/logging/log_ctrl.h>
@@ -105,6 +106,7 @@ static void shell_tdata_dump(const struct k_thread *cthread, void *user_data)
 	const char *tname;
 	int ret;
 	char state_str[32];
+	k_ticks_t timeout = 0;
 
 #ifdef CONFIG_THREAD_RUNTIME_STATS
 	k_thread_runtime_stats_t rt_stats_thread;
@@ -117,11 +119,17 @@ static void shell_tdata_dump(const struct k_thread *cthread, void *user_data)
 		      (thread == k_current_get()) ? "*" : " ",
 		      thread,
 		      tname ? tname : "NA");
+
+#ifdef CONFIG_SYS_CLOCK_EXISTS
+	/* dticks is an absolute tick with the scalable timeout queue */
+	timeout = z_timeout_remaining(&thread->base.timeout);
+#endif
+
 	/* Cannot use lld as it's less portable. */
 	shell_print(sh, "\toptions: 0x%x, priority: %d timeout: %" PRId64,
 		      thread->base.user_options,
 		      thread->base.prio,
-		      (int64_t)thread->base.timeout.dticks);
+		      (int64_t)timeout);
 	shell_print(sh, "\tstate: %s, entry: %p",
 		    k_thread_state_str(thread, state_str, sizeof(state_str)),
 		    thread->entry.pEntry);
@@ -158,6 +166,14 @@ static void shell_tdata_dump(const struct k_thread *cthread, void *user_data)
 			    (uint32_t)rt_stats_thread.peak_cycles);
 		shell_print(sh, "\tAverage execution cycles: %u",
 			    (uint32_t)rt_stats_thread.average_cycles);
+#endif
+#ifdef CONFIG_SCHED_LATENCY_STATS
+		shell_print(sh, "\tWake-ups: %u, latency avg %u max %u cycles",
+			    rt_stats_thread.latency.count,
+			    (rt_stats_thread.latency.count != 0U) ?
+			    (uint32_t)(rt_stats_thread.latency.total /
+				       rt_stats_thread.latency.count) : 0U,
+			    rt_stats_thread.latency.max);
 #endif
 	} else {
 		shell_print(sh, "\tTotal execution cycles: ? (? %%)");
@@ -275,7 +291,7 @@ static int cmd_kernel_stacks(const struct shell *sh,
 #endif
 
 #if defined(CONFIG_SYS_HEAP_RUNTIME_STATS) && (K_HEAP_MEM_POOL_SIZE > 0)
-extern struct sys_heap _system_heap;
+extern struct k_heap _system_heap;
 
 static int cmd_kernel_heap(const struct shell *sh,
 			   size_t argc, char **argv)
@@ -285,16 +301,221 @@ static int cmd_kernel_heap(const struct shell *sh,
 
 	int err;
 	struct sys_memory_stats stats;
+	struct sys_heap_fragmentation frag;
+	k_spinlock_key_t key;
 
-	err = sys_heap_runtime_stats_get(&_system_heap, &stats);
+	err = sys_heap_runtime_stats_get(&_system_heap.heap, &stats);
 	if (err) {
 		shell_error(sh, "Failed to read kernel system heap statistics (err %d)", err);
 		return -ENOEXEC;
 	}
 
+	key = k_spin_lock(&_system_heap.lock);
+	(void)sys_heap_fragmentation_get(&_system_heap.heap, &frag);
+	k_spin_unlock(&_system_heap.lock, key);
+
 	shell_print(sh, "free:           %zu", stats.free_bytes);
 	shell_print(sh, "allocated:      %zu", stats.allocated_bytes);
 	shell_print(sh, "max. allocated: %zu", stats.max_allocated_bytes);
+	shell_print(sh, "free blocks:    %u", frag.free_blocks);
+	shell_print(sh, "largest free:   %zu", frag.largest_free_bytes);
+	shell_print(sh, "fragmentation:  %u%%", frag.index);
+
+	return 0;
+}
+#endif
+
+#if defined(CONFIG_SYS_HEAP_PROFILE)
+static void shell_heap_site_dump(const struct sys_heap_profile_site *site,
+				 void *user_data)
+{
+	const struct shell *sh = user_data;
+
+	shell_print(sh, "%p: allocs %u frees %u live %u (%zu bytes, max %zu)",
+		    site->site, site->allocs, site->frees, site->live_blocks,
+		    site->live_bytes, site->max_live_bytes);
+	shell_print(sh, "\tlifetime avg %u max %u, oldest live %u ticks",
+		    (site->frees != 0U) ?
+		    (uint32_t)(site->lifetime_ticks / site->frees) : 0U,
+		    site->max_lifetime_ticks, site->oldest_live_ticks);
+
+	for (int i = 0; i < CONFIG_SYS_HEAP_PROFILE_SIZE_BINS; i++) {
+		if (site->sizes[i] != 0U) {
+			shell_print(sh, "\t%s2^%-2d bytes %u",
+				    (i == CONFIG_SYS_HEAP_PROFILE_SIZE_BINS - 1) ?
+				    ">=" : "  ", i, site->sizes[i]);
+		}
+	}
+}
+
+static void shell_heap_profile_dump(struct sys_heap *heap,
+				    struct sys_heap_profile *profile,
+				    void *user_data)
+{
+	const struct shell *sh = user_data;
+	uint32_t untracked;
+
+	shell_print(sh, "Heap %p", heap);
+	untracked = sys_heap_profile_foreach_site(profile, shell_heap_site_dump,
+						  (void *)sh);
+	shell_print(sh, "untracked allocations: %u", untracked);
+}
+
+static void shell_heap_profile_reset(struct sys_heap *heap,
+				     struct sys_heap_profile *profile,
+				     void *user_data)
+{
+	ARG_UNUSED(heap);
+	ARG_UNUSED(user_data);
+
+	sys_heap_profile_reset(profile);
+}
+
+static int cmd_kernel_heap_profile(const struct shell *sh,
+				   size_t argc, char **argv)
+{
+	if (argc > 1) {
+		if (strcmp(argv[1], "reset") != 0) {
+			shell_error(sh, "Unknown option %s", argv[1]);
+			return -EINVAL;
+		}
+
+		sys_heap_profile_foreach(shell_heap_profile_reset, NULL);
+		return 0;
+	}
+
+	sys_heap_profile_foreach(shell_heap_profile_dump, (void *)sh);
+
+	return 0;
+}
+#endif
+
+#if defined(CONFIG_SCHED_LATENCY_STATS)
+static void shell_latency_dump(const struct shell *sh, const char *name,
+			       int id, struct k_sched_latency_stats *stats)
+{
+	if (stats->count == 0U) {
+		return;
+	}
+
+	shell_print(sh, "%s %3d: wake-ups %u, avg %u max %u", name, id,
+		    stats->count, (uint32_t)(stats->total / stats->count),
+		    stats->max);
+
+	for (int i = 0; i < CONFIG_SCHED_LATENCY_STATS_BUCKETS; i++) {
+		if (stats->buckets[i] != 0U) {
+			shell_print(sh, "\t%s2^%-2d %u",
+				    (i == CONFIG_SCHED_LATENCY_STATS_BUCKETS - 1) ?
+				    ">=" : "  ", i, stats->buckets[i]);
+		}
+	}
+}
+
+static int cmd_kernel_latency(const struct shell *sh,
+			      size_t argc, char **argv)
+{
+	struct k_sched_latency_stats stats;
+	unsigned int num_cpus = arch_num_cpus();
+
+	if (argc > 1) {
+		if (strcmp(argv[1], "reset") != 0) {
+			shell_error(sh, "Unknown option %s", argv[1]);
+			return -EINVAL;
+		}
+
+		k_sched_latency_reset();
+		return 0;
+	}
+
+	shell_print(sh, "Wake-to-run latency in hw cycles");
+
+	for (int i = 0; i < num_cpus; i++) {
+		if (k_sched_latency_cpu_get(i, &stats) == 0) {
+			shell_latency_dump(sh, "CPU ", i, &stats);
+		}
+	}
+
+	for (int prio = K_HIGHEST_THREAD_PRIO; prio <= K_LOWEST_THREAD_PRIO; prio++) {
+		if (k_sched_latency_prio_get(prio, &stats) == 0) {
+			shell_latency_dump(sh, "prio", prio, &stats);
+		}
+	}
+
+	return 0;
+}
+#endif
+
+#if defined(CONFIG_OBJ_CORE_STATS_MUTEX) || defined(CONFIG_OBJ_CORE_STATS_SEM) || \
+	defined(CONFIG_OBJ_CORE_STATS_SPINLOCK)
+#define KERNEL_LOCK_STATS
+
+static const struct {
+	uint32_t id;
+	const char *name;
+} lock_types[] = {
+	{ K_OBJ_TYPE_MUTEX_ID, "mutex" },
+	{ K_OBJ_TYPE_SEM_ID, "sem" },
+	{ K_OBJ_TYPE_SPINLOCK_ID, "spinlock" },
+};
+
+struct lock_stats_walk {
+	const struct shell *sh;
+	const char *name;
+	bool reset;
+};
+
+static int shell_lock_stats_dump(struct k_obj_core *obj_core, void *data)
+{
+	struct lock_stats_walk *walk = data;
+	struct k_lock_stats stats;
+	void *obj = (uint8_t *)obj_core - obj_core->type->obj_core_offset;
+
+	if (walk->reset) {
+		(void)k_obj_core_stats_reset(obj_core);
+		return 0;
+	}
+
+	if (k_obj_core_stats_query(obj_core, &stats, sizeof(stats)) != 0) {
+		return 0;
+	}
+
+	shell_print(walk->sh,
+		    "%-8s %p acq %10llu cont %10llu wait avg %8llu max %8u hold max %8u",
+		    walk->name, obj, stats.acquisitions, stats.contentions,
+		    (stats.contentions != 0U) ?
+		    stats.total_wait / stats.contentions : 0ULL,
+		    stats.max_wait, stats.max_hold);
+
+	return 0;
+}
+
+static int cmd_kernel_locks(const struct shell *sh,
+			    size_t argc, char **argv)
+{
+	struct lock_stats_walk walk = {
+		.sh = sh,
+		.reset = (argc > 1) && (strcmp(argv[1], "reset") == 0),
+	};
+	struct k_obj_type *type;
+
+	if ((argc > 1) && !walk.reset) {
+		shell_error(sh, "Unknown option %s", argv[1]);
+		return -EINVAL;
+	}
+
+	if (!walk.reset) {
+		shell_print(sh, "Times are in hw cycles");
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(lock_types); i++) {
+		type = k_obj_type_find(lock_types[i].id);
+		if (type == NULL) {
+			continue;
+		}
+
+		walk.name = lock_types[i].name;
+		k_obj_type_walk_unlocked(type, shell_lock_stats_dump, &walk);
+	}
 
 	return 0;
 }
@@ -400,6 +621,20 @@ SHELL_STATIC_SUBCMD_SET_CREATE(sub_kernel,
 #endif
 #if defined(CONFIG_SYS_HEAP_RUNTIME_STATS) && (K_HEAP_MEM_POOL_SIZE > 0)
 	SHELL_CMD(heap, NULL, "System heap usage statistics.", cmd_kernel_heap),
+#endif
+#if defined(CONFIG_SYS_HEAP_PROFILE)
+	SHELL_CMD_ARG(heap-profile, NULL,
+		      "Allocation sites of profiled heaps. Use \"reset\" to clear them.",
+		      cmd_kernel_heap_profile, 1, 1),
+#endif
+#if defined(CONFIG_SCHED_LATENCY_STATS)
+	SHELL_CMD_ARG(latency, NULL,
+		      "Wake-to-run latency histograms. Use \"reset\" to clear them.",
+		      cmd_kernel_latency, 1, 1),
+#endif
+#if defined(KERNEL_LOCK_STATS)
+	SHELL_CMD_ARG(locks, NULL, "Lock contention statistics. Use \"reset\" to clear them.",
+		      cmd_kernel_locks, 1, 1),
 #endif
 	SHELL_CMD_ARG(uptime, NULL, "Kernel uptime. Can be called with the -p or --pretty options",
 		      cmd_kernel_uptime, 1, 1),
@@ -0,0 +1,238 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @brief bitarray search performance tests
+ *
+ * @defgroup lib_bitarray_perf_tests Bitarray
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/sys/bitarray.h>
+
+#define NUM_BITS 4096
+#define NUM_OPS  256
+
+SYS_BITARRAY_DEFINE_STATIC(ba, NUM_BITS);
+
+static uint32_t rand_state;
+
+static uint32_t rand32(void)
+{
+	/* xorshift32 */
+	rand_state ^= rand_state << 13;
+	rand_state ^= rand_state >> 17;
+	rand_state ^= rand_state << 5;
+
+	return rand_state;
+}
+
+/* Reference implementations, looking at one bit at a time */
+
+static bool ref_test(size_t bit)
+{
+	return (ba.bundles[bit / 32] & BIT(bit % 32)) != 0U;
+}
+
+static size_t ref_find(size_t offset, bool set)
+{
+	for (size_t bit = offset; bit < NUM_BITS; bit++) {
+		if (ref_test(bit) == set) {
+			return bit;
+		}
+	}
+
+	return NUM_BITS;
+}
+
+static size_t ref_popcount(size_t num_bits, size_t offset)
+{
+	size_t count = 0;
+
+	for (size_t bit = offset; bit < offset + num_bits; bit++) {
+		count += ref_test(bit) ? 1 : 0;
+	}
+
+	return count;
+}
+
+static size_t ref_alloc(size_t num_bits)
+{
+	size_t run = 0;
+
+	for (size_t bit = 0; bit < NUM_BITS; bit++) {
+		run = ref_test(bit) ? 0 : run + 1;
+		if (run == num_bits) {
+			return bit + 1 - num_bits;
+		}
+	}
+
+	return NUM_BITS;
+}
+
+/* Set about one bit in @p density, in runs of up to 8 bits */
+static void fill(uint32_t density)
+{
+	(void)sys_bitarray_clear_region(&ba, NUM_BITS, 0);
+
+	for (size_t bit = 0; bit < NUM_BITS; bit += 8) {
+		uint32_t r = rand32();
+
+		if ((r % density) == 0U) {
+			(void)sys_bitarray_set_region(&ba, 1 + ((r >> 16) % 8), bit);
+		}
+	}
+}
+
+static void report(const char *name, uint32_t word_cycles, uint32_t ref_cycles)
+{
+	TC_PRINT("%s: %u cycles word at a time, %u cycles bit by bit\n",
+		 name, word_cycles, ref_cycles);
+}
+
+/**
+ * @brief Test searching for set and cleared bits
+ *
+ * @details Fill a bitarray sparsely, then find the first set bit from
+ * random offsets, and likewise for cleared bits in a dense bitarray.
+ * Verify that the results match a bit by bit search and report the
+ * time taken by both.
+ *
+ * @ingroup lib_bitarray_perf_tests
+ *
+ * @see sys_bitarray_find_first_set(), sys_bitarray_find_first_clear()
+ */
+ZTEST(bitarray_perf, test_bitarray_find_perf)
+{
+	static const uint32_t densities[] = { 1, 64 };
+	uint32_t start, word_cycles, ref_cycles;
+	size_t offsets[NUM_OPS];
+	size_t found[NUM_OPS];
+	size_t expected;
+
+	for (int set = 0; set < 2; set++) {
+		fill(densities[set]);
+
+		for (int i = 0; i < NUM_OPS; i++) {
+			offsets[i] = rand32() % NUM_BITS;
+		}
+
+		start = k_cycle_get_32();
+		for (int i = 0; i < NUM_OPS; i++) {
+			int ret = set ?
+				sys_bitarray_find_first_set(&ba, offsets[i], &found[i]) :
+				sys_bitarray_find_first_clear(&ba, offsets[i], &found[i]);
+
+			if (ret == -ENOENT) {
+				found[i] = NUM_BITS;
+			}
+		}
+		word_cycles = k_cycle_get_32() - start;
+
+		ref_cycles = 0U;
+		for (int i = 0; i < NUM_OPS; i++) {
+			start = k_cycle_get_32();
+			expected = ref_find(offsets[i], set);
+			ref_cycles += k_cycle_get_32() - start;
+
+			zassert_equal(found[i], expected,
+				      "first %s bit from %u: expected %u, got %u",
+				      set ? "set" : "cleared", offsets[i],
+				      expected, found[i]);
+		}
+
+		report(set ? "find first set" : "find first clear",
+		       word_cycles, ref_cycles);
+	}
+}
+
+/**
+ * @brief Test counting set bits in regions
+ *
+ * @ingroup lib_bitarray_perf_tests
+ *
+ * @see sys_bitarray_popcount_region()
+ */
+ZTEST(bitarray_perf, test_bitarray_popcount_perf)
+{
+	uint32_t start, word_cycles = 0U, ref_cycles = 0U;
+	size_t count, expected;
+
+	fill(2);
+
+	for (int i = 0; i < NUM_OPS; i++) {
+		size_t offset = rand32() % NUM_BITS;
+		size_t num_bits = 1 + rand32() % (NUM_BITS - offset);
+
+		start = k_cycle_get_32();
+		zassert_equal(sys_bitarray_popcount_region(&ba, num_bits, offset,
+							   &count),
+			      0, "sys_bitarray_popcount_region() failed");
+		word_cycles += k_cycle_get_32() - start;
+
+		start = k_cycle_get_32();
+		expected = ref_popcount(num_bits, offset);
+		ref_cycles += k_cycle_get_32() - start;
+
+		zassert_equal(count, expected,
+			      "%u bits from %u: expected %u set, got %u",
+			      num_bits, offset, expected, count);
+	}
+
+	report("popcount region", word_cycles, ref_cycles);
+}
+
+/**
+ * @brief Test allocating regions from a fragmented bitarray
+ *
+ * @details Fill a bitarray densely with short runs, then allocate
+ * regions of random sizes until they no longer fit.  Verify that each
+ * region is the first fit found by a bit by bit search.
+ *
+ * @ingroup lib_bitarray_perf_tests
+ *
+ * @see sys_bitarray_alloc()
+ */
+ZTEST(bitarray_perf, test_bitarray_alloc_perf)
+{
+	uint32_t start, word_cycles = 0U, ref_cycles = 0U;
+	size_t offset, expected;
+	int ret;
+
+	fill(1);
+
+	for (int i = 0; i < NUM_OPS; i++) {
+		size_t num_bits = 1 + rand32() % 12;
+
+		start = k_cycle_get_32();
+		expected = ref_alloc(num_bits);
+		ref_cycles += k_cycle_get_32() - start;
+
+		start = k_cycle_get_32();
+		ret = sys_bitarray_alloc(&ba, num_bits, &offset);
+		word_cycles += k_cycle_get_32() - start;
+
+		if (expected == NUM_BITS) {
+			zassert_equal(ret, -ENOSPC, "%u bits should not fit", num_bits);
+			continue;
+		}
+
+		zassert_equal(ret, 0, "sys_bitarray_alloc() failed (%d)", ret);
+		zassert_equal(offset, expected, "%u bits: expected %u, got %u",
+			      num_bits, expected, offset);
+	}
+
+	report("alloc", word_cycles, ref_cycles);
+}
+
+static void bitarray_perf_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	rand_state = 0x2545f491U;
+}
+
+ZTEST_SUITE(bitarray_perf, NULL, NULL, bitarray_perf_before, NULL, NULL);
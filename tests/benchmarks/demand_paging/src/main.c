@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/kernel/mm.h>
+#include <zephyr/kernel/mm/demand_paging.h>
+#include <zephyr/linker/sections.h>
+#include <zephyr/sys/printk.h>
+
+/* This is a demand paging eviction benchmark.  It accesses a working
+ * set larger than RAM with a few patterns and reports the page faults
+ * and evictions each one causes, so that runs with different eviction
+ * algorithms can be compared directly.  The working set is initialized
+ * data, which is left in the backing store and paged in on demand.  The
+ * code and state of the benchmark itself are pinned so that they do not
+ * add page faults of their own.
+ */
+
+#define WS_PAGES     96
+#define HOT_PAGES    24
+#define HOT_PERCENT  80
+#define NUM_ACCESSES 20000
+
+/* One access in WRITE_EVERY is a write, so that evicted pages may be dirty */
+#define WRITE_EVERY 4
+
+static uint8_t working_set[WS_PAGES][CONFIG_MMU_PAGE_SIZE] = { [0][0] = 1 };
+
+__pinned_bss
+static uint32_t rand_state;
+
+__pinned_bss
+static volatile uint32_t sink;
+
+enum pattern {
+	PATTERN_SEQUENTIAL,
+	PATTERN_HOT_COLD,
+	PATTERN_RANDOM,
+	PATTERN_COUNT,
+};
+
+__pinned_rodata
+static const char *const pattern_names[PATTERN_COUNT] = {
+	"sequential",
+	"hot/cold",
+	"random",
+};
+
+__pinned_func
+static uint32_t rand32(void)
+{
+	/* xorshift32 */
+	rand_state ^= rand_state << 13;
+	rand_state ^= rand_state >> 17;
+	rand_state ^= rand_state << 5;
+
+	return rand_state;
+}
+
+__pinned_func
+static size_t next_page(enum pattern pattern, uint32_t i)
+{
+	switch (pattern) {
+	case PATTERN_SEQUENTIAL:
+		return i % WS_PAGES;
+	case PATTERN_HOT_COLD:
+		if ((rand32() % 100U) < HOT_PERCENT) {
+			return rand32() % HOT_PAGES;
+		}
+		return rand32() % WS_PAGES;
+	default:
+		return rand32() % WS_PAGES;
+	}
+}
+
+__pinned_func
+static void run(enum pattern pattern)
+{
+	for (uint32_t i = 0; i < NUM_ACCESSES; i++) {
+		uint8_t *page = working_set[next_page(pattern, i)];
+		size_t offset = rand32() % CONFIG_MMU_PAGE_SIZE;
+
+		if ((i % WRITE_EVERY) == 0U) {
+			page[offset]++;
+		} else {
+			sink += page[offset];
+		}
+	}
+}
+
+__pinned_func
+static void bench(enum pattern pattern)
+{
+	struct k_mem_paging_stats_t before, after;
+	unsigned long faults;
+
+	rand_state = 0x2545f491U;
+
+	k_mem_paging_stats_get(&before);
+	run(pattern);
+	k_mem_paging_stats_get(&after);
+
+	faults = after.pagefaults.cnt - before.pagefaults.cnt;
+
+	printk("%-10s faults %6lu (%4lu per 1000 accesses) evicted clean %6lu dirty %6lu",
+	       pattern_names[pattern], faults, faults * 1000UL / NUM_ACCESSES,
+	       after.eviction.clean - before.eviction.clean,
+	       after.eviction.dirty - before.eviction.dirty);
+#ifdef CONFIG_DEMAND_PAGING_READ_AHEAD
+	printk(" read ahead %6lu",
+	       after.pagefaults.read_ahead - before.pagefaults.read_ahead);
+#endif
+	printk("\n");
+}
+
+int main(void)
+{
+	const char *algorithm = IS_ENABLED(CONFIG_EVICTION_CLOCK) ? "clock" :
+				IS_ENABLED(CONFIG_EVICTION_LRU) ? "LRU" :
+				IS_ENABLED(CONFIG_EVICTION_NRU) ? "NRU" : "custom";
+
+	printk("%s eviction, working set of %d pages, %zu free pages, %d accesses\n",
+	       algorithm, WS_PAGES, k_mem_free_get() / CONFIG_MMU_PAGE_SIZE,
+	       NUM_ACCESSES);
+
+	for (int pattern = 0; pattern < PATTERN_COUNT; pattern++) {
+		bench(pattern);
+	}
+
+	printk("fin\n");
+	return 0;
+}
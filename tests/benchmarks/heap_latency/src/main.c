@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/sys/sys_heap.h>
+#include <zephyr/timing/timing.h>
+
+/* This is a heap latency microbenchmark.  It fragments a sys_heap
+ * with blocks of random sizes, then times every allocation and free of
+ * a pseudo-random sequence and reports the worst case and the average
+ * of each.  The sequence does not depend on the allocation engine, so
+ * runs with different engines can be compared directly.
+ */
+
+#define HEAP_SIZE (32 * 1024)
+#define NUM_BLOCKS 512
+#define NUM_OPS 20000
+
+static uint8_t heap_mem[HEAP_SIZE] __aligned(8);
+static struct sys_heap heap;
+static void *blocks[NUM_BLOCKS];
+static uint32_t rand_state = 0x2545f491U;
+
+struct op_stats {
+	uint64_t max_cycles;
+	uint64_t total_cycles;
+	uint32_t count;
+};
+
+static struct op_stats alloc_stats;
+static struct op_stats free_stats;
+static uint32_t alloc_failures;
+
+static uint32_t rand32(void)
+{
+	/* xorshift32 */
+	rand_state ^= rand_state << 13;
+	rand_state ^= rand_state >> 17;
+	rand_state ^= rand_state << 5;
+
+	return rand_state;
+}
+
+/* Mostly small blocks, with one in 16 large enough to leave holes
+ * that small ones then split up
+ */
+static size_t rand_size(void)
+{
+	uint32_t r = rand32();
+
+	if ((r & 15U) == 0U) {
+		return 256U + (r >> 8) % 1792U;
+	}
+
+	return 8U + (r >> 8) % 120U;
+}
+
+static void record(struct op_stats *stats, timing_t *start, timing_t *end)
+{
+	uint64_t cycles = timing_cycles_get(start, end);
+
+	stats->max_cycles = MAX(stats->max_cycles, cycles);
+	stats->total_cycles += cycles;
+	stats->count++;
+}
+
+static void fragment(void)
+{
+	for (int i = 0; i < NUM_BLOCKS; i++) {
+		blocks[i] = sys_heap_alloc(&heap, rand_size());
+	}
+
+	for (int i = 0; i < NUM_BLOCKS; i += 2) {
+		sys_heap_free(&heap, blocks[i]);
+		blocks[i] = NULL;
+	}
+}
+
+static void run(void)
+{
+	timing_t start, end;
+
+	for (int op = 0; op < NUM_OPS; op++) {
+		int i = rand32() % NUM_BLOCKS;
+
+		if (blocks[i] == NULL) {
+			size_t size = rand_size();
+
+			start = timing_counter_get();
+			blocks[i] = sys_heap_alloc(&heap, size);
+			end = timing_counter_get();
+			record(&alloc_stats, &start, &end);
+
+			if (blocks[i] == NULL) {
+				alloc_failures++;
+			}
+		} else {
+			start = timing_counter_get();
+			sys_heap_free(&heap, blocks[i]);
+			end = timing_counter_get();
+			record(&free_stats, &start, &end);
+
+			blocks[i] = NULL;
+		}
+	}
+}
+
+static void report(const char *name, struct op_stats *stats)
+{
+	uint32_t avg = 0U;
+
+	if (stats->count != 0U) {
+		avg = (uint32_t)timing_cycles_to_ns(stats->total_cycles /
+						    stats->count);
+	}
+
+	printk("%s max %6u ns avg %6u ns", name,
+	       (uint32_t)timing_cycles_to_ns(stats->max_cycles), avg);
+}
+
+int main(void)
+{
+	timing_init();
+	timing_start();
+
+	printk("%s engine, heap of %d bytes, %d operations\n",
+	       IS_ENABLED(CONFIG_SYS_HEAP_TLSF) ? "TLSF" : "buckets",
+	       HEAP_SIZE, NUM_OPS);
+
+	sys_heap_init(&heap, heap_mem, sizeof(heap_mem));
+	fragment();
+	run();
+
+	report("alloc", &alloc_stats);
+	printk(" failed %u/%u\n", alloc_failures, alloc_stats.count);
+	report("free ", &free_stats);
+	printk("\n");
+
+	timing_stop();
+	printk("fin\n");
+	return 0;
+}
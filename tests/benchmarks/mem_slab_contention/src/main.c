@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/timing/timing.h>
+
+/* This is a memory slab contention microbenchmark.  One thread per CPU
+ * allocates a batch of blocks from a single k_mem_slab and frees them
+ * again, many times over.  It reports the average cost of
+ * k_mem_slab_alloc() and k_mem_slab_free(), which is dominated by the
+ * slab lock bouncing between CPUs unless the per-CPU caches absorb it.
+ */
+
+#define N_ROUNDS 2000
+#define STACK_SIZE 1024
+#define MAX_THREADS MAX(CONFIG_MP_MAX_NUM_CPUS, 2)
+#define MAX_BATCH 8
+#define BLOCK_SIZE 64
+
+static const int batches[] = { 1, 4, MAX_BATCH };
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, MAX_THREADS, STACK_SIZE);
+static struct k_thread threads[MAX_THREADS];
+
+K_MEM_SLAB_DEFINE_STATIC(slab, BLOCK_SIZE, MAX_THREADS * MAX_BATCH, 8);
+
+static uint64_t alloc_cycles[MAX_THREADS];
+static uint64_t free_cycles[MAX_THREADS];
+
+static void thread_fn(void *arg1, void *arg2, void *arg3)
+{
+	int id = POINTER_TO_INT(arg1);
+	int batch = POINTER_TO_INT(arg2);
+	void *blocks[MAX_BATCH];
+	timing_t start, end;
+
+	ARG_UNUSED(arg3);
+
+	for (int i = 0; i < N_ROUNDS; i++) {
+		for (int j = 0; j < batch; j++) {
+			start = timing_counter_get();
+			(void)k_mem_slab_alloc(&slab, &blocks[j], K_FOREVER);
+			end = timing_counter_get();
+			alloc_cycles[id] += timing_cycles_get(&start, &end);
+		}
+
+		for (int j = 0; j < batch; j++) {
+			start = timing_counter_get();
+			k_mem_slab_free(&slab, blocks[j]);
+			end = timing_counter_get();
+			free_cycles[id] += timing_cycles_get(&start, &end);
+		}
+	}
+}
+
+static void run(int batch)
+{
+	unsigned int n = MAX(arch_num_cpus(), 2U);
+	uint64_t alloc_tot = 0U, free_tot = 0U;
+
+	for (unsigned int i = 0; i < n; i++) {
+		alloc_cycles[i] = 0U;
+		free_cycles[i] = 0U;
+		k_thread_create(&threads[i], stacks[i], STACK_SIZE, thread_fn,
+				INT_TO_POINTER(i), INT_TO_POINTER(batch), NULL,
+				K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+	}
+
+	for (unsigned int i = 0; i < n; i++) {
+		k_thread_join(&threads[i], K_FOREVER);
+		alloc_tot += alloc_cycles[i];
+		free_tot += free_cycles[i];
+	}
+
+	printk("batch %d threads %u alloc %6u ns free %6u ns\n", batch, n,
+	       (uint32_t)timing_cycles_to_ns_avg(alloc_tot, N_ROUNDS * batch * n),
+	       (uint32_t)timing_cycles_to_ns_avg(free_tot, N_ROUNDS * batch * n));
+}
+
+int main(void)
+{
+	timing_init();
+	timing_start();
+
+	printk("Memory slab per-CPU caches: %s\n",
+	       IS_ENABLED(CONFIG_MEM_SLAB_CACHE) ? "yes" : "no");
+
+	for (int i = 0; i < ARRAY_SIZE(batches); i++) {
+		run(batches[i]);
+	}
+
+	timing_stop();
+	printk("fin\n");
+	return 0;
+}
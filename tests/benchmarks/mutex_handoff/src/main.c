@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/timing/timing.h>
+
+/* This is a mutex hand-off microbenchmark.  One thread per CPU
+ * hammers a single k_mutex, holding it for a fixed amount of busy work
+ * each time.  It reports the average cost of k_mutex_lock() and the
+ * average delay between a release by one thread and the acquisition
+ * by another, which is where adaptive spinning saves a context switch
+ * on each side of the hand-off.
+ */
+
+#define N_LOCKS 2000
+#define STACK_SIZE 1024
+#define MAX_THREADS MAX(CONFIG_MP_MAX_NUM_CPUS, 2)
+
+static const int hold_loops[] = { 0, 100, 1000 };
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, MAX_THREADS, STACK_SIZE);
+static struct k_thread threads[MAX_THREADS];
+
+static K_MUTEX_DEFINE(mutex);
+
+/* Protected by the mutex */
+static timing_t release_ts;
+static int last_owner = -1;
+static uint64_t handoff_cycles;
+static uint32_t handoffs;
+
+static uint64_t lock_cycles[MAX_THREADS];
+
+static void busy(int loops)
+{
+	for (volatile int i = 0; i < loops; i++) {
+	}
+}
+
+static void thread_fn(void *arg1, void *arg2, void *arg3)
+{
+	int id = POINTER_TO_INT(arg1);
+	int hold = POINTER_TO_INT(arg2);
+	timing_t start, locked;
+
+	ARG_UNUSED(arg3);
+
+	for (int i = 0; i < N_LOCKS; i++) {
+		start = timing_counter_get();
+		k_mutex_lock(&mutex, K_FOREVER);
+		locked = timing_counter_get();
+
+		lock_cycles[id] += timing_cycles_get(&start, &locked);
+		if ((last_owner >= 0) && (last_owner != id)) {
+			handoff_cycles += timing_cycles_get(&release_ts, &locked);
+			handoffs++;
+		}
+		last_owner = id;
+
+		busy(hold);
+
+		release_ts = timing_counter_get();
+		k_mutex_unlock(&mutex);
+
+		/* Give the other threads a chance to grab the mutex */
+		busy(hold / 4);
+	}
+}
+
+static void run(int hold)
+{
+	unsigned int n = MAX(arch_num_cpus(), 2U);
+	uint64_t tot = 0U;
+
+	last_owner = -1;
+	handoff_cycles = 0U;
+	handoffs = 0U;
+
+	for (unsigned int i = 0; i < n; i++) {
+		lock_cycles[i] = 0U;
+		k_thread_create(&threads[i], stacks[i], STACK_SIZE, thread_fn,
+				INT_TO_POINTER(i), INT_TO_POINTER(hold), NULL,
+				K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+	}
+
+	for (unsigned int i = 0; i < n; i++) {
+		k_thread_join(&threads[i], K_FOREVER);
+		tot += lock_cycles[i];
+	}
+
+	printk("hold %4d threads %u lock %6u ns handoff %6u ns\n", hold, n,
+	       (uint32_t)timing_cycles_to_ns_avg(tot, N_LOCKS * n),
+	       (uint32_t)timing_cycles_to_ns_avg(handoff_cycles,
+						 MAX(handoffs, 1U)));
+}
+
+int main(void)
+{
+	timing_init();
+	timing_start();
+
+	printk("Mutex adaptive spinning: %s\n",
+	       IS_ENABLED(CONFIG_MUTEX_ADAPTIVE_SPIN) ? "yes" : "no");
+
+	for (int i = 0; i < ARRAY_SIZE(hold_loops); i++) {
+		run(hold_loops[i]);
+	}
+
+	timing_stop();
+	printk("fin\n");
+	return 0;
+}
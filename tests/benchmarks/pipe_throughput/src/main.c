@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/timing/timing.h>
+
+/* This is a pipe throughput microbenchmark.  It streams the same
+ * amount of data through a k_pipe once with the k_pipe_put() /
+ * k_pipe_get() copy path and once with the in-place claim / commit
+ * path, and reports the throughput of both for several chunk sizes.
+ */
+
+#define PIPE_SIZE 512
+#define TOTAL_BYTES (64 * 1024)
+
+static const size_t chunk_sizes[] = { 16, 64, PIPE_SIZE / 2 };
+
+K_PIPE_DEFINE(bench_pipe, PIPE_SIZE, 4);
+
+static uint8_t tx_buf[PIPE_SIZE / 2];
+static uint8_t rx_buf[PIPE_SIZE / 2];
+static uint32_t checksum;
+
+static inline void produce(uint8_t *buf, size_t len, size_t offset)
+{
+	for (size_t i = 0; i < len; i++) {
+		buf[i] = (uint8_t)(offset + i);
+	}
+}
+
+static inline void consume(const uint8_t *buf, size_t len)
+{
+	for (size_t i = 0; i < len; i++) {
+		checksum += buf[i];
+	}
+}
+
+static void stream_copy(size_t chunk)
+{
+	size_t bytes;
+
+	for (size_t off = 0; off < TOTAL_BYTES; off += chunk) {
+		produce(tx_buf, chunk, off);
+		(void)k_pipe_put(&bench_pipe, tx_buf, chunk, &bytes, chunk,
+				 K_NO_WAIT);
+
+		(void)k_pipe_get(&bench_pipe, rx_buf, chunk, &bytes, chunk,
+				 K_NO_WAIT);
+		consume(rx_buf, chunk);
+	}
+}
+
+static void stream_claim(size_t chunk)
+{
+	uint8_t *data;
+	size_t len;
+
+	for (size_t off = 0; off < TOTAL_BYTES; off += chunk) {
+		/* A claim stops at the end of the buffer, so a chunk
+		 * may take two claims
+		 */
+		for (size_t done = 0; done < chunk; done += len) {
+			len = k_pipe_put_claim(&bench_pipe, &data, chunk - done);
+			produce(data, len, off + done);
+			(void)k_pipe_put_commit(&bench_pipe, len);
+		}
+
+		for (size_t done = 0; done < chunk; done += len) {
+			len = k_pipe_get_claim(&bench_pipe, &data, chunk - done);
+			consume(data, len);
+			(void)k_pipe_get_commit(&bench_pipe, len);
+		}
+	}
+}
+
+static uint32_t mb_per_s_x10(uint64_t cycles)
+{
+	uint64_t ns = timing_cycles_to_ns(cycles);
+
+	if (ns == 0U) {
+		return 0U;
+	}
+
+	/* bytes/ns == GB/s; scale to tenths of MB/s */
+	return (uint32_t)(((uint64_t)TOTAL_BYTES * 10000U) / ns);
+}
+
+static void run(size_t chunk)
+{
+	timing_t start, end;
+	uint64_t copy_cycles, claim_cycles;
+	uint32_t copy_sum, claim_sum;
+	uint32_t copy_rate, claim_rate;
+
+	checksum = 0U;
+	start = timing_counter_get();
+	stream_copy(chunk);
+	end = timing_counter_get();
+	copy_cycles = timing_cycles_get(&start, &end);
+	copy_sum = checksum;
+
+	checksum = 0U;
+	start = timing_counter_get();
+	stream_claim(chunk);
+	end = timing_counter_get();
+	claim_cycles = timing_cycles_get(&start, &end);
+	claim_sum = checksum;
+
+	if (copy_sum != claim_sum) {
+		printk("checksum mismatch: copy %u claim %u\n", copy_sum,
+		       claim_sum);
+	}
+
+	copy_rate = mb_per_s_x10(copy_cycles);
+	claim_rate = mb_per_s_x10(claim_cycles);
+
+	printk("chunk %4zu copy %5u.%u MB/s claim %5u.%u MB/s\n", chunk,
+	       copy_rate / 10U, copy_rate % 10U,
+	       claim_rate / 10U, claim_rate % 10U);
+}
+
+int main(void)
+{
+	timing_init();
+	timing_start();
+
+	printk("Pipe of %d bytes, %d bytes per run\n", PIPE_SIZE, TOTAL_BYTES);
+
+	for (int i = 0; i < ARRAY_SIZE(chunk_sizes); i++) {
+		run(chunk_sizes[i]);
+	}
+
+	timing_stop();
+	printk("fin\n");
+	return 0;
+}
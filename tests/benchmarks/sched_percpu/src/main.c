@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/timing/timing.h>
+
+/* This is a scheduler run queue contention microbenchmark.  A number of
+ * threads of the same priority per CPU yield in a loop, so that every
+ * CPU keeps putting its current thread back into the run queue and
+ * picking the next one.  It reports the average cost of k_yield(),
+ * which is dominated by the run queue shared by all CPUs unless the
+ * per-CPU run queues absorb it.
+ */
+
+#define N_ROUNDS 2000
+#define STACK_SIZE 1024
+#define MAX_PER_CPU 4
+#define MAX_THREADS (MAX(CONFIG_MP_MAX_NUM_CPUS, 2) * MAX_PER_CPU)
+
+static const int per_cpu[] = { 1, 2, MAX_PER_CPU };
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, MAX_THREADS, STACK_SIZE);
+static struct k_thread threads[MAX_THREADS];
+
+static uint64_t yield_cycles[MAX_THREADS];
+
+static void thread_fn(void *arg1, void *arg2, void *arg3)
+{
+	int id = POINTER_TO_INT(arg1);
+	timing_t start, end;
+
+	ARG_UNUSED(arg2);
+	ARG_UNUSED(arg3);
+
+	for (int i = 0; i < N_ROUNDS; i++) {
+		start = timing_counter_get();
+		k_yield();
+		end = timing_counter_get();
+		yield_cycles[id] += timing_cycles_get(&start, &end);
+	}
+}
+
+static void run(int threads_per_cpu)
+{
+	unsigned int n = MAX(arch_num_cpus(), 2U) * threads_per_cpu;
+	uint64_t yield_tot = 0U;
+
+	for (unsigned int i = 0; i < n; i++) {
+		yield_cycles[i] = 0U;
+		k_thread_create(&threads[i], stacks[i], STACK_SIZE, thread_fn,
+				INT_TO_POINTER(i), NULL, NULL,
+				K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+	}
+
+	for (unsigned int i = 0; i < n; i++) {
+		k_thread_join(&threads[i], K_FOREVER);
+		yield_tot += yield_cycles[i];
+	}
+
+	printk("threads/cpu %d threads %u yield %6u ns\n", threads_per_cpu, n,
+	       (uint32_t)timing_cycles_to_ns_avg(yield_tot, N_ROUNDS * n));
+}
+
+int main(void)
+{
+	timing_init();
+	timing_start();
+
+	printk("Per-CPU run queues: %s\n",
+	       IS_ENABLED(CONFIG_SCHED_PERCPU) ? "yes" : "no");
+
+	for (int i = 0; i < ARRAY_SIZE(per_cpu); i++) {
+		run(per_cpu[i]);
+	}
+
+	timing_stop();
+	printk("fin\n");
+	return 0;
+}
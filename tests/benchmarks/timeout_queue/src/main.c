@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/timing/timing.h>
+#include <timeout_q.h>
+
+/* This is a timeout queue microbenchmark.  It measures the latency
+ * of z_add_timeout() and z_abort_timeout() as a function of the
+ * number of timeouts already present in the queue.  The background
+ * timeouts are scattered far enough in the future that none of them
+ * will expire while the benchmark runs, and the measured timeout
+ * lands at a pseudo-random position among them so that neither the
+ * best case (head of queue) nor the worst case (tail) dominates.
+ *
+ * On SMP builds a second pass runs the add/abort loop concurrently
+ * on every CPU to expose contention on the timeout queue lock(s).
+ */
+
+#define MAX_OUTSTANDING 1000
+#define N_RUNS 200
+#define N_SETTLE 10
+
+/* Far enough out that nothing expires during a run */
+#define BASE_TICKS 1000000
+
+static const int populations[] = { 10, 100, MAX_OUTSTANDING };
+
+static struct _timeout background[MAX_OUTSTANDING];
+static struct _timeout probe;
+
+static uint32_t rand_state = 1;
+
+/* Deterministic LCG so both backends see the same sequence */
+static uint32_t next_rand(void)
+{
+	rand_state = rand_state * 1103515245U + 12345U;
+	return rand_state >> 8;
+}
+
+static void dummy_fn(struct _timeout *t)
+{
+	ARG_UNUSED(t);
+}
+
+static void fill(int count)
+{
+	for (int i = 0; i < count; i++) {
+		z_init_timeout(&background[i]);
+		z_add_timeout(&background[i], dummy_fn,
+			      K_TICKS(BASE_TICKS + (next_rand() % BASE_TICKS)));
+	}
+}
+
+static void drain(int count)
+{
+	for (int i = 0; i < count; i++) {
+		z_abort_timeout(&background[i]);
+	}
+}
+
+static void run(int count)
+{
+	uint64_t add_tot = 0U, abort_tot = 0U;
+
+	fill(count);
+	z_init_timeout(&probe);
+
+	for (int i = 0; i < N_RUNS + N_SETTLE; i++) {
+		k_timeout_t t = K_TICKS(BASE_TICKS + (next_rand() % BASE_TICKS));
+		timing_t start, added, aborted;
+
+		start = timing_counter_get();
+		z_add_timeout(&probe, dummy_fn, t);
+		added = timing_counter_get();
+		z_abort_timeout(&probe);
+		aborted = timing_counter_get();
+
+		/* Let caches and branch predictors settle first */
+		if (i >= N_SETTLE) {
+			add_tot += timing_cycles_get(&start, &added);
+			abort_tot += timing_cycles_get(&added, &aborted);
+		}
+	}
+
+	drain(count);
+
+	printk("outstanding %4d add %6u ns abort %6u ns\n", count,
+	       (uint32_t)timing_cycles_to_ns_avg(add_tot, N_RUNS),
+	       (uint32_t)timing_cycles_to_ns_avg(abort_tot, N_RUNS));
+}
+
+#ifdef CONFIG_SMP
+/* Contention case: one thread per CPU repeatedly arms and cancels its
+ * own timeout at the same time as the others, so any time spent
+ * spinning on a shared queue lock shows up in the per-operation cost.
+ */
+#define N_SMP_OPS 2000
+#define SMP_STACK_SIZE 1024
+
+static K_THREAD_STACK_ARRAY_DEFINE(smp_stacks, CONFIG_MP_MAX_NUM_CPUS,
+				   SMP_STACK_SIZE);
+static struct k_thread smp_threads[CONFIG_MP_MAX_NUM_CPUS];
+static struct _timeout smp_timeouts[CONFIG_MP_MAX_NUM_CPUS];
+static uint64_t smp_cycles[CONFIG_MP_MAX_NUM_CPUS];
+
+static void smp_fn(void *arg1, void *arg2, void *arg3)
+{
+	int id = POINTER_TO_INT(arg1);
+	struct _timeout *to = &smp_timeouts[id];
+	timing_t start, end;
+
+	ARG_UNUSED(arg2);
+	ARG_UNUSED(arg3);
+
+	z_init_timeout(to);
+
+	start = timing_counter_get();
+	for (int i = 0; i < N_SMP_OPS; i++) {
+		z_add_timeout(to, dummy_fn, K_TICKS(BASE_TICKS + i));
+		z_abort_timeout(to);
+	}
+	end = timing_counter_get();
+
+	smp_cycles[id] = timing_cycles_get(&start, &end);
+}
+
+static void run_smp(int count)
+{
+	unsigned int cpus = arch_num_cpus();
+	uint64_t tot = 0U;
+
+	fill(count);
+
+	for (unsigned int i = 0; i < cpus; i++) {
+		k_thread_create(&smp_threads[i], smp_stacks[i],
+				SMP_STACK_SIZE, smp_fn,
+				INT_TO_POINTER(i), NULL, NULL,
+				K_PRIO_COOP(1), 0, K_NO_WAIT);
+	}
+
+	for (unsigned int i = 0; i < cpus; i++) {
+		k_thread_join(&smp_threads[i], K_FOREVER);
+		tot += smp_cycles[i];
+	}
+
+	drain(count);
+
+	printk("smp cpus %u outstanding %4d add+abort %6u ns\n", cpus, count,
+	       (uint32_t)timing_cycles_to_ns_avg(tot, N_SMP_OPS * cpus));
+}
+#endif /* CONFIG_SMP */
+
+int main(void)
+{
+	timing_init();
+	timing_start();
+
+	printk("Timeout queue backend: %s\n",
+	       IS_ENABLED(CONFIG_TIMEOUT_QUEUE_SCALABLE) ? "scalable" : "dumb");
+
+	for (int i = 0; i < ARRAY_SIZE(populations); i++) {
+		run(populations[i]);
+	}
+
+#ifdef CONFIG_SMP
+	printk("Per-CPU timeout queues: %s\n",
+	       IS_ENABLED(CONFIG_TIMEOUT_QUEUE_PERCPU) ? "yes" : "no");
+
+	for (int i = 0; i < ARRAY_SIZE(populations); i++) {
+		run_smp(populations[i]);
+	}
+#endif
+
+	timing_stop();
+	printk("fin\n");
+	return 0;
+}
@@ -519,6 +519,152 @@ ZTEST(bitarray, test_bitarray_alloc_free)
 	alloc_and_free_interval();
 }
 
+/**
+ * @brief Test bitarrays allocation of several regions at once
+ *
+ * @see sys_bitarray_alloc_regions()
+ */
+ZTEST(bitarray, test_bitarray_alloc_regions)
+{
+	int ret;
+	size_t cnt;
+	size_t offsets[40];
+
+	/* Bitarrays have embedded spinlocks and can't on the stack. */
+	if (IS_ENABLED(CONFIG_KERNEL_COHERENCE)) {
+		ztest_test_skip();
+	}
+
+	/* Not a multiple of the bundle size */
+	SYS_BITARRAY_DEFINE(ba, 76);
+
+	printk("Testing bit array region alloc\n");
+
+	/* 4 bits allocated, then 4 free bits, and repeat */
+	for (cnt = 0; cnt < ba.num_bundles; cnt++) {
+		ba.bundles[cnt] = 0x0F0F0F0F;
+	}
+	ba.bundles[ba.num_bundles - 1] &= BIT(ba.num_bits % 32) - 1;
+
+	/* 36 bits are free, single bits are taken lowest first */
+	ret = sys_bitarray_alloc_regions(&ba, 1, 37, offsets);
+	zassert_equal(ret, -ENOSPC, "sys_bitarray_alloc_regions() should fail");
+	zassert_equal(get_bitarray_popcnt(&ba), 40, "failed allocation changed bits");
+
+	ret = sys_bitarray_alloc_regions(&ba, 1, 5, offsets);
+	zassert_equal(ret, 0, "sys_bitarray_alloc_regions() failed (%d)", ret);
+	zassert_equal(offsets[0], 4, "offset expected 4, got %u", offsets[0]);
+	zassert_equal(offsets[3], 7, "offset expected 7, got %u", offsets[3]);
+	zassert_equal(offsets[4], 12, "offset expected 12, got %u", offsets[4]);
+
+	/* Regions of 3 fit in bits 13 to 15 and in the 7 holes of 4 bits */
+	ret = sys_bitarray_alloc_regions(&ba, 3, 9, offsets);
+	zassert_equal(ret, -ENOSPC, "sys_bitarray_alloc_regions() should fail");
+	zassert_equal(get_bitarray_popcnt(&ba), 45, "failed allocation changed bits");
+
+	ret = sys_bitarray_alloc_regions(&ba, 3, 8, offsets);
+	zassert_equal(ret, 0, "sys_bitarray_alloc_regions() failed (%d)", ret);
+	zassert_equal(offsets[0], 13, "offset expected 13, got %u", offsets[0]);
+	for (cnt = 1; cnt < 8; cnt++) {
+		zassert_equal(offsets[cnt], 12 + 8 * cnt,
+			      "offset expected %u, got %u", 12 + 8 * cnt, offsets[cnt]);
+	}
+
+	/* One free bit is left at the end of each hole */
+	ret = sys_bitarray_alloc_regions(&ba, 1, 7, offsets);
+	zassert_equal(ret, 0, "sys_bitarray_alloc_regions() failed (%d)", ret);
+	zassert_equal(get_bitarray_popcnt(&ba), ba.num_bits, "all bits should be set");
+
+	ret = sys_bitarray_alloc_regions(&ba, 1, 1, offsets);
+	zassert_equal(ret, -ENOSPC, "sys_bitarray_alloc_regions() should fail");
+
+	ret = sys_bitarray_alloc_regions(&ba, 0, 1, offsets);
+	zassert_equal(ret, -EINVAL, "sys_bitarray_alloc_regions() should fail");
+	ret = sys_bitarray_alloc_regions(&ba, ba.num_bits + 1, 1, offsets);
+	zassert_equal(ret, -EINVAL, "sys_bitarray_alloc_regions() should fail");
+}
+
+/**
+ * @brief Test finding and counting bits in bitarrays
+ *
+ * @see sys_bitarray_find_first_set()
+ * @see sys_bitarray_find_first_clear()
+ * @see sys_bitarray_popcount_region()
+ */
+ZTEST(bitarray, test_bitarray_find_popcount)
+{
+	int ret;
+	size_t bit;
+	size_t count;
+
+	/* Bitarrays have embedded spinlocks and can't on the stack. */
+	if (IS_ENABLED(CONFIG_KERNEL_COHERENCE)) {
+		ztest_test_skip();
+	}
+
+	/* Not a multiple of the bundle size */
+	SYS_BITARRAY_DEFINE(ba, 100);
+
+	printk("Testing bit array find and popcount\n");
+
+	ret = sys_bitarray_find_first_set(&ba, 0, &bit);
+	zassert_equal(ret, -ENOENT, "no bit should be set");
+	ret = sys_bitarray_find_first_clear(&ba, 99, &bit);
+	zassert_equal(ret, 0, "sys_bitarray_find_first_clear() failed (%d)", ret);
+	zassert_equal(bit, 99, "expected bit 99, got %u", bit);
+
+	ret = sys_bitarray_set_region(&ba, 30, 20);
+	zassert_equal(ret, 0, "sys_bitarray_set_region() failed (%d)", ret);
+	ret = sys_bitarray_set_bit(&ba, 97);
+	zassert_equal(ret, 0, "sys_bitarray_set_bit() failed (%d)", ret);
+
+	ret = sys_bitarray_find_first_set(&ba, 0, &bit);
+	zassert_equal(ret, 0, "sys_bitarray_find_first_set() failed (%d)", ret);
+	zassert_equal(bit, 20, "expected bit 20, got %u", bit);
+	ret = sys_bitarray_find_first_set(&ba, 33, &bit);
+	zassert_equal(bit, 33, "expected bit 33, got %u", bit);
+	ret = sys_bitarray_find_first_set(&ba, 50, &bit);
+	zassert_equal(bit, 97, "expected bit 97, got %u", bit);
+	ret = sys_bitarray_find_first_set(&ba, 98, &bit);
+	zassert_equal(ret, -ENOENT, "no bit should be set past 97");
+
+	ret = sys_bitarray_find_first_clear(&ba, 20, &bit);
+	zassert_equal(ret, 0, "sys_bitarray_find_first_clear() failed (%d)", ret);
+	zassert_equal(bit, 50, "expected bit 50, got %u", bit);
+	ret = sys_bitarray_find_first_clear(&ba, 97, &bit);
+	zassert_equal(bit, 98, "expected bit 98, got %u", bit);
+
+	ret = sys_bitarray_set_region(&ba, 2, 98);
+	zassert_equal(ret, 0, "sys_bitarray_set_region() failed (%d)", ret);
+	ret = sys_bitarray_find_first_clear(&ba, 98, &bit);
+	zassert_equal(ret, -ENOENT, "no bit should be cleared past 97");
+
+	ret = sys_bitarray_find_first_set(&ba, 100, &bit);
+	zassert_equal(ret, -EINVAL, "sys_bitarray_find_first_set() should fail");
+	ret = sys_bitarray_find_first_clear(&ba, 100, &bit);
+	zassert_equal(ret, -EINVAL, "sys_bitarray_find_first_clear() should fail");
+
+	ret = sys_bitarray_clear_region(&ba, 100, 0);
+	zassert_equal(ret, 0, "sys_bitarray_clear_region() failed (%d)", ret);
+	ret = sys_bitarray_set_region(&ba, 40, 30);
+	zassert_equal(ret, 0, "sys_bitarray_set_region() failed (%d)", ret);
+
+	ret = sys_bitarray_popcount_region(&ba, 100, 0, &count);
+	zassert_equal(ret, 0, "sys_bitarray_popcount_region() failed (%d)", ret);
+	zassert_equal(count, 40, "expected 40 bits, got %u", count);
+	ret = sys_bitarray_popcount_region(&ba, 5, 28, &count);
+	zassert_equal(count, 3, "expected 3 bits, got %u", count);
+	ret = sys_bitarray_popcount_region(&ba, 50, 50, &count);
+	zassert_equal(count, 20, "expected 20 bits, got %u", count);
+	ret = sys_bitarray_popcount_region(&ba, 10, 0, &count);
+	zassert_equal(count, 0, "expected 0 bits, got %u", count);
+
+	ret = sys_bitarray_popcount_region(&ba, 0, 0, &count);
+	zassert_equal(ret, -EINVAL, "sys_bitarray_popcount_region() should fail");
+	ret = sys_bitarray_popcount_region(&ba, 2, 99, &count);
+	zassert_equal(ret, -EINVAL, "sys_bitarray_popcount_region() should fail");
+}
+
 ZTEST(bitarray, test_bitarray_region_set_clear)
 {
 	int ret;
@@ -105,6 +105,9 @@ static void print_paging_stats(struct k_mem_paging_stats_t *stats, const char *s
 #ifndef CONFIG_DEMAND_PAGING_ALLOW_IRQ
 	printk("    - in ISR: %lu\n", stats->pagefaults.in_isr);
 #endif
+#ifdef CONFIG_DEMAND_PAGING_READ_AHEAD
+	printk("    - Pages read ahead: %lu\n", stats->pagefaults.read_ahead);
+#endif
 
 	printk("* Eviction (%s):\n", scope);
 	printk("    - Total pages evicted: %lu\n",
@@ -212,9 +215,16 @@ static void test_k_mem_page_out(void)
 	faults = z_num_pagefaults_get() - faults;
 	irq_unlock(key);
 
+#ifdef CONFIG_DEMAND_PAGING_READ_AHEAD
+	/* Sequential writes, so pages after the first few are read ahead */
+	zassert_true(faults > 0 && faults < HALF_PAGES,
+		     "unexpected num pagefaults expected less than %lu got %d",
+		     HALF_PAGES, faults);
+#else
 	zassert_equal(faults, HALF_PAGES,
 		      "unexpected num pagefaults expected %lu got %d",
 		      HALF_PAGES, faults);
+#endif
 
 	ret = k_mem_page_out(arena, arena_size);
 	zassert_equal(ret, -ENOMEM, "k_mem_page_out should have failed");
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * RAM backing store which can refuse locations to everything but page
+ * faults, as a backing store keeping its last locations for them does
+ * when it is nearly full.
+ */
+#include <mmu.h>
+#include <string.h>
+#include <kernel_arch_interface.h>
+#include <zephyr/kernel/mm/demand_paging.h>
+
+#include "backing_store.h"
+
+bool backing_store_reject_evictions;
+unsigned int backing_store_rejected;
+
+static char backing_store[CONFIG_MMU_PAGE_SIZE * BACKING_STORE_PAGES];
+static struct k_mem_slab backing_slabs;
+
+static void *location_to_slab(uintptr_t location)
+{
+	__ASSERT(location < sizeof(backing_store), "bad location 0x%lx",
+		 location);
+
+	return backing_store + location;
+}
+
+int k_mem_paging_backing_store_location_get(struct z_page_frame *pf,
+					    uintptr_t *location,
+					    bool page_fault)
+{
+	void *slab;
+
+	if (!page_fault && backing_store_reject_evictions) {
+		backing_store_rejected++;
+		return -ENOMEM;
+	}
+
+	if (k_mem_slab_alloc(&backing_slabs, &slab, K_NO_WAIT) != 0) {
+		return -ENOMEM;
+	}
+	*location = (char *)slab - backing_store;
+
+	return 0;
+}
+
+void k_mem_paging_backing_store_location_free(uintptr_t location)
+{
+	k_mem_slab_free(&backing_slabs, location_to_slab(location));
+}
+
+void k_mem_paging_backing_store_page_out(uintptr_t location)
+{
+	(void)memcpy(location_to_slab(location), Z_SCRATCH_PAGE,
+		     CONFIG_MMU_PAGE_SIZE);
+}
+
+void k_mem_paging_backing_store_page_in(uintptr_t location)
+{
+	(void)memcpy(Z_SCRATCH_PAGE, location_to_slab(location),
+		     CONFIG_MMU_PAGE_SIZE);
+}
+
+void k_mem_paging_backing_store_page_finalize(struct z_page_frame *pf,
+					      uintptr_t location)
+{
+	k_mem_paging_backing_store_location_free(location);
+}
+
+void k_mem_paging_backing_store_init(void)
+{
+	k_mem_slab_init(&backing_slabs, backing_store, CONFIG_MMU_PAGE_SIZE,
+			BACKING_STORE_PAGES);
+}
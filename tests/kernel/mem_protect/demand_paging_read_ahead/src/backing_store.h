@@ -0,0 +1,21 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef TEST_BACKING_STORE_H_
+#define TEST_BACKING_STORE_H_
+
+#include <stdbool.h>
+
+/* Number of data pages the backing store can hold */
+#define BACKING_STORE_PAGES 16
+
+/* When set, only page faults get a backing store location */
+extern bool backing_store_reject_evictions;
+
+/* Number of locations refused to other requests than page faults */
+extern unsigned int backing_store_rejected;
+
+#endif /* TEST_BACKING_STORE_H_ */
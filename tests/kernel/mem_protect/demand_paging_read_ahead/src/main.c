@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/kernel/mm.h>
+#include <zephyr/kernel/mm/demand_paging.h>
+#include <mmu.h>
+
+#include "backing_store.h"
+
+/* Data pages paged out before reading the arena back */
+#define OUT_PAGES (BACKING_STORE_PAGES / 2)
+#define OUT_BYTES (OUT_PAGES * CONFIG_MMU_PAGE_SIZE)
+
+/* Each data page of the arena is filled with its index */
+static char page_byte(size_t offset)
+{
+	return (char)(offset / CONFIG_MMU_PAGE_SIZE);
+}
+
+/* Sequential page faults read ahead, evicting a page frame for each data
+ * page read ahead. Show that when the backing store refuses a location
+ * for an evicted dirty page, the faulting data page still ends up in its
+ * own page frame, and the page frame which was not evicted is left alone.
+ */
+ZTEST(demand_paging_read_ahead, test_read_ahead_rejected)
+{
+	struct k_mem_paging_stats_t stats;
+	size_t arena_size;
+	char *arena, *filler;
+	unsigned long faults;
+	unsigned int key;
+	int ret;
+
+	arena_size = k_mem_free_get();
+	arena = k_mem_map(arena_size, K_MEM_PERM_RW);
+	zassert_not_null(arena, "failed to map arena size %zu", arena_size);
+
+	for (size_t i = 0; i < arena_size; i++) {
+		arena[i] = page_byte(i);
+	}
+
+	/* Page out the start of the arena, then use up the page frames it
+	 * freed, so that its page-ins have to evict dirty data pages
+	 */
+	ret = k_mem_page_out(arena, OUT_BYTES);
+	zassert_equal(ret, 0, "k_mem_page_out failed with %d", ret);
+
+	filler = k_mem_map(OUT_BYTES, K_MEM_PERM_RW);
+	zassert_not_null(filler, "failed to map filler");
+	(void)memset(filler, 0xa5, OUT_BYTES);
+
+	key = irq_lock();
+	backing_store_reject_evictions = true;
+	faults = z_num_pagefaults_get();
+
+	for (size_t i = 0; i < arena_size; i++) {
+		if (arena[i] != page_byte(i)) {
+			backing_store_reject_evictions = false;
+			irq_unlock(key);
+			zassert_unreachable("arena corrupted at %p: got 0x%hhx expected 0x%hhx",
+					    &arena[i], arena[i], page_byte(i));
+		}
+	}
+
+	faults = z_num_pagefaults_get() - faults;
+	backing_store_reject_evictions = false;
+	irq_unlock(key);
+
+	for (size_t i = 0; i < OUT_BYTES; i++) {
+		zassert_equal(filler[i], (char)0xa5, "filler corrupted at %p",
+			      &filler[i]);
+	}
+
+	/* Every paged out data page faulted as none could be read ahead */
+	zassert_true(faults >= OUT_PAGES, "%lu page faults, expected %u or more",
+		     faults, OUT_PAGES);
+	zassert_not_equal(backing_store_rejected, 0U,
+			  "no read-ahead was refused a location");
+
+	k_mem_paging_stats_get(&stats);
+	zassert_equal(stats.pagefaults.read_ahead, 0UL,
+		      "%lu pages read ahead", stats.pagefaults.read_ahead);
+}
+
+ZTEST_SUITE(demand_paging_read_ahead, NULL, NULL, NULL, NULL, NULL);
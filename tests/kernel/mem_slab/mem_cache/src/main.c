@@ -0,0 +1,226 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#define OBJ_ALIGN   16
+#define NUM_STATIC  4
+#define NUM_INITIAL 2
+#define GROW_OBJS   3
+#define GROW_MAX    2
+#define STACK_SIZE  (512 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+#define OBJ_MAGIC 0x6f626a21U
+
+struct obj {
+	uint32_t magic;
+	uint32_t uses;
+	uint8_t payload[40];
+};
+
+#define BLOCK_SIZE K_MEM_CACHE_BLOCK_SIZE(sizeof(struct obj), OBJ_ALIGN)
+
+static atomic_t static_ctors, static_dtors;
+static atomic_t dyn_ctors, dyn_dtors;
+
+static void obj_init(void *p)
+{
+	struct obj *o = p;
+
+	o->magic = OBJ_MAGIC;
+	o->uses = 0U;
+}
+
+static void static_ctor(void *p)
+{
+	obj_init(p);
+	atomic_inc(&static_ctors);
+}
+
+static void static_dtor(void *p)
+{
+	ARG_UNUSED(p);
+	atomic_inc(&static_dtors);
+}
+
+static void dyn_ctor(void *p)
+{
+	obj_init(p);
+	atomic_inc(&dyn_ctors);
+}
+
+static void dyn_dtor(void *p)
+{
+	struct obj *o = p;
+
+	zassert_equal(o->magic, OBJ_MAGIC, "destroying an unconstructed object");
+	o->magic = 0U;
+	atomic_inc(&dyn_dtors);
+}
+
+K_MEM_CACHE_DEFINE(static_cache, sizeof(struct obj), NUM_STATIC, OBJ_ALIGN,
+		   static_ctor, static_dtor);
+
+static char __aligned(OBJ_ALIGN) dyn_buf[NUM_INITIAL * BLOCK_SIZE];
+static struct k_mem_cache dyn_cache;
+
+K_HEAP_DEFINE(grow_heap, 1024 + GROW_MAX * GROW_OBJS * BLOCK_SIZE);
+
+static K_THREAD_STACK_DEFINE(stack, STACK_SIZE);
+static struct k_thread thread;
+
+static void check_obj(struct obj *o)
+{
+	zassert_not_null(o, "allocation failed");
+	zassert_equal((uintptr_t)o % OBJ_ALIGN, 0U, "object %p misaligned", o);
+	zassert_equal(o->magic, OBJ_MAGIC, "object %p not constructed", o);
+}
+
+ZTEST(mem_cache, test_static_cache)
+{
+	struct obj *objs[NUM_STATIC];
+
+	/* Constructed at boot, once per object */
+	zassert_equal(atomic_get(&static_ctors), NUM_STATIC);
+
+	for (int i = 0; i < NUM_STATIC; i++) {
+		objs[i] = k_mem_cache_alloc(&static_cache, K_NO_WAIT);
+		check_obj(objs[i]);
+		objs[i]->uses++;
+	}
+
+	zassert_is_null(k_mem_cache_alloc(&static_cache, K_NO_WAIT),
+			"cache without a heap grew");
+
+	for (int i = 0; i < NUM_STATIC; i++) {
+		k_mem_cache_free(&static_cache, objs[i]);
+	}
+
+	/* Freed objects keep their state and aren't constructed again */
+	for (int i = 0; i < NUM_STATIC; i++) {
+		objs[i] = k_mem_cache_alloc(&static_cache, K_NO_WAIT);
+		check_obj(objs[i]);
+		zassert_equal(objs[i]->uses, 1U, "object state lost");
+	}
+
+	for (int i = 0; i < NUM_STATIC; i++) {
+		k_mem_cache_free(&static_cache, objs[i]);
+	}
+
+	zassert_equal(atomic_get(&static_ctors), NUM_STATIC);
+	zassert_equal(k_mem_cache_shrink(&static_cache), 0U);
+	zassert_equal(atomic_get(&static_dtors), 0);
+}
+
+ZTEST(mem_cache, test_grow_shrink)
+{
+	const int total = NUM_INITIAL + GROW_MAX * GROW_OBJS;
+	struct obj *objs[NUM_INITIAL + GROW_MAX * GROW_OBJS];
+	struct sys_memory_stats stats;
+
+	zassert_equal(k_mem_cache_init(&dyn_cache, dyn_buf, sizeof(struct obj),
+				       OBJ_ALIGN, NUM_INITIAL, dyn_ctor, dyn_dtor),
+		      0);
+	zassert_equal(k_mem_cache_heap_set(&dyn_cache, &grow_heap, GROW_OBJS,
+					   GROW_MAX),
+		      0);
+	zassert_equal(atomic_get(&dyn_ctors), NUM_INITIAL);
+
+	for (int i = 0; i < total; i++) {
+		objs[i] = k_mem_cache_alloc(&dyn_cache, K_NO_WAIT);
+		check_obj(objs[i]);
+	}
+
+	zassert_is_null(k_mem_cache_alloc(&dyn_cache, K_NO_WAIT),
+			"cache grew beyond its limit");
+	zassert_equal(atomic_get(&dyn_ctors), total);
+
+	zassert_equal(k_mem_cache_runtime_stats_get(&dyn_cache, &stats), 0);
+	zassert_equal(stats.allocated_bytes, total * BLOCK_SIZE);
+	zassert_equal(stats.free_bytes, 0U);
+	zassert_equal(stats.max_allocated_bytes, total * BLOCK_SIZE);
+
+	/* A slab with an object in use is kept */
+	for (int i = 0; i < total - 1; i++) {
+		k_mem_cache_free(&dyn_cache, objs[i]);
+	}
+	zassert_equal(k_mem_cache_shrink(&dyn_cache), 1U);
+	zassert_equal(atomic_get(&dyn_dtors), GROW_OBJS);
+
+	k_mem_cache_free(&dyn_cache, objs[total - 1]);
+	zassert_equal(k_mem_cache_shrink(&dyn_cache), 1U);
+	zassert_equal(atomic_get(&dyn_dtors), GROW_MAX * GROW_OBJS);
+
+	zassert_equal(k_mem_cache_runtime_stats_get(&dyn_cache, &stats), 0);
+	zassert_equal(stats.allocated_bytes, 0U);
+	zassert_equal(stats.free_bytes, NUM_INITIAL * BLOCK_SIZE);
+
+	/* The heap memory was returned, so the cache grows again */
+	for (int i = 0; i < total; i++) {
+		objs[i] = k_mem_cache_alloc(&dyn_cache, K_NO_WAIT);
+		check_obj(objs[i]);
+	}
+	zassert_equal(atomic_get(&dyn_ctors), total + GROW_MAX * GROW_OBJS);
+
+	for (int i = 0; i < total; i++) {
+		k_mem_cache_free(&dyn_cache, objs[i]);
+	}
+	zassert_equal(k_mem_cache_shrink(&dyn_cache), GROW_MAX);
+}
+
+static void free_fn(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p3);
+
+	k_msleep(10);
+	k_mem_cache_free(p1, p2);
+}
+
+ZTEST(mem_cache, test_alloc_wait)
+{
+	struct obj *objs[NUM_STATIC];
+	struct obj *o;
+
+	for (int i = 0; i < NUM_STATIC; i++) {
+		objs[i] = k_mem_cache_alloc(&static_cache, K_NO_WAIT);
+		check_obj(objs[i]);
+	}
+
+	zassert_is_null(k_mem_cache_alloc(&static_cache, K_MSEC(10)),
+			"allocation did not time out");
+
+	k_thread_create(&thread, stack, STACK_SIZE, free_fn, &static_cache,
+			objs[0], NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+
+	o = k_mem_cache_alloc(&static_cache, K_MSEC(1000));
+	zassert_equal_ptr(o, objs[0], "waiter did not get the freed object");
+	k_thread_join(&thread, K_FOREVER);
+
+	for (int i = 0; i < NUM_STATIC; i++) {
+		k_mem_cache_free(&static_cache, objs[i]);
+	}
+}
+
+ZTEST(mem_cache, test_invalid_params)
+{
+	struct k_mem_cache cache;
+	struct sys_memory_stats stats;
+
+	zassert_equal(k_mem_cache_init(&cache, NULL, sizeof(struct obj), 3, 0,
+				       NULL, NULL),
+		      -EINVAL);
+	zassert_equal(k_mem_cache_init(&cache, NULL, 0, OBJ_ALIGN, 0,
+				       NULL, NULL),
+		      -EINVAL);
+	zassert_equal(k_mem_cache_heap_set(&static_cache, NULL, 1, 1), -EINVAL);
+	zassert_equal(k_mem_cache_heap_set(&static_cache, &grow_heap, 0, 1),
+		      -EINVAL);
+	zassert_equal(k_mem_cache_runtime_stats_get(NULL, &stats), -EINVAL);
+	zassert_equal(k_mem_cache_runtime_stats_get(&static_cache, NULL), -EINVAL);
+}
+
+ZTEST_SUITE(mem_cache, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "test_msgq.h"
+
+#define MANY_LEN 5
+
+K_THREAD_STACK_DECLARE(tstack, STACK_SIZE);
+extern struct k_thread tdata;
+extern struct k_msgq msgq;
+static char __aligned(4) many_buffer[MSG_SIZE * MANY_LEN];
+static ZTEST_BMEM uint32_t many_rx[MANY_LEN * 2];
+static uint32_t single_rx;
+
+static void fill_seq(uint32_t *buf, int num, uint32_t first)
+{
+	for (int i = 0; i < num; i++) {
+		buf[i] = first + i;
+	}
+}
+
+static void check_seq(uint32_t *buf, int num, uint32_t first)
+{
+	for (int i = 0; i < num; i++) {
+		zassert_equal(buf[i], first + i, "msg %d: got %u", i, buf[i]);
+	}
+}
+
+/**
+ * @addtogroup kernel_message_queue_tests
+ * @{
+ */
+
+/**
+ * @brief Test batched put/get across the ring buffer wrap-around
+ * @see k_msgq_put_many(), k_msgq_get_many()
+ */
+ZTEST(msgq_api, test_msgq_put_get_many)
+{
+	uint32_t tx[MANY_LEN + 2];
+	int ret;
+
+	k_msgq_init(&msgq, many_buffer, MSG_SIZE, MANY_LEN);
+
+	fill_seq(tx, ARRAY_SIZE(tx), 0);
+	zassert_equal(k_msgq_put_many(&msgq, tx, 0, K_NO_WAIT), 0);
+	zassert_equal(k_msgq_put_many(&msgq, tx, 3, K_NO_WAIT), 3);
+	zassert_equal(k_msgq_get_many(&msgq, many_rx, 2, K_NO_WAIT), 2);
+	check_seq(many_rx, 2, 0);
+
+	/* Only four slots left: the write wraps and is truncated */
+	ret = k_msgq_put_many(&msgq, &tx[3], 4 + 2, K_NO_WAIT);
+	zassert_equal(ret, 4);
+	zassert_equal(k_msgq_num_free_get(&msgq), 0);
+	zassert_equal(k_msgq_put_many(&msgq, tx, 1, K_NO_WAIT), -ENOMSG);
+
+	/* Reading more than available returns what is queued */
+	ret = k_msgq_get_many(&msgq, many_rx, ARRAY_SIZE(many_rx), K_NO_WAIT);
+	zassert_equal(ret, MANY_LEN);
+	check_seq(many_rx, MANY_LEN, 2);
+
+	zassert_equal(k_msgq_get_many(&msgq, many_rx, 1, K_NO_WAIT), -ENOMSG);
+	zassert_equal(k_msgq_get_many(&msgq, many_rx, 1, TIMEOUT), -EAGAIN);
+}
+
+static void get_entry(void *p1, void *p2, void *p3)
+{
+	zassert_equal(k_msgq_get(&msgq, &single_rx, K_FOREVER), 0);
+}
+
+/**
+ * @brief Test that k_msgq_put_many() hands messages to a waiting receiver
+ * @see k_msgq_put_many()
+ */
+ZTEST(msgq_api_1cpu, test_msgq_put_many_to_waiter)
+{
+	uint32_t tx[3];
+
+	k_msgq_init(&msgq, many_buffer, MSG_SIZE, MANY_LEN);
+
+	k_thread_create(&tdata, tstack, STACK_SIZE, get_entry, NULL, NULL,
+			NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_msleep(TIMEOUT_MS >> 1);
+
+	fill_seq(tx, ARRAY_SIZE(tx), 10);
+	zassert_equal(k_msgq_put_many(&msgq, tx, ARRAY_SIZE(tx), K_NO_WAIT), 3);
+	k_thread_join(&tdata, K_FOREVER);
+
+	/* The first message went straight to the receiver */
+	zassert_equal(single_rx, 10);
+	zassert_equal(k_msgq_num_used_get(&msgq), 2);
+	zassert_equal(k_msgq_get_many(&msgq, many_rx, 2, K_NO_WAIT), 2);
+	check_seq(many_rx, 2, 11);
+}
+
+static void put_entry(void *p1, void *p2, void *p3)
+{
+	uint32_t msg = POINTER_TO_UINT(p1);
+
+	zassert_equal(k_msgq_put(&msgq, &msg, K_FOREVER), 0);
+}
+
+/**
+ * @brief Test that k_msgq_get_many() admits a blocked sender
+ * @see k_msgq_get_many()
+ */
+ZTEST(msgq_api_1cpu, test_msgq_get_many_wakes_sender)
+{
+	uint32_t tx[MANY_LEN];
+
+	k_msgq_init(&msgq, many_buffer, MSG_SIZE, MANY_LEN);
+
+	fill_seq(tx, MANY_LEN, 20);
+	zassert_equal(k_msgq_put_many(&msgq, tx, MANY_LEN, K_NO_WAIT),
+		      MANY_LEN);
+
+	k_thread_create(&tdata, tstack, STACK_SIZE, put_entry,
+			UINT_TO_POINTER(20 + MANY_LEN), NULL, NULL,
+			K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_msleep(TIMEOUT_MS >> 1);
+
+	zassert_equal(k_msgq_get_many(&msgq, many_rx, 2, K_NO_WAIT), 2);
+	k_thread_join(&tdata, K_FOREVER);
+
+	zassert_equal(k_msgq_num_used_get(&msgq), MANY_LEN - 1);
+	zassert_equal(k_msgq_get_many(&msgq, &many_rx[2], MANY_LEN, K_NO_WAIT),
+		      MANY_LEN - 1);
+	check_seq(many_rx, MANY_LEN + 1, 20);
+}
+
+#ifdef CONFIG_USERSPACE
+/**
+ * @brief Test batched put/get from a user thread
+ * @see k_msgq_put_many(), k_msgq_get_many()
+ */
+ZTEST_USER(msgq_api, test_msgq_user_put_get_many)
+{
+	uint32_t tx[MANY_LEN];
+	struct k_msgq *q;
+
+	q = k_object_alloc(K_OBJ_MSGQ);
+	zassert_not_null(q, "couldn't alloc message queue");
+	zassert_false(k_msgq_alloc_init(q, MSG_SIZE, MANY_LEN));
+
+	fill_seq(tx, MANY_LEN, 30);
+	zassert_equal(k_msgq_put_many(q, tx, MANY_LEN, K_NO_WAIT), MANY_LEN);
+	zassert_equal(k_msgq_get_many(q, many_rx, MANY_LEN, K_NO_WAIT),
+		      MANY_LEN);
+	check_seq(many_rx, MANY_LEN, 30);
+
+	k_msgq_cleanup(q);
+}
+#endif
+
+/**
+ * @}
+ */
@@ -693,6 +693,176 @@ ZTEST(obj_core_stats_mem_slab, test_obj_core_stats_mem_slab)
 	k_mem_slab_free(&mem_slab, mem2);
 }
 
+/***************** LOCKS *********************/
+
+#if defined(CONFIG_OBJ_CORE_STATS_MUTEX) || defined(CONFIG_OBJ_CORE_STATS_SEM) || \
+	defined(CONFIG_OBJ_CORE_STATS_SPINLOCK)
+
+#define LOCK_HOLD_MS 10
+
+static K_THREAD_STACK_DEFINE(lock_thread_stack,
+			     1024 + CONFIG_TEST_EXTRA_STACK_SIZE);
+static struct k_thread lock_thread;
+
+static void lock_thread_start(k_thread_entry_t entry, void *obj)
+{
+	k_thread_create(&lock_thread, lock_thread_stack,
+			K_THREAD_STACK_SIZEOF(lock_thread_stack), entry,
+			obj, NULL, NULL,
+			k_thread_priority_get(k_current_get()) - 1, 0,
+			K_NO_WAIT);
+
+	/* Let it run until it sleeps */
+	k_yield();
+}
+
+static void test_lock_query(const char *str, struct k_obj_core *obj_core,
+			    struct k_lock_stats *expected)
+{
+	struct k_lock_stats query;
+	int  status;
+
+	status = k_obj_core_stats_query(obj_core, &query, sizeof(query));
+	zassert_equal(status, 0,
+		      "%s: Failed to get query stats (%d)\n", str, status);
+
+	zassert_equal(query.acquisitions, expected->acquisitions,
+		      "%s: Expected %llu acquisitions, got %llu\n",
+		      str, expected->acquisitions, query.acquisitions);
+	zassert_equal(query.contentions, expected->contentions,
+		      "%s: Expected %llu contentions, got %llu\n",
+		      str, expected->contentions, query.contentions);
+	zassert_equal(query.max_wait != 0U, expected->max_wait != 0U,
+		      "%s: Unexpected max wait %u\n", str, query.max_wait);
+	zassert_equal(query.max_hold != 0U, expected->max_hold != 0U,
+		      "%s: Unexpected max hold %u\n", str, query.max_hold);
+	zassert_true(query.total_wait >= query.max_wait,
+		     "%s: Total wait %llu below max wait %u\n",
+		     str, query.total_wait, query.max_wait);
+}
+
+#ifdef CONFIG_OBJ_CORE_STATS_MUTEX
+K_MUTEX_DEFINE(lock_mutex);
+
+static void mutex_holder_entry(void *p1, void *p2, void *p3)
+{
+	k_mutex_lock(p1, K_FOREVER);
+	k_msleep(LOCK_HOLD_MS);
+	k_mutex_unlock(p1);
+}
+
+ZTEST(obj_core_stats_lock, test_obj_core_stats_mutex)
+{
+	struct k_lock_stats expected = { 0 };
+	int  status;
+
+	status = k_obj_core_stats_reset(K_OBJ_CORE(&lock_mutex));
+	zassert_equal(status, 0, "Expected 0, got %d\n", status);
+	test_lock_query("Reset", K_OBJ_CORE(&lock_mutex), &expected);
+
+	/* Recursive locking counts each acquisition */
+	k_mutex_lock(&lock_mutex, K_FOREVER);
+	k_mutex_lock(&lock_mutex, K_FOREVER);
+	k_mutex_unlock(&lock_mutex);
+	k_mutex_unlock(&lock_mutex);
+	expected.acquisitions = 2;
+	test_lock_query("Uncontended", K_OBJ_CORE(&lock_mutex), &expected);
+
+	lock_thread_start(mutex_holder_entry, &lock_mutex);
+	expected.acquisitions++;
+
+	status = k_mutex_lock(&lock_mutex, K_NO_WAIT);
+	zassert_equal(status, -EBUSY, "Expected -EBUSY, got %d\n", status);
+	expected.contentions++;
+
+	status = k_mutex_lock(&lock_mutex, K_FOREVER);
+	zassert_equal(status, 0, "Expected 0, got %d\n", status);
+	k_mutex_unlock(&lock_mutex);
+	k_thread_join(&lock_thread, K_FOREVER);
+	expected.acquisitions++;
+	expected.contentions++;
+	expected.max_wait = 1;
+	expected.max_hold = 1;
+	test_lock_query("Contended", K_OBJ_CORE(&lock_mutex), &expected);
+}
+#endif
+
+#ifdef CONFIG_OBJ_CORE_STATS_SEM
+K_SEM_DEFINE(lock_sem, 0, 1);
+
+static void sem_giver_entry(void *p1, void *p2, void *p3)
+{
+	k_msleep(LOCK_HOLD_MS);
+	k_sem_give(p1);
+}
+
+ZTEST(obj_core_stats_lock, test_obj_core_stats_sem)
+{
+	struct k_lock_stats expected = { 0 };
+	int  status;
+
+	status = k_obj_core_stats_reset(K_OBJ_CORE(&lock_sem));
+	zassert_equal(status, 0, "Expected 0, got %d\n", status);
+	test_lock_query("Reset", K_OBJ_CORE(&lock_sem), &expected);
+
+	status = k_sem_take(&lock_sem, K_NO_WAIT);
+	zassert_equal(status, -EBUSY, "Expected -EBUSY, got %d\n", status);
+	expected.contentions++;
+	test_lock_query("Unavailable", K_OBJ_CORE(&lock_sem), &expected);
+
+	lock_thread_start(sem_giver_entry, &lock_sem);
+	status = k_sem_take(&lock_sem, K_FOREVER);
+	zassert_equal(status, 0, "Expected 0, got %d\n", status);
+	k_thread_join(&lock_thread, K_FOREVER);
+	expected.acquisitions++;
+	expected.contentions++;
+	expected.max_wait = 1;
+	test_lock_query("Contended", K_OBJ_CORE(&lock_sem), &expected);
+
+	/* Semaphores have no owner, hence no hold time */
+	k_sem_give(&lock_sem);
+	status = k_sem_take(&lock_sem, K_NO_WAIT);
+	zassert_equal(status, 0, "Expected 0, got %d\n", status);
+	expected.acquisitions++;
+	test_lock_query("Available", K_OBJ_CORE(&lock_sem), &expected);
+}
+#endif
+
+#ifdef CONFIG_OBJ_CORE_STATS_SPINLOCK
+static struct k_spinlock lock_spinlock;
+
+ZTEST(obj_core_stats_lock, test_obj_core_stats_spinlock)
+{
+	struct k_lock_stats expected = { 0 };
+	k_spinlock_key_t key;
+	int  status;
+
+	status = k_spin_stats_register(&lock_spinlock);
+	zassert_equal(status, 0, "Expected 0, got %d\n", status);
+	zassert_equal(k_obj_type_find(K_OBJ_TYPE_SPINLOCK_ID),
+		      K_OBJ_CORE(&lock_spinlock)->type,
+		      "Spinlock not linked to its object type\n");
+
+	status = k_obj_core_stats_reset(K_OBJ_CORE(&lock_spinlock));
+	zassert_equal(status, 0, "Expected 0, got %d\n", status);
+
+	for (int i = 0; i < 3; i++) {
+		key = k_spin_lock(&lock_spinlock);
+		k_busy_wait(LOCK_HOLD_MS);
+		k_spin_unlock(&lock_spinlock, key);
+	}
+
+	/* The query takes the lock too */
+	expected.acquisitions = 4;
+	expected.max_hold = 1;
+	test_lock_query("Uncontended", K_OBJ_CORE(&lock_spinlock), &expected);
+
+	status = k_spin_stats_deregister(&lock_spinlock);
+	zassert_equal(status, 0, "Expected 0, got %d\n", status);
+}
+#endif
+#endif
+
 ZTEST_SUITE(obj_core_stats_system, NULL, NULL,
 	    ztest_simple_1cpu_before, ztest_simple_1cpu_after, NULL);
 
@@ -704,3 +874,9 @@ ZTEST_SUITE(obj_core_stats_mem_block, NULL, NULL,
 
 ZTEST_SUITE(obj_core_stats_mem_slab, NULL, NULL,
 	    ztest_simple_1cpu_before, ztest_simple_1cpu_after, NULL);
+
+#if defined(CONFIG_OBJ_CORE_STATS_MUTEX) || defined(CONFIG_OBJ_CORE_STATS_SEM) || \
+	defined(CONFIG_OBJ_CORE_STATS_SPINLOCK)
+ZTEST_SUITE(obj_core_stats_lock, NULL, NULL,
+	    ztest_simple_1cpu_before, ztest_simple_1cpu_after, NULL);
+#endif
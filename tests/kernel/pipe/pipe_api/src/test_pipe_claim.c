@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @brief Tests for the Pipe zero-copy claim / commit API
+ * @ingroup kernel_pipe_tests
+ * @{
+ */
+
+#include <zephyr/ztest.h>
+
+#define CLAIM_PIPE_SIZE 8
+#define CLAIM_STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+K_PIPE_DEFINE(claim_pipe, CLAIM_PIPE_SIZE, 4);
+
+static K_THREAD_STACK_DEFINE(claim_stack, CLAIM_STACK_SIZE);
+static struct k_thread claim_thread;
+static unsigned char claim_rx[CLAIM_PIPE_SIZE];
+
+static void claim_pipe_reset(void)
+{
+	k_pipe_init(&claim_pipe, claim_pipe.buffer, CLAIM_PIPE_SIZE);
+	memset(claim_rx, 0, sizeof(claim_rx));
+}
+
+static void put_in_place(const char *str, size_t expected)
+{
+	uint8_t *data;
+	size_t len = strlen(str);
+
+	zassert_equal(k_pipe_put_claim(&claim_pipe, &data, len), expected);
+	memcpy(data, str, expected);
+	zassert_ok(k_pipe_put_commit(&claim_pipe, expected));
+}
+
+/**
+ * @brief Test claiming space and data across the buffer wrap-around
+ * @see k_pipe_put_claim(), k_pipe_put_commit(), k_pipe_get_claim(),
+ *      k_pipe_get_commit()
+ */
+ZTEST(pipe_api, test_pipe_claim_wrap)
+{
+	size_t bytes_read;
+	uint8_t *data;
+
+	claim_pipe_reset();
+
+	put_in_place("abcde", 5);
+	zassert_ok(k_pipe_get(&claim_pipe, claim_rx, 3, &bytes_read, 3,
+			      K_NO_WAIT));
+	zassert_mem_equal(claim_rx, "abc", 3);
+
+	/* Claims never wrap around the end of the buffer */
+	put_in_place("fghij", 3);
+	put_in_place("ijkl", 3);
+	zassert_equal(k_pipe_read_avail(&claim_pipe), CLAIM_PIPE_SIZE);
+
+	zassert_equal(k_pipe_get_claim(&claim_pipe, &data, CLAIM_PIPE_SIZE), 5);
+	zassert_mem_equal(data, "defgh", 5);
+	zassert_ok(k_pipe_get_commit(&claim_pipe, 5));
+
+	zassert_equal(k_pipe_get_claim(&claim_pipe, &data, CLAIM_PIPE_SIZE), 3);
+	zassert_mem_equal(data, "ijk", 3);
+
+	/* Only consume part of it, the rest stays in the pipe */
+	zassert_ok(k_pipe_get_commit(&claim_pipe, 1));
+	zassert_equal(k_pipe_read_avail(&claim_pipe), 2);
+	zassert_ok(k_pipe_get(&claim_pipe, claim_rx, 2, &bytes_read, 2,
+			      K_NO_WAIT));
+	zassert_mem_equal(claim_rx, "jk", 2);
+}
+
+/**
+ * @brief Test claim bookkeeping errors
+ * @see k_pipe_put_claim(), k_pipe_put_commit(), k_pipe_get_claim(),
+ *      k_pipe_get_commit()
+ */
+ZTEST(pipe_api, test_pipe_claim_busy)
+{
+	size_t bytes_read;
+	uint8_t *data;
+
+	claim_pipe_reset();
+
+	zassert_equal(k_pipe_get_claim(&claim_pipe, &data, 1), 0);
+
+	zassert_equal(k_pipe_put_claim(&claim_pipe, &data, 4), 4);
+	zassert_equal(k_pipe_put_claim(&claim_pipe, &data, 4), 0);
+	zassert_equal(k_pipe_put_commit(&claim_pipe, 5), -EINVAL);
+	memcpy(data, "wxyz", 4);
+	zassert_ok(k_pipe_put_commit(&claim_pipe, 4));
+
+	zassert_equal(k_pipe_get_claim(&claim_pipe, &data, 2), 2);
+	zassert_equal(k_pipe_get_claim(&claim_pipe, &data, 2), 0);
+
+	/* Regular readers can't overtake the claimed data */
+	zassert_equal(k_pipe_get(&claim_pipe, claim_rx, 1, &bytes_read, 1,
+				 K_NO_WAIT), -EIO);
+	zassert_equal(k_pipe_get_commit(&claim_pipe, 3), -EINVAL);
+	zassert_ok(k_pipe_get_commit(&claim_pipe, 0));
+
+	zassert_ok(k_pipe_get(&claim_pipe, claim_rx, 4, &bytes_read, 4,
+			      K_NO_WAIT));
+	zassert_mem_equal(claim_rx, "wxyz", 4);
+}
+
+static void reader_entry(void *p1, void *p2, void *p3)
+{
+	size_t bytes_read;
+
+	zassert_ok(k_pipe_get(&claim_pipe, claim_rx, 4, &bytes_read, 4,
+			      K_FOREVER));
+	zassert_equal(bytes_read, 4);
+}
+
+/**
+ * @brief Test that committing written data wakes up a waiting reader
+ * @see k_pipe_put_claim(), k_pipe_put_commit()
+ */
+ZTEST(pipe_api_1cpu, test_pipe_put_commit_wakes_reader)
+{
+	claim_pipe_reset();
+
+	k_thread_create(&claim_thread, claim_stack, CLAIM_STACK_SIZE,
+			reader_entry, NULL, NULL, NULL,
+			K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_msleep(10);
+
+	put_in_place("1234", 4);
+	k_thread_join(&claim_thread, K_FOREVER);
+
+	zassert_mem_equal(claim_rx, "1234", 4);
+	zassert_equal(k_pipe_read_avail(&claim_pipe), 0);
+}
+
+static void writer_entry(void *p1, void *p2, void *p3)
+{
+	size_t bytes_written;
+
+	zassert_ok(k_pipe_put(&claim_pipe, "5678", 4, &bytes_written, 4,
+			      K_FOREVER));
+	zassert_equal(bytes_written, 4);
+}
+
+/**
+ * @brief Test that releasing read data lets a waiting writer in
+ * @see k_pipe_get_claim(), k_pipe_get_commit()
+ */
+ZTEST(pipe_api_1cpu, test_pipe_get_commit_wakes_writer)
+{
+	size_t bytes_read;
+	uint8_t *data;
+
+	claim_pipe_reset();
+
+	put_in_place("abcdefgh", CLAIM_PIPE_SIZE);
+
+	k_thread_create(&claim_thread, claim_stack, CLAIM_STACK_SIZE,
+			writer_entry, NULL, NULL, NULL,
+			K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_msleep(10);
+
+	zassert_equal(k_pipe_get_claim(&claim_pipe, &data, CLAIM_PIPE_SIZE),
+		      CLAIM_PIPE_SIZE);
+	zassert_mem_equal(data, "abcdefgh", CLAIM_PIPE_SIZE);
+	zassert_ok(k_pipe_get_commit(&claim_pipe, CLAIM_PIPE_SIZE));
+	k_thread_join(&claim_thread, K_FOREVER);
+
+	zassert_ok(k_pipe_get(&claim_pipe, claim_rx, 4, &bytes_read, 4,
+			      K_NO_WAIT));
+	zassert_mem_equal(claim_rx, "5678", 4);
+}
+
+/**
+ * @}
+ */
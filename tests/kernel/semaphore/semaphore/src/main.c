@@ -79,6 +79,7 @@ struct k_thread sem_tid_1, sem_tid_2, sem_tid_3, sem_tid_4;
 struct k_thread multiple_tid[TOTAL_THREADS_WAITING];
 
 K_SEM_DEFINE(ksema, SEM_INIT_VAL, SEM_MAX_VAL);
+K_SEM_DEFINE(max_limit_sem, 0, K_SEM_MAX_LIMIT);
 struct k_sem msg_sema, mut_sem;
 static K_THREAD_STACK_DEFINE(tstack, STACK_SIZE);
 struct k_thread tdata;
@@ -290,6 +291,16 @@ ZTEST_USER(semaphore, test_k_sem_init)
 
 	/* initialize a semaphore with invalid count */
 	expect_k_sem_init_nomsg(&msg_sema, SEM_MAX_VAL + 1, SEM_MAX_VAL, -EINVAL);
+
+	/* the largest limit is valid whatever the implementation */
+	expect_k_sem_init_nomsg(&msg_sema, 0, K_SEM_MAX_LIMIT, 0);
+	k_sem_give(&msg_sema);
+	k_sem_give(&msg_sema);
+	zassert_equal(k_sem_count_get(&msg_sema), 2);
+
+	k_sem_give(&max_limit_sem);
+	zassert_equal(k_sem_count_get(&max_limit_sem), 1);
+	zassert_ok(k_sem_take(&max_limit_sem, K_NO_WAIT));
 }
 
 
@@ -1332,7 +1343,7 @@ void *test_init(void)
 				  &stack_3, &stack_4, &timeout_info_pipe,
 				  &sem_tid_1, &sem_tid_2, &sem_tid_3,
 				  &sem_tid_4, &tstack, &tdata, &mut_sem,
-				  &statically_defined_sem);
+				  &statically_defined_sem, &max_limit_sem);
 #endif
 	return NULL;
 }
@@ -539,5 +539,87 @@ ZTEST(usage_api, test_thread_stats_usage)
 	k_thread_abort(tid);
 }
 
+#ifdef CONFIG_SCHED_LATENCY_STATS
+static K_SEM_DEFINE(latency_sem, 0, 1);
+
+#define LATENCY_WAKEUPS 3
+
+/**
+ * @brief Helper thread to test_sched_latency()
+ */
+void helper_latency(void *p1, void *p2, void *p3)
+{
+	for (int i = 0; i < LATENCY_WAKEUPS; i++) {
+		k_sem_take(&latency_sem, K_FOREVER);
+	}
+}
+
+/**
+ * @brief Test the wake-to-run latency statistics
+ *
+ * 1. Create a higher priority helper thread that waits on a semaphore
+ *    a few times, and give it.
+ *    - Its start and each wake-up should be counted for the thread,
+ *      its priority level and the CPU.
+ *    - The histogram buckets should add up to the number of wake-ups.
+ */
+ZTEST(usage_api, test_sched_latency)
+{
+	struct k_sched_latency_stats prio_before, prio_after;
+	struct k_sched_latency_stats cpu_before, cpu_after;
+	k_thread_runtime_stats_t stats;
+	int prio = k_thread_priority_get(k_current_get()) - 1;
+	uint32_t sum = 0;
+	k_tid_t tid;
+
+	zassert_equal(k_sched_latency_prio_get(K_LOWEST_THREAD_PRIO + 1,
+					       &prio_before), -EINVAL);
+	zassert_equal(k_sched_latency_cpu_get(arch_num_cpus(), &cpu_before),
+		      -EINVAL);
+
+	zassert_ok(k_sched_latency_prio_get(prio, &prio_before));
+	zassert_ok(k_sched_latency_cpu_get(0, &cpu_before));
+
+	tid = k_thread_create(&helper_thread, helper_stack,
+			      K_THREAD_STACK_SIZEOF(helper_stack),
+			      helper_latency, NULL, NULL, NULL,
+			      prio, 0, K_NO_WAIT);
+	k_yield();
+
+	for (int i = 0; i < LATENCY_WAKEUPS; i++) {
+		k_sem_give(&latency_sem);
+		k_yield();
+	}
+	k_thread_join(tid, K_FOREVER);
+
+	k_thread_runtime_stats_get(tid, &stats);
+	zassert_equal(stats.latency.count, LATENCY_WAKEUPS + 1,
+		      "Expected %u wake-ups, got %u", LATENCY_WAKEUPS + 1,
+		      stats.latency.count);
+	zassert_true(stats.latency.total >= stats.latency.max);
+
+	for (int i = 0; i < CONFIG_SCHED_LATENCY_STATS_BUCKETS; i++) {
+		sum += stats.latency.buckets[i];
+	}
+	zassert_equal(sum, stats.latency.count);
+
+	zassert_ok(k_sched_latency_prio_get(prio, &prio_after));
+	zassert_equal(prio_after.count - prio_before.count,
+		      LATENCY_WAKEUPS + 1);
+
+	zassert_ok(k_sched_latency_cpu_get(0, &cpu_after));
+	zassert_true(cpu_after.count - cpu_before.count >= LATENCY_WAKEUPS + 1);
+
+	k_sched_latency_reset();
+	zassert_ok(k_sched_latency_prio_get(prio, &prio_after));
+	zassert_equal(prio_after.count, 0);
+}
+#else
+ZTEST(usage_api, test_sched_latency)
+{
+	ztest_test_skip();
+}
+#endif
+
 ZTEST_SUITE(usage_api, NULL, NULL,
 		ztest_simple_1cpu_before, ztest_simple_1cpu_after, NULL);
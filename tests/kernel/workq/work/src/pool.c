@@ -0,0 +1,242 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+
+#ifdef CONFIG_WORKQUEUE_POOL
+
+#define POOL_THREADS 3
+#define POOL_STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define POOL_PRIORITY K_PRIO_COOP(0)
+#define POOL_RELEASE_MS 10
+
+static K_THREAD_STACK_ARRAY_DEFINE(pool_stacks, POOL_THREADS,
+				   POOL_STACK_SIZE);
+static struct k_thread pool_threads[POOL_THREADS - 1];
+static struct k_work_q pool_queue;
+
+/* Given by the test to let a blocked handler complete. */
+static K_SEM_DEFINE(pool_rel_sem, 0, POOL_THREADS);
+
+static void pool_release_cb(struct k_timer *timer)
+{
+	k_sem_give(&pool_rel_sem);
+}
+
+static K_TIMER_DEFINE(pool_releaser, pool_release_cb, NULL);
+
+/* A work item whose handler blocks until released, and records
+ * whether it was ever entered by two threads at once.
+ */
+struct pool_item {
+	struct k_work work;
+	atomic_t runs;
+	atomic_t active;
+	bool reentered;
+};
+
+static struct pool_item pool_items[2];
+
+/* Work synchronization objects must be in cache-coherent memory,
+ * which excludes stacks on some architectures.
+ */
+static struct k_work_sync pool_sync;
+
+static void pool_handler(struct k_work *work)
+{
+	struct pool_item *item = CONTAINER_OF(work, struct pool_item, work);
+
+	if (atomic_inc(&item->active) != 0) {
+		item->reentered = true;
+	}
+
+	k_sem_take(&pool_rel_sem, K_FOREVER);
+
+	(void)atomic_inc(&item->runs);
+	(void)atomic_dec(&item->active);
+}
+
+static void pool_reset(void)
+{
+	k_timer_stop(&pool_releaser);
+	k_sem_reset(&pool_rel_sem);
+
+	for (int i = 0; i < ARRAY_SIZE(pool_items); i++) {
+		k_work_init(&pool_items[i].work, pool_handler);
+		atomic_clear(&pool_items[i].runs);
+		atomic_clear(&pool_items[i].active);
+		pool_items[i].reentered = false;
+	}
+}
+
+static void pool_release_periodic(void)
+{
+	k_timer_start(&pool_releaser, K_MSEC(POOL_RELEASE_MS),
+		      K_MSEC(POOL_RELEASE_MS));
+}
+
+/* Items submitted to a pool are processed concurrently. */
+ZTEST(work_pool, test_pool_concurrent)
+{
+	struct k_work *w0 = &pool_items[0].work;
+	struct k_work *w1 = &pool_items[1].work;
+
+	pool_reset();
+
+	zassert_equal(k_work_submit_to_queue(&pool_queue, w0), 1);
+	zassert_equal(k_work_submit_to_queue(&pool_queue, w1), 1);
+	k_sleep(K_TICKS(1));
+
+	/* Both are running, blocked in the handler */
+	zassert_equal(k_work_busy_get(w0), K_WORK_RUNNING);
+	zassert_equal(k_work_busy_get(w1), K_WORK_RUNNING);
+	zassert_equal(pool_queue.busy, 2);
+
+	k_sem_give(&pool_rel_sem);
+	k_sem_give(&pool_rel_sem);
+	k_sleep(K_TICKS(1));
+
+	zassert_equal(atomic_get(&pool_items[0].runs), 1);
+	zassert_equal(atomic_get(&pool_items[1].runs), 1);
+	zassert_equal(k_work_busy_get(w0), 0);
+	zassert_equal(k_work_busy_get(w1), 0);
+	zassert_equal(pool_queue.busy, 0);
+	zassert_equal(pool_queue.flags, K_WORK_QUEUE_STARTED);
+}
+
+/* A resubmitted running item is not picked up by an idle thread. */
+ZTEST(work_pool, test_pool_not_reentrant)
+{
+	struct pool_item *item = &pool_items[0];
+
+	pool_reset();
+
+	zassert_equal(k_work_submit_to_queue(&pool_queue, &item->work), 1);
+	k_sleep(K_TICKS(1));
+	zassert_equal(k_work_busy_get(&item->work), K_WORK_RUNNING);
+
+	zassert_equal(k_work_submit_to_queue(&pool_queue, &item->work), 2);
+	k_sleep(K_TICKS(1));
+	zassert_equal(k_work_busy_get(&item->work),
+		      K_WORK_RUNNING | K_WORK_QUEUED);
+	zassert_equal(pool_queue.busy, 1);
+
+	/* The first invocation completes, and the second one starts */
+	k_sem_give(&pool_rel_sem);
+	k_sleep(K_TICKS(1));
+	zassert_equal(atomic_get(&item->runs), 1);
+	zassert_equal(k_work_busy_get(&item->work), K_WORK_RUNNING);
+
+	k_sem_give(&pool_rel_sem);
+	k_sleep(K_TICKS(1));
+	zassert_equal(atomic_get(&item->runs), 2);
+	zassert_equal(k_work_busy_get(&item->work), 0);
+	zassert_false(item->reentered);
+}
+
+/* Flushing an item waits for the latest submission to complete. */
+ZTEST(work_pool, test_pool_flush)
+{
+	struct pool_item *item = &pool_items[0];
+
+	pool_reset();
+
+	/* Nothing to flush */
+	zassert_false(k_work_flush(&item->work, &pool_sync));
+
+	/* Running and queued again: flush waits for both. */
+	zassert_equal(k_work_submit_to_queue(&pool_queue, &item->work), 1);
+	k_sleep(K_TICKS(1));
+	zassert_equal(k_work_submit_to_queue(&pool_queue, &item->work), 2);
+
+	pool_release_periodic();
+	zassert_true(k_work_flush(&item->work, &pool_sync));
+	zassert_equal(atomic_get(&item->runs), 2);
+	zassert_equal(k_work_busy_get(&item->work), 0);
+	k_timer_stop(&pool_releaser);
+	k_sem_reset(&pool_rel_sem);
+
+	/* Only running. */
+	zassert_equal(k_work_submit_to_queue(&pool_queue, &item->work), 1);
+	k_sleep(K_TICKS(1));
+	zassert_equal(k_work_busy_get(&item->work), K_WORK_RUNNING);
+
+	pool_release_periodic();
+	zassert_true(k_work_flush(&item->work, &pool_sync));
+	zassert_equal(atomic_get(&item->runs), 3);
+	zassert_false(item->reentered);
+}
+
+/* Cancelling a queued submission of a running item lets a flush
+ * complete with the running invocation.
+ */
+ZTEST(work_pool, test_pool_cancel)
+{
+	struct pool_item *item = &pool_items[0];
+
+	pool_reset();
+
+	zassert_equal(k_work_submit_to_queue(&pool_queue, &item->work), 1);
+	k_sleep(K_TICKS(1));
+	zassert_equal(k_work_submit_to_queue(&pool_queue, &item->work), 2);
+
+	zassert_equal(k_work_cancel(&item->work),
+		      K_WORK_RUNNING | K_WORK_CANCELING);
+
+	pool_release_periodic();
+	zassert_true(k_work_flush(&item->work, &pool_sync));
+	zassert_equal(atomic_get(&item->runs), 1);
+
+	zassert_false(k_work_cancel_sync(&item->work, &pool_sync));
+	zassert_equal(k_work_busy_get(&item->work), 0);
+}
+
+/* Draining waits for all the threads of the pool. */
+ZTEST(work_pool, test_pool_drain)
+{
+	pool_reset();
+
+	zassert_equal(k_work_submit_to_queue(&pool_queue,
+					     &pool_items[0].work), 1);
+	zassert_equal(k_work_submit_to_queue(&pool_queue,
+					     &pool_items[1].work), 1);
+	k_sleep(K_TICKS(1));
+
+	pool_release_periodic();
+	zassert_equal(k_work_queue_drain(&pool_queue, false), 1);
+
+	zassert_equal(atomic_get(&pool_items[0].runs), 1);
+	zassert_equal(atomic_get(&pool_items[1].runs), 1);
+	zassert_equal(pool_queue.busy, 0);
+	zassert_equal(pool_queue.flags, K_WORK_QUEUE_STARTED);
+}
+
+static void *work_pool_setup(void)
+{
+	struct k_work_queue_config cfg = {
+		.name = "wq.pool",
+	};
+
+	k_work_queue_pool_start(&pool_queue, pool_threads, &pool_stacks[0][0],
+				POOL_STACK_SIZE, POOL_THREADS, POOL_PRIORITY,
+				&cfg);
+	zassert_equal(pool_queue.num_threads, POOL_THREADS);
+	zassert_equal(k_work_queue_thread_get(&pool_queue),
+		      &pool_queue.thread);
+
+	return NULL;
+}
+
+static void work_pool_after(void *fixture)
+{
+	k_timer_stop(&pool_releaser);
+	ztest_simple_1cpu_after(fixture);
+}
+
+ZTEST_SUITE(work_pool, NULL, work_pool_setup, ztest_simple_1cpu_before,
+	    work_pool_after, NULL);
+
+#endif /* CONFIG_WORKQUEUE_POOL */
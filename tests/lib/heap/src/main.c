@@ -7,6 +7,7 @@
 #include <zephyr/ztest.h>
 #include <zephyr/sys/sys_heap.h>
 #include <zephyr/sys/heap_listener.h>
+#include <zephyr/sys/heap_profile.h>
 #include <inttypes.h>
 
 /* Guess at a value for heap size based on available memory on the
@@ -211,6 +212,45 @@ ZTEST(lib_heap, test_fragmentation)
 	log_result(SMALL_HEAP_SZ, &result);
 }
 
+ZTEST(lib_heap, test_fragmentation_index)
+{
+	struct sys_heap heap;
+	struct sys_heap_fragmentation frag;
+	void *blocks[8];
+
+	sys_heap_init(&heap, heapmem, SMALL_HEAP_SZ);
+
+	zassert_equal(sys_heap_fragmentation_get(&heap, &frag), 0);
+	zassert_equal(frag.free_blocks, 1);
+	zassert_equal(frag.largest_free_bytes, frag.free_bytes);
+	zassert_equal(frag.index, 0);
+
+	for (int i = 0; i < ARRAY_SIZE(blocks); i++) {
+		blocks[i] = sys_heap_alloc(&heap, 64);
+		zassert_not_null(blocks[i]);
+	}
+
+	/* Every other block freed: none of them can merge */
+	for (int i = 0; i < ARRAY_SIZE(blocks); i += 2) {
+		sys_heap_free(&heap, blocks[i]);
+	}
+
+	zassert_equal(sys_heap_fragmentation_get(&heap, &frag), 0);
+	zassert_equal(frag.free_blocks, ARRAY_SIZE(blocks) / 2 + 1);
+	zassert_true(frag.largest_free_bytes < frag.free_bytes);
+	zassert_true(frag.index > 0 && frag.index < 100);
+
+	for (int i = 1; i < ARRAY_SIZE(blocks); i += 2) {
+		sys_heap_free(&heap, blocks[i]);
+	}
+
+	zassert_equal(sys_heap_fragmentation_get(&heap, &frag), 0);
+	zassert_equal(frag.free_blocks, 1);
+	zassert_equal(frag.index, 0);
+
+	zassert_equal(sys_heap_fragmentation_get(NULL, &frag), -EINVAL);
+}
+
 /* The heap block format changes for heaps with more than 2^15 chunks,
  * so test that case too.  This can be too large to iterate over
  * exhaustively with good performance, so the relative operation count
@@ -259,13 +299,33 @@ ZTEST(lib_heap, test_solo_free_header)
 
 	TC_PRINT("Testing solo free header in a heap\n");
 
-	sys_heap_init(&heap, heapmem, SOLO_FREE_HEADER_HEAP_SZ);
-	if (sizeof(void *) > 4U) {
-		sys_heap_alloc(&heap, 1);
-		zassert_true(sys_heap_validate(&heap), "");
-	} else {
+	if (sizeof(void *) <= 4U) {
 		ztest_test_skip();
+		return;
 	}
+
+#ifdef CONFIG_SYS_HEAP_TLSF
+	/* The TLSF heap header size doesn't allow for the layout above.
+	 * Allocate one chunk less than the whole heap instead, which
+	 * leaves the same solo free header before the end marker.
+	 */
+	size_t max = SMALL_HEAP_SZ;
+	void *mem;
+
+	sys_heap_init(&heap, heapmem, SMALL_HEAP_SZ);
+	do {
+		max -= 8;
+		mem = sys_heap_alloc(&heap, max);
+	} while (mem == NULL);
+	sys_heap_free(&heap, mem);
+
+	zassert_not_null(sys_heap_alloc(&heap, max - 8));
+	zassert_true(sys_heap_validate(&heap), "");
+#else
+	sys_heap_init(&heap, heapmem, SOLO_FREE_HEADER_HEAP_SZ);
+	sys_heap_alloc(&heap, 1);
+	zassert_true(sys_heap_validate(&heap), "");
+#endif
 }
 
 /* Simple clobber detection */
@@ -485,4 +545,305 @@ ZTEST(lib_heap, test_heap_listeners)
 #endif /* CONFIG_SYS_HEAP_LISTENER */
 }
 
+#ifdef CONFIG_MULTITHREADING
+
+#define MT_THREADS 4
+#define MT_HEAP_SZ MIN(BIG_HEAP_SZ, 16 * 1024)
+#define MT_STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+static K_THREAD_STACK_ARRAY_DEFINE(mt_stacks, MT_THREADS, MT_STACK_SIZE);
+static struct k_thread mt_threads[MT_THREADS];
+static struct k_heap mt_heap;
+
+static void *mt_alloc(void *arg, size_t bytes)
+{
+	void *ret = k_heap_alloc(arg, bytes, K_NO_WAIT);
+
+	fill_block(ret, bytes);
+	return ret;
+}
+
+static void mt_free(void *arg, void *p)
+{
+	check_fill(p);
+	k_heap_free(arg, p);
+}
+
+/* Several threads allocate from and free to the same k_heap, each
+ * with its own set of blocks.  Unlike the other stress tests this goes
+ * through k_heap so the heap is only validated at the end, once all
+ * threads are done.
+ */
+ZTEST(lib_heap, test_heap_threads)
+{
+	struct z_heap_stress_result result;
+
+	TC_PRINT("Testing %d threads on a %d byte k_heap\n", MT_THREADS,
+		 (int) MT_HEAP_SZ);
+
+	k_heap_init(&mt_heap, heapmem, MT_HEAP_SZ);
+
+	sys_heap_stress_threads(mt_alloc, mt_free, &mt_heap,
+				MT_HEAP_SZ, ITERATION_COUNT,
+				scratchmem, sizeof(scratchmem),
+				50, mt_threads, &mt_stacks[0][0],
+				MT_STACK_SIZE, MT_THREADS, K_PRIO_PREEMPT(1),
+				&result);
+
+	log_result(MT_HEAP_SZ, &result);
+	zassert_true(result.successful_allocs > 0);
+	zassert_true(sys_heap_validate(&mt_heap.heap), "Heap is corrupted");
+
+#ifdef CONFIG_SYS_HEAP_CACHE
+	struct sys_heap_cache_stats stats;
+
+	zassert_equal(sys_heap_cache_stats_get(&mt_heap.heap, &mt_heap.cache,
+					       &stats), 0);
+	TC_PRINT("cache hits: %u, misses: %u, frees: %u, overflows: %u\n",
+		 stats.hits, stats.misses, stats.frees, stats.overflows);
+	zassert_true(stats.hits > 0);
+#endif
+}
+
+#endif /* CONFIG_MULTITHREADING */
+
+ZTEST(lib_heap, test_heap_cache)
+{
+#ifdef CONFIG_SYS_HEAP_CACHE
+	static struct k_heap heap;
+	struct sys_heap_cache_stats stats;
+	void *blocks[SMALL_HEAP_SZ / 16];
+	size_t max = SMALL_HEAP_SZ;
+	void *mem, *big;
+	int n;
+
+	k_heap_init(&heap, heapmem, SMALL_HEAP_SZ);
+
+	/* Find the largest block the empty heap can provide */
+	do {
+		max -= 8;
+		big = k_heap_alloc(&heap, max, K_NO_WAIT);
+	} while (big == NULL);
+	k_heap_free(&heap, big);
+
+	/* A freed small block is handed out again from the cache */
+	mem = k_heap_alloc(&heap, 16, K_NO_WAIT);
+	zassert_not_null(mem);
+	k_heap_free(&heap, mem);
+	zassert_equal(k_heap_alloc(&heap, 16, K_NO_WAIT), mem);
+
+	zassert_equal(sys_heap_cache_stats_get(&heap.heap, &heap.cache,
+					       &stats), 0);
+	zassert_equal(stats.hits, 1);
+	zassert_equal(stats.frees, 1);
+	zassert_equal(stats.cached_bytes, 0);
+	k_heap_free(&heap, mem);
+
+	/* Fill the heap with small blocks and free them all, leaving
+	 * some of them in the cache.  A request for the largest block
+	 * must still succeed by flushing the cache.
+	 */
+	for (n = 0; n < ARRAY_SIZE(blocks); n++) {
+		blocks[n] = k_heap_alloc(&heap, 16, K_NO_WAIT);
+		if (blocks[n] == NULL) {
+			break;
+		}
+	}
+	zassert_true(n > CONFIG_SYS_HEAP_CACHE_DEPTH);
+
+	for (int i = 0; i < n; i++) {
+		k_heap_free(&heap, blocks[i]);
+	}
+
+	zassert_equal(sys_heap_cache_stats_get(&heap.heap, &heap.cache,
+					       &stats), 0);
+	zassert_true(stats.cached_bytes > 0);
+	zassert_true(stats.overflows > 0);
+
+	big = k_heap_alloc(&heap, max, K_NO_WAIT);
+	zassert_not_null(big, "cached blocks not returned to the heap");
+
+	zassert_equal(sys_heap_cache_stats_get(&heap.heap, &heap.cache,
+					       &stats), 0);
+	zassert_equal(stats.cached_bytes, 0);
+
+	k_heap_free(&heap, big);
+	zassert_true(sys_heap_validate(&heap.heap), "Heap is corrupted");
+
+	zassert_equal(sys_heap_cache_stats_get(NULL, &heap.cache, &stats),
+		      -EINVAL);
+#else
+	ztest_test_skip();
+#endif /* CONFIG_SYS_HEAP_CACHE */
+}
+
+#ifdef CONFIG_SYS_HEAP_PROFILE
+static struct sys_heap_profile profile;
+static struct sys_heap_profile_site profile_sites[4];
+static int profile_num_sites;
+
+/* Distinct allocation sites, different enough not to be merged by the
+ * compiler.  The barrier keeps the allocation from being a tail call,
+ * which would make the test the site.
+ */
+static void * __attribute__((noinline)) profile_site_a(struct k_heap *heap, size_t bytes)
+{
+	void *mem = k_heap_alloc(heap, bytes, K_NO_WAIT);
+
+	compiler_barrier();
+	return mem;
+}
+
+static void * __attribute__((noinline)) profile_site_b(struct k_heap *heap, size_t bytes)
+{
+	void *mem = k_heap_alloc(heap, bytes, K_MSEC(1));
+
+	compiler_barrier();
+	return mem;
+}
+
+static void * __attribute__((noinline)) profile_site_c(struct k_heap *heap, size_t bytes)
+{
+	void *mem = sys_heap_aligned_alloc(&heap->heap, 16, bytes);
+
+	compiler_barrier();
+	return mem;
+}
+
+static void profile_site_cb(const struct sys_heap_profile_site *site,
+			    void *user_data)
+{
+	ARG_UNUSED(user_data);
+
+	if (profile_num_sites < ARRAY_SIZE(profile_sites)) {
+		profile_sites[profile_num_sites] = *site;
+	}
+	profile_num_sites++;
+}
+
+static struct sys_heap_profile_site *profile_site_find(uint32_t allocs)
+{
+	for (int i = 0; i < MIN(profile_num_sites, ARRAY_SIZE(profile_sites)); i++) {
+		if (profile_sites[i].allocs == allocs) {
+			return &profile_sites[i];
+		}
+	}
+
+	return NULL;
+}
+#endif /* CONFIG_SYS_HEAP_PROFILE */
+
+ZTEST(lib_heap, test_heap_profile)
+{
+#ifdef CONFIG_SYS_HEAP_PROFILE
+	static struct k_heap heap;
+	struct sys_heap_profile_site *site;
+	void *a[3], *b[2], *c, *old;
+	uint32_t untracked;
+
+	k_heap_init(&heap, heapmem, SMALL_HEAP_SZ);
+
+	/* Allocated before profiling, so never accounted */
+	old = k_heap_alloc(&heap, 32, K_NO_WAIT);
+	zassert_not_null(old);
+
+	sys_heap_profile_attach(&heap.heap, &profile);
+
+	for (int i = 0; i < ARRAY_SIZE(a); i++) {
+		a[i] = profile_site_a(&heap, 24);
+		zassert_not_null(a[i]);
+	}
+	for (int i = 0; i < ARRAY_SIZE(b); i++) {
+		b[i] = profile_site_b(&heap, 100);
+		zassert_not_null(b[i]);
+	}
+	c = profile_site_c(&heap, 500);
+	zassert_not_null(c);
+
+	k_heap_free(&heap, old);
+	k_msleep(10);
+	k_heap_free(&heap, a[0]);
+
+	profile_num_sites = 0;
+	untracked = sys_heap_profile_foreach_site(&profile, profile_site_cb, NULL);
+	zassert_equal(untracked, 0);
+	zassert_equal(profile_num_sites, 3, "k_heap callers not told apart");
+
+	site = profile_site_find(3);
+	zassert_not_null(site);
+	zassert_equal(site->frees, 1);
+	zassert_equal(site->live_blocks, 2);
+	zassert_equal(site->live_bytes, 48);
+	zassert_equal(site->max_live_bytes, 72);
+	zassert_equal(site->sizes[4], 3);
+	zassert_true(site->max_lifetime_ticks > 0);
+	zassert_true(site->oldest_live_ticks > 0);
+
+	site = profile_site_find(2);
+	zassert_not_null(site);
+	zassert_equal(site->frees, 0);
+	zassert_equal(site->live_bytes, 200);
+	zassert_equal(site->sizes[6], 2);
+
+	site = profile_site_find(1);
+	zassert_not_null(site);
+	zassert_equal(site->live_blocks, 1);
+	zassert_equal(site->sizes[MIN(8, CONFIG_SYS_HEAP_PROFILE_SIZE_BINS - 1)], 1);
+
+	/* Frees are accounted to the allocating site */
+	for (int i = 1; i < ARRAY_SIZE(a); i++) {
+		k_heap_free(&heap, a[i]);
+	}
+	for (int i = 0; i < ARRAY_SIZE(b); i++) {
+		k_heap_free(&heap, b[i]);
+	}
+	k_heap_free(&heap, c);
+
+	profile_num_sites = 0;
+	(void)sys_heap_profile_foreach_site(&profile, profile_site_cb, NULL);
+	for (int i = 0; i < profile_num_sites; i++) {
+		zassert_equal(profile_sites[i].live_blocks, 0);
+		zassert_equal(profile_sites[i].live_bytes, 0);
+		zassert_equal(profile_sites[i].frees, profile_sites[i].allocs);
+	}
+
+	/* Blocks going in and out of the k_heap cache are accounted too */
+	a[0] = profile_site_a(&heap, 24);
+	zassert_not_null(a[0]);
+
+	profile_num_sites = 0;
+	(void)sys_heap_profile_foreach_site(&profile, profile_site_cb, NULL);
+	site = profile_site_find(4);
+	zassert_not_null(site, "cached allocation not accounted");
+	zassert_equal(site->live_blocks, 1);
+
+	k_heap_free(&heap, a[0]);
+
+	profile_num_sites = 0;
+	(void)sys_heap_profile_foreach_site(&profile, profile_site_cb, NULL);
+	site = profile_site_find(4);
+	zassert_not_null(site);
+	zassert_equal(site->frees, 4, "cached free not accounted");
+	zassert_equal(site->live_blocks, 0);
+
+#ifdef CONFIG_SYS_HEAP_CACHE
+	struct sys_heap_cache_stats stats;
+
+	zassert_equal(sys_heap_cache_stats_get(&heap.heap, &heap.cache,
+					       &stats), 0);
+	zassert_true(stats.hits > 0);
+#endif
+
+	sys_heap_profile_reset(&profile);
+	profile_num_sites = 0;
+	(void)sys_heap_profile_foreach_site(&profile, profile_site_cb, NULL);
+	zassert_equal(profile_num_sites, 0);
+
+	sys_heap_profile_detach(&heap.heap);
+	zassert_true(sys_heap_validate(&heap.heap), "Heap is corrupted");
+#else
+	ztest_test_skip();
+#endif /* CONFIG_SYS_HEAP_PROFILE */
+}
+
 ZTEST_SUITE(lib_heap, NULL, NULL, NULL, NULL, NULL);
@@ -593,6 +593,64 @@ ZTEST(lib_mem_block, test_mem_block_alloc_free_contiguous)
 #endif
 }
 
+ZTEST(lib_mem_block, test_mem_block_alloc_contiguous_batch)
+{
+	int i, ret, val;
+	void *runs[NUM_BLOCKS / 2];
+
+	/* take block 1, so that runs of 2 can't start at block 0 */
+	ret = sys_mem_blocks_get(&mem_block_01, mem_block_01.buffer + BLK_SZ, 1);
+	zassert_equal(ret, 0, "sys_mem_blocks_get failed (%d)", ret);
+
+	/* runs of 2 fit in the 6 remaining blocks, but not 4 of them */
+	ret = sys_mem_blocks_alloc_contiguous_batch(&mem_block_01, 2,
+						    NUM_BLOCKS / 2, runs);
+	zassert_equal(ret, -ENOMEM,
+		      "sys_mem_blocks_alloc_contiguous_batch failed (%d)", ret);
+
+	/* nothing should have been allocated by the failed batch */
+	for (i = 0; i < NUM_BLOCKS; i++) {
+		ret = sys_bitarray_test_bit(mem_block_01.bitmap, i, &val);
+		zassert_equal(val, (i == 1) ? 1 : 0,
+			      "bit %i should be %s", i, (i == 1) ? "set" : "cleared");
+	}
+
+	ret = sys_mem_blocks_alloc_contiguous_batch(&mem_block_01, 2,
+						    NUM_BLOCKS / 2 - 1, runs);
+	zassert_equal(ret, 0,
+		      "sys_mem_blocks_alloc_contiguous_batch failed (%d)", ret);
+
+	for (i = 0; i < NUM_BLOCKS / 2 - 1; i++) {
+		zassert_equal_ptr(runs[i], mem_block_01.buffer + BLK_SZ * (2 + 2 * i),
+				  "run %d at %p", i, runs[i]);
+	}
+
+	/* all blocks except 0 should be taken */
+	for (i = 0; i < NUM_BLOCKS; i++) {
+		ret = sys_bitarray_test_bit(mem_block_01.bitmap, i, &val);
+		zassert_equal(val, (i == 0) ? 0 : 1,
+			      "bit %i should be %s", i, (i == 0) ? "cleared" : "set");
+	}
+
+	/* scattered blocks are allocated all or none as well */
+	ret = sys_mem_blocks_alloc(&mem_block_01, 2, runs);
+	zassert_equal(ret, -ENOMEM, "sys_mem_blocks_alloc failed (%d)", ret);
+	ret = sys_bitarray_test_bit(mem_block_01.bitmap, 0, &val);
+	zassert_equal(val, 0, "bit 0 should be cleared");
+
+	/* cleanup - free all blocks */
+	ret = sys_mem_blocks_free_contiguous(&mem_block_01, mem_block_01.buffer + BLK_SZ,
+					     NUM_BLOCKS - 1);
+	zassert_equal(ret, 0, "sys_mem_blocks_free_contiguous failed (%d)", ret);
+
+	ret = sys_mem_blocks_alloc_contiguous_batch(&mem_block_01, 0, 1, runs);
+	zassert_equal(ret, 0,
+		      "sys_mem_blocks_alloc_contiguous_batch failed (%d)", ret);
+	ret = sys_mem_blocks_alloc_contiguous_batch(&mem_block_01, NUM_BLOCKS, 2, runs);
+	zassert_equal(ret, -ENOMEM,
+		      "sys_mem_blocks_alloc_contiguous_batch failed (%d)", ret);
+}
+
 ZTEST(lib_mem_block, test_multi_mem_block_alloc_free)
 {
 	int ret;
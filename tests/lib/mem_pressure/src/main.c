@@ -0,0 +1,278 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/sys/mem_pressure.h>
+#include <zephyr/sys/sys_heap.h>
+
+#define NUM_BLOCKS 20
+#define BLOCK_SIZE 32
+#define HEAP_SIZE  2048
+#define ALLOC_SIZE 32
+
+K_MEM_SLAB_DEFINE_STATIC(slab, BLOCK_SIZE, NUM_BLOCKS, 4);
+K_HEAP_DEFINE(heap, HEAP_SIZE);
+
+static char sys_heap_mem[HEAP_SIZE];
+static struct sys_heap sys_heap;
+
+static MEM_PRESSURE_SOURCE_DEFINE(slab_src, MEM_PRESSURE_K_MEM_SLAB, &slab,
+				  50, 80);
+static MEM_PRESSURE_SOURCE_DEFINE(heap_src, MEM_PRESSURE_K_HEAP, &heap,
+				  50, 90);
+static MEM_PRESSURE_SOURCE_DEFINE(sys_heap_src, MEM_PRESSURE_SYS_HEAP,
+				  &sys_heap, 25, 75);
+
+struct reclaim_record {
+	const struct mem_pressure_source *src;
+	enum mem_pressure_level level;
+	int calls;
+};
+
+static void reclaim(const struct mem_pressure_source *src,
+		    enum mem_pressure_level level, void *user_data)
+{
+	struct reclaim_record *rec = user_data;
+
+	rec->src = src;
+	rec->level = level;
+	rec->calls++;
+}
+
+static struct reclaim_record slab_rec, heap_rec;
+
+static MEM_PRESSURE_CALLBACK_DEFINE(slab_cb, BIT(MEM_PRESSURE_K_MEM_SLAB),
+				    reclaim, &slab_rec);
+static MEM_PRESSURE_CALLBACK_DEFINE(heap_cb,
+				    BIT(MEM_PRESSURE_K_HEAP) |
+				    BIT(MEM_PRESSURE_SYS_HEAP),
+				    reclaim, &heap_rec);
+
+static void *blocks[NUM_BLOCKS];
+
+static void slab_alloc(int count)
+{
+	for (int i = 0; i < count; i++) {
+		zassert_ok(k_mem_slab_alloc(&slab, &blocks[k_mem_slab_num_used_get(&slab)],
+					    K_NO_WAIT));
+	}
+}
+
+static void slab_free(int count)
+{
+	for (int i = 0; i < count; i++) {
+		k_mem_slab_free(&slab, blocks[k_mem_slab_num_used_get(&slab) - 1]);
+	}
+}
+
+static void check_slab(enum mem_pressure_level level, int calls)
+{
+	mem_pressure_check();
+
+	zassert_equal(slab_src.level, level, "expected %s, got %s at %u%%",
+		      mem_pressure_level_str(level),
+		      mem_pressure_level_str(slab_src.level), slab_src.usage);
+	zassert_equal(slab_rec.calls, calls, "expected %d calls, got %d",
+		      calls, slab_rec.calls);
+	if (calls > 0) {
+		zassert_equal_ptr(slab_rec.src, &slab_src);
+		zassert_equal(slab_rec.level, level);
+	}
+}
+
+ZTEST(mem_pressure, test_levels)
+{
+	check_slab(MEM_PRESSURE_NONE, 0);
+
+	/* 45% */
+	slab_alloc(9);
+	check_slab(MEM_PRESSURE_NONE, 0);
+
+	/* 50% */
+	slab_alloc(1);
+	check_slab(MEM_PRESSURE_LOW, 1);
+	zassert_equal(slab_src.usage, 50U);
+
+	/* Unchanged levels don't run the callbacks again */
+	check_slab(MEM_PRESSURE_LOW, 1);
+
+	/* 80% */
+	slab_alloc(6);
+	check_slab(MEM_PRESSURE_CRITICAL, 2);
+	zassert_equal(slab_src.events, 2U);
+
+	/* 75% is within the hysteresis of the critical threshold */
+	slab_free(1);
+	check_slab(MEM_PRESSURE_CRITICAL, 2);
+
+	/* 70% is not */
+	slab_free(1);
+	check_slab(MEM_PRESSURE_LOW, 3);
+
+	/* 45%, then 40% */
+	slab_free(5);
+	check_slab(MEM_PRESSURE_LOW, 3);
+	slab_free(1);
+	check_slab(MEM_PRESSURE_NONE, 4);
+	zassert_equal(slab_src.events, 2U);
+
+	slab_free(k_mem_slab_num_used_get(&slab));
+	check_slab(MEM_PRESSURE_NONE, 4);
+}
+
+ZTEST(mem_pressure, test_exhausted)
+{
+	void *p[HEAP_SIZE / ALLOC_SIZE];
+	int n = 0;
+
+	/* A failed allocation triggers a check without any polling */
+	while ((p[n] = k_heap_alloc(&heap, ALLOC_SIZE, K_NO_WAIT)) != NULL) {
+		n++;
+	}
+	k_msleep(10);
+
+	zassert_equal(heap_src.level, MEM_PRESSURE_CRITICAL,
+		      "level %s at %u%%", mem_pressure_level_str(heap_src.level),
+		      heap_src.usage);
+	zassert_equal(heap_rec.calls, 1);
+	zassert_equal_ptr(heap_rec.src, &heap_src);
+
+	while (n > 0) {
+		k_heap_free(&heap, p[--n]);
+	}
+	mem_pressure_check();
+
+	zassert_equal(heap_src.level, MEM_PRESSURE_NONE);
+	zassert_equal(heap_rec.calls, 2);
+}
+
+ZTEST(mem_pressure, test_heap_cache)
+{
+#ifdef CONFIG_SYS_HEAP_CACHE
+	struct sys_heap_cache_stats stats;
+	void *p[CONFIG_SYS_HEAP_CACHE_DEPTH];
+	unsigned int usage;
+	k_spinlock_key_t key;
+	void *big;
+
+	key = k_spin_lock(&heap.lock);
+	(void)sys_heap_cache_flush(&heap.heap, &heap.cache);
+	k_spin_unlock(&heap.lock, key);
+	mem_pressure_check();
+	usage = heap_src.usage;
+
+	/* Blocks kept in the cache don't count as used */
+	for (int i = 0; i < ARRAY_SIZE(p); i++) {
+		p[i] = k_heap_alloc(&heap, ALLOC_SIZE, K_NO_WAIT);
+		zassert_not_null(p[i]);
+	}
+	for (int i = 0; i < ARRAY_SIZE(p); i++) {
+		k_heap_free(&heap, p[i]);
+	}
+	mem_pressure_check();
+
+	zassert_ok(sys_heap_cache_stats_get(&heap.heap, &heap.cache, &stats));
+	zassert_true(stats.cached_bytes > 0U);
+	zassert_equal(heap_src.usage, usage, "usage %u%%, expected %u%%",
+		      heap_src.usage, usage);
+
+	/* Reaching the low level returns them to the heap */
+	big = k_heap_alloc(&heap, HEAP_SIZE * 6 / 10, K_NO_WAIT);
+	zassert_not_null(big);
+	mem_pressure_check();
+
+	zassert_equal(heap_src.level, MEM_PRESSURE_LOW);
+	zassert_ok(sys_heap_cache_stats_get(&heap.heap, &heap.cache, &stats));
+	zassert_equal(stats.cached_bytes, 0U);
+
+	k_heap_free(&heap, big);
+	mem_pressure_check();
+	zassert_equal(heap_src.level, MEM_PRESSURE_NONE);
+#else
+	ztest_test_skip();
+#endif
+}
+
+ZTEST(mem_pressure, test_sys_heap)
+{
+	void *p;
+
+	p = sys_heap_alloc(&sys_heap, HEAP_SIZE / 2);
+	zassert_not_null(p);
+	mem_pressure_check();
+
+	zassert_equal(sys_heap_src.level, MEM_PRESSURE_LOW, "level %s at %u%%",
+		      mem_pressure_level_str(sys_heap_src.level),
+		      sys_heap_src.usage);
+	zassert_equal_ptr(heap_rec.src, &sys_heap_src);
+
+	sys_heap_free(&sys_heap, p);
+	mem_pressure_check();
+
+	zassert_equal(sys_heap_src.level, MEM_PRESSURE_NONE);
+}
+
+ZTEST(mem_pressure, test_unregister)
+{
+	mem_pressure_callback_unregister(&slab_cb);
+
+	slab_alloc(NUM_BLOCKS);
+	mem_pressure_check();
+	zassert_equal(slab_src.level, MEM_PRESSURE_CRITICAL);
+	zassert_equal(slab_rec.calls, 0);
+
+	mem_pressure_source_unregister(&slab_src);
+	slab_free(NUM_BLOCKS);
+	mem_pressure_check();
+	zassert_equal(slab_src.level, MEM_PRESSURE_CRITICAL,
+		      "unregistered source was checked");
+
+	zassert_ok(mem_pressure_source_register(&slab_src));
+	mem_pressure_callback_register(&slab_cb);
+	zassert_equal(slab_src.level, MEM_PRESSURE_NONE);
+}
+
+ZTEST(mem_pressure, test_invalid_params)
+{
+	MEM_PRESSURE_SOURCE_DEFINE(bad_src, MEM_PRESSURE_K_MEM_SLAB, &slab,
+				   90, 80);
+	MEM_PRESSURE_SOURCE_DEFINE(pool_src, MEM_PRESSURE_NET_BUF_POOL, NULL,
+				   50, 80);
+
+	zassert_equal(mem_pressure_source_register(&bad_src), -EINVAL);
+
+	bad_src.low = 50U;
+	bad_src.critical = 101U;
+	zassert_equal(mem_pressure_source_register(&bad_src), -EINVAL);
+
+	/* Net buffer pools are only tracked with CONFIG_NET_BUF_POOL_USAGE */
+	zassert_equal(mem_pressure_source_register(&pool_src), -ENOTSUP);
+}
+
+static void *mem_pressure_setup(void)
+{
+	sys_heap_init(&sys_heap, sys_heap_mem, sizeof(sys_heap_mem));
+
+	zassert_ok(mem_pressure_source_register(&slab_src));
+	zassert_ok(mem_pressure_source_register(&heap_src));
+	zassert_ok(mem_pressure_source_register(&sys_heap_src));
+	mem_pressure_callback_register(&slab_cb);
+	mem_pressure_callback_register(&heap_cb);
+
+	return NULL;
+}
+
+static void mem_pressure_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	memset(&slab_rec, 0, sizeof(slab_rec));
+	memset(&heap_rec, 0, sizeof(heap_rec));
+}
+
+ZTEST_SUITE(mem_pressure, NULL, mem_pressure_setup, mem_pressure_before,
+	    NULL, NULL);
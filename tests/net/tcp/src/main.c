@@ -26,11 +26,12 @@ LOG_MODULE_REGISTER(net_test, CONFIG_NET_TCP_LOG_LEVEL);
 #include <zephyr/net/ethernet.h>
 #include <zephyr/net/dummy.h>
 #include <zephyr/net/net_pkt.h>
+#include <zephyr/net/socket.h>
 
 #include "ipv4.h"
 #include "ipv6.h"
 #include "tcp.h"
-#include "tcp_private.h"
+#include "tcp_internal.h"
 #include "net_stats.h"
 
 #include <zephyr/ztest.h>
@@ -117,6 +118,9 @@ enum test_state {
 
 static enum test_state t_state;
 
+/* Window scale option of the last SYN or SYN-ACK sent, -1 if it had none */
+static int syn_wnd_scale;
+
 static struct k_work_delayable test_server;
 static void test_server_timeout(struct k_work *work);
 
@@ -136,6 +140,16 @@ static void handle_server_recv_out_of_order(struct net_pkt *pkt);
 static void handle_server_rst_on_closed_port(sa_family_t af, struct tcphdr *th);
 static void handle_server_rst_on_listening_port(sa_family_t af, struct tcphdr *th);
 static void handle_syn_invalid_ack(sa_family_t af, struct tcphdr *th);
+#if defined(CONFIG_NET_TCP_SACK)
+static void handle_server_sack(struct net_pkt *pkt, struct tcphdr *th);
+static void handle_client_sack(struct net_pkt *pkt, struct tcphdr *th);
+#endif
+#if defined(CONFIG_NET_TCP_ADAPTIVE_RTO)
+static void handle_client_rtt(struct net_pkt *pkt, struct tcphdr *th);
+#endif
+#if defined(CONFIG_NET_TCP_CONGESTION_CUBIC) && defined(CONFIG_NET_TCP_FAST_RETRANSMIT)
+static void handle_client_congestion(struct net_pkt *pkt, struct tcphdr *th);
+#endif
 
 static void verify_flags(struct tcphdr *th, uint8_t flags,
 			 const char *fun, int line)
@@ -233,6 +247,18 @@ static uint8_t tcp_options[20] = {
 	0x01, /* NOP */
 	0x03, 0x03, 0x07 /* Win scale*/ };
 
+/* Options of the SYN and SACK blocks of the ACKs sent by the peer, and
+ * the window it advertises (NET_IPV6_MTU if 0).
+ */
+static const uint8_t *peer_syn_options;
+static size_t peer_syn_options_len;
+static struct tcp_sack_block peer_sack[NET_TCP_MAX_SACK_BLOCKS];
+static int peer_sack_blocks;
+static uint16_t peer_win;
+static bool peer_ts;
+static uint32_t peer_tsval;
+static uint32_t peer_tsecr;
+
 static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 					      uint16_t src_port,
 					      uint16_t dst_port,
@@ -241,13 +267,42 @@ static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 					      size_t len)
 {
 	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct tcphdr);
+	uint8_t opts[4 + sizeof(peer_sack) + 12];
 	struct net_pkt *pkt;
 	struct tcphdr *th;
 	uint8_t opts_len = 0;
 	int ret = -EINVAL;
 
 	if ((test_case_no == 4U) && (flags & SYN)) {
+		memcpy(opts, tcp_options, sizeof(tcp_options));
 		opts_len = sizeof(tcp_options);
+	} else if ((flags & SYN) && peer_syn_options != NULL) {
+		memcpy(opts, peer_syn_options, peer_syn_options_len);
+		opts_len = peer_syn_options_len;
+	} else if (!(flags & SYN) && peer_sack_blocks > 0) {
+		opts[0] = NET_TCP_NOP_OPT;
+		opts[1] = NET_TCP_NOP_OPT;
+		opts[2] = NET_TCP_SACK_OPT;
+		opts[3] = 2 + peer_sack_blocks * NET_TCP_SACK_BLOCK_SIZE;
+
+		for (int i = 0; i < peer_sack_blocks; i++) {
+			UNALIGNED_PUT(htonl(peer_sack[i].left),
+				      (uint32_t *)&opts[4 + i * 8]);
+			UNALIGNED_PUT(htonl(peer_sack[i].right),
+				      (uint32_t *)&opts[8 + i * 8]);
+		}
+
+		opts_len = 4 + peer_sack_blocks * NET_TCP_SACK_BLOCK_SIZE;
+	}
+
+	if (peer_ts) {
+		opts[opts_len] = NET_TCP_NOP_OPT;
+		opts[opts_len + 1] = NET_TCP_NOP_OPT;
+		opts[opts_len + 2] = NET_TCP_TIMESTAMPS_OPT;
+		opts[opts_len + 3] = NET_TCP_TIMESTAMPS_SIZE;
+		UNALIGNED_PUT(htonl(peer_tsval), (uint32_t *)&opts[opts_len + 4]);
+		UNALIGNED_PUT(htonl(peer_tsecr), (uint32_t *)&opts[opts_len + 8]);
+		opts_len += 12U;
 	}
 
 	/* Allocate buffer */
@@ -282,14 +337,9 @@ static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 	th->th_sport = src_port;
 	th->th_dport = dst_port;
 
-	if ((test_case_no == 4U) && (flags & SYN)) {
-		th->th_off = 10U;
-	} else {
-		th->th_off = 5U;
-	}
-
+	th->th_off = 5U + opts_len / 4U;
 	th->th_flags = flags;
-	th->th_win = NET_IPV6_MTU;
+	th->th_win = peer_win ? htons(peer_win) : NET_IPV6_MTU;
 	th->th_seq = htonl(seq);
 
 	if (ACK & flags) {
@@ -301,9 +351,9 @@ static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 		goto fail;
 	}
 
-	if ((test_case_no == 4U) && (flags & SYN)) {
+	if (opts_len > 0) {
 		/* Add TCP Options */
-		ret = net_pkt_write(pkt, tcp_options, opts_len);
+		ret = net_pkt_write(pkt, opts, opts_len);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -424,6 +474,89 @@ fail:
 	return -EINVAL;
 }
 
+/* Copy the data of the option of the given kind to buf, returns its
+ * length or -1 if the option was not found.
+ */
+static int read_tcp_opt(struct net_pkt *pkt, struct tcphdr *th, uint8_t kind,
+			uint8_t *buf, size_t buf_len)
+{
+	uint8_t opts[40];
+	size_t len = th->th_off * 4U - sizeof(struct tcphdr);
+	int found = -1;
+	size_t i;
+
+	if (len == 0U || len > sizeof(opts)) {
+		return -1;
+	}
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+
+	if (net_pkt_skip(pkt, net_pkt_ip_hdr_len(pkt) + net_pkt_ip_opts_len(pkt) +
+			 sizeof(struct tcphdr)) < 0 ||
+	    net_pkt_read(pkt, opts, len) < 0) {
+		goto out;
+	}
+
+	for (i = 0; i < len && opts[i] != NET_TCP_END_OPT; ) {
+		if (opts[i] == NET_TCP_NOP_OPT) {
+			i++;
+			continue;
+		}
+
+		if (i + 1 >= len || opts[i + 1] < 2U) {
+			break;
+		}
+
+		if (opts[i] == kind && i + opts[i + 1] <= len) {
+			found = MIN(opts[i + 1] - 2, buf_len);
+			memcpy(buf, &opts[i + 2], found);
+			break;
+		}
+
+		i += opts[i + 1];
+	}
+
+out:
+	net_pkt_cursor_init(pkt);
+
+	return found;
+}
+
+static int read_wnd_scale_opt(struct net_pkt *pkt, struct tcphdr *th)
+{
+	uint8_t scale;
+
+	if (read_tcp_opt(pkt, th, NET_TCP_WINDOW_SCALE_OPT, &scale,
+			 sizeof(scale)) != 1) {
+		return -1;
+	}
+
+	return scale;
+}
+
+#if defined(CONFIG_NET_TCP_SACK)
+/* Returns the number of SACK blocks in the packet */
+static int read_sack_opt(struct net_pkt *pkt, struct tcphdr *th,
+			 struct tcp_sack_block *blocks)
+{
+	uint8_t buf[NET_TCP_MAX_SACK_BLOCKS * NET_TCP_SACK_BLOCK_SIZE];
+	int len, i;
+
+	len = read_tcp_opt(pkt, th, NET_TCP_SACK_OPT, buf, sizeof(buf));
+	if (len <= 0) {
+		return 0;
+	}
+
+	for (i = 0; i < len / NET_TCP_SACK_BLOCK_SIZE; i++) {
+		blocks[i].left = ntohl(UNALIGNED_GET((uint32_t *)&buf[i * 8]));
+		blocks[i].right = ntohl(UNALIGNED_GET((uint32_t *)&buf[i * 8 + 4]));
+	}
+
+	return i;
+}
+#endif
+
 static int tester_send(const struct device *dev, struct net_pkt *pkt)
 {
 	struct tcphdr th;
@@ -439,6 +572,10 @@ static int tester_send(const struct device *dev, struct net_pkt *pkt)
 		goto fail;
 	}
 
+	if (th.th_flags & SYN) {
+		syn_wnd_scale = read_wnd_scale_opt(pkt, &th);
+	}
+
 	switch (test_case_no) {
 	case 1:
 	case 2:
@@ -485,6 +622,24 @@ static int tester_send(const struct device *dev, struct net_pkt *pkt)
 	case 17:
 		handle_client_fin_wait_2_failure_test(net_pkt_family(pkt), &th);
 		break;
+#if defined(CONFIG_NET_TCP_SACK)
+	case 18:
+		handle_server_sack(pkt, &th);
+		break;
+	case 19:
+		handle_client_sack(pkt, &th);
+		break;
+#endif
+#if defined(CONFIG_NET_TCP_ADAPTIVE_RTO)
+	case 20:
+		handle_client_rtt(pkt, &th);
+		break;
+#endif
+#if defined(CONFIG_NET_TCP_CONGESTION_CUBIC) && defined(CONFIG_NET_TCP_FAST_RETRANSMIT)
+	case 21:
+		handle_client_congestion(pkt, &th);
+		break;
+#endif
 
 	default:
 		zassert_true(false, "Undefined test case");
@@ -807,6 +962,40 @@ static void test_tcp_accept_cb(struct net_context *ctx,
 	test_sem_give();
 }
 
+/* Check the window scaling of an accepted connection, peer_scale is the
+ * shift the peer sent in its SYN or -1 if it did not send the option.
+ */
+static void check_wnd_scale(struct net_context *ctx, int peer_scale)
+{
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+	struct tcp *conn = ctx->tcp;
+
+	if (peer_scale < 0) {
+		zassert_equal(syn_wnd_scale, -1,
+			      "Window scale option sent without the peer's");
+		zassert_equal(conn->recv_win_scale, 0, "Receive window scaled");
+		zassert_equal(conn->send_win_scale, 0, "Send window scaled");
+		return;
+	}
+
+	zassert_equal(syn_wnd_scale, conn->recv_win_scale,
+		      "Window scale %d sent, %u used", syn_wnd_scale,
+		      conn->recv_win_scale);
+	zassert_equal(conn->send_win_scale, peer_scale,
+		      "Peer window scale %d, %u used", peer_scale,
+		      conn->send_win_scale);
+	zassert_true((conn->recv_win_max >> conn->recv_win_scale) <= UINT16_MAX,
+		     "Receive window %u does not fit with shift %u",
+		     conn->recv_win_max, conn->recv_win_scale);
+	zassert_true(conn->recv_win_scale == 0 ||
+		     (conn->recv_win_max >> (conn->recv_win_scale - 1)) > UINT16_MAX,
+		     "Receive window shift %u is not the smallest one",
+		     conn->recv_win_scale);
+#else
+	zassert_equal(syn_wnd_scale, -1, "Window scale option sent");
+#endif
+}
+
 /* Test case scenario IPv4
  *   Expect SYN
  *   send SYN ACK,
@@ -857,6 +1046,7 @@ ZTEST(net_tcp, test_server_ipv4)
 	 * connection.
 	 */
 	test_sem_take(K_MSEC(100), __LINE__);
+	check_wnd_scale(accepted_ctx, -1);
 
 	/* Trigger the peer to send DATA  */
 	k_work_reschedule(&test_server, K_NO_WAIT);
@@ -890,6 +1080,9 @@ ZTEST(net_tcp, test_server_ipv4)
 ZTEST(net_tcp, test_server_with_options_ipv4)
 {
 	struct net_context *ctx;
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+	struct tcp *conn;
+#endif
 	int ret;
 
 	t_state = T_SYN;
@@ -927,6 +1120,17 @@ ZTEST(net_tcp, test_server_with_options_ipv4)
 	 */
 	test_sem_take(K_MSEC(100), __LINE__);
 
+	/* The peer sent a window scale of 7 and scales its windows after
+	 * the SYN.
+	 */
+	check_wnd_scale(accepted_ctx, 7);
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+	conn = accepted_ctx->tcp;
+	zassert_equal(conn->send_win,
+		      MIN((uint32_t)ntohs(NET_IPV6_MTU) << 7, conn->send_win_max),
+		      "Peer window not scaled");
+#endif
+
 	/* Trigger the peer to send DATA  */
 	k_work_reschedule(&test_server, K_NO_WAIT);
 
@@ -2005,7 +2209,7 @@ ZTEST(net_tcp, test_client_invalid_rst)
 {
 	struct net_context *ctx;
 	struct tcp *conn;
-	uint16_t wnd;
+	uint32_t wnd;
 
 	ctx = create_server_socket(0, 0);
 
@@ -2194,6 +2398,286 @@ ZTEST(net_tcp, test_server_out_of_order_data)
 	test_server_timeout_out_of_order_data();
 }
 
+#if defined(CONFIG_NET_TCP_SACK)
+static const uint8_t sack_perm_options[] = {
+	0x01, 0x01, 0x04, 0x02, /* NOP, NOP, SACK permitted */
+};
+
+static const uint8_t sack_mss_options[] = {
+	0x02, 0x04, 0x00, 0x50, /* Max segment 80 */
+	0x01, 0x01, 0x04, 0x02, /* NOP, NOP, SACK permitted */
+};
+
+static uint32_t sack_ack;
+static struct tcp_sack_block sack_blocks[NET_TCP_MAX_SACK_BLOCKS];
+static int sack_num_blocks;
+
+static void handle_server_sack(struct net_pkt *pkt, struct tcphdr *th)
+{
+	sack_ack = ntohl(th->th_ack);
+	sack_num_blocks = read_sack_opt(pkt, th, sack_blocks);
+
+	test_sem_give();
+}
+
+static void send_server_sack_data(uint32_t offset, size_t len)
+{
+	struct net_pkt *pkt;
+	int ret;
+
+	seq = 1U + offset;
+	pkt = prepare_data_packet(AF_INET6, htons(MY_PORT), htons(PEER_PORT),
+				  &lorem_ipsum[offset], len);
+	zassert_not_null(pkt, "Cannot create pkt");
+
+	ret = net_recv_data(net_iface, pkt);
+	zassert_true(ret == 0, "recv data failed (%d)", ret);
+
+	/* The device acknowledges every data segment */
+	test_sem_take(K_MSEC(100), __LINE__);
+}
+
+/* Test case scenario IPv6
+ *   negotiate SACK in the handshake,
+ *   send out of order data,
+ *   expect ACK with a SACK block covering it,
+ *   send the missing data,
+ *   expect ACK for all the data without SACK blocks.
+ */
+ZTEST(net_tcp, test_server_sack)
+{
+	struct net_context *ctx;
+	struct net_pkt *rst;
+	struct tcp *conn;
+	int ret;
+
+	/* Out of order data is only reported when it is queued */
+	if (CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT == 0) {
+		ztest_test_skip();
+	}
+
+	k_sem_reset(&test_sem);
+
+	peer_syn_options = sack_perm_options;
+	peer_syn_options_len = sizeof(sack_perm_options);
+
+	ctx = create_server_socket(0, 0);
+	conn = accepted_ctx->tcp;
+	zassert_true(conn->sack_ok, "SACK not negotiated");
+
+	test_case_no = 18;
+
+	send_server_sack_data(10, 10);
+	zassert_equal(sack_ack, 1U, "Unexpected ACK %u", sack_ack);
+	zassert_equal(sack_num_blocks, 1, "Expected 1 SACK block, got %d",
+		      sack_num_blocks);
+	zassert_equal(sack_blocks[0].left, 11U, "Unexpected SACK left edge %u",
+		      sack_blocks[0].left);
+	zassert_equal(sack_blocks[0].right, 21U, "Unexpected SACK right edge %u",
+		      sack_blocks[0].right);
+
+	send_server_sack_data(0, 10);
+	zassert_equal(sack_ack, 21U, "Unexpected ACK %u", sack_ack);
+	zassert_equal(sack_num_blocks, 0, "Unexpected SACK blocks");
+
+	/* Abort the connection, no need for the closing handshake */
+	seq = 21U;
+	rst = prepare_rst_packet(AF_INET6, htons(MY_PORT), htons(PEER_PORT));
+
+	ret = net_recv_data(net_iface, rst);
+	zassert_true(ret == 0, "recv data failed (%d)", ret);
+
+	/* Let the receiving thread run */
+	k_msleep(50);
+
+	peer_syn_options = NULL;
+	peer_syn_options_len = 0;
+
+	net_context_put(ctx);
+	net_context_put(accepted_ctx);
+}
+
+/* Below the MSS the interface MTU allows */
+#define SACK_MSS      80
+#define SACK_DATA_LEN (5 * SACK_MSS)
+
+static uint16_t sack_port;
+static uint32_t sack_seg_offset[10];
+static uint32_t sack_seg_len[10];
+static int sack_segs;
+static K_SEM_DEFINE(sack_seg_sem, 0, ARRAY_SIZE(sack_seg_offset));
+
+static void handle_client_sack(struct net_pkt *pkt, struct tcphdr *th)
+{
+	struct net_pkt *reply;
+	size_t len;
+	int ret;
+
+	if (th->th_flags & SYN) {
+		device_initial_seq = ntohl(th->th_seq);
+		sack_port = th->th_sport;
+		seq = 0U;
+		ack = ntohl(th->th_seq) + 1U;
+		reply = prepare_syn_ack_packet(AF_INET, htons(MY_PORT),
+					       th->th_sport);
+		seq++;
+
+		ret = net_recv_data(net_iface, reply);
+		zassert_true(ret == 0, "recv data failed (%d)", ret);
+		return;
+	}
+
+	len = net_pkt_get_len(pkt) - net_pkt_ip_hdr_len(pkt) -
+	      net_pkt_ip_opts_len(pkt) - th->th_off * 4U;
+
+	/* Only the data segments are of interest */
+	if (len == 0U || sack_segs == ARRAY_SIZE(sack_seg_offset)) {
+		return;
+	}
+
+	sack_seg_offset[sack_segs] = get_rel_seq(th) - 1U;
+	sack_seg_len[sack_segs] = len;
+	sack_segs++;
+
+	k_sem_give(&sack_seg_sem);
+}
+
+/* Acknowledge the data up to offset, with the given SACK blocks */
+static void send_client_sack(uint32_t offset, const struct tcp_sack_block *blocks,
+			     int num_blocks)
+{
+	struct net_pkt *pkt;
+	int ret;
+
+	for (int i = 0; i < num_blocks; i++) {
+		peer_sack[i].left = device_initial_seq + 1U + blocks[i].left;
+		peer_sack[i].right = device_initial_seq + 1U + blocks[i].right;
+	}
+
+	peer_sack_blocks = num_blocks;
+	ack = device_initial_seq + 1U + offset;
+
+	pkt = prepare_ack_packet(AF_INET, htons(MY_PORT), sack_port);
+	zassert_not_null(pkt, "Cannot create pkt");
+
+	peer_sack_blocks = 0;
+
+	ret = net_recv_data(net_iface, pkt);
+	zassert_true(ret == 0, "recv data failed (%d)", ret);
+}
+
+static void check_sack_segment(int i, uint32_t offset)
+{
+	zassert_ok(k_sem_take(&sack_seg_sem, K_MSEC(50)),
+		   "Segment %d not sent", i);
+	zassert_equal(sack_seg_offset[i], offset,
+		      "Segment %d at %u, expected %u", i, sack_seg_offset[i],
+		      offset);
+	zassert_equal(sack_seg_len[i], SACK_MSS, "Segment %d of %u bytes at %u", i,
+		      sack_seg_len[i], sack_seg_offset[i]);
+}
+
+/* Test case scenario IPv4
+ *   negotiate SACK and a MSS of 80 bytes in the handshake,
+ *   expect 5 data segments,
+ *   send ACKs reporting the 2nd and 4th segment lost,
+ *   expect them to be retransmitted on the 3rd duplicate ACK and the
+ *   partial ACK, without waiting for a retransmission timeout,
+ *   send ACK for all the data,
+ *   expect no further retransmissions.
+ */
+ZTEST(net_tcp, test_client_sack_retransmit)
+{
+	const struct tcp_sack_block first[] = {
+		{ 2 * SACK_MSS, 3 * SACK_MSS },
+	};
+	const struct tcp_sack_block both[] = {
+		{ 2 * SACK_MSS, 3 * SACK_MSS }, { 4 * SACK_MSS, 5 * SACK_MSS },
+	};
+	const struct tcp_sack_block last[] = {
+		{ 4 * SACK_MSS, 5 * SACK_MSS },
+	};
+	struct net_context *ctx;
+	struct net_pkt *rst;
+	struct tcp *conn;
+	int ret;
+
+	k_sem_reset(&sack_seg_sem);
+
+	test_case_no = 19;
+	seq = ack = 0;
+	sack_segs = 0;
+	peer_syn_options = sack_mss_options;
+	peer_syn_options_len = sizeof(sack_mss_options);
+	peer_win = 8192;
+
+	ret = net_context_get(AF_INET, SOCK_STREAM, IPPROTO_TCP, &ctx);
+	if (ret < 0) {
+		zassert_true(false, "Failed to get net_context");
+	}
+
+	net_context_ref(ctx);
+
+	ret = net_context_connect(ctx, (struct sockaddr *)&peer_addr_s,
+				  sizeof(struct sockaddr_in),
+				  NULL,
+				  K_MSEC(100), NULL);
+	if (ret < 0) {
+		zassert_true(false, "Failed to connect to peer");
+	}
+
+	conn = ctx->tcp;
+	zassert_true(conn->sack_ok, "SACK not negotiated");
+
+#if defined(CONFIG_NET_TCP_CONGESTION_AVOIDANCE)
+	/* Send all the data at once */
+	conn->ca.cwnd = UINT16_MAX;
+#endif
+
+	ret = net_context_send(ctx, lorem_ipsum, SACK_DATA_LEN, NULL,
+			       K_NO_WAIT, NULL);
+	zassert_equal(ret, SACK_DATA_LEN, "Failed to send data (%d)", ret);
+
+	for (int i = 0; i < SACK_DATA_LEN / SACK_MSS; i++) {
+		check_sack_segment(i, i * SACK_MSS);
+	}
+
+	send_client_sack(SACK_MSS, first, ARRAY_SIZE(first));
+
+	for (int i = 0; i < 3; i++) {
+		send_client_sack(SACK_MSS, both, ARRAY_SIZE(both));
+	}
+
+	/* Expected well within the retransmission timeout */
+	check_sack_segment(5, SACK_MSS);
+
+	send_client_sack(3 * SACK_MSS, last, ARRAY_SIZE(last));
+
+	check_sack_segment(6, 3 * SACK_MSS);
+
+	send_client_sack(SACK_DATA_LEN, NULL, 0);
+
+	/* Nothing is left to retransmit */
+	zassert_equal(k_sem_take(&sack_seg_sem, K_MSEC(300)), -EAGAIN,
+		      "Unexpected segment %d", sack_segs);
+
+	/* Abort the connection, no need for the closing handshake */
+	rst = prepare_rst_packet(AF_INET, htons(MY_PORT), sack_port);
+
+	ret = net_recv_data(net_iface, rst);
+	zassert_true(ret == 0, "recv data failed (%d)", ret);
+
+	/* Let the receiving thread run */
+	k_msleep(50);
+
+	peer_syn_options = NULL;
+	peer_syn_options_len = 0;
+	peer_win = 0;
+
+	net_context_put(ctx);
+}
+#endif /* CONFIG_NET_TCP_SACK */
+
 static void handle_server_rst_on_closed_port(sa_family_t af, struct tcphdr *th)
 {
 	switch (t_state) {
@@ -2408,4 +2892,507 @@ ZTEST(net_tcp, test_client_rst_on_unexpected_ack_on_syn)
 	test_sem_take(K_MSEC(100), __LINE__);
 }
 
+#if defined(CONFIG_NET_TCP_ADAPTIVE_RTO)
+/* Round trip times of the peer for the SYN and for the data, the actual
+ * ones are rounded up to the tick.
+ */
+#define RTT_SYN_MS  50
+#define RTT_DATA_MS 100
+#define RTT_DATA_LEN 10
+
+static uint16_t rtt_port;
+static uint32_t rtt_syn_ms;
+static size_t rtt_data_len;
+static uint32_t rtt_data_tsecr;
+static K_SEM_DEFINE(rtt_data_sem, 0, 1);
+
+static void handle_client_rtt(struct net_pkt *pkt, struct tcphdr *th)
+{
+	uint8_t ts[8];
+	struct net_pkt *reply;
+	size_t len;
+	int ret;
+
+	/* Echo the latest timestamp of the device */
+	if (read_tcp_opt(pkt, th, NET_TCP_TIMESTAMPS_OPT, ts,
+			 sizeof(ts)) == sizeof(ts)) {
+		peer_tsecr = ntohl(UNALIGNED_GET((uint32_t *)ts));
+		rtt_data_tsecr = ntohl(UNALIGNED_GET((uint32_t *)&ts[4]));
+	}
+
+	if (th->th_flags & SYN) {
+		device_initial_seq = ntohl(th->th_seq);
+		rtt_port = th->th_sport;
+		seq = 0U;
+		ack = ntohl(th->th_seq) + 1U;
+
+		rtt_syn_ms = k_uptime_get_32();
+		k_msleep(RTT_SYN_MS);
+		rtt_syn_ms = k_uptime_get_32() - rtt_syn_ms;
+
+		reply = prepare_syn_ack_packet(AF_INET, htons(MY_PORT),
+					       th->th_sport);
+		seq++;
+
+		ret = net_recv_data(net_iface, reply);
+		zassert_true(ret == 0, "recv data failed (%d)", ret);
+		return;
+	}
+
+	len = net_pkt_get_len(pkt) - net_pkt_ip_hdr_len(pkt) -
+	      net_pkt_ip_opts_len(pkt) - th->th_off * 4U;
+	if (len == 0U) {
+		return;
+	}
+
+	rtt_data_len = len;
+	k_sem_give(&rtt_data_sem);
+}
+
+static void check_rtt(struct net_context *ctx, uint32_t rtt_ms,
+		      uint32_t rttvar_ms, bool timestamps)
+{
+	struct tcp_info info;
+	size_t len = sizeof(info);
+
+	zassert_ok(net_tcp_get_option(ctx, TCP_OPT_INFO, &info, &len));
+	zassert_equal(len, sizeof(info));
+
+	zassert_equal((info.tcpi_options & TCPI_OPT_TIMESTAMPS) != 0,
+		      timestamps, "Timestamps %snegotiated",
+		      timestamps ? "not " : "");
+	zassert_within(info.tcpi_rtt, rtt_ms * USEC_PER_MSEC, USEC_PER_MSEC,
+		       "RTT %u us, expected %u ms", info.tcpi_rtt, rtt_ms);
+	zassert_within(info.tcpi_rttvar, rttvar_ms * USEC_PER_MSEC,
+		       USEC_PER_MSEC, "RTT variance %u us, expected %u ms",
+		       info.tcpi_rttvar, rttvar_ms);
+	zassert_within(info.tcpi_rto, (rtt_ms + 4 * rttvar_ms) * USEC_PER_MSEC,
+		       5 * USEC_PER_MSEC, "RTO %u us, expected %u ms",
+		       info.tcpi_rto, rtt_ms + 4 * rttvar_ms);
+}
+
+/* Test case scenario IPv4
+ *   send SYN, the peer answers with a SYN-ACK after about 50 ms,
+ *   expect that RTT and a RTO of 3 times it,
+ *   send data, the peer acknowledges it after about 100 ms,
+ *   expect the RTT and RTO to follow as per RFC 6298.
+ * The RTT is measured with the timestamps option when negotiated, else
+ * by timing the SYN and the data segment.
+ */
+static void test_client_rtt(bool timestamps)
+{
+	struct net_context *ctx;
+	struct net_pkt *pkt;
+	uint32_t rtt_ms;
+	int ret;
+
+	k_sem_reset(&rtt_data_sem);
+
+	test_case_no = 20;
+	seq = ack = 0;
+	peer_ts = timestamps;
+	peer_tsval = 0x12345678U;
+	peer_tsecr = 0U;
+	peer_win = 8192;
+
+	ret = net_context_get(AF_INET, SOCK_STREAM, IPPROTO_TCP, &ctx);
+	if (ret < 0) {
+		zassert_true(false, "Failed to get net_context");
+	}
+
+	net_context_ref(ctx);
+
+	ret = net_context_connect(ctx, (struct sockaddr *)&peer_addr_s,
+				  sizeof(struct sockaddr_in),
+				  NULL,
+				  K_MSEC(100), NULL);
+	if (ret < 0) {
+		zassert_true(false, "Failed to connect to peer");
+	}
+
+	/* SRTT is R, RTTVAR is R/2 */
+	check_rtt(ctx, rtt_syn_ms, rtt_syn_ms / 2, timestamps);
+
+	ret = net_context_send(ctx, lorem_ipsum, RTT_DATA_LEN, NULL,
+			       K_NO_WAIT, NULL);
+	zassert_equal(ret, RTT_DATA_LEN, "Failed to send data (%d)", ret);
+
+	zassert_ok(k_sem_take(&rtt_data_sem, K_MSEC(50)), "Data not sent");
+	zassert_equal(rtt_data_len, RTT_DATA_LEN);
+	if (timestamps) {
+		zassert_equal(rtt_data_tsecr, peer_tsval,
+			      "Timestamp of the peer not echoed");
+	}
+
+	rtt_ms = k_uptime_get_32();
+	k_msleep(RTT_DATA_MS);
+	rtt_ms = k_uptime_get_32() - rtt_ms;
+
+	ack = device_initial_seq + 1U + RTT_DATA_LEN;
+	pkt = prepare_ack_packet(AF_INET, htons(MY_PORT), rtt_port);
+	ret = net_recv_data(net_iface, pkt);
+	zassert_true(ret == 0, "recv data failed (%d)", ret);
+
+	/* Let the receiving thread run */
+	k_msleep(10);
+
+	/* SRTT is 7/8 SRTT + 1/8 R, RTTVAR 3/4 RTTVAR + 1/4 |SRTT - R| */
+	check_rtt(ctx, (7 * rtt_syn_ms + rtt_ms) / 8,
+		  (3 * rtt_syn_ms / 2 + rtt_ms - rtt_syn_ms) / 4, timestamps);
+
+	/* Abort the connection, no need for the closing handshake */
+	pkt = prepare_rst_packet(AF_INET, htons(MY_PORT), rtt_port);
+
+	ret = net_recv_data(net_iface, pkt);
+	zassert_true(ret == 0, "recv data failed (%d)", ret);
+
+	k_msleep(50);
+
+	peer_ts = false;
+	peer_win = 0;
+
+	net_context_put(ctx);
+}
+
+ZTEST(net_tcp, test_client_rtt_timestamps)
+{
+	if (!IS_ENABLED(CONFIG_NET_TCP_TIMESTAMPS)) {
+		ztest_test_skip();
+	}
+
+	test_client_rtt(true);
+}
+
+ZTEST(net_tcp, test_client_rtt_karn)
+{
+	test_client_rtt(false);
+}
+#endif /* CONFIG_NET_TCP_ADAPTIVE_RTO */
+
+#if defined(CONFIG_NET_TCP_CONGESTION_CUBIC) && defined(CONFIG_NET_TCP_FAST_RETRANSMIT)
+#define CA_MSS  80
+#define CA_SEGS 10
+
+static const uint8_t ca_mss_options[] = {
+	0x02, 0x04, 0x00, 0x50, /* Max segment 80 */
+};
+
+static uint16_t ca_port;
+static K_SEM_DEFINE(ca_seg_sem, 0, 2 * CA_SEGS);
+
+static void handle_client_congestion(struct net_pkt *pkt, struct tcphdr *th)
+{
+	struct net_pkt *reply;
+	size_t len;
+	int ret;
+
+	if (th->th_flags & SYN) {
+		device_initial_seq = ntohl(th->th_seq);
+		ca_port = th->th_sport;
+		seq = 0U;
+		ack = ntohl(th->th_seq) + 1U;
+		reply = prepare_syn_ack_packet(AF_INET, htons(MY_PORT),
+					       th->th_sport);
+		seq++;
+
+		ret = net_recv_data(net_iface, reply);
+		zassert_true(ret == 0, "recv data failed (%d)", ret);
+		return;
+	}
+
+	len = net_pkt_get_len(pkt) - net_pkt_ip_hdr_len(pkt) -
+	      net_pkt_ip_opts_len(pkt) - th->th_off * 4U;
+	if (len > 0U) {
+		k_sem_give(&ca_seg_sem);
+	}
+}
+
+static void send_ca_ack(uint32_t offset)
+{
+	struct net_pkt *pkt;
+	int ret;
+
+	ack = device_initial_seq + 1U + offset;
+	pkt = prepare_ack_packet(AF_INET, htons(MY_PORT), ca_port);
+	zassert_not_null(pkt, "Cannot create pkt");
+
+	ret = net_recv_data(net_iface, pkt);
+	zassert_true(ret == 0, "recv data failed (%d)", ret);
+}
+
+/* Test case scenario IPv4
+ *   select the congestion control algorithm of the connection,
+ *   send 10 segments,
+ *   send an ACK for the first one and three duplicate ACKs,
+ *   expect a fast retransmission, with the slow start threshold set by
+ *   the algorithm from the 9 segments in flight,
+ *   send ACK for all the data,
+ *   expect the window to be the slow start threshold after the recovery.
+ */
+static struct net_context *ca_connect(const char *name)
+{
+	char buf[TCP_CA_NAME_MAX];
+	size_t len = sizeof(buf);
+	struct net_context *ctx;
+	int ret;
+
+	k_sem_reset(&ca_seg_sem);
+
+	test_case_no = 21;
+	seq = ack = 0;
+	peer_syn_options = ca_mss_options;
+	peer_syn_options_len = sizeof(ca_mss_options);
+	peer_win = 8192;
+
+	ret = net_context_get(AF_INET, SOCK_STREAM, IPPROTO_TCP, &ctx);
+	if (ret < 0) {
+		zassert_true(false, "Failed to get net_context");
+	}
+
+	net_context_ref(ctx);
+
+	ret = net_context_connect(ctx, (struct sockaddr *)&peer_addr_s,
+				  sizeof(struct sockaddr_in),
+				  NULL,
+				  K_MSEC(100), NULL);
+	if (ret < 0) {
+		zassert_true(false, "Failed to connect to peer");
+	}
+
+	zassert_equal(net_tcp_set_option(ctx, TCP_OPT_CONGESTION, "vegas", 5),
+		      -ENOENT, "Unknown algorithm selected");
+	zassert_ok(net_tcp_set_option(ctx, TCP_OPT_CONGESTION, name,
+				      strlen(name)));
+	zassert_ok(net_tcp_get_option(ctx, TCP_OPT_CONGESTION, buf, &len));
+	zassert_equal(len, strlen(name) + 1);
+	zassert_mem_equal(buf, name, len);
+
+	return ctx;
+}
+
+static void ca_close(struct net_context *ctx)
+{
+	struct net_pkt *rst;
+	int ret;
+
+	/* Abort the connection, no need for the closing handshake */
+	rst = prepare_rst_packet(AF_INET, htons(MY_PORT), ca_port);
+
+	ret = net_recv_data(net_iface, rst);
+	zassert_true(ret == 0, "recv data failed (%d)", ret);
+
+	k_msleep(50);
+
+	peer_syn_options = NULL;
+	peer_syn_options_len = 0;
+	peer_win = 0;
+
+	net_context_put(ctx);
+}
+
+/* Test case scenario IPv4
+ *   select the congestion control algorithm of the connection,
+ *   send 10 segments,
+ *   send an ACK for the first one and three duplicate ACKs,
+ *   expect a fast retransmission, with the slow start threshold set by
+ *   the algorithm from the 9 segments in flight,
+ *   send ACK for all the data,
+ *   expect the window to be the slow start threshold after the recovery.
+ */
+static void test_client_congestion(const char *name, uint32_t ssthresh)
+{
+	struct net_context *ctx;
+	struct tcp *conn;
+	int ret;
+
+	ctx = ca_connect(name);
+	conn = ctx->tcp;
+
+	/* Send all the data at once */
+	conn->ca.cwnd = CA_SEGS * CA_MSS;
+
+	ret = net_context_send(ctx, lorem_ipsum, CA_SEGS * CA_MSS, NULL,
+			       K_NO_WAIT, NULL);
+	zassert_equal(ret, CA_SEGS * CA_MSS, "Failed to send data (%d)", ret);
+
+	for (int i = 0; i < CA_SEGS; i++) {
+		zassert_ok(k_sem_take(&ca_seg_sem, K_MSEC(50)),
+			   "Segment %d not sent", i);
+	}
+
+	for (int i = 0; i < 4; i++) {
+		send_ca_ack(CA_MSS);
+	}
+
+	zassert_ok(k_sem_take(&ca_seg_sem, K_MSEC(50)), "No fast retransmission");
+	zassert_equal(conn->ca.ssthresh, ssthresh, "ssthresh %u, expected %u",
+		      conn->ca.ssthresh, ssthresh);
+	zassert_equal(conn->ca.cwnd, ssthresh + 3 * CA_MSS);
+
+	send_ca_ack(CA_SEGS * CA_MSS);
+
+	/* Let the receiving thread run */
+	k_msleep(10);
+
+	zassert_equal(conn->ca.cwnd, ssthresh, "cwnd %u, expected %u",
+		      conn->ca.cwnd, ssthresh);
+
+	ca_close(ctx);
+}
+
+ZTEST(net_tcp, test_client_congestion_reno)
+{
+	/* Half of the window */
+	test_client_congestion("reno", (CA_SEGS - 1) * CA_MSS / 2);
+}
+
+ZTEST(net_tcp, test_client_congestion_cubic)
+{
+	/* 0.7 times the window */
+	test_client_congestion("cubic", (CA_SEGS - 1) * CA_MSS * 7 / 10);
+}
+
+/* Start a CUBIC epoch with the window gap below W_max, return K in ms */
+static uint32_t cubic_epoch_k(struct tcp *conn, uint32_t gap)
+{
+	conn->ca.cubic.in_epoch = false;
+	conn->ca.cubic.w_max = conn->ca.cwnd + gap;
+	conn->ca.ssthresh = conn->ca.cwnd;
+	conn->ca.ops->on_ack(conn, 1);
+
+	return conn->ca.cubic.k;
+}
+
+/* Test case scenario IPv4
+ *   select CUBIC for a connection,
+ *   start congestion avoidance epochs below W_max,
+ *   expect K = cbrt((W_max - cwnd) / C), which checks the integer cube
+ *   root on exact cubes and their neighbors.
+ */
+ZTEST(net_tcp, test_client_congestion_cubic_cbrt)
+{
+	/* Window gaps in bytes with a MSS of 80, and the expected K in ms:
+	 * (W_max - cwnd) / C = gap * 2.5e9 / 80 ms^3
+	 */
+	static const struct {
+		uint32_t gap;
+		uint32_t k;
+	} vectors[] = {
+		{ 4, 500 },      /* 500^3 */
+		{ 31, 989 },     /* between 989^3 and 990^3 */
+		{ 32, 1000 },    /* 1000^3 */
+		{ 33, 1010 },    /* between 1010^3 and 1011^3 */
+		{ 108, 1500 },   /* 1500^3 */
+		{ 4000, 5000 },  /* 5000^3 */
+	};
+	struct net_context *ctx;
+	struct tcp *conn;
+
+	ctx = ca_connect("cubic");
+	conn = ctx->tcp;
+
+	k_mutex_lock(&conn->lock, K_FOREVER);
+	conn->ca.cwnd = 20 * CA_MSS;
+
+	for (int i = 0; i < ARRAY_SIZE(vectors); i++) {
+		uint32_t k = cubic_epoch_k(conn, vectors[i].gap);
+
+		zassert_equal(k, vectors[i].k, "gap %u: K %u, expected %u",
+			      vectors[i].gap, k, vectors[i].k);
+	}
+	k_mutex_unlock(&conn->lock);
+
+	ca_close(ctx);
+}
+
+/* W_cubic(t) = C * (t - K)^3 + W_max in bytes, t and K in ms */
+static int32_t cubic_window(int32_t t, int32_t k, int32_t w_max)
+{
+	int64_t dt = t - k;
+
+	return w_max + (int32_t)(dt * dt * dt * CA_MSS / 2500000000LL);
+}
+
+/* Test case scenario IPv4
+ *   select CUBIC for a connection with 100 segments in flight,
+ *   report a loss,
+ *   expect W_max to be the flight size and the window to drop to 0.7
+ *   times that,
+ *   acknowledge a window worth of data in rounds spread over 8 seconds,
+ *   expect the window to follow W_cubic(t) each round: growing fast
+ *   then slower up to K (concave), staying near W_max around K
+ *   (plateau), then growing faster and faster (convex).
+ */
+ZTEST(net_tcp, test_client_congestion_cubic_growth)
+{
+	static const int32_t rounds_ms[] = {
+		500, 1000, 1500, 2000, 2500, 3000, 3500, 4000,
+		4217, 4500, 5000, 5500, 6000, 6500, 7000, 7500, 8000,
+	};
+	const int32_t w_max = 100 * CA_MSS;
+	int32_t prev, prev_inc = 0;
+	struct net_context *ctx;
+	struct tcp *conn;
+	int32_t k;
+
+	ctx = ca_connect("cubic");
+	conn = ctx->tcp;
+
+	k_mutex_lock(&conn->lock, K_FOREVER);
+#if defined(CONFIG_NET_TCP_ADAPTIVE_RTO)
+	/* Targets are one RTT ahead, keep them at the round times */
+	conn->srtt = 0U;
+#endif
+
+	/* Loss with 100 segments in flight, then recovery */
+	conn->unacked_len = w_max;
+	conn->ca.ops->on_loss(conn);
+	conn->unacked_len = 0;
+	zassert_equal(conn->ca.cubic.w_max, w_max);
+	zassert_equal(conn->ca.ssthresh, w_max * 7 / 10);
+	conn->ca.cwnd = conn->ca.ssthresh;
+
+	/* The first ACK starts the epoch, K = cbrt(30 segments / 0.4) s */
+	conn->ca.ops->on_ack(conn, 1);
+	k = conn->ca.cubic.k;
+	zassert_equal(k, 4217, "K %d ms", k);
+	prev = conn->ca.cwnd;
+
+	for (int i = 0; i < ARRAY_SIZE(rounds_ms); i++) {
+		int32_t t = rounds_ms[i];
+		int32_t expected = cubic_window(t, k, w_max);
+		int32_t cwnd, inc;
+
+		/* A round of ACKs t ms into the epoch */
+		conn->ca.cubic.epoch_start = k_uptime_get_32() - t;
+		conn->ca.ops->on_ack(conn, conn->ca.cwnd);
+
+		cwnd = conn->ca.cwnd;
+		zassert_within(cwnd, expected, CA_MSS / 2,
+			       "%d ms: cwnd %d, expected %d", t, cwnd, expected);
+
+		inc = (cwnd - prev) * 1000 / (t - (i > 0 ? rounds_ms[i - 1] : 0));
+		if (t < k - 500) {
+			/* Concave: slower and slower growth */
+			zassert_true(i == 0 || inc < prev_inc,
+				     "%d ms: growth %d B/s after %d B/s", t, inc, prev_inc);
+		} else if (t <= k + 500) {
+			/* Plateau */
+			zassert_within(cwnd, w_max, CA_MSS,
+				       "%d ms: cwnd %d away from W_max", t, cwnd);
+		} else if (t > k + 1000) {
+			/* Convex: faster and faster growth above W_max */
+			zassert_true(cwnd > w_max && inc > prev_inc,
+				     "%d ms: growth %d B/s after %d B/s", t, inc, prev_inc);
+		}
+
+		prev = cwnd;
+		prev_inc = inc;
+	}
+	k_mutex_unlock(&conn->lock);
+
+	ca_close(ctx);
+}
+#endif
+
 ZTEST_SUITE(net_tcp, NULL, presetup, NULL, NULL, NULL);
@@ -433,7 +433,7 @@ ZTEST(udp_fn_tests, test_udp)
 	struct net_conn_handle *handlers[CONFIG_NET_MAX_CONN];
 	struct net_if *iface;
 	struct net_if_addr *ifaddr;
-	struct ud *ud;
+	struct ud *ud, *listener;
 	int ret, i = 0;
 	bool st;
 
@@ -646,6 +646,26 @@ ZTEST(udp_fn_tests, test_udp)
 	TEST_IPV6_OK(ud, &in6addr_peer, &in6addr_my, 12345, 42421);
 	TEST_IPV6_LONG_OK(ud, &in6addr_peer, &in6addr_my, 12345, 42421);
 
+	/* A wildcard listener and a connected socket on the same port both
+	 * match packets from the peer port, the most specific one must win
+	 * whatever the registration order and the hash buckets they are in.
+	 */
+	listener = REGISTER(AF_INET, NULL, &any_addr4, 0, 5353);
+	ud = REGISTER(AF_INET, &peer_addr4, &my_addr4, 1234, 5353);
+	TEST_IPV4_OK(ud, &in4addr_peer, &in4addr_my, 1234, 5353);
+	TEST_IPV4_OK(listener, &in4addr_peer, &in4addr_my, 1235, 5353);
+	UNREGISTER(ud);
+	TEST_IPV4_OK(listener, &in4addr_peer, &in4addr_my, 1234, 5353);
+	UNREGISTER(listener);
+
+	ud = REGISTER(AF_INET6, &peer_addr6, &my_addr6, 1234, 5353);
+	listener = REGISTER(AF_INET6, NULL, &any_addr6, 0, 5353);
+	TEST_IPV6_OK(ud, &in6addr_peer, &in6addr_my, 1234, 5353);
+	TEST_IPV6_OK(listener, &in6addr_peer, &in6addr_my, 1235, 5353);
+	UNREGISTER(listener);
+	TEST_IPV6_OK(ud, &in6addr_peer, &in6addr_my, 1234, 5353);
+	UNREGISTER(ud);
+
 	/* Remote addr same as local addr, these two will never match */
 	REGISTER(AF_INET6, &my_addr6, NULL, 1234, 4242);
 	REGISTER(AF_INET, &my_addr4, NULL, 1234, 4242);